@@ -0,0 +1,299 @@
+/**
+* @Filename: BMP180_Acquisition.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [1:40pm]
+* @Version:  1.0.0
+*
+* @Description: Pipelined BMP180 acquisition engine
+*
+*               Transaction sequence for pressurePerTemperature = N:
+*
+*                 W(temp) .. 4.5ms .. R(UT) W(pres) .. tP .. R(UP)
+*                 W(pres) .. tP .. R(UP) ... (N pressure samples)
+*                 W(temp) ...
+*
+*               B5 is computed while the pressure conversion that follows
+*               the temperature read is running, and each pressure value
+*               is compensated while the next conversion is running.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include "FreeRTOS.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sensorlib/i2cm_drv.h"
+
+#include "Drivers/BMP180_Acquisition.h"
+#include "Drivers/BMP180_Compensation.h"
+#include "Drivers/CycleCounter.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+// Register map and commands (BMP180 datasheet, section 5)
+static const uint8_t REG_CALIBRATION = 0xAA;
+static const uint8_t REG_CTRL_MEAS = 0xF4;
+static const uint8_t REG_OUT_MSB = 0xF6;
+static const uint8_t CMD_TEMPERATURE = 0x2E;
+static const uint8_t CMD_PRESSURE = 0x34;
+
+// Bytes on the bus per transaction, including address bytes
+static const uint32_t BYTES_READ_CALIBRATION = 25;
+static const uint32_t BYTES_START_CONVERSION = 3;
+static const uint32_t BYTES_READ_TEMPERATURE = 5;
+static const uint32_t BYTES_READ_PRESSURE = 6;
+
+// Ticks to back off after an I2C error before restarting, 10 ms rounded up
+static const uint32_t ERROR_RETRY_TICKS = (configTICK_RATE_HZ + 99) / 100;
+
+
+/************************************************
+* Local function declarations
+************************************************/
+static void compensate_pending(BMP180_Acquisition* psAcq, bool* pbSampleReady);
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: compensate_pending
+* Description:   Compensate raw values read by the previous transactions.
+*                Called after the next transaction has been issued so the
+*                arithmetic overlaps the conversion.
+* Parameters:    BMP180_Acquisition* psAcq
+*                bool* pbSampleReady
+* Return:        void
+*************************************************************************/
+static void compensate_pending(BMP180_Acquisition* psAcq, bool* pbSampleReady) {
+  uint32_t start = CycleCounter_Get();
+
+  if (psAcq->bUTPending) {
+    psAcq->b5 = BMP180Comp_ComputeB5(&psAcq->calibration, psAcq->ut);
+    psAcq->temperature = BMP180Comp_Temperature(psAcq->b5);
+    psAcq->bUTPending = false;
+  }
+
+  if (psAcq->bUPPending) {
+    psAcq->pressure = BMP180Comp_Pressure(&psAcq->calibration, psAcq->b5, psAcq->up, psAcq->oss);
+    psAcq->bUPPending = false;
+    psAcq->samples++;
+    psAcq->compensationCycles = CycleCounter_Get() - start;
+    *pbSampleReady = true;
+  }
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: BMP180Acq_Init
+* Description:   Initialize the engine. The first BMP180Acq_Start reads
+*                the calibration E2PROM.
+* Parameters:    BMP180_Acquisition* psAcq
+*                tI2CMInstance* psI2CInst
+*                uint8_t ui8Addr
+*                uint32_t oss                    - 0..3
+*                uint32_t pressurePerTemperature - >= 1
+* Return:        void
+*************************************************************************/
+extern void BMP180Acq_Init(BMP180_Acquisition* psAcq, tI2CMInstance* psI2CInst, uint8_t ui8Addr,
+                           uint32_t oss, uint32_t pressurePerTemperature) {
+  psAcq->psI2CInst = psI2CInst;
+  psAcq->ui8Addr = ui8Addr;
+  psAcq->oss = (oss > BMP180_OSS_ULTRA_HIGH_RESOLUTION) ? BMP180_OSS_ULTRA_HIGH_RESOLUTION : oss;
+  psAcq->pressurePerTemperature = (pressurePerTemperature == 0) ? 1 : pressurePerTemperature;
+  psAcq->state = BMP180ACQ_READ_CALIBRATION;
+
+  psAcq->bUTPending = false;
+  psAcq->bUPPending = false;
+  psAcq->ut = 0;
+  psAcq->up = 0;
+
+  psAcq->pressureSinceTemperature = 0;
+  psAcq->b5 = 0;
+  psAcq->temperature = 0;
+  psAcq->pressure = 0;
+
+  psAcq->samples = 0;
+  psAcq->transactions = 0;
+  psAcq->busBytes = 0;
+  psAcq->errors = 0;
+  psAcq->compensationCycles = 0;
+
+  CycleCounter_Initialization();
+}
+
+
+/*************************************************************************
+* Function Name: BMP180Acq_Start
+* Description:   Issue the I2C transaction for the current state, then
+*                compensate any raw values read previously.
+* Parameters:    BMP180_Acquisition* psAcq
+*                tSensorCallback* pfnCallback
+*                void* pvCallbackData
+*                bool* pbSampleReady
+* Return:        void
+*************************************************************************/
+extern void BMP180Acq_Start(BMP180_Acquisition* psAcq, tSensorCallback* pfnCallback,
+                            void* pvCallbackData, bool* pbSampleReady) {
+  *pbSampleReady = false;
+  psAcq->transactions++;
+
+  switch (psAcq->state) {
+    case BMP180ACQ_READ_CALIBRATION:
+      psAcq->pui8Command[0] = REG_CALIBRATION;
+      psAcq->busBytes += BYTES_READ_CALIBRATION;
+      I2CMRead(psAcq->psI2CInst, psAcq->ui8Addr, psAcq->pui8Command, 1,
+               psAcq->pui8Data, 22, pfnCallback, pvCallbackData);
+      break;
+
+    case BMP180ACQ_START_TEMPERATURE:
+      psAcq->pui8Command[0] = REG_CTRL_MEAS;
+      psAcq->pui8Command[1] = CMD_TEMPERATURE;
+      psAcq->busBytes += BYTES_START_CONVERSION;
+      I2CMWrite(psAcq->psI2CInst, psAcq->ui8Addr, psAcq->pui8Command, 2,
+                pfnCallback, pvCallbackData);
+      break;
+
+    case BMP180ACQ_READ_TEMPERATURE:
+      psAcq->pui8Command[0] = REG_OUT_MSB;
+      psAcq->busBytes += BYTES_READ_TEMPERATURE;
+      I2CMRead(psAcq->psI2CInst, psAcq->ui8Addr, psAcq->pui8Command, 1,
+               psAcq->pui8Data, 2, pfnCallback, pvCallbackData);
+      break;
+
+    case BMP180ACQ_START_PRESSURE:
+      psAcq->pui8Command[0] = REG_CTRL_MEAS;
+      psAcq->pui8Command[1] = CMD_PRESSURE | (psAcq->oss << 6);
+      psAcq->busBytes += BYTES_START_CONVERSION;
+      I2CMWrite(psAcq->psI2CInst, psAcq->ui8Addr, psAcq->pui8Command, 2,
+                pfnCallback, pvCallbackData);
+      break;
+
+    case BMP180ACQ_READ_PRESSURE:
+      psAcq->pui8Command[0] = REG_OUT_MSB;
+      psAcq->busBytes += BYTES_READ_PRESSURE;
+      I2CMRead(psAcq->psI2CInst, psAcq->ui8Addr, psAcq->pui8Command, 1,
+               psAcq->pui8Data, 3, pfnCallback, pvCallbackData);
+      break;
+  }
+
+  // The transaction is now running on the bus, use the time to compensate
+  compensate_pending(psAcq, pbSampleReady);
+}
+
+
+/*************************************************************************
+* Function Name: BMP180Acq_Complete
+* Description:   Consume the result of the transaction issued by
+*                BMP180Acq_Start and advance the state machine
+* Parameters:    BMP180_Acquisition* psAcq
+*                uint_fast8_t ui8Status - status passed to the callback
+* Return:        uint32_t - ticks to wait before the next BMP180Acq_Start
+*************************************************************************/
+extern uint32_t BMP180Acq_Complete(BMP180_Acquisition* psAcq, uint_fast8_t ui8Status) {
+  if (ui8Status != I2CM_STATUS_SUCCESS) {
+    // Drop any half-finished sample and start over with a temperature
+    // conversion, unless the calibration has not been read yet.
+    psAcq->errors++;
+    psAcq->bUTPending = false;
+    psAcq->bUPPending = false;
+    if (psAcq->state != BMP180ACQ_READ_CALIBRATION) {
+      psAcq->state = BMP180ACQ_START_TEMPERATURE;
+    }
+    return ERROR_RETRY_TICKS;
+  }
+
+  switch (psAcq->state) {
+    case BMP180ACQ_READ_CALIBRATION:
+      BMP180Comp_ParseCalibration(&psAcq->calibration, psAcq->pui8Data);
+      psAcq->state = BMP180ACQ_START_TEMPERATURE;
+      return 0;
+
+    case BMP180ACQ_START_TEMPERATURE:
+      psAcq->state = BMP180ACQ_READ_TEMPERATURE;
+      return BMP180Acq_ConversionTicks(BMP180ACQ_TEMPERATURE_US);
+
+    case BMP180ACQ_READ_TEMPERATURE:
+      psAcq->ut = (psAcq->pui8Data[0] << 8) | psAcq->pui8Data[1];
+      psAcq->bUTPending = true;
+      psAcq->pressureSinceTemperature = 0;
+      psAcq->state = BMP180ACQ_START_PRESSURE;
+      return 0;
+
+    case BMP180ACQ_START_PRESSURE:
+      psAcq->state = BMP180ACQ_READ_PRESSURE;
+      return BMP180Acq_ConversionTicks(BMP180ACQ_PRESSURE_US(psAcq->oss));
+
+    case BMP180ACQ_READ_PRESSURE:
+      psAcq->up = BMP180Comp_UncompensatedPressure(psAcq->pui8Data[0], psAcq->pui8Data[1],
+                                                   psAcq->pui8Data[2], psAcq->oss);
+      psAcq->bUPPending = true;
+      psAcq->pressureSinceTemperature++;
+      psAcq->state = (psAcq->pressureSinceTemperature >= psAcq->pressurePerTemperature)
+                         ? BMP180ACQ_START_TEMPERATURE
+                         : BMP180ACQ_START_PRESSURE;
+      return 0;
+  }
+
+  return 0;
+}
+
+
+/*************************************************************************
+* Function Name: BMP180Acq_ConversionTicks
+* Description:   Ticks to wait for a conversion, rounded up. vTaskDelay(n)
+*                can return up to one tick early, so one tick is added.
+* Parameters:    uint32_t conversionUs
+* Return:        uint32_t ticks
+*************************************************************************/
+extern uint32_t BMP180Acq_ConversionTicks(uint32_t conversionUs) {
+  return (uint32_t)((((uint64_t)conversionUs * configTICK_RATE_HZ) + 999999) / 1000000) + 1;
+}
+
+
+/*************************************************************************
+* Function Name: BMP180Acq_ModelSamplesPerSecond
+* Description:   Achievable pressure samples per second: N pressure
+*                conversions and one temperature conversion per cycle,
+*                each rounded up to whole ticks, plus the bus time of
+*                every transaction in the cycle.
+* Parameters:    uint32_t oss
+*                uint32_t pressurePerTemperature
+* Return:        uint32_t samples/s
+*************************************************************************/
+extern uint32_t BMP180Acq_ModelSamplesPerSecond(uint32_t oss, uint32_t pressurePerTemperature) {
+  uint32_t cycleTicks = BMP180Acq_ConversionTicks(BMP180ACQ_TEMPERATURE_US) +
+                        pressurePerTemperature * BMP180Acq_ConversionTicks(BMP180ACQ_PRESSURE_US(oss));
+  uint64_t cycleUs = ((uint64_t)cycleTicks * 1000000) / configTICK_RATE_HZ;
+
+  cycleUs += pressurePerTemperature * BMP180Acq_ModelBusBytesPerSample(pressurePerTemperature) * BMP180ACQ_I2C_BYTE_US;
+
+  return (uint32_t)(((uint64_t)pressurePerTemperature * 1000000) / cycleUs);
+}
+
+
+/*************************************************************************
+* Function Name: BMP180Acq_ModelBusBytesPerSample
+* Description:   Average I2C bytes per pressure sample, with the
+*                temperature transactions spread over N samples
+* Parameters:    uint32_t pressurePerTemperature
+* Return:        uint32_t bytes (rounded up)
+*************************************************************************/
+extern uint32_t BMP180Acq_ModelBusBytesPerSample(uint32_t pressurePerTemperature) {
+  uint32_t temperatureBytes = BYTES_START_CONVERSION + BYTES_READ_TEMPERATURE;
+  uint32_t pressureBytes = BYTES_START_CONVERSION + BYTES_READ_PRESSURE;
+
+  return pressureBytes + (temperatureBytes + pressurePerTemperature - 1) / pressurePerTemperature;
+}
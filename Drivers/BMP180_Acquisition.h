@@ -0,0 +1,120 @@
+/**
+* @Filename: BMP180_Acquisition.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [1:40pm]
+* @Version:  1.0.0
+*
+* @Description: Pipelined BMP180 acquisition engine. Drives the BMP180
+*               directly over I2C so that the next conversion is started
+*               before the previous result is compensated, and one
+*               temperature conversion is reused across several pressure
+*               conversions.
+*
+*               The engine is a state machine with two entry points:
+*               BMP180Acq_Start issues the next I2C transaction, and
+*               BMP180Acq_Complete is called once that transaction's
+*               callback has fired. It never blocks, so it can be driven
+*               from a task, a timer or a co-routine.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef DRIVERS_BMP180_ACQUISITION_H_
+#define DRIVERS_BMP180_ACQUISITION_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sensorlib/i2cm_drv.h"
+
+#include "Drivers/BMP180_Compensation.h"
+
+/************************************************
+* Constants
+************************************************/
+// Maximum conversion times from the BMP180 datasheet, in microseconds
+#define BMP180ACQ_TEMPERATURE_US 4500
+#define BMP180ACQ_PRESSURE_US(oss) (((oss) == 0) ? 4500 : \
+                                    ((oss) == 1) ? 7500 : \
+                                    ((oss) == 2) ? 13500 : 25500)
+
+// I2C7 runs in fast mode. Each byte on the bus is 9 bit times, 22.5 us
+// rounded up so the model does not overstate the sample rate.
+#define BMP180ACQ_I2C_BIT_RATE 400000
+#define BMP180ACQ_I2C_BYTE_US  (((9 * 1000000) + BMP180ACQ_I2C_BIT_RATE - 1) / BMP180ACQ_I2C_BIT_RATE)
+
+
+/************************************************
+* Types
+************************************************/
+typedef enum BMP180Acq_State_t {
+  BMP180ACQ_READ_CALIBRATION,   // Read the 22 byte calibration E2PROM
+  BMP180ACQ_START_TEMPERATURE,  // Write the temperature conversion command
+  BMP180ACQ_READ_TEMPERATURE,   // Read UT
+  BMP180ACQ_START_PRESSURE,     // Write the pressure conversion command
+  BMP180ACQ_READ_PRESSURE       // Read UP
+} BMP180Acq_State_t;
+
+typedef struct BMP180_Acquisition {
+  tI2CMInstance* psI2CInst;
+  uint8_t ui8Addr;
+  uint32_t oss;                      // Oversampling setting, 0..3
+  uint32_t pressurePerTemperature;   // Pressure conversions per temperature
+  BMP180Acq_State_t state;
+  BMP180_Calibration calibration;
+
+  // Raw results waiting to be compensated once the next conversion is
+  // under way
+  bool bUTPending;
+  bool bUPPending;
+  int32_t ut;
+  int32_t up;
+
+  // Compensated results
+  uint32_t pressureSinceTemperature;
+  int32_t b5;
+  int32_t temperature;  // 0.1 degrees C
+  int32_t pressure;     // Pa
+
+  // Statistics
+  uint32_t samples;
+  uint32_t transactions;
+  uint32_t busBytes;
+  uint32_t errors;
+  uint32_t compensationCycles;  // Last pressure compensation, with B5 if
+                                // the temperature was new
+
+  // I2C buffers, must stay valid until the transaction completes
+  uint8_t pui8Command[2];
+  uint8_t pui8Data[22];
+} BMP180_Acquisition;
+
+
+/************************************************
+* Function declarations
+************************************************/
+extern void BMP180Acq_Init(BMP180_Acquisition* psAcq, tI2CMInstance* psI2CInst, uint8_t ui8Addr,
+                           uint32_t oss, uint32_t pressurePerTemperature);
+
+// Issue the next I2C transaction. pfnCallback is called from the I2C
+// interrupt when it completes. *pbSampleReady is set when a new
+// temperature/pressure pair was compensated while the transaction runs.
+extern void BMP180Acq_Start(BMP180_Acquisition* psAcq, tSensorCallback* pfnCallback,
+                            void* pvCallbackData, bool* pbSampleReady);
+
+// Consume the completed transaction. Returns the number of ticks to wait
+// before calling BMP180Acq_Start again.
+extern uint32_t BMP180Acq_Complete(BMP180_Acquisition* psAcq, uint_fast8_t ui8Status);
+
+// Timing model: ticks for a conversion of the given length, and the
+// sample rate (samples/s) and bus bytes per sample for a configuration.
+// Tests/Test_BMP180_Acquisition checks it against the engine at several
+// tick rates.
+extern uint32_t BMP180Acq_ConversionTicks(uint32_t conversionUs);
+extern uint32_t BMP180Acq_ModelSamplesPerSecond(uint32_t oss, uint32_t pressurePerTemperature);
+extern uint32_t BMP180Acq_ModelBusBytesPerSample(uint32_t pressurePerTemperature);
+
+#endif /* DRIVERS_BMP180_ACQUISITION_H_ */
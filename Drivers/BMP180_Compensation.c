@@ -0,0 +1,125 @@
+/**
+* @Filename: BMP180_Compensation.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [11:20am]
+* @Version:  1.0.0
+*
+* @Description: Integer-only BMP180 temperature and pressure compensation.
+*               The sensorlib BMP180Data*GetFloat functions use soft-float
+*               because the FPU is disabled; this path uses only 32-bit
+*               integer arithmetic.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Drivers/BMP180_Compensation.h"
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: BMP180Comp_ParseCalibration
+* Description:   Decode the 22 byte calibration E2PROM (registers 0xAA to
+*                0xBF, MSB first)
+* Parameters:    BMP180_Calibration* calibration
+*                const uint8_t* pui8Data
+* Return:        void
+*************************************************************************/
+extern void BMP180Comp_ParseCalibration(BMP180_Calibration* calibration, const uint8_t* pui8Data) {
+  calibration->AC1 = (int16_t)((pui8Data[0] << 8) | pui8Data[1]);
+  calibration->AC2 = (int16_t)((pui8Data[2] << 8) | pui8Data[3]);
+  calibration->AC3 = (int16_t)((pui8Data[4] << 8) | pui8Data[5]);
+  calibration->AC4 = (uint16_t)((pui8Data[6] << 8) | pui8Data[7]);
+  calibration->AC5 = (uint16_t)((pui8Data[8] << 8) | pui8Data[9]);
+  calibration->AC6 = (uint16_t)((pui8Data[10] << 8) | pui8Data[11]);
+  calibration->B1 = (int16_t)((pui8Data[12] << 8) | pui8Data[13]);
+  calibration->B2 = (int16_t)((pui8Data[14] << 8) | pui8Data[15]);
+  calibration->MB = (int16_t)((pui8Data[16] << 8) | pui8Data[17]);
+  calibration->MC = (int16_t)((pui8Data[18] << 8) | pui8Data[19]);
+  calibration->MD = (int16_t)((pui8Data[20] << 8) | pui8Data[21]);
+}
+
+
+/*************************************************************************
+* Function Name: BMP180Comp_UncompensatedPressure
+* Description:   UP = (MSB << 16 + LSB << 8 + XLSB) >> (8 - oss)
+* Parameters:    uint8_t msb, lsb, xlsb - registers 0xF6, 0xF7, 0xF8
+*                uint32_t oss
+* Return:        int32_t UP
+*************************************************************************/
+extern int32_t BMP180Comp_UncompensatedPressure(uint8_t msb, uint8_t lsb, uint8_t xlsb, uint32_t oss) {
+  return (((int32_t)msb << 16) | ((int32_t)lsb << 8) | xlsb) >> (8 - oss);
+}
+
+
+/*************************************************************************
+* Function Name: BMP180Comp_ComputeB5
+* Description:   Temperature intermediate B5 from the raw temperature UT
+* Parameters:    const BMP180_Calibration* calibration
+*                int32_t ut
+* Return:        int32_t B5
+*************************************************************************/
+extern int32_t BMP180Comp_ComputeB5(const BMP180_Calibration* calibration, int32_t ut) {
+  int32_t x1 = ((ut - (int32_t)calibration->AC6) * (int32_t)calibration->AC5) >> 15;
+  int32_t x2 = ((int32_t)calibration->MC << 11) / (x1 + calibration->MD);
+  return x1 + x2;
+}
+
+
+/*************************************************************************
+* Function Name: BMP180Comp_Temperature
+* Description:   Compensated temperature
+* Parameters:    int32_t b5
+* Return:        int32_t - 0.1 degrees C
+*************************************************************************/
+extern int32_t BMP180Comp_Temperature(int32_t b5) {
+  return (b5 + 8) >> 4;
+}
+
+
+/*************************************************************************
+* Function Name: BMP180Comp_Pressure
+* Description:   Compensated pressure
+* Parameters:    const BMP180_Calibration* calibration
+*                int32_t b5  - from BMP180Comp_ComputeB5
+*                int32_t up  - from BMP180Comp_UncompensatedPressure
+*                uint32_t oss
+* Return:        int32_t - Pa
+*************************************************************************/
+extern int32_t BMP180Comp_Pressure(const BMP180_Calibration* calibration, int32_t b5, int32_t up, uint32_t oss) {
+  int32_t b6 = b5 - 4000;
+  int32_t x1 = (calibration->B2 * ((b6 * b6) >> 12)) >> 11;
+  int32_t x2 = (calibration->AC2 * b6) >> 11;
+  int32_t x3 = x1 + x2;
+  int32_t b3 = ((((int32_t)calibration->AC1 * 4 + x3) << oss) + 2) / 4;
+  uint32_t b4;
+  uint32_t b7;
+  int32_t p;
+
+  x1 = (calibration->AC3 * b6) >> 13;
+  x2 = (calibration->B1 * ((b6 * b6) >> 12)) >> 16;
+  x3 = ((x1 + x2) + 2) >> 2;
+  b4 = ((uint32_t)calibration->AC4 * (uint32_t)(x3 + 32768)) >> 15;
+  b7 = ((uint32_t)up - b3) * (50000 >> oss);
+
+  if (b7 < 0x80000000) {
+    p = (b7 * 2) / b4;
+  }
+  else {
+    p = (b7 / b4) * 2;
+  }
+
+  x1 = (p >> 8) * (p >> 8);
+  x1 = (x1 * 3038) >> 16;
+  x2 = (-7357 * p) >> 16;
+
+  return p + ((x1 + x2 + 3791) >> 4);
+}
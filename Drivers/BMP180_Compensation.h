@@ -0,0 +1,71 @@
+/**
+* @Filename: BMP180_Compensation.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [11:20am]
+* @Version:  1.0.0
+*
+* @Description: Integer-only BMP180 temperature and pressure compensation,
+*               following section 3.5 of the BMP180 datasheet
+*               (BST-BMP180-DS000-09). Tests/Test_BMP180_Compensation
+*               checks it against the datasheet example.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef DRIVERS_BMP180_COMPENSATION_H_
+#define DRIVERS_BMP180_COMPENSATION_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/************************************************
+* Constants
+************************************************/
+// Oversampling settings (OSS), selects 1, 2, 4 or 8 internal samples
+#define BMP180_OSS_ULTRA_LOW_POWER       0
+#define BMP180_OSS_STANDARD              1
+#define BMP180_OSS_HIGH_RESOLUTION       2
+#define BMP180_OSS_ULTRA_HIGH_RESOLUTION 3
+
+
+/************************************************
+* Types
+************************************************/
+// Calibration coefficients read from the BMP180 E2PROM (0xAA..0xBF)
+typedef struct BMP180_Calibration {
+  int16_t AC1;
+  int16_t AC2;
+  int16_t AC3;
+  uint16_t AC4;
+  uint16_t AC5;
+  uint16_t AC6;
+  int16_t B1;
+  int16_t B2;
+  int16_t MB;
+  int16_t MC;
+  int16_t MD;
+} BMP180_Calibration;
+
+
+/************************************************
+* Function declarations
+************************************************/
+// Copy the calibration coefficients from the 22 byte big-endian E2PROM dump
+extern void BMP180Comp_ParseCalibration(BMP180_Calibration* calibration, const uint8_t* pui8Data);
+
+// Combine the 0xF6..0xF8 result registers into UP for the given OSS
+extern int32_t BMP180Comp_UncompensatedPressure(uint8_t msb, uint8_t lsb, uint8_t xlsb, uint32_t oss);
+
+// B5 is shared between the temperature and pressure calculations
+extern int32_t BMP180Comp_ComputeB5(const BMP180_Calibration* calibration, int32_t ut);
+
+// Temperature in 0.1 degrees C
+extern int32_t BMP180Comp_Temperature(int32_t b5);
+
+// Pressure in Pa
+extern int32_t BMP180Comp_Pressure(const BMP180_Calibration* calibration, int32_t b5, int32_t up, uint32_t oss);
+
+#endif /* DRIVERS_BMP180_COMPENSATION_H_ */
@@ -0,0 +1,262 @@
+/**
+* @Filename: Critical_Monitor.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [1:30am]
+* @Version:  1.0.0
+*
+* @Description: How long interrupts stay masked, and by whom
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Drivers/CycleCounter.h"
+#include "Drivers/Critical_Monitor.h"
+
+#include "Tasks/Latency_Histogram.h"
+#include "Tasks/Log.h"
+#include "Tasks/Metrics.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+#define CRITICAL_MONITOR_SITE_MASK (CRITICAL_MONITOR_SITES - 1)
+
+
+/************************************************
+* Local types
+************************************************/
+typedef struct CriticalMonitor_Site {
+  const char* file;  // NULL while the slot is free
+  uint32_t line;
+  uint32_t count;
+  uint32_t max;
+  uint64_t total;
+} CriticalMonitor_Site;
+
+
+/************************************************
+* Local variables
+************************************************/
+static bool CriticalMonitor_Initialized = false;
+
+// Masked period in progress
+bool CriticalMonitor_Active = false;
+uint32_t CriticalMonitor_Start = 0;
+const char* CriticalMonitor_File = NULL;
+uint32_t CriticalMonitor_Line = 0;
+
+CriticalMonitor_Site CriticalMonitor_Sites[CRITICAL_MONITOR_SITES];
+CriticalMonitor_Site CriticalMonitor_Other;
+
+LatencyHistogram CriticalMonitor_Histogram;
+Metrics_Metric CriticalMonitor_Max = METRICS_GAUGE("critical max cycles");
+
+
+/************************************************
+* Local function declarations
+************************************************/
+static CriticalMonitor_Site* find_site(const char* file, uint32_t line);
+static const char* base_name(const char* file);
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: find_site
+* Description:   Slot of a call site, claimed on first use
+* Parameters:    const char* file
+*                uint32_t line
+* Return:        CriticalMonitor_Site* - CriticalMonitor_Other if the table
+*                is full
+*************************************************************************/
+static CriticalMonitor_Site* find_site(const char* file, uint32_t line) {
+  uint32_t index = ((uint32_t)(uintptr_t)file ^ (line * 2654435761UL)) & CRITICAL_MONITOR_SITE_MASK;
+  uint32_t i = 0;
+
+  for (i = 0; i < CRITICAL_MONITOR_SITES; ++i) {
+    CriticalMonitor_Site* site = &CriticalMonitor_Sites[(index + i) & CRITICAL_MONITOR_SITE_MASK];
+
+    if ((site->file == file) && (site->line == line)) {
+      return site;
+    }
+
+    if (site->file == NULL) {
+      site->file = file;
+      site->line = line;
+      return site;
+    }
+  }
+
+  return &CriticalMonitor_Other;
+}
+
+
+/*************************************************************************
+* Function Name: base_name
+* Description:   File name without its directories
+* Parameters:    const char* file
+* Return:        const char*
+*************************************************************************/
+static const char* base_name(const char* file) {
+  const char* name = file;
+
+  for (; *file != '\0'; ++file) {
+    if ((*file == '/') || (*file == '\\')) {
+      name = file + 1;
+    }
+  }
+
+  return name;
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: CriticalMonitor_Initialization
+* Description:   Start the cycle counter and register the histogram and
+*                the gauge
+* Parameters:    N/A
+* Return:        uint32_t
+*************************************************************************/
+extern uint32_t CriticalMonitor_Initialization() {
+  if (!CriticalMonitor_Initialized) {
+    CycleCounter_Initialization();
+    CriticalMonitor_Reset();
+    Metrics_Register(&CriticalMonitor_Max);
+    CriticalMonitor_Initialized = true;
+  }
+
+  return (1);
+}
+
+
+/*************************************************************************
+* Function Name: CriticalMonitor_Begin
+* Description:   Interrupts were just masked at file:line
+* Parameters:    const char* file
+*                uint32_t line
+* Return:        void
+*************************************************************************/
+extern void CriticalMonitor_Begin(const char* file, uint32_t line) {
+  CriticalMonitor_File = file;
+  CriticalMonitor_Line = line;
+  CriticalMonitor_Active = true;
+  CriticalMonitor_Start = CycleCounter_Get();
+}
+
+
+/*************************************************************************
+* Function Name: CriticalMonitor_End
+* Description:   Interrupts are about to be unmasked, count the period
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void CriticalMonitor_End() {
+  uint32_t cycles = CycleCounter_Get() - CriticalMonitor_Start;
+  CriticalMonitor_Site* site = NULL;
+
+  if (!CriticalMonitor_Active || !CriticalMonitor_Initialized) {
+    return;
+  }
+  CriticalMonitor_Active = false;
+
+  site = find_site(CriticalMonitor_File, CriticalMonitor_Line);
+  site->count++;
+  site->total += cycles;
+  if (cycles > site->max) {
+    site->max = cycles;
+  }
+
+  LatencyHistogram_Record(&CriticalMonitor_Histogram, cycles);
+  if (cycles > CriticalMonitor_Max.value) {
+    Metrics_Set(&CriticalMonitor_Max, cycles);
+  }
+}
+
+
+/*************************************************************************
+* Function Name: CriticalMonitor_Print
+* Description:   Print the call sites with the longest masked periods
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void CriticalMonitor_Print() {
+  uint32_t printed = 0;
+  uint32_t n = 0;
+  uint32_t i = 0;
+
+#if ( configUSE_CRITICAL_MONITOR == 0 )
+  Log_Printf("critical section monitor not built, define configUSE_CRITICAL_MONITOR=1\n");
+  return;
+#endif
+
+  Log_Printf("site,count,max cycles,max us,mean cycles\n");
+
+  // Pick the largest remaining max each time; the table may change while
+  // it is printed
+  for (n = 0; n < CRITICAL_MONITOR_PRINTED_SITES; ++n) {
+    const CriticalMonitor_Site* worst = NULL;
+    uint32_t worstIndex = 0;
+
+    for (i = 0; i < CRITICAL_MONITOR_SITES; ++i) {
+      const CriticalMonitor_Site* site = &CriticalMonitor_Sites[i];
+
+      if ((site->file == NULL) || ((printed & (1UL << i)) != 0)) {
+        continue;
+      }
+      if ((worst == NULL) || (site->max > worst->max)) {
+        worst = site;
+        worstIndex = i;
+      }
+    }
+
+    if (worst == NULL) {
+      break;
+    }
+    printed |= (1UL << worstIndex);
+
+    Log_Printf("%s:%u,%u,%u,%u,%u\n", base_name(worst->file), worst->line, worst->count, worst->max,
+               worst->max / CYCLECOUNTER_CYCLES_PER_US,
+               (worst->count == 0) ? 0 : (uint32_t)(worst->total / worst->count));
+  }
+
+  if (CriticalMonitor_Other.count != 0) {
+    Log_Printf("other,%u,%u,%u,%u\n", CriticalMonitor_Other.count, CriticalMonitor_Other.max,
+               CriticalMonitor_Other.max / CYCLECOUNTER_CYCLES_PER_US,
+               (uint32_t)(CriticalMonitor_Other.total / CriticalMonitor_Other.count));
+  }
+}
+
+
+/*************************************************************************
+* Function Name: CriticalMonitor_Reset
+* Description:   Forget everything recorded
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void CriticalMonitor_Reset() {
+  taskENTER_CRITICAL();
+
+  memset(CriticalMonitor_Sites, 0, sizeof(CriticalMonitor_Sites));
+  memset(&CriticalMonitor_Other, 0, sizeof(CriticalMonitor_Other));
+  LatencyHistogram_Init(&CriticalMonitor_Histogram, "critical");
+  Metrics_Set(&CriticalMonitor_Max, 0);
+
+  taskEXIT_CRITICAL();
+}
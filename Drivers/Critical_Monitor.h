@@ -0,0 +1,71 @@
+/**
+* @Filename: Critical_Monitor.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [1:30am]
+* @Version:  1.0.0
+*
+* @Description: How long interrupts stay masked, and by whom.
+*
+*               With configUSE_CRITICAL_MONITOR set to 1 in the project's
+*               predefined symbols, portENTER_CRITICAL and
+*               portSET_INTERRUPT_MASK_FROM_ISR pass their __FILE__ and
+*               __LINE__ to the port. When they mask interrupts that were
+*               unmasked, the port calls CriticalMonitor_Begin; when
+*               portEXIT_CRITICAL or portCLEAR_INTERRUPT_MASK_FROM_ISR
+*               unmask them, it calls CriticalMonitor_End. Every masked
+*               period is counted in:
+*                 - the "critical" latency histogram (see the "latency"
+*                   console command)
+*                 - the "critical max cycles" gauge metric
+*                 - a table of call sites with count, total and max
+*
+*               The "critical" console command prints the call sites with
+*               the longest masked periods.
+*
+*               Masking done outside the macros (PendSV in portasm.asm,
+*               portDISABLE_INTERRUPTS) is not seen. The recorded periods
+*               include the monitor's own work, about the cost of one
+*               histogram record.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef DRIVERS_CRITICAL_MONITOR_H_
+#define DRIVERS_CRITICAL_MONITOR_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/************************************************
+* Configuration
+************************************************/
+// Call sites tracked, a power of two. Periods from further sites are
+// counted as "other".
+#define CRITICAL_MONITOR_SITES 32
+
+// Call sites printed by CriticalMonitor_Print
+#define CRITICAL_MONITOR_PRINTED_SITES 10
+
+
+/************************************************
+* Function declarations
+************************************************/
+// Start the cycle counter and register the histogram and the gauge.
+// Called from main.
+extern uint32_t CriticalMonitor_Initialization();
+
+// Interrupts were just masked at file:line, or are about to be unmasked.
+// Called by the port with interrupts masked.
+extern void CriticalMonitor_Begin(const char* file, uint32_t line);
+extern void CriticalMonitor_End();
+
+// Print the call sites with the longest masked periods
+extern void CriticalMonitor_Print();
+
+// Forget everything recorded
+extern void CriticalMonitor_Reset();
+
+#endif /* DRIVERS_CRITICAL_MONITOR_H_ */
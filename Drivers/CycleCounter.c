@@ -0,0 +1,48 @@
+/**
+* @Filename: CycleCounter.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [9:12am]
+* @Version:  1.0.0
+*
+* @Description: Enables the Cortex-M4 DWT cycle counter
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Drivers/CycleCounter.h"
+
+
+/************************************************
+* Local variables
+************************************************/
+uint32_t CycleCounterInitFlag = 0;
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: CycleCounter_Initialization
+* Description:   Enable trace and start the DWT cycle counter. Safe to
+*                call more than once.
+* Parameters:    N/A
+* Return:        uint32_t (1)
+*************************************************************************/
+extern uint32_t CycleCounter_Initialization() {
+  if (CycleCounterInitFlag == 0) {
+    CYCLECOUNTER_DEMCR |= CYCLECOUNTER_DEMCR_TRCENA;
+    CYCLECOUNTER_DWT_CYCCNT = 0;
+    CYCLECOUNTER_DWT_CTRL |= CYCLECOUNTER_DWT_CYCCNTENA;
+
+    CycleCounterInitFlag = 1;
+  }
+
+  return (1);
+}
@@ -0,0 +1,73 @@
+/**
+* @Filename: CycleCounter.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [9:12am]
+* @Version:  1.0.0
+*
+* @Description: Access to the Cortex-M4 DWT cycle counter (CYCCNT), a
+*               free-running 32-bit counter clocked at the system clock.
+*               Used to measure code paths in CPU cycles.
+*
+*               Host builds (the tests under Tests/) define
+*               CYCLECOUNTER_HOST and set CycleCounter_Host instead. Host
+*               benchmarks also define CYCLECOUNTER_HOST_CLOCK and count
+*               nanoseconds of CycleCounter_HostClock.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef DRIVERS_CYCLECOUNTER_H_
+#define DRIVERS_CYCLECOUNTER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+/************************************************
+* Constants
+************************************************/
+// System clock cycles per microsecond
+#define CYCLECOUNTER_CYCLES_PER_US (configCPU_CLOCK_HZ / 1000000)
+
+
+/************************************************
+* Register definitions
+************************************************/
+// Debug Exception and Monitor Control Register, TRCENA enables the DWT
+#define CYCLECOUNTER_DEMCR        (*((volatile uint32_t*)0xE000EDFC))
+#define CYCLECOUNTER_DEMCR_TRCENA 0x01000000
+
+// DWT control register, CYCCNTENA starts the cycle counter
+#define CYCLECOUNTER_DWT_CTRL      (*((volatile uint32_t*)0xE0001000))
+#define CYCLECOUNTER_DWT_CYCCNTENA 0x00000001
+
+// DWT cycle count register
+#define CYCLECOUNTER_DWT_CYCCNT (*((volatile uint32_t*)0xE0001004))
+
+
+/************************************************
+* Macros
+************************************************/
+// Current cycle count. Differences of two readings are correct across a
+// single 32-bit wrap (~35.8 seconds at 120 MHz).
+#if defined(CYCLECOUNTER_HOST_CLOCK)
+extern uint32_t CycleCounter_HostClock();
+#define CycleCounter_Get() (CycleCounter_HostClock())
+#elif defined(CYCLECOUNTER_HOST)
+extern volatile uint32_t CycleCounter_Host;
+#define CycleCounter_Get() (CycleCounter_Host)
+#else
+#define CycleCounter_Get() (CYCLECOUNTER_DWT_CYCCNT)
+#endif
+
+
+/************************************************
+* Function declarations
+************************************************/
+extern uint32_t CycleCounter_Initialization();
+
+#endif /* DRIVERS_CYCLECOUNTER_H_ */
@@ -21,6 +21,34 @@
  *	Modification:	Gary J. Minden
  *					2018-09-27 (B80927)
  *					Added a call to IntRegister.
+ *
+ *	Modification:	2026-10-19
+ *					Signal STARTUP_I2C7 when initialization
+ *					completes.
+ *
+ *	Modification:	2026-10-19
+ *					Interrupt and callback counts are registered
+ *					metrics, updated atomically.
+ *
+ *	Modification:	2026-10-19
+ *					Console output goes through Log; the
+ *					callback runs in the I2C7 interrupt and
+ *					defers its error line to the Log task.
+ *
+ *	Modification:	2026-10-20
+ *					The interrupt is registered through
+ *					ISRAccounting_Register.
+ *
+ *	Modification:	2026-10-20
+ *					The interrupt runs at INTERRUPT_PRIORITY_I2C7,
+ *					in the kernel aware band, since its callbacks
+ *					call FreeRTOS.
+ *
+ *	Modification:	2026-10-20
+ *					Initialization no longer spins on the first
+ *					transaction: it is started by the first call
+ *					and finished by a later one, since callers
+ *					are sensor steps that must not block.
  */
 
 #include "inc/hw_ints.h"
@@ -45,6 +73,12 @@
 #include "drivers/uartstdio.h"
 
 #include "Drivers/I2C7_Handler.h"
+#include "Drivers/ISR_Accounting.h"
+#include "Drivers/Interrupt_Priorities.h"
+
+#include "Tasks/Log.h"
+#include "Tasks/Metrics.h"
+#include "Tasks/Startup_Sync.h"
 
 #include "FreeRTOS.h"
 #include "task.h"
@@ -61,8 +95,13 @@
 //	The number of I2C7 Interrupts taken and
 //	the number of callbacks taken.
 //
-uint32_t	I2C7_Interrupts_Nbr = 0;
-uint32_t	I2C7_Callbacks_Nbr = 0;
+Metrics_Metric	I2C7_Interrupts_Nbr = METRICS_COUNTER( "I2C7 interrupts" );
+Metrics_Metric	I2C7_Callbacks_Nbr = METRICS_COUNTER( "I2C7 callbacks" );
+
+//
+//	Duration of the I2C7 interrupt
+//
+ISRAccounting_Vector	I2C7_ISR_Accounting = ISR_ACCOUNTING_VECTOR( "I2C7" );
 
 //
 // The I2C7 master driver instance data and pointer to instance.
@@ -70,6 +109,7 @@ uint32_t	I2C7_Callbacks_Nbr = 0;
 tI2CMInstance I2C7_Instance;
 extern	tI2CMInstance* I2C7_Instance_Ref = &I2C7_Instance;
 
+bool I2C7_Started = false;
 bool I2C7_Initialized = false;
 
 uint8_t I2C7WriteData[8] = { 0x10, 0x11, 0x12, 0x13,
@@ -88,7 +128,7 @@ volatile bool I2C7_SimpleDone = false;
 //
 extern void I2C7_IntServiceRoutine( ) {
 
-	I2C7_Interrupts_Nbr++;
+	Metrics_Increment( &I2C7_Interrupts_Nbr );
 
 	//
 	// Call the I2C master driver interrupt handler.
@@ -102,7 +142,7 @@ extern void I2C7_IntServiceRoutine( ) {
 //
 void I2CMSimpleCallback(void *pvData, uint_fast8_t ui8Status) {
 
-	I2C7_Callbacks_Nbr++;
+	Metrics_Increment( &I2C7_Callbacks_Nbr );
 
 	//
 	// See if an error occurred.
@@ -111,7 +151,7 @@ void I2CMSimpleCallback(void *pvData, uint_fast8_t ui8Status) {
 		//
 		// An error occurred, so handle it here if required.
 		//
-		UARTprintf( ">>>>I2C7 Error: %02X\n", ui8Status );
+		Log_PrintfFromISR( ">>>>I2C7 Error: %02X\n", ui8Status, 0 );
 	}
 	//
 	// Indicate that the I2C transaction has completed.
@@ -124,7 +164,7 @@ void I2CMSimpleCallback(void *pvData, uint_fast8_t ui8Status) {
 //
 extern uint32_t I2C7_Initialization() {
 
-	if ( !I2C7_Initialized ) {
+	if ( !I2C7_Started ) {
 
 		//
 		//	Set up GPIO_D_0 and GPIO_D_1 for I2C7 use
@@ -143,33 +183,42 @@ extern uint32_t I2C7_Initialization() {
 	    Processor_Initialization();
 	    UARTStdio_Initialization();
 
+	    Metrics_Register( &I2C7_Interrupts_Nbr );
+	    Metrics_Register( &I2C7_Callbacks_Nbr );
+
 	    //
 	    //	Enable I2C7 interrupts.
 	    //
-	    IntRegister( INT_I2C7, I2C7_IntServiceRoutine );
+	    ISRAccounting_Register( &I2C7_ISR_Accounting, INT_I2C7, I2C7_IntServiceRoutine );
+	    IntPrioritySet( INT_I2C7, INTERRUPT_PRIORITY_I2C7 );
 	    IntEnable( INT_I2C7 );
 
 	    //
 	    //  Initialize the I2C master driver.
-	    //	Wait for completion
+	    //	I2CMSimpleCallback marks the first
+	    //	transaction done; a later call
+	    //	finishes the initialization.
 	    //
 	    I2CMInit( &I2C7_Instance, I2C7_BASE, INT_I2C7, 0xff, 0xff, g_ulSystemClock );
 
+	    I2C7_Started = true;
 	    I2C7_SimpleDone = false;
 	 	I2C7_Status = I2CMWrite( &I2C7_Instance, 0x45,
 							I2C7WriteData, 1,
 							I2CMSimpleCallback, NULL );
+	}
 
-	 	while ( !I2C7_SimpleDone ) {
-	 	}
+	if ( !I2C7_Initialized && I2C7_SimpleDone ) {
 
 	    I2C7_Initialized = true;
 
-		UARTprintf( ">>>>I2C7_Handler; Status: %02X\n", I2C7_Status );
+		Log_Printf( ">>>>I2C7_Handler; Status: %02X\n", I2C7_Status );
+
+		Startup_Signal( STARTUP_I2C7 );
 
 	}
 
-	return( 1 );
+	return( I2C7_Initialized ? 1 : 0 );
 }
 
 
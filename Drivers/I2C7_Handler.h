@@ -23,7 +23,10 @@
 #include "sensorlib/i2cm_drv.h"
 
 //
-//	Define the I2C7_Initialization subroutine
+//	Define the I2C7_Initialization subroutine. The first call
+//	starts the initialization, which completes in the I2C7
+//	interrupt; a call after that signals STARTUP_I2C7. Never
+//	waits. Returns 1 once I2C7 is initialized, 0 before.
 //
 extern uint32_t I2C7_Initialization();
 //
@@ -0,0 +1,316 @@
+/**
+* @Filename: ISR_Accounting.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [12:40am]
+* @Version:  1.0.0
+*
+* @Description: Interrupt count, duration and nesting per vector
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include "inc/hw_ints.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "driverlib/interrupt.h"
+
+#include "Drivers/CycleCounter.h"
+#include "Drivers/ISR_Accounting.h"
+#include "Drivers/Interrupt_Priorities.h"
+#include "Drivers/Timestamp.h"
+
+#include "Tasks/Log.h"
+#include "Tasks/Metrics.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+// Interrupt Control and State Register, VECTACTIVE is the running
+// exception. Host builds (the tests under Tests/) define
+// ISR_ACCOUNTING_HOST and set ISRAccounting_Host_ICSR instead.
+#ifdef ISR_ACCOUNTING_HOST
+extern volatile uint32_t ISRAccounting_Host_ICSR;
+#define ISR_ACCOUNTING_ICSR (ISRAccounting_Host_ICSR)
+#else
+#define ISR_ACCOUNTING_ICSR (*((volatile uint32_t*)0xE000ED04))
+#endif
+#define ISR_ACCOUNTING_ICSR_VECTACTIVE 0x000001FF
+
+// Word of the exception frame holding the interrupted PC
+#define ISR_ACCOUNTING_FRAME_PC 6
+
+// Unused interrupt triggered by ISRAccounting_PrintCost, and the number of
+// times it is triggered
+#define ISR_ACCOUNTING_COST_INTERRUPT INT_TIMER1A
+#define ISR_ACCOUNTING_COST_CALLS     1000
+
+
+/************************************************
+* Local variables
+************************************************/
+static bool ISRAccounting_Initialized = false;
+
+// Accounting for the kernel tick
+ISRAccounting_Vector SysTick_ISR_Accounting = ISR_ACCOUNTING_VECTOR("SysTick");
+
+// Registered vectors, in order, and by vector number
+ISRAccounting_Vector* ISRAccounting_List[ISR_ACCOUNTING_MAX_VECTORS];
+volatile uint32_t ISRAccounting_List_Nbr = 0;
+ISRAccounting_Vector* ISRAccounting_Lookup[NUM_INTERRUPTS];
+
+// Accounted interrupts running, and per level the exception frame and the
+// cycles taken by interrupts that preempted it
+volatile uint32_t ISRAccounting_Depth = 0;
+const uint32_t* ISRAccounting_Frames[ISR_ACCOUNTING_MAX_DEPTH];
+uint32_t ISRAccounting_Preempted[ISR_ACCOUNTING_MAX_DEPTH];
+
+// Time of the previous ISRAccounting_Print
+uint64_t ISRAccounting_PrintedNs = 0;
+
+// Entry used by ISRAccounting_PrintCost, not listed or reported
+ISRAccounting_Vector ISRAccounting_Cost = ISR_ACCOUNTING_VECTOR("cost");
+
+
+/************************************************
+* Local function declarations
+************************************************/
+extern void ISR_Accounting_Trampoline(void);
+extern void xPortSysTickHandler(void);
+static void install(ISRAccounting_Vector* entry, uint32_t interrupt, void (*handler)(void));
+static void cost_handler(void);
+static uint32_t cost_average();
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: install
+* Description:   Point a vector at the accounting entry point
+* Parameters:    ISRAccounting_Vector* entry
+*                uint32_t interrupt
+*                void (*handler)(void)
+* Return:        void
+*************************************************************************/
+static void install(ISRAccounting_Vector* entry, uint32_t interrupt, void (*handler)(void)) {
+  CycleCounter_Initialization();
+
+  // The entry must be complete before the vector can reach it
+  entry->handler = handler;
+  entry->vector = interrupt;
+  ISRAccounting_Lookup[interrupt] = entry;
+
+  IntRegister(interrupt, ISR_Accounting_Trampoline);
+}
+
+
+/*************************************************************************
+* Function Name: cost_handler
+* Description:   Empty handler timed by ISRAccounting_PrintCost
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void cost_handler(void) {
+}
+
+
+/*************************************************************************
+* Function Name: cost_average
+* Description:   Average cycles to trigger and take the cost interrupt
+* Parameters:    N/A
+* Return:        uint32_t
+*************************************************************************/
+static uint32_t cost_average() {
+  uint32_t total = 0;
+  uint32_t i = 0;
+
+  for (i = 0; i < ISR_ACCOUNTING_COST_CALLS; ++i) {
+    uint32_t start = CycleCounter_Get();
+    IntTrigger(ISR_ACCOUNTING_COST_INTERRUPT);
+    total += CycleCounter_Get() - start;
+  }
+
+  return total / ISR_ACCOUNTING_COST_CALLS;
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: ISRAccounting_Initialization
+* Description:   Account the SysTick interrupt
+* Parameters:    N/A
+* Return:        uint32_t
+*************************************************************************/
+extern uint32_t ISRAccounting_Initialization() {
+  if (!ISRAccounting_Initialized) {
+    ISRAccounting_Register(&SysTick_ISR_Accounting, FAULT_SYSTICK, xPortSysTickHandler);
+    ISRAccounting_Initialized = true;
+  }
+
+  return (1);
+}
+
+
+/*************************************************************************
+* Function Name: ISRAccounting_Register
+* Description:   Install a handler through the accounting entry point and
+*                register its metrics
+* Parameters:    ISRAccounting_Vector* entry
+*                uint32_t interrupt
+*                void (*handler)(void)
+* Return:        bool
+*************************************************************************/
+extern bool ISRAccounting_Register(ISRAccounting_Vector* entry, uint32_t interrupt, void (*handler)(void)) {
+  if (ISRAccounting_List_Nbr >= ISR_ACCOUNTING_MAX_VECTORS) {
+    IntRegister(interrupt, handler);
+    return false;
+  }
+
+  Metrics_Register(&entry->calls);
+  Metrics_Register(&entry->cycles);
+  Metrics_Register(&entry->maxCycles);
+
+  // Fill the slot before publishing it to the console
+  ISRAccounting_List[ISRAccounting_List_Nbr] = entry;
+  ISRAccounting_List_Nbr++;
+
+  install(entry, interrupt, handler);
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: ISRAccounting_Dispatch
+* Description:   Run and time the handler of the active vector
+* Parameters:    const uint32_t* frame - exception frame of the interrupt
+* Return:        void
+*************************************************************************/
+extern void ISRAccounting_Dispatch(const uint32_t* frame) {
+  ISRAccounting_Vector* entry = ISRAccounting_Lookup[ISR_ACCOUNTING_ICSR & ISR_ACCOUNTING_ICSR_VECTACTIVE];
+  uint32_t depth = ISRAccounting_Depth;
+  uint32_t start = 0;
+  uint32_t cycles = 0;
+  uint32_t self = 0;
+
+  if (depth >= ISR_ACCOUNTING_MAX_DEPTH) {
+    entry->handler();
+    return;
+  }
+
+  // Claim this level before starting the clock; an interrupt that
+  // preempts before the claim is not part of this call
+  ISRAccounting_Frames[depth] = frame;
+  ISRAccounting_Preempted[depth] = 0;
+  ISRAccounting_Depth = depth + 1;
+  start = CycleCounter_Get();
+
+  entry->handler();
+
+  cycles = CycleCounter_Get() - start;
+  self = cycles - ISRAccounting_Preempted[depth];
+  ISRAccounting_Depth = depth;
+
+  if (depth > 0) {
+    ISRAccounting_Preempted[depth - 1] += cycles;
+    entry->nested++;
+  }
+
+  // Single writer: a vector cannot preempt itself
+  entry->totalCycles += self;
+  Metrics_Increment(&entry->calls);
+  Metrics_Add(&entry->cycles, self);
+  if (self > entry->maxCycles.value) {
+    Metrics_Set(&entry->maxCycles, self);
+  }
+}
+
+
+/*************************************************************************
+* Function Name: ISRAccounting_InterruptedPC
+* Description:   From an accounted handler, the PC at which its interrupt
+*                was taken
+* Parameters:    N/A
+* Return:        uint32_t - 0 outside an accounted handler
+*************************************************************************/
+extern uint32_t ISRAccounting_InterruptedPC() {
+  uint32_t depth = ISRAccounting_Depth;
+
+  if ((depth == 0) || (depth > ISR_ACCOUNTING_MAX_DEPTH)) {
+    return 0;
+  }
+
+  return ISRAccounting_Frames[depth - 1][ISR_ACCOUNTING_FRAME_PC];
+}
+
+
+/*************************************************************************
+* Function Name: ISRAccounting_Print
+* Description:   Print calls, cycles, max, nested and load per vector
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void ISRAccounting_Print() {
+  uint64_t now = Timestamp_GetNs();
+  uint64_t elapsedCycles = ((now - ISRAccounting_PrintedNs) * CYCLECOUNTER_CYCLES_PER_US) / 1000;
+  uint32_t i = 0;
+
+  Log_Printf("isr,calls,nested,total ms,max cycles,mean us,load %%\n");
+  for (i = 0; i < ISRAccounting_List_Nbr; ++i) {
+    ISRAccounting_Vector* entry = ISRAccounting_List[i];
+    uint32_t calls = entry->calls.value;
+    uint64_t total = entry->totalCycles;
+    uint32_t meanUs = (calls == 0) ? 0 : (uint32_t)(total / calls) / CYCLECOUNTER_CYCLES_PER_US;
+    uint32_t loadBp = (elapsedCycles == 0) ? 0 : (uint32_t)(((total - entry->printedCycles) * 10000) / elapsedCycles);
+
+    Log_Printf("%s,%u,%u,%u,%u,%u,%u.%02u\n", entry->name, calls, entry->nested,
+               (uint32_t)(total / (CYCLECOUNTER_CYCLES_PER_US * 1000)), entry->maxCycles.value, meanUs,
+               loadBp / 100, loadBp % 100);
+    entry->printedCycles = total;
+  }
+
+  ISRAccounting_PrintedNs = now;
+}
+
+
+/*************************************************************************
+* Function Name: ISRAccounting_PrintCost
+* Description:   Time an empty handler on an unused interrupt, installed
+*                directly and through the accounting entry point
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void ISRAccounting_PrintCost() {
+  uint32_t direct = 0;
+  uint32_t accounted = 0;
+
+  CycleCounter_Initialization();
+
+  IntPrioritySet(ISR_ACCOUNTING_COST_INTERRUPT, INTERRUPT_PRIORITY_SOFTWARE);
+  IntEnable(ISR_ACCOUNTING_COST_INTERRUPT);
+
+  IntRegister(ISR_ACCOUNTING_COST_INTERRUPT, cost_handler);
+  direct = cost_average();
+
+  install(&ISRAccounting_Cost, ISR_ACCOUNTING_COST_INTERRUPT, cost_handler);
+  accounted = cost_average();
+
+  IntDisable(ISR_ACCOUNTING_COST_INTERRUPT);
+  IntUnregister(ISR_ACCOUNTING_COST_INTERRUPT);
+  ISRAccounting_Lookup[ISR_ACCOUNTING_COST_INTERRUPT] = NULL;
+
+  Log_Printf("empty interrupt: direct %u cycles, accounted %u cycles, overhead %u cycles\n",
+             direct, accounted, accounted - direct);
+}
@@ -0,0 +1,104 @@
+/**
+* @Filename: ISR_Accounting.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [12:40am]
+* @Version:  1.0.0
+*
+* @Description: Interrupt count, duration and nesting per vector.
+*
+*               ISRAccounting_Register installs a common entry point
+*               (ISR_Accounting_Trampoline.asm) for the vector with
+*               IntRegister. The entry point passes the exception frame to
+*               ISRAccounting_Dispatch, which looks up the vector from
+*               VECTACTIVE, times the real handler with the cycle counter
+*               and counts:
+*                 - calls
+*                 - cycles spent in the handler itself; time spent in
+*                   accounted interrupts that preempted it is excluded
+*                 - the most cycles of one call
+*                 - calls that preempted another accounted interrupt
+*
+*               The first three are registered metrics, so Task_Metrics
+*               reports them every period. The "isr" console command
+*               prints all four and the interrupt load.
+*
+*               A vector is accounted by defining an ISRAccounting_Vector
+*               with ISR_ACCOUNTING_VECTOR("name") and registering it in
+*               place of IntRegister.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef DRIVERS_ISR_ACCOUNTING_H_
+#define DRIVERS_ISR_ACCOUNTING_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Tasks/Metrics.h"
+
+/************************************************
+* Configuration
+************************************************/
+#define ISR_ACCOUNTING_MAX_VECTORS 8
+
+// Deepest nesting tracked, one per interrupt priority level
+#define ISR_ACCOUNTING_MAX_DEPTH 8
+
+
+/************************************************
+* Types
+************************************************/
+typedef struct ISRAccounting_Vector {
+  const char* name;
+  void (*handler)(void);
+  uint32_t vector;
+
+  Metrics_Metric calls;      // Counter
+  Metrics_Metric cycles;     // Counter, wraps
+  Metrics_Metric maxCycles;  // Gauge
+
+  uint64_t totalCycles;      // cycles without the wrap
+  uint32_t nested;           // Calls that preempted another accounted interrupt
+
+  uint64_t printedCycles;    // totalCycles when the console last printed
+} ISRAccounting_Vector;
+
+
+/************************************************
+* Macros
+************************************************/
+// Initializer for a static ISRAccounting_Vector, name is a string literal
+#define ISR_ACCOUNTING_VECTOR(name) \
+  { (name), NULL, 0, METRICS_COUNTER(name " ISR calls"), METRICS_COUNTER(name " ISR cycles"), \
+    METRICS_GAUGE(name " ISR max cycles"), 0, 0, 0 }
+
+
+/************************************************
+* Function declarations
+************************************************/
+// Account the SysTick interrupt. Called from main.
+extern uint32_t ISRAccounting_Initialization();
+
+// Install handler for interrupt (an INT_* or FAULT_* number) through the
+// accounting entry point. Returns false if ISR_ACCOUNTING_MAX_VECTORS are
+// already registered.
+extern bool ISRAccounting_Register(ISRAccounting_Vector* entry, uint32_t interrupt, void (*handler)(void));
+
+// Called by the entry point with the exception frame of the interrupt
+extern void ISRAccounting_Dispatch(const uint32_t* frame);
+
+// From an accounted handler, the PC at which its interrupt was taken
+extern uint32_t ISRAccounting_InterruptedPC();
+
+// Print calls, cycles, max, nested and load per vector. Load is over the
+// time since the previous print.
+extern void ISRAccounting_Print();
+
+// Print the cycles an accounted and a direct empty interrupt take
+extern void ISRAccounting_PrintCost();
+
+#endif /* DRIVERS_ISR_ACCOUNTING_H_ */
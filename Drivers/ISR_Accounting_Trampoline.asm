@@ -0,0 +1,41 @@
+;;*****************************************************************************
+;;
+;;	ISR_Accounting_Trampoline.asm
+;;
+;;		Author: 		Kaiser Mittenburg, Ben Sokol
+;;		Organization:	KU/EECS/EECS 690
+;;		Date:			2026-10-20
+;;		Version:		1.0
+;;
+;;		Purpose:		Common entry point of accounted interrupts. Pass
+;;						the exception frame to ISRAccounting_Dispatch.
+;;
+;;		Notes:			Bit 2 of the EXC_RETURN value in LR tells whether
+;;						the frame was stacked on the process stack (a task
+;;						was interrupted) or the main stack (an interrupt
+;;						was preempted). The branch leaves LR unchanged, so
+;;						ISRAccounting_Dispatch returns from the exception.
+;;
+;;*****************************************************************************
+
+;;	Declare sections and external references
+
+		.global		ISR_Accounting_Trampoline	; Declare entry point as a global symbol
+		.global		ISRAccounting_Dispatch		; C dispatcher
+
+;;	No constant data
+
+;;	No variable allocation
+
+;;	Program instructions
+
+		.text								; Program section
+
+ISR_Accounting_Trampoline:					; Entry point
+
+		TST		LR,#4         ; Which stack holds the frame
+		ITE		EQ
+		MRSEQ	R0,MSP        ; Main stack
+		MRSNE	R0,PSP        ; Process stack
+		B		ISRAccounting_Dispatch  ; Frame address is the argument
+		.end
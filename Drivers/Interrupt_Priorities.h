@@ -0,0 +1,108 @@
+/**
+* @Filename: Interrupt_Priorities.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [4:30am]
+* @Version:  1.0.0
+*
+* @Description: NVIC priority of every interrupt the application enables.
+*
+*               Priorities are in the NVIC's 8 bit form, lower is more
+*               urgent; the TM4C1294 implements the top NUM_PRIORITY_BITS
+*               bits, so levels are INTERRUPT_PRIORITY_STEP apart. An
+*               interrupt left at the reset priority (0) is above every
+*               critical section and must not call FreeRTOS. Three bands:
+*
+*                 above configMAX_SYSCALL_INTERRUPT_PRIORITY
+*                   Zero latency: never masked by the kernel, so it must
+*                   not call any FreeRTOS function, not even a FromISR
+*                   one. To wake a task it pends a kernel aware software
+*                   interrupt with IntTrigger.
+*                 configMAX_SYSCALL_INTERRUPT_PRIORITY ..
+*                 configKERNEL_INTERRUPT_PRIORITY
+*                   Kernel aware: may call the FromISR functions, is
+*                   masked by critical sections.
+*
+*               The profiler timer is zero latency, so its samples are not
+*               held off by critical sections, and hands the end of a
+*               collection period to a kernel aware software interrupt.
+*               I2C7 is the most urgent kernel aware interrupt, it paces
+*               the sensor transactions; UART0 only moves console bytes.
+*
+*               Any of the INTERRUPT_PRIORITY_ values can be overridden in
+*               the project's predefined symbols. The rules below are
+*               checked by the preprocessor, so a plan that breaks them
+*               does not build.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef DRIVERS_INTERRUPT_PRIORITIES_H_
+#define DRIVERS_INTERRUPT_PRIORITIES_H_
+
+#include "inc/hw_ints.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+/************************************************
+* Configuration
+************************************************/
+// Distance between two implemented priority levels
+#define INTERRUPT_PRIORITY_STEP (1 << (8 - NUM_PRIORITY_BITS))
+
+// Zero latency: Timer0A program counter sampling
+#ifndef INTERRUPT_PRIORITY_PROFILER
+#define INTERRUPT_PRIORITY_PROFILER (configMAX_SYSCALL_INTERRUPT_PRIORITY - INTERRUPT_PRIORITY_STEP)
+#endif
+
+// Kernel aware: I2C7 transactions, UART0 console
+#ifndef INTERRUPT_PRIORITY_I2C7
+#define INTERRUPT_PRIORITY_I2C7 configMAX_SYSCALL_INTERRUPT_PRIORITY
+#endif
+#ifndef INTERRUPT_PRIORITY_UART0
+#define INTERRUPT_PRIORITY_UART0 (configMAX_SYSCALL_INTERRUPT_PRIORITY + INTERRUPT_PRIORITY_STEP)
+#endif
+
+// Kernel aware: software triggered interrupts, the profiler's hand-off
+// and the benchmark and cost measurement interrupts
+#ifndef INTERRUPT_PRIORITY_SOFTWARE
+#define INTERRUPT_PRIORITY_SOFTWARE configKERNEL_INTERRUPT_PRIORITY
+#endif
+
+
+/************************************************
+* Rules
+************************************************/
+#if (configMAX_SYSCALL_INTERRUPT_PRIORITY == 0) || (configMAX_SYSCALL_INTERRUPT_PRIORITY > configKERNEL_INTERRUPT_PRIORITY)
+#error configMAX_SYSCALL_INTERRUPT_PRIORITY must be above configKERNEL_INTERRUPT_PRIORITY and below 0
+#endif
+
+#if ((INTERRUPT_PRIORITY_PROFILER % INTERRUPT_PRIORITY_STEP) != 0) || \
+    ((INTERRUPT_PRIORITY_I2C7 % INTERRUPT_PRIORITY_STEP) != 0) ||     \
+    ((INTERRUPT_PRIORITY_UART0 % INTERRUPT_PRIORITY_STEP) != 0) ||    \
+    ((INTERRUPT_PRIORITY_SOFTWARE % INTERRUPT_PRIORITY_STEP) != 0)
+#error Interrupt priorities must be multiples of INTERRUPT_PRIORITY_STEP, the low bits are not implemented
+#endif
+
+#if (INTERRUPT_PRIORITY_PROFILER < 0) || (INTERRUPT_PRIORITY_PROFILER >= configMAX_SYSCALL_INTERRUPT_PRIORITY)
+#error INTERRUPT_PRIORITY_PROFILER must be above configMAX_SYSCALL_INTERRUPT_PRIORITY
+#endif
+
+#if (INTERRUPT_PRIORITY_I2C7 < configMAX_SYSCALL_INTERRUPT_PRIORITY) || (INTERRUPT_PRIORITY_I2C7 > configKERNEL_INTERRUPT_PRIORITY)
+#error INTERRUPT_PRIORITY_I2C7 calls FreeRTOS, it must be within the kernel aware band
+#endif
+
+#if (INTERRUPT_PRIORITY_UART0 < configMAX_SYSCALL_INTERRUPT_PRIORITY) || (INTERRUPT_PRIORITY_UART0 > configKERNEL_INTERRUPT_PRIORITY)
+#error INTERRUPT_PRIORITY_UART0 must be within the kernel aware band
+#endif
+
+#if (INTERRUPT_PRIORITY_SOFTWARE < configMAX_SYSCALL_INTERRUPT_PRIORITY) || (INTERRUPT_PRIORITY_SOFTWARE > configKERNEL_INTERRUPT_PRIORITY)
+#error INTERRUPT_PRIORITY_SOFTWARE calls FreeRTOS, it must be within the kernel aware band
+#endif
+
+#endif /* DRIVERS_INTERRUPT_PRIORITIES_H_ */
@@ -0,0 +1,145 @@
+/**
+* @Filename: Timestamp.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [10:05pm]
+* @Version:  1.0.0
+*
+* @Description: 64-bit monotonic time from the tick count and SysTick
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Drivers/CycleCounter.h"
+#include "Drivers/Timestamp.h"
+
+#include "Tasks/Log.h"
+
+#include "FreeRTOS.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+// Reads timed by Timestamp_PrintReadCost
+#define TIMESTAMP_COST_READS 1000
+
+
+/************************************************
+* External variables
+************************************************/
+extern volatile uint32_t xPortSysTickCount;
+extern volatile uint32_t xPortSysTickCountHigh;
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: Timestamp_Read
+* Description:   Read the tick count and SysTick consistently
+* Parameters:    Timestamp* timestamp
+* Return:        void
+*************************************************************************/
+extern void Timestamp_Read(Timestamp* timestamp) {
+  uint32_t high = 0;
+  uint32_t ticks = 0;
+  uint32_t current = 0;
+  bool tickPending = false;
+  uint32_t subTickNs = 0;
+
+  do {
+    high = xPortSysTickCountHigh;
+    ticks = xPortSysTickCount;
+    current = TIMESTAMP_SYSTICK_CURRENT;
+
+    // SysTick reloaded but its interrupt has not run. current may have
+    // been read just before the reload, so read it again.
+    tickPending = ((TIMESTAMP_ICSR & TIMESTAMP_ICSR_PENDSTSET) != 0);
+    if (tickPending) {
+      current = TIMESTAMP_SYSTICK_CURRENT;
+    }
+  } while ((ticks != xPortSysTickCount) || (high != xPortSysTickCountHigh));
+
+  if (tickPending) {
+    if (++ticks == 0) {
+      ++high;
+    }
+  }
+
+  // SysTick counts down from LOAD
+  subTickNs = (uint32_t)(((uint64_t)(TIMESTAMP_SYSTICK_LOAD - current) * TIMESTAMP_NS_PER_COUNT_Q32) >> 32);
+  if (subTickNs >= TIMESTAMP_TICK_NS) {
+    subTickNs = TIMESTAMP_TICK_NS - 1;
+  }
+
+  timestamp->ticksHigh = high;
+  timestamp->ticks = ticks;
+  timestamp->subTickNs = subTickNs;
+}
+
+
+/*************************************************************************
+* Function Name: Timestamp_ToNs
+* Description:   Convert a reading to nanoseconds
+* Parameters:    const Timestamp* timestamp
+* Return:        uint64_t
+*************************************************************************/
+extern uint64_t Timestamp_ToNs(const Timestamp* timestamp) {
+  uint64_t ticks = ((uint64_t)timestamp->ticksHigh << 32) | timestamp->ticks;
+  return (ticks * TIMESTAMP_TICK_NS) + timestamp->subTickNs;
+}
+
+
+/*************************************************************************
+* Function Name: Timestamp_GetNs
+* Description:   Current time in nanoseconds
+* Parameters:    N/A
+* Return:        uint64_t
+*************************************************************************/
+extern uint64_t Timestamp_GetNs() {
+  Timestamp timestamp;
+  Timestamp_Read(&timestamp);
+  return Timestamp_ToNs(&timestamp);
+}
+
+
+/*************************************************************************
+* Function Name: Timestamp_PrintReadCost
+* Description:   Print the current time and the average and maximum
+*                cycles taken by Timestamp_Read
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void Timestamp_PrintReadCost() {
+  Timestamp timestamp;
+  uint32_t total = 0;
+  uint32_t max = 0;
+  uint32_t i = 0;
+  uint64_t ns = 0;
+
+  CycleCounter_Initialization();
+
+  for (i = 0; i < TIMESTAMP_COST_READS; ++i) {
+    uint32_t start = CycleCounter_Get();
+    Timestamp_Read(&timestamp);
+    uint32_t cycles = CycleCounter_Get() - start;
+
+    total += cycles;
+    if (cycles > max) {
+      max = cycles;
+    }
+  }
+
+  ns = Timestamp_ToNs(&timestamp);
+  Log_Printf("time %u.%09u s, tick %u:%u + %u ns\n",
+             (uint32_t)(ns / 1000000000), (uint32_t)(ns % 1000000000),
+             timestamp.ticksHigh, timestamp.ticks, timestamp.subTickNs);
+  Log_Printf("read cycles avg %u max %u over %u reads\n", total / TIMESTAMP_COST_READS, max, TIMESTAMP_COST_READS);
+}
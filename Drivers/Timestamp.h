@@ -0,0 +1,98 @@
+/**
+* @Filename: Timestamp.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [10:05pm]
+* @Version:  1.0.0
+*
+* @Description: 64-bit monotonic time since the scheduler started.
+*
+*               The time is the 64-bit tick count (xPortSysTickCount and
+*               its wrap count xPortSysTickCountHigh) plus the part of
+*               the current tick already counted down by SysTick, which
+*               runs at the CPU clock (8.3 ns at 120 MHz).
+*
+*               A read is consistent from tasks, interrupts and critical
+*               sections:
+*                 - if the tick interrupt runs during the read, the tick
+*                   count changes and the read is retried
+*                 - if SysTick has reloaded but its interrupt cannot run
+*                   yet (caller is a higher priority interrupt or has
+*                   interrupts masked), PENDSTSET is set and the missing
+*                   tick is added
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef DRIVERS_TIMESTAMP_H_
+#define DRIVERS_TIMESTAMP_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+/************************************************
+* Register definitions
+************************************************/
+// Host builds (the tests under Tests/) define TIMESTAMP_HOST and provide
+// Timestamp_HostRead, which models SysTick and its interrupt
+#ifdef TIMESTAMP_HOST
+extern uint32_t Timestamp_HostRead(uint32_t address);
+#define TIMESTAMP_REGISTER(address) (Timestamp_HostRead(address))
+#else
+#define TIMESTAMP_REGISTER(address) (*((volatile uint32_t*)(address)))
+#endif
+
+#define TIMESTAMP_SYSTICK_LOAD_ADDRESS    0xE000E014
+#define TIMESTAMP_SYSTICK_CURRENT_ADDRESS 0xE000E018
+#define TIMESTAMP_SYSTICK_LOAD            TIMESTAMP_REGISTER(TIMESTAMP_SYSTICK_LOAD_ADDRESS)
+#define TIMESTAMP_SYSTICK_CURRENT         TIMESTAMP_REGISTER(TIMESTAMP_SYSTICK_CURRENT_ADDRESS)
+
+// Interrupt Control and State Register, PENDSTSET is the pending SysTick
+#define TIMESTAMP_ICSR_ADDRESS   0xE000ED04
+#define TIMESTAMP_ICSR           TIMESTAMP_REGISTER(TIMESTAMP_ICSR_ADDRESS)
+#define TIMESTAMP_ICSR_PENDSTSET 0x04000000
+
+
+/************************************************
+* Constants
+************************************************/
+// Nanoseconds per tick
+#define TIMESTAMP_TICK_NS (1000000000UL / configTICK_RATE_HZ)
+
+// SysTick counts per tick, as programmed by the port
+#define TIMESTAMP_COUNTS_PER_TICK (configCPU_CLOCK_HZ / configTICK_RATE_HZ)
+
+// Nanoseconds per SysTick count, 32.32 fixed point
+#define TIMESTAMP_NS_PER_COUNT_Q32 ((((uint64_t)TIMESTAMP_TICK_NS) << 32) / TIMESTAMP_COUNTS_PER_TICK)
+
+
+/************************************************
+* Types
+************************************************/
+typedef struct Timestamp {
+  uint32_t ticksHigh;  // xPortSysTickCount wraps
+  uint32_t ticks;      // xPortSysTickCount
+  uint32_t subTickNs;  // 0 .. TIMESTAMP_TICK_NS - 1
+} Timestamp;
+
+
+/************************************************
+* Function declarations
+************************************************/
+// Read the current time
+extern void Timestamp_Read(Timestamp* timestamp);
+
+// Current time in nanoseconds
+extern uint64_t Timestamp_GetNs();
+
+// Convert a reading to nanoseconds
+extern uint64_t Timestamp_ToNs(const Timestamp* timestamp);
+
+// Print the current time and the cost of Timestamp_Read in cycles
+extern void Timestamp_PrintReadCost();
+
+#endif /* DRIVERS_TIMESTAMP_H_ */
@@ -0,0 +1,574 @@
+/**
+* @Filename: Trace_Recorder.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [11:55pm]
+* @Version:  1.0.0
+*
+* @Description: Kernel event trace recorder, Chrome trace output and
+*               streaming
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Without the header in FreeRTOSConfig.h the kernel is built with the
+// empty trace macros and nothing is recorded
+#if ( configUSE_TRACE_RECORDER == 1 ) && !defined(DRIVERS_TRACE_RECORDER_H_)
+#error configUSE_TRACE_RECORDER requires FreeRTOSConfig.h to include Drivers/Trace_Recorder.h
+#endif
+
+#include "Drivers/CycleCounter.h"
+#include "Drivers/Trace_Recorder.h"
+
+#include "Tasks/Log.h"
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+/************************************************
+* Local constant variables
+************************************************/
+#define TRACE_RECORDER_MASK (TRACE_RECORDER_EVENTS - 1)
+
+// Calls timed by TraceRecorder_PrintCost
+#define TRACE_RECORDER_COST_CALLS 1000
+
+// Row used for events recorded in interrupts
+#define TRACE_RECORDER_ISR_TID 0
+
+
+/************************************************
+* Local types
+************************************************/
+typedef struct TraceRecorder_Task {
+  const void* task;
+  const char* name;
+} TraceRecorder_Task;
+
+
+/************************************************
+* Local variables
+************************************************/
+TraceRecorder_Event TraceRecorder_Events[TRACE_RECORDER_EVENTS];
+volatile uint32_t TraceRecorder_Head = 0;
+volatile bool TraceRecorder_Running = false;
+
+TraceRecorder_Task TraceRecorder_Tasks[TRACE_RECORDER_MAX_TASKS];
+volatile uint32_t TraceRecorder_Tasks_Nbr = 0;
+
+// Streaming: next event to send, and the names already sent
+volatile bool TraceRecorder_Streaming = false;
+uint32_t TraceRecorder_Tail = 0;
+uint32_t TraceRecorder_Stream_First = 0;
+volatile uint32_t TraceRecorder_Lost_Nbr = 0;
+bool TraceRecorder_Header_Sent = false;
+uint32_t TraceRecorder_Tasks_Sent = 0;
+const void* TraceRecorder_Names_Sent[TRACE_RECORDER_STREAM_NAMES];
+uint32_t TraceRecorder_Names_Sent_Nbr = 0;
+
+
+/************************************************
+* Local function declarations
+************************************************/
+static uint32_t task_tid(const void* task);
+static const char* event_name(uint32_t type);
+static void stream_names(const TraceRecorder_Event* events, uint32_t count);
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: task_tid
+* Description:   Chrome trace row of a task, 1 + its index in the table
+* Parameters:    const void* task
+* Return:        uint32_t - TRACE_RECORDER_MAX_TASKS + 1 if unknown
+*************************************************************************/
+static uint32_t task_tid(const void* task) {
+  uint32_t i = 0;
+
+  for (i = 0; i < TraceRecorder_Tasks_Nbr; ++i) {
+    if (TraceRecorder_Tasks[i].task == task) {
+      return i + 1;
+    }
+  }
+
+  return TRACE_RECORDER_MAX_TASKS + 1;
+}
+
+
+/*************************************************************************
+* Function Name: event_name
+* Description:   Name printed for an instant event
+* Parameters:    uint32_t type
+* Return:        const char*
+*************************************************************************/
+static const char* event_name(uint32_t type) {
+  switch (type) {
+    case TRACE_RECORDER_TASK_CREATE:
+      return "create";
+    case TRACE_RECORDER_TASK_DELAY:
+      return "delay";
+    case TRACE_RECORDER_TASK_DELAY_UNTIL:
+      return "delay until";
+    case TRACE_RECORDER_QUEUE_SEND:
+    case TRACE_RECORDER_QUEUE_SEND_FROM_ISR:
+      return "send";
+    case TRACE_RECORDER_QUEUE_RECEIVE:
+    case TRACE_RECORDER_QUEUE_RECEIVE_FROM_ISR:
+      return "receive";
+    case TRACE_RECORDER_QUEUE_BLOCK_SEND:
+      return "block on send";
+    case TRACE_RECORDER_QUEUE_BLOCK_RECEIVE:
+      return "block on receive";
+    case TRACE_RECORDER_TIMER_EXPIRED:
+      return "timer";
+    default:
+      return "user";
+  }
+}
+
+
+/*************************************************************************
+* Function Name: stream_names
+* Description:   Send the names of new tasks, and of the timers of events
+*                about to be sent, that the converter has not been given
+* Parameters:    const TraceRecorder_Event* events
+*                uint32_t count
+* Return:        void
+*************************************************************************/
+static void stream_names(const TraceRecorder_Event* events, uint32_t count) {
+  uint32_t i = 0;
+  uint32_t j = 0;
+
+  while (TraceRecorder_Tasks_Sent < TraceRecorder_Tasks_Nbr) {
+    const TraceRecorder_Task* task = &TraceRecorder_Tasks[TraceRecorder_Tasks_Sent++];
+    Log_PrintfWait("#TN %08x %s\n", (uint32_t)(uintptr_t)task->task, task->name);
+  }
+
+  for (i = 0; i < count; ++i) {
+    if (events[i].type != TRACE_RECORDER_TIMER_EXPIRED) {
+      continue;
+    }
+    for (j = 0; j < TraceRecorder_Names_Sent_Nbr; ++j) {
+      if (TraceRecorder_Names_Sent[j] == events[i].object) {
+        break;
+      }
+    }
+    // Once the table is full, further timers are shown by address
+    if ((j == TraceRecorder_Names_Sent_Nbr) && (j < TRACE_RECORDER_STREAM_NAMES)) {
+      TraceRecorder_Names_Sent[TraceRecorder_Names_Sent_Nbr++] = events[i].object;
+      Log_PrintfWait("#TS %08x %s\n", (uint32_t)(uintptr_t)events[i].object, (const char*)events[i].object);
+    }
+  }
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: TraceRecorder_Record
+* Description:   Add one event to the ring
+* Parameters:    uint32_t type
+*                const void* object
+* Return:        void
+*************************************************************************/
+extern void TraceRecorder_Record(uint32_t type, const void* object) {
+  UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+
+  if (TraceRecorder_Running) {
+    TraceRecorder_Event* event = &TraceRecorder_Events[TraceRecorder_Head & TRACE_RECORDER_MASK];
+    TraceRecorder_Head++;
+
+    event->cycles = CycleCounter_Get();
+    event->object = object;
+    event->type = type;
+  }
+
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+
+/*************************************************************************
+* Function Name: TraceRecorder_TaskCreate
+* Description:   Remember the name of a task and record its creation
+* Parameters:    const void* task
+*                const char* name
+* Return:        void
+*************************************************************************/
+extern void TraceRecorder_TaskCreate(const void* task, const char* name) {
+  if (TraceRecorder_Tasks_Nbr < TRACE_RECORDER_MAX_TASKS) {
+    TraceRecorder_Tasks[TraceRecorder_Tasks_Nbr].task = task;
+    TraceRecorder_Tasks[TraceRecorder_Tasks_Nbr].name = name;
+    TraceRecorder_Tasks_Nbr++;
+  }
+
+  TraceRecorder_Record(TRACE_RECORDER_TASK_CREATE, task);
+}
+
+
+/*************************************************************************
+* Function Name: TraceRecorder_Start
+* Description:   Clear the ring and start recording
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void TraceRecorder_Start() {
+  UBaseType_t mask = 0;
+
+  CycleCounter_Initialization();
+
+  mask = portSET_INTERRUPT_MASK_FROM_ISR();
+  TraceRecorder_Head = 0;
+  TraceRecorder_Tail = 0;
+  TraceRecorder_Running = true;
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+
+/*************************************************************************
+* Function Name: TraceRecorder_Stop
+* Description:   Stop recording, the ring is kept
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void TraceRecorder_Stop() {
+  UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+  TraceRecorder_Running = false;
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+
+/*************************************************************************
+* Function Name: TraceRecorder_PrintStatus
+* Description:   Print whether recording is running and how many events
+*                are held
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void TraceRecorder_PrintStatus() {
+  uint32_t head = TraceRecorder_Head;
+
+  Log_Printf("trace %s, %u events recorded, %u held, %u tasks\n",
+             TraceRecorder_Running ? "running" : "stopped", head,
+             (head < TRACE_RECORDER_EVENTS) ? head : TRACE_RECORDER_EVENTS,
+             TraceRecorder_Tasks_Nbr);
+  if (TraceRecorder_Streaming) {
+    Log_Printf("trace streaming, %u events lost\n", TraceRecorder_Lost_Nbr);
+  }
+}
+
+
+/*************************************************************************
+* Function Name: TraceRecorder_PrintChromeTrace
+* Description:   Stop recording and print the ring as Chrome trace JSON
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void TraceRecorder_PrintChromeTrace() {
+  uint32_t head = 0;
+  uint32_t count = 0;
+  uint32_t i = 0;
+  uint32_t previousCycles = 0;
+  uint64_t elapsed = 0;
+  uint32_t running = 0;
+
+  TraceRecorder_Stop();
+
+  head = TraceRecorder_Head;
+  count = (head < TRACE_RECORDER_EVENTS) ? head : TRACE_RECORDER_EVENTS;
+
+  Log_Printf("{\"traceEvents\":[\n");
+  Log_Printf("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"interrupts\"}}\n",
+             TRACE_RECORDER_ISR_TID);
+  for (i = 0; i < TraceRecorder_Tasks_Nbr; ++i) {
+    Log_Printf(",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}\n",
+               i + 1, TraceRecorder_Tasks[i].name);
+  }
+
+  for (i = head - count; i != head; ++i) {
+    const TraceRecorder_Event* event = &TraceRecorder_Events[i & TRACE_RECORDER_MASK];
+    uint32_t us = 0;
+    uint32_t ns = 0;
+    uint32_t tid = running;
+
+    // Time from the first event, cycle count differences survive a wrap
+    if (i != (head - count)) {
+      elapsed += (uint32_t)(event->cycles - previousCycles);
+    }
+    previousCycles = event->cycles;
+    us = (uint32_t)(elapsed / CYCLECOUNTER_CYCLES_PER_US);
+    ns = (uint32_t)((elapsed % CYCLECOUNTER_CYCLES_PER_US) * 1000 / CYCLECOUNTER_CYCLES_PER_US);
+
+    switch (event->type) {
+      case TRACE_RECORDER_TASK_SWITCHED_IN:
+        if (running != 0) {
+          Log_Printf(",{\"ph\":\"E\",\"ts\":%u.%03u,\"pid\":1,\"tid\":%u}\n", us, ns, running);
+        }
+        running = task_tid(event->object);
+        Log_Printf(",{\"name\":\"run\",\"ph\":\"B\",\"ts\":%u.%03u,\"pid\":1,\"tid\":%u}\n", us, ns, running);
+        break;
+
+      case TRACE_RECORDER_TIMER_EXPIRED:
+        Log_Printf(",{\"name\":\"timer %s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%u.%03u,\"pid\":1,\"tid\":%u}\n",
+                   (const char*)event->object, us, ns, tid);
+        break;
+
+      case TRACE_RECORDER_TASK_CREATE:
+        tid = task_tid(event->object);
+        Log_Printf(",{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%u.%03u,\"pid\":1,\"tid\":%u}\n",
+                   event_name(event->type), us, ns, tid);
+        break;
+
+      case TRACE_RECORDER_TASK_DELAY:
+      case TRACE_RECORDER_TASK_DELAY_UNTIL:
+      case TRACE_RECORDER_USER:
+        Log_Printf(",{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%u.%03u,\"pid\":1,\"tid\":%u}\n",
+                   event_name(event->type), us, ns, tid);
+        break;
+
+      default:
+        if ((event->type == TRACE_RECORDER_QUEUE_SEND_FROM_ISR) ||
+            (event->type == TRACE_RECORDER_QUEUE_RECEIVE_FROM_ISR)) {
+          tid = TRACE_RECORDER_ISR_TID;
+        }
+        Log_Printf(",{\"name\":\"%s 0x%08x\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%u.%03u,\"pid\":1,\"tid\":%u}\n",
+                   event_name(event->type), (uint32_t)(uintptr_t)event->object, us, ns, tid);
+        break;
+    }
+  }
+
+  if (running != 0) {
+    uint32_t us = (uint32_t)(elapsed / CYCLECOUNTER_CYCLES_PER_US);
+    uint32_t ns = (uint32_t)((elapsed % CYCLECOUNTER_CYCLES_PER_US) * 1000 / CYCLECOUNTER_CYCLES_PER_US);
+    Log_Printf(",{\"ph\":\"E\",\"ts\":%u.%03u,\"pid\":1,\"tid\":%u}\n", us, ns, running);
+  }
+
+  Log_Printf("]}\n");
+}
+
+
+/*************************************************************************
+* Function Name: TraceRecorder_PrintCost
+* Description:   Print the average and maximum cycles taken by
+*                TraceRecorder_Record while recording and while stopped.
+*                Clears the ring and leaves recording as it was.
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void TraceRecorder_PrintCost() {
+  bool wasRunning = TraceRecorder_Running;
+  uint32_t pass = 0;
+
+  CycleCounter_Initialization();
+
+  for (pass = 0; pass < 2; ++pass) {
+    uint32_t total = 0;
+    uint32_t max = 0;
+    uint32_t i = 0;
+
+    if (pass == 0) {
+      TraceRecorder_Start();
+    }
+    else {
+      TraceRecorder_Stop();
+    }
+
+    for (i = 0; i < TRACE_RECORDER_COST_CALLS; ++i) {
+      uint32_t start = CycleCounter_Get();
+      TraceRecorder_Record(TRACE_RECORDER_USER, NULL);
+      uint32_t cycles = CycleCounter_Get() - start;
+
+      total += cycles;
+      if (cycles > max) {
+        max = cycles;
+      }
+    }
+
+    Log_Printf("record %s: cycles avg %u max %u over %u calls\n", (pass == 0) ? "running" : "stopped",
+               total / TRACE_RECORDER_COST_CALLS, max, TRACE_RECORDER_COST_CALLS);
+  }
+
+  if (wasRunning) {
+    TraceRecorder_Start();
+  }
+  else {
+    TraceRecorder_Head = 0;
+    TraceRecorder_Tail = 0;
+  }
+}
+
+
+/*************************************************************************
+* Function Name: TraceRecorder_StreamStart
+* Description:   Stream from the next event recorded, beginning with the
+*                header and the task names
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void TraceRecorder_StreamStart() {
+  UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+
+  TraceRecorder_Tail = TraceRecorder_Head;
+  TraceRecorder_Stream_First = TraceRecorder_Head;
+  TraceRecorder_Lost_Nbr = 0;
+  TraceRecorder_Header_Sent = false;
+  TraceRecorder_Tasks_Sent = 0;
+  TraceRecorder_Names_Sent_Nbr = 0;
+  TraceRecorder_Streaming = true;
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+
+/*************************************************************************
+* Function Name: TraceRecorder_StreamStop
+* Description:   Stop streaming; recording goes on
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void TraceRecorder_StreamStop() {
+  TraceRecorder_Streaming = false;
+}
+
+
+/*************************************************************************
+* Function Name: TraceRecorder_StreamPoll
+* Description:   Send the events recorded since the last call, up to
+*                TRACE_RECORDER_STREAM_RECORDS per line. Events are
+*                copied out of the ring with interrupts masked, so one
+*                overwritten meanwhile is counted lost rather than sent
+*                torn.
+* Parameters:    N/A
+* Return:        uint32_t - events sent
+*************************************************************************/
+extern uint32_t TraceRecorder_StreamPoll() {
+  TraceRecorder_Event events[TRACE_RECORDER_STREAM_RECORDS];
+  char line[LOG_LINE_SIZE];
+  uint32_t sent = 0;
+
+  if (TraceRecorder_Streaming && !TraceRecorder_Header_Sent) {
+    Log_PrintfWait("#TH %u %u %08x\n", TRACE_RECORDER_STREAM_VERSION, CYCLECOUNTER_CYCLES_PER_US,
+                   TraceRecorder_Stream_First);
+    TraceRecorder_Header_Sent = true;
+  }
+
+  while (TraceRecorder_Streaming) {
+    UBaseType_t mask = 0;
+    uint32_t head = 0;
+    uint32_t first = 0;
+    uint32_t count = 0;
+    uint32_t i = 0;
+    int length = 0;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    head = TraceRecorder_Head;
+    if ((head - TraceRecorder_Tail) > TRACE_RECORDER_EVENTS) {
+      TraceRecorder_Lost_Nbr += head - TRACE_RECORDER_EVENTS - TraceRecorder_Tail;
+      TraceRecorder_Tail = head - TRACE_RECORDER_EVENTS;
+    }
+    first = TraceRecorder_Tail;
+    count = head - first;
+    if (count > TRACE_RECORDER_STREAM_RECORDS) {
+      count = TRACE_RECORDER_STREAM_RECORDS;
+    }
+    for (i = 0; i < count; ++i) {
+      events[i] = TraceRecorder_Events[(first + i) & TRACE_RECORDER_MASK];
+    }
+    TraceRecorder_Tail = first + count;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+    if (count == 0) {
+      break;
+    }
+
+    stream_names(events, count);
+
+    length = snprintf(line, sizeof(line), "#TE %08x", first);
+    for (i = 0; i < count; ++i) {
+      length += snprintf(&line[length], sizeof(line) - (size_t)length, " %02x%08x%08x", (uint8_t)events[i].type,
+                         events[i].cycles, (uint32_t)(uintptr_t)events[i].object);
+    }
+    Log_PrintfWait("%s\n", line);
+    sent += count;
+  }
+
+  return sent;
+}
+
+
+/*************************************************************************
+* Function Name: TraceRecorder_StreamLostCount
+* Description:   Events overwritten before they could be streamed
+* Parameters:    N/A
+* Return:        uint32_t
+*************************************************************************/
+extern uint32_t TraceRecorder_StreamLostCount() {
+  return TraceRecorder_Lost_Nbr;
+}
+
+
+/*************************************************************************
+* Function Name: Task_TraceStream
+* Description:   Stream the ring every TRACE_RECORDER_STREAM_PERIOD ticks
+*                while "trace stream on". Its own console writes are
+*                traced too, a few events per line sent.
+* Parameters:    void* pvParameters
+* Return:        void
+*************************************************************************/
+extern void Task_TraceStream(void* pvParameters) {
+  while (1) {
+    if (TraceRecorder_Streaming) {
+      TraceRecorder_StreamPoll();
+    }
+    vTaskDelay(TRACE_RECORDER_STREAM_PERIOD);
+  }
+}
+
+#else
+
+// Recorder not built, the console reports it
+extern void TraceRecorder_Start() {
+}
+
+extern void TraceRecorder_Stop() {
+}
+
+extern void TraceRecorder_PrintStatus() {
+  Log_Printf("trace recorder not built, set configUSE_TRACE_RECORDER to 1\n");
+}
+
+extern void TraceRecorder_PrintChromeTrace() {
+  TraceRecorder_PrintStatus();
+}
+
+extern void TraceRecorder_PrintCost() {
+  TraceRecorder_PrintStatus();
+}
+
+extern void TraceRecorder_StreamStart() {
+  TraceRecorder_PrintStatus();
+}
+
+extern void TraceRecorder_StreamStop() {
+}
+
+extern uint32_t TraceRecorder_StreamPoll() {
+  return 0;
+}
+
+extern uint32_t TraceRecorder_StreamLostCount() {
+  return 0;
+}
+
+#endif /* configUSE_TRACE_RECORDER */
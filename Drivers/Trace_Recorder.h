@@ -0,0 +1,169 @@
+/**
+* @Filename: Trace_Recorder.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [11:55pm]
+* @Version:  1.0.0
+*
+* @Description: Kernel event trace recorder.
+*
+*               The kernel trace macros below record task switches, queue
+*               (and semaphore/mutex) sends and receives, blocking, delays
+*               and timer expiries into a RAM ring of TRACE_RECORDER_EVENTS
+*               events, time stamped with the DWT cycle counter. The ring
+*               always holds the latest events. To build it, end
+*               FreeRTOSConfig.h with
+*
+*                 #define configUSE_TRACE_RECORDER 1
+*                 #include "Drivers/Trace_Recorder.h"
+*
+*               so the macros are defined before the kernel's empty
+*               defaults.
+*
+*               main starts recording just before the scheduler, and the
+*               "trace start" console command restarts it with an empty
+*               ring. TraceRecorder_PrintChromeTrace
+*               stops it and prints the ring as Chrome trace JSON (open in
+*               chrome://tracing or ui.perfetto.dev): one row per task,
+*               a slice while the task runs, and instant events for the
+*               rest. Events from interrupts are shown on the
+*               "interrupts" row.
+*
+*               Tasks are named from the table filled by traceTASK_CREATE;
+*               queues are named by address. Tasks must not be deleted.
+*
+*               "trace stream" sends the events as they are recorded
+*               instead: Task_TraceStream, at the lowest task priority,
+*               drains the ring every TRACE_RECORDER_STREAM_PERIOD ticks
+*               into console lines of compact binary records, hex encoded
+*               so they can share the console with text:
+*
+*                 #TH <version> <cycles per us> <index> stream header
+*                 #TN <address> <task name>           before its events
+*                 #TS <address> <timer name>          before its events
+*                 #TE <index> <record>...             events from index
+*
+*               A record is 9 bytes: type, cycles and object (32 bits,
+*               big-endian). Events overwritten before they were sent are
+*               counted as lost and show as a gap in the index. Capture
+*               the console and convert it on the host with
+*               Tools/Trace_Convert (see Tools/Makefile).
+*
+*               Other files include this header after FreeRTOS.h.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef DRIVERS_TRACE_RECORDER_H_
+#define DRIVERS_TRACE_RECORDER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/************************************************
+* Configuration
+************************************************/
+// Events kept, a power of two. 12 bytes each.
+#define TRACE_RECORDER_EVENTS 1024
+
+// Tasks that can be named
+#define TRACE_RECORDER_MAX_TASKS 16
+
+// Streaming: ticks between drains of the ring, records per console line
+// and timer names remembered as sent
+#define TRACE_RECORDER_STREAM_PERIOD   (configTICK_RATE_HZ / 100)
+#define TRACE_RECORDER_STREAM_RECORDS  5
+#define TRACE_RECORDER_STREAM_NAMES    16
+#define TRACE_RECORDER_STREAM_VERSION  1
+
+
+/************************************************
+* Event types
+************************************************/
+#define TRACE_RECORDER_TASK_SWITCHED_IN      1
+#define TRACE_RECORDER_TASK_CREATE           2
+#define TRACE_RECORDER_TASK_DELAY            3
+#define TRACE_RECORDER_TASK_DELAY_UNTIL      4
+#define TRACE_RECORDER_QUEUE_SEND            5
+#define TRACE_RECORDER_QUEUE_RECEIVE         6
+#define TRACE_RECORDER_QUEUE_BLOCK_SEND      7
+#define TRACE_RECORDER_QUEUE_BLOCK_RECEIVE   8
+#define TRACE_RECORDER_QUEUE_SEND_FROM_ISR   9
+#define TRACE_RECORDER_QUEUE_RECEIVE_FROM_ISR 10
+#define TRACE_RECORDER_TIMER_EXPIRED         11
+#define TRACE_RECORDER_USER                  12
+
+
+/************************************************
+* Types
+************************************************/
+typedef struct TraceRecorder_Event {
+  uint32_t cycles;     // CYCCNT when recorded
+  const void* object;  // TCB, queue or timer name
+  uint32_t type;       // TRACE_RECORDER_*
+} TraceRecorder_Event;
+
+
+/************************************************
+* Function declarations
+************************************************/
+// Add one event to the ring. Safe from tasks, interrupts and critical
+// sections.
+extern void TraceRecorder_Record(uint32_t type, const void* object);
+
+// Remember the name of a task and record its creation
+extern void TraceRecorder_TaskCreate(const void* task, const char* name);
+
+// Clear the ring and start recording, or stop recording
+extern void TraceRecorder_Start();
+extern void TraceRecorder_Stop();
+
+// Print whether recording is running and how many events are held
+extern void TraceRecorder_PrintStatus();
+
+// Stop recording and print the ring as Chrome trace JSON
+extern void TraceRecorder_PrintChromeTrace();
+
+// Print the cycles taken by TraceRecorder_Record while recording and while
+// stopped. Clears the ring.
+extern void TraceRecorder_PrintCost();
+
+// Start streaming from the next event recorded, or stop
+extern void TraceRecorder_StreamStart();
+extern void TraceRecorder_StreamStop();
+
+// Send every event recorded since the last call. Returns the number
+// sent. Task_TraceStream calls it while streaming.
+extern uint32_t TraceRecorder_StreamPoll();
+
+// Events overwritten before they could be streamed
+extern uint32_t TraceRecorder_StreamLostCount();
+
+// Streams the ring while "trace stream" is on
+extern void Task_TraceStream(void* pvParameters);
+
+
+/************************************************
+* Kernel trace macros
+************************************************/
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+#define traceTASK_SWITCHED_IN() TraceRecorder_Record(TRACE_RECORDER_TASK_SWITCHED_IN, pxCurrentTCB)
+#define traceTASK_CREATE(pxNewTCB) TraceRecorder_TaskCreate((pxNewTCB), (pxNewTCB)->pcTaskName)
+#define traceTASK_DELAY() TraceRecorder_Record(TRACE_RECORDER_TASK_DELAY, pxCurrentTCB)
+#define traceTASK_DELAY_UNTIL() TraceRecorder_Record(TRACE_RECORDER_TASK_DELAY_UNTIL, pxCurrentTCB)
+
+#define traceQUEUE_SEND(pxQueue) TraceRecorder_Record(TRACE_RECORDER_QUEUE_SEND, (pxQueue))
+#define traceQUEUE_RECEIVE(pxQueue) TraceRecorder_Record(TRACE_RECORDER_QUEUE_RECEIVE, (pxQueue))
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue) TraceRecorder_Record(TRACE_RECORDER_QUEUE_BLOCK_SEND, (pxQueue))
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) TraceRecorder_Record(TRACE_RECORDER_QUEUE_BLOCK_RECEIVE, (pxQueue))
+#define traceQUEUE_SEND_FROM_ISR(pxQueue) TraceRecorder_Record(TRACE_RECORDER_QUEUE_SEND_FROM_ISR, (pxQueue))
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue) TraceRecorder_Record(TRACE_RECORDER_QUEUE_RECEIVE_FROM_ISR, (pxQueue))
+
+#define traceTIMER_EXPIRED(pxTimer) TraceRecorder_Record(TRACE_RECORDER_TIMER_EXPIRED, (pxTimer)->pcTimerName)
+
+#endif /* configUSE_TRACE_RECORDER */
+
+#endif /* DRIVERS_TRACE_RECORDER_H_ */
@@ -8,6 +8,14 @@
  *		Description:	This file defines the interface to the
  *						UARTStdio initialization subroutine.
  *
+ *		Modification:	2026-10-19
+ *						The bit rate is UARTSTDIO_BAUD_RATE and can be
+ *						changed at run time. At 10 bits per byte,
+ *						115200 carries 11.5 kB/s and 921600 carries
+ *						92 kB/s. The UART clock (120 MHz) allows up to
+ *						7.5 Mbit/s, or 15 Mbit/s with the high speed
+ *						divider; the host side usually sets the limit.
+ *
  */
 
 #ifndef KU_UARTStdio_Initialization_s
@@ -23,10 +31,24 @@ extern "C" {
 #include	<stdint.h>
 #include	<stdarg.h>
 
+//
+//	Bit rate set by UARTStdio_Initialization
+//
+#ifndef	UARTSTDIO_BAUD_RATE
+#define	UARTSTDIO_BAUD_RATE		115200
+#endif
+
 //
 //	Define initialization interfaces.
 //
 extern	uint32_t	UARTStdio_Initialization();
 
+//
+//	Change or read the bit rate. Waits for pending output to be sent
+//	at the old rate first.
+//
+extern	void		UARTStdio_SetBaudRate( uint32_t BaudRate );
+extern	uint32_t	UARTStdio_GetBaudRate();
+
 #endif	// KU_UARTStdio_Initialization_s
 
@@ -8,6 +8,19 @@
  *		Description:	This file defines the subroutin to
  *						initialize the UARTStdio sub-system
  *
+ *		Modification:	2026-10-19
+ *						Use UARTSTDIO_BAUD_RATE, add
+ *						UARTStdio_SetBaudRate, and register the
+ *						UARTStdio interrupt handler when built with
+ *						UART_BUFFERED.
+ *
+ *		Modification:	2026-10-20
+ *						Register the interrupt handler through
+ *						ISRAccounting_Register.
+ *
+ *		Modification:	2026-10-20
+ *						Run the interrupt at INTERRUPT_PRIORITY_UART0.
+ *
  */
  
 //*****************************************************************************
@@ -29,9 +42,12 @@
 
 #include	"driverlib/pin_map.h"
 #include	"driverlib/gpio.h"
+#include	"driverlib/interrupt.h"
 #include	"driverlib/sysctl.h"
 #include	"driverlib/uart.h"
 
+#include	"Drivers/ISR_Accounting.h"
+#include	"Drivers/Interrupt_Priorities.h"
 #include	"Drivers/Processor_Initialization.h"
 #include	"Drivers/uartstdio.h"
 #include	"Drivers/UARTStdio_Initialization.h"
@@ -47,10 +63,24 @@ uint32_t		UARTStdioInitFlag = 0;
 
 uint32_t		theSystemClockFrequency = 0;
 
+//
+//	Current bit rate
+//
+uint32_t		UARTStdio_BaudRate = UARTSTDIO_BAUD_RATE;
+
+#ifdef UART_BUFFERED
+extern void UARTStdioIntHandler( void );
+
+//
+//	Duration of the UART0 interrupt
+//
+ISRAccounting_Vector	UART0_ISR_Accounting = ISR_ACCOUNTING_VECTOR( "UART0" );
+#endif
+
 //*****************************************************************************
 //
 //!	The UARTStdio initialization subroutine configures PortA<1..0> for UART0
-//!	and initializes UARTStdio for 115,200 bits per second.
+//!	and initializes UARTStdio for UARTSTDIO_BAUD_RATE bits per second.
 //
 //*****************************************************************************
 
@@ -72,10 +102,18 @@ extern uint32_t UARTStdio_Initialization() {
 
 	    UARTClockSourceSet( UART0_BASE, UART_CLOCK_SYSTEM );
 
+#ifdef UART_BUFFERED
+	    //
+	    //	Buffered UARTStdio is interrupt driven
+	    //
+	    ISRAccounting_Register( &UART0_ISR_Accounting, INT_UART0, UARTStdioIntHandler );
+	    IntPrioritySet( INT_UART0, INTERRUPT_PRIORITY_UART0 );
+#endif
+
 	    //
 	    //	Initialize UARTStdio
 	    //
-	    UARTStdioConfig( 0, 115200, g_ulSystemClock );
+	    UARTStdioConfig( 0, UARTStdio_BaudRate, g_ulSystemClock );
 
 		UARTStdioInitFlag = 1;			// Set flag indicating initialization complete.
 	}
@@ -84,6 +122,26 @@ extern uint32_t UARTStdio_Initialization() {
 
  }
 
+//*****************************************************************************
+//
+//!	Change the UART0 bit rate. Output already written is sent at the
+//!	old rate first.
+//
+//*****************************************************************************
+
+extern void UARTStdio_SetBaudRate( uint32_t BaudRate ) {
+
+	UARTStdio_Initialization();
+
+	UARTStdioSetBaud( BaudRate, g_ulSystemClock );
+	UARTStdio_BaudRate = BaudRate;
+}
+
+extern uint32_t UARTStdio_GetBaudRate() {
+
+	return( UARTStdio_BaudRate );
+}
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
@@ -44,6 +44,36 @@
 //
 //*****************************************************************************
 
+//*****************************************************************************
+//
+// FIFO trigger levels used in buffered mode.  The UART FIFOs are 16 bytes
+// deep.  A TX interrupt refills the FIFO from the trigger level, and an RX
+// interrupt empties it at the trigger level (the receive timeout collects
+// the tail of a burst, one more interrupt per burst):
+//
+//   TX level   bytes per interrupt   interrupts per byte
+//   1/8        14                    0.071
+//   2/8        12                    0.083
+//   4/8         8                    0.125
+//
+//   RX level   bytes per interrupt   margin before overrun at 921600
+//   1/8         2                    14 bytes, 152 us
+//   4/8         8                     8 bytes,  87 us
+//   7/8        14                     2 bytes,  22 us
+//
+// Higher levels mean fewer interrupts per byte but less time to service
+// each one.  The defaults suit a mostly-transmit console up to 921600 baud.
+// Tests/Test_UART_FIFO.c checks this table and the defaults against a
+// model of the FIFOs, and prints the model for every level and rate.
+//
+//*****************************************************************************
+#ifndef UART_TX_FIFO_LEVEL
+#define UART_TX_FIFO_LEVEL      UART_FIFO_TX1_8
+#endif
+#ifndef UART_RX_FIFO_LEVEL
+#define UART_RX_FIFO_LEVEL      UART_FIFO_RX4_8
+#endif
+
 //*****************************************************************************
 //
 // If buffered mode is defined, set aside RX and TX buffers and read/write
@@ -83,6 +113,16 @@ static unsigned char g_pcUARTRxBuffer[UART_RX_BUFFER_SIZE];
 static volatile uint32_t g_ui32UARTRxWriteIndex = 0;
 static volatile uint32_t g_ui32UARTRxReadIndex = 0;
 
+//*****************************************************************************
+//
+// Interrupts taken and bytes moved through the FIFOs, for measuring the
+// interrupt cost per byte.
+//
+//*****************************************************************************
+static volatile uint32_t g_ui32UARTIntCount = 0;
+static volatile uint32_t g_ui32UARTTxByteCount = 0;
+static volatile uint32_t g_ui32UARTRxByteCount = 0;
+
 //*****************************************************************************
 //
 // Macros to determine number of free and used bytes in the transmit buffer.
@@ -297,6 +337,7 @@ UARTPrimeTransmit(uint32_t ui32Base)
             MAP_UARTCharPutNonBlocking(ui32Base,
                                       g_pcUARTTxBuffer[g_ui32UARTTxReadIndex]);
             ADVANCE_TX_BUFFER_INDEX(g_ui32UARTTxReadIndex);
+            g_ui32UARTTxByteCount++;
         }
 
         //
@@ -373,10 +414,9 @@ UARTStdioConfig(uint32_t ui32PortNum, uint32_t ui32Baud, uint32_t ui32SrcClock)
 
 #ifdef UART_BUFFERED
     //
-    // Set the UART to interrupt whenever the TX FIFO is almost empty or
-    // when any character is received.
+    // Set the UART to interrupt at the configured FIFO levels.
     //
-    MAP_UARTFIFOLevelSet(g_ui32Base, UART_FIFO_TX1_8, UART_FIFO_RX1_8);
+    MAP_UARTFIFOLevelSet(g_ui32Base, UART_TX_FIFO_LEVEL, UART_RX_FIFO_LEVEL);
 
     //
     // Flush both the buffers.
@@ -406,6 +446,42 @@ UARTStdioConfig(uint32_t ui32PortNum, uint32_t ui32Baud, uint32_t ui32SrcClock)
     MAP_UARTEnable(g_ui32Base);
 }
 
+//*****************************************************************************
+//
+//! Changes the bit rate of the UART console.
+//!
+//! \param ui32Baud is the new bit rate.
+//! \param ui32SrcClock is the frequency of the source clock for the UART
+//! module.
+//!
+//! Waits for everything already written to be transmitted, then
+//! reconfigures the UART.  Bit rates above 1/16 of the source clock use the
+//! high speed (8x) divider.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTStdioSetBaud(uint32_t ui32Baud, uint32_t ui32SrcClock)
+{
+    ASSERT(g_ui32Base != 0);
+
+#ifdef UART_BUFFERED
+    UARTFlushTx(false);
+#endif
+
+    //
+    // Let the last character leave the shift register.
+    //
+    while(MAP_UARTBusy(g_ui32Base))
+    {
+    }
+
+    MAP_UARTConfigSetExpClk(g_ui32Base, ui32SrcClock, ui32Baud,
+                            (UART_CONFIG_PAR_NONE | UART_CONFIG_STOP_ONE |
+                             UART_CONFIG_WLEN_8));
+}
+
 //*****************************************************************************
 //
 //! Writes a string of characters to the UART output.
@@ -1325,6 +1401,32 @@ UARTRxBytesAvail(void)
 }
 #endif
 
+#if defined(UART_BUFFERED) || defined(DOXYGEN)
+//*****************************************************************************
+//
+//! Returns the UART interrupt and byte counts.
+//!
+//! \param pui32Ints receives the number of UART interrupts taken.
+//! \param pui32TxBytes receives the number of bytes moved into the TX FIFO.
+//! \param pui32RxBytes receives the number of bytes read from the RX FIFO.
+//!
+//! This function, available only when the module is built to operate in
+//! buffered mode using \b UART_BUFFERED, may be used to measure interrupts
+//! per byte.  The counts wrap at 2^32.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+UARTStdioGetCounts(uint32_t *pui32Ints, uint32_t *pui32TxBytes,
+                   uint32_t *pui32RxBytes)
+{
+    *pui32Ints = g_ui32UARTIntCount;
+    *pui32TxBytes = g_ui32UARTTxByteCount;
+    *pui32RxBytes = g_ui32UARTRxByteCount;
+}
+#endif
+
 #if defined(UART_BUFFERED) || defined(DOXYGEN)
 //*****************************************************************************
 //
@@ -1559,6 +1661,7 @@ UARTStdioIntHandler(void)
     //
     ui32Ints = MAP_UARTIntStatus(g_ui32Base, true);
     MAP_UARTIntClear(g_ui32Base, ui32Ints);
+    g_ui32UARTIntCount++;
 
     //
     // Are we being interrupted because the TX FIFO has space available?
@@ -1594,6 +1697,7 @@ UARTStdioIntHandler(void)
             //
             i32Char = MAP_UARTCharGetNonBlocking(g_ui32Base);
             cChar = (unsigned char)(i32Char & 0xFF);
+            g_ui32UARTRxByteCount++;
 
             //
             // If echo is disabled, we skip the various text filtering
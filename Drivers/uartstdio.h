@@ -65,6 +65,7 @@ extern unsigned char UARTgetc(void);
 extern void UARTprintf(const char *pcString, ...);
 extern void UARTvprintf(const char *pcString, va_list vaArgP);
 extern int UARTwrite(const char *pcBuf, uint32_t ui32Len);
+extern void UARTStdioSetBaud(uint32_t ui32Baud, uint32_t ui32SrcClock);
 #ifdef UART_BUFFERED
 extern int UARTPeek(unsigned char ucChar);
 extern void UARTFlushTx(bool bDiscard);
@@ -72,6 +73,8 @@ extern void UARTFlushRx(void);
 extern int UARTRxBytesAvail(void);
 extern int UARTTxBytesFree(void);
 extern void UARTEchoSet(bool bEnable);
+extern void UARTStdioGetCounts(uint32_t *pui32Ints, uint32_t *pui32TxBytes,
+                               uint32_t *pui32RxBytes);
 #endif
 
 //*****************************************************************************
@@ -31,44 +31,81 @@
 #include "driverlib/pin_map.h"
 #include "driverlib/sysctl.h"
 
+#include "Drivers/Critical_Monitor.h"
 #include "Drivers/I2C7_Handler.h"
+#include "Drivers/ISR_Accounting.h"
 #include "Drivers/Processor_Initialization.h"
+#include "Drivers/Trace_Recorder.h"
 #include "Drivers/UARTStdio_Initialization.h"
 #include "Drivers/uartstdio.h"
 
+#include "Tasks/Kernel_Benchmark.h"
+#include "Tasks/Log.h"
+#include "Tasks/Startup_Sync.h"
+
 #include "FreeRTOS.h"
 #include "task.h"
 
-extern void Task_Blink_LED_PortN_1(void *pvParameters);
-extern void Task_ReportTime(void *pvParameters);
+extern void Blink_LED_PortN_1_Start(void);
 extern void Task_ReportData(void *pvParameters);
 extern void Task_ProgramTrace(void *pvParameters);
-extern void Task_BMP180_Handler(void *pvParameters);
-extern void Task_MPU9150_Handler(void *pvParameters);
+extern void BMP180_Handler_Start(void);
+extern void MPU9150_Handler_Start(void);
+extern void Task_Console(void *pvParameters);
+extern void Task_Metrics(void *pvParameters);
 
 int main(void) {
   Processor_Initialization();
   UARTStdio_Initialization();
 
-  // Create a task to blink LED, PortN_1
-  xTaskCreate(Task_Blink_LED_PortN_1, "Blinky", 32, NULL, 1, NULL);
+  // Count and time the SysTick interrupt. Drivers account their own.
+  ISRAccounting_Initialization();
+
+#if ( configUSE_CRITICAL_MONITOR == 1 )
+  // Time masked periods of the critical section macros
+  CriticalMonitor_Initialization();
+#endif
+
+  // Start-up barrier that subsystems signal once they are ready
+  Startup_Initialization();
+
+  // Console output is written a line at a time; interrupt handlers queue
+  // their lines for the Log task
+  Log_Initialization();
+  xTaskCreate(Task_Log, "Log", 256, NULL, 1, NULL);
 
   // Create a task to report data.
   xTaskCreate(Task_ReportData, "ReportData", 512, NULL, 1, NULL);
 
-  // Create a task to report SysTickCount
-  xTaskCreate(Task_ReportTime, "ReportTime", 512, NULL, 1, NULL);
-
   // Create a task to program trace
   xTaskCreate(Task_ProgramTrace, "Trace", 512, NULL, 1, NULL);
 
-  // Create a task to report temperature and pressure
-  xTaskCreate(Task_BMP180_Handler, "Pressure", 512, NULL, 1, NULL);
+  // The LED toggles from a software timer. The sensors are state machines
+  // run by the Acquisition task (see Acquisition_Scheduler.h).
+  Blink_LED_PortN_1_Start();
+  BMP180_Handler_Start();
+  MPU9150_Handler_Start();
+
+  // Create a task to report the metrics registry
+  xTaskCreate(Task_Metrics, "Metrics", 256, NULL, 1, NULL);
+
+  // Create a task to read console commands
+  xTaskCreate(Task_Console, "Console", 512, NULL, 1, NULL);
+
+#ifdef KERNEL_BENCHMARK
+  // Time the kernel primitives once ReportData is up, and on "bench"
+  xTaskCreate(Task_KernelBenchmark, "Benchmark", 512, NULL, KERNEL_BENCHMARK_PRIORITY, NULL);
+#endif
+
+  Log_Printf("FreeRTOS Starting!\n");
 
-  // Create a task to report acceleration and gyroscope
-  xTaskCreate(Task_MPU9150_Handler, "Accelerometer", 512, NULL, 1, NULL);
+#if ( configUSE_TRACE_RECORDER == 1 )
+  // Record from the first task switch, "trace start" clears and restarts
+  TraceRecorder_Start();
 
-  UARTprintf("FreeRTOS Starting!\n");
+  // Sends the ring to the console while "trace stream on"
+  xTaskCreate(Task_TraceStream, "TraceStream", 256, NULL, 1, NULL);
+#endif
 
   //Start FreeRTOS Task Scheduler
   vTaskStartScheduler();
@@ -347,6 +347,60 @@ void vCoRoutineSchedule( void )
 }
 /*-----------------------------------------------------------*/
 
+TickType_t xCoRoutineGetTicksToNextWake( void )
+{
+TickType_t xTicksToWake, xTicksBehind;
+UBaseType_t uxPriority;
+
+	/* A co-routine readied by an interrupt still has to be moved to the ready
+	lists.  An interrupt that readies one after this check must also wake the
+	task that runs the co-routines, as this function cannot see it. */
+	if( listLIST_IS_EMPTY( &xPendingReadyCoRoutineList ) == pdFALSE )
+	{
+		return ( TickType_t ) 0;
+	}
+
+	for( uxPriority = 0; uxPriority < configMAX_CO_ROUTINE_PRIORITIES; uxPriority++ )
+	{
+		if( listLIST_IS_EMPTY( &( pxReadyCoRoutineLists[ uxPriority ] ) ) == pdFALSE )
+		{
+			return ( TickType_t ) 0;
+		}
+	}
+
+	/* No co-routine has been created yet. */
+	if( pxDelayedCoRoutineList == NULL )
+	{
+		return portMAX_DELAY;
+	}
+
+	/* Wake times in the overflow list are after the tick count overflows, so
+	the unsigned difference is the wait in either list. */
+	if( listLIST_IS_EMPTY( pxDelayedCoRoutineList ) == pdFALSE )
+	{
+		xTicksToWake = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedCoRoutineList ) - xCoRoutineTickCount;
+	}
+	else if( listLIST_IS_EMPTY( pxOverflowDelayedCoRoutineList ) == pdFALSE )
+	{
+		xTicksToWake = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxOverflowDelayedCoRoutineList ) - xCoRoutineTickCount;
+	}
+	else
+	{
+		return portMAX_DELAY;
+	}
+
+	/* The ticks that passed while the last co-routine ran count towards the
+	wait. */
+	xTicksBehind = xTaskGetTickCount() - xLastTickCount;
+	if( xTicksBehind >= xTicksToWake )
+	{
+		return ( TickType_t ) 0;
+	}
+
+	return xTicksToWake - xTicksBehind;
+}
+/*-----------------------------------------------------------*/
+
 static void prvInitialiseCoRoutineLists( void )
 {
 UBaseType_t uxPriority;
@@ -287,6 +287,14 @@ extern "C" {
 		#error If configUSE_TIMERS is set to 1 then configTIMER_TASK_STACK_DEPTH must also be defined.
 	#endif /* configTIMER_TASK_STACK_DEPTH */
 
+	#ifndef configUSE_TIMER_WHEEL
+		#define configUSE_TIMER_WHEEL 0
+	#endif /* configUSE_TIMER_WHEEL */
+
+	#ifndef configTIMER_WHEEL_LEVELS
+		#define configTIMER_WHEEL_LEVELS 4
+	#endif /* configTIMER_WHEEL_LEVELS */
+
 #endif /* configUSE_TIMERS */
 
 #ifndef INCLUDE_xTaskGetSchedulerState
@@ -331,6 +339,12 @@ extern "C" {
 	#define portPOINTER_SIZE_TYPE uint32_t
 #endif
 
+#ifndef configUSE_TRACE_RECORDER
+	/* Set to 1 in FreeRTOSConfig.h, which then includes the header that
+	defines the recorder's trace macros. */
+	#define configUSE_TRACE_RECORDER 0
+#endif
+
 /* Remove any unused trace macros. */
 #ifndef traceSTART
 	/* Used to perform any necessary initialisation - for example, open a file
@@ -519,6 +533,12 @@ extern "C" {
 	#define traceTASK_DELAY_UNTIL()
 #endif
 
+#ifndef traceTASK_DEADLINE_MISSED
+	/* Called by vTaskWaitForNextPeriod() when the job of pxTCB completed after
+	its deadline. */
+	#define traceTASK_DEADLINE_MISSED( pxTCB )
+#endif
+
 #ifndef traceTASK_DELAY
 	#define traceTASK_DELAY()
 #endif
@@ -777,6 +797,38 @@ extern "C" {
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
 
+#ifndef configUSE_DELAYED_TASK_HEAP
+	/* Set to 1 to keep delayed tasks in binary heaps rather than sorted lists,
+	see tasks.c. */
+	#define configUSE_DELAYED_TASK_HEAP 0
+#endif
+
+#ifndef configUSE_EDF_SCHEDULING
+	/* Set to 1 to schedule the tasks at configEDF_PRIORITY earliest deadline
+	first, see vTaskSetPeriod() in task.h. */
+	#define configUSE_EDF_SCHEDULING 0
+#endif
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+	#ifndef configEDF_PRIORITY
+		/* The highest priority the timer service task does not use.  The two
+		must differ, tasks.c checks it. */
+		#if ( configUSE_TIMERS == 1 )
+			#define configEDF_PRIORITY ( ( ( configMAX_PRIORITIES - 1 ) == ( configTIMER_TASK_PRIORITY ) ) ? ( configMAX_PRIORITIES - 2 ) : ( configMAX_PRIORITIES - 1 ) )
+		#else
+			#define configEDF_PRIORITY ( configMAX_PRIORITIES - 1 )
+		#endif
+	#endif
+#endif
+
+#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+	#ifndef configDELAYED_TASK_HEAP_SIZE
+		/* The most tasks that can exist at once, the idle and timer service
+		tasks included.  xTaskCreate() asserts it is not exceeded. */
+		#define configDELAYED_TASK_HEAP_SIZE 256
+	#endif
+#endif
+
 #ifndef portTICK_TYPE_IS_ATOMIC
 	#define portTICK_TYPE_IS_ATOMIC 0
 #endif
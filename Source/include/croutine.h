@@ -283,6 +283,38 @@ void vCoRoutineSchedule( void );
 #define crSET_STATE0( xHandle ) ( ( CRCB_t * )( xHandle ) )->uxState = (__LINE__ * 2); return; case (__LINE__ * 2):
 #define crSET_STATE1( xHandle ) ( ( CRCB_t * )( xHandle ) )->uxState = ((__LINE__ * 2)+1); return; case ((__LINE__ * 2)+1):
 
+/**
+ * croutine. h
+ *<pre>
+ TickType_t xCoRoutineGetTicksToNextWake( void );</pre>
+ *
+ * Ticks until vCoRoutineSchedule() next has a co-routine to run, so the task
+ * that calls vCoRoutineSchedule() can block instead of polling it.  Must be
+ * called from that task.
+ *
+ * A co-routine readied from an interrupt (crQUEUE_SEND_FROM_ISR() for
+ * example) is not seen if the interrupt occurs after the call, so such an
+ * interrupt must also unblock the task, with vTaskNotifyGiveFromISR() if the
+ * task blocks in ulTaskNotifyTake().
+ *
+ * @return 0 if a co-routine is ready to run, portMAX_DELAY if no co-routine is
+ * delayed either, otherwise the ticks until the first delayed co-routine wakes.
+ *
+ * Example usage:
+   <pre>
+ void vCoRoutineTask( void *pvParameters )
+ {
+     for( ;; )
+     {
+         vCoRoutineSchedule();
+         ( void ) ulTaskNotifyTake( pdTRUE, xCoRoutineGetTicksToNextWake() );
+     }
+ }</pre>
+ * \defgroup xCoRoutineGetTicksToNextWake xCoRoutineGetTicksToNextWake
+ * \ingroup Tasks
+ */
+TickType_t xCoRoutineGetTicksToNextWake( void );
+
 /**
  * croutine. h
  *<pre>
@@ -912,6 +912,77 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue, void * const pvBuffer ) PRIV
  */
 BaseType_t xQueueGenericReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait, const BaseType_t xJustPeek ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendMultiple(
+								QueueHandle_t xQueue,
+								const void * const pvItemsToQueue,
+								UBaseType_t uxItemCount,
+								TickType_t xTicksToWait
+							 );
+ * </pre>
+ *
+ * Post up to uxItemCount items to the back of a queue within a single
+ * critical section.  Each task waiting to receive is unblocked at most once
+ * per item posted, so with one receiver there is one wake up however many
+ * items are posted.  Must not be called from an interrupt service routine,
+ * or on a mutex, semaphore or a queue that is a member of a queue set.
+ *
+ * Interrupts stay masked while all the items are copied, so callers should
+ * limit uxItemCount to what they are prepared to mask interrupts for.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to uxItemCount consecutive items.
+ *
+ * @param uxItemCount The number of items to post.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space on the queue, should the queue be full.  Once there is
+ * space, as many items as fit are posted and the call returns.
+ *
+ * @return The number of items posted, from the start of pvItemsToQueue.  0
+ * if the queue stayed full.
+ *
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItemsToQueue, const UBaseType_t uxItemCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueReceiveMultiple(
+									QueueHandle_t xQueue,
+									void * const pvBuffer,
+									UBaseType_t uxMaxItems,
+									TickType_t xTicksToWait
+								);
+ * </pre>
+ *
+ * Receive up to uxMaxItems items from a queue within a single critical
+ * section.  Each task waiting to send is unblocked at most once per item
+ * removed.  The same restrictions as xQueueSendMultiple() apply.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to room for uxMaxItems items.
+ *
+ * @param uxMaxItems The most items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item, should the queue be empty.  Once there are items, as
+ * many as are queued (up to uxMaxItems) are received and the call returns.
+ *
+ * @return The number of items received.  0 if the queue stayed empty.
+ *
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * queue. h
  * <pre>UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue );</pre>
@@ -613,6 +613,93 @@ void vTaskDelay( const TickType_t xTicksToDelay ) PRIVILEGED_FUNCTION;
  */
 void vTaskDelayUntil( TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>void vTaskSetPeriod( const TickType_t xPeriod, const TickType_t xRelativeDeadline );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Make the calling task periodic, with its first job released now.  The task
+ * must run at configEDF_PRIORITY, which defaults to the highest priority
+ * not used by the timer service task.  Tasks at that priority are scheduled
+ * earliest deadline first rather than round robin: the ready task whose
+ * current job has the earliest absolute deadline runs.  A task at
+ * configEDF_PRIORITY that has not called vTaskSetPeriod() (for example one
+ * that inherited the priority through a mutex) runs before all of them.
+ *
+ * Tasks at other priorities are scheduled by fixed priority as usual, below
+ * or above the deadline scheduled tasks depending on configEDF_PRIORITY.
+ *
+ * A task whose job becomes ready with an earlier deadline than the running
+ * one preempts it at the next tick (configUSE_TIME_SLICING must be 1), or
+ * sooner if the running task blocks.  Deadlines are compared as tick counts,
+ * so the order may be wrong for jobs whose deadlines straddle a tick count
+ * overflow.
+ *
+ * @param xPeriod The number of ticks between job releases.
+ *
+ * @param xRelativeDeadline The number of ticks after its release by which
+ * each job must complete.
+ *
+ * Example usage:
+   <pre>
+ void vSensorTask( void * pvParameters )
+ {
+	 // 50 ticks between samples, each due 40 ticks after it is released.
+	 vTaskSetPeriod( 50, 40 );
+
+	 for( ;; )
+	 {
+		 // Take and process a sample.
+
+		 vTaskWaitForNextPeriod();
+	 }
+ }
+   </pre>
+ * \defgroup vTaskSetPeriod vTaskSetPeriod
+ * \ingroup TaskCtrl
+ */
+void vTaskSetPeriod( const TickType_t xPeriod, const TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskWaitForNextPeriod( void );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Complete the current job of a task made periodic by vTaskSetPeriod(), and
+ * block until the next job is released.  If the job completed after its
+ * deadline the task's deadline miss count is incremented and
+ * traceTASK_DEADLINE_MISSED() is called.  If the next job has already been
+ * released, because this one ran late, the function returns without
+ * blocking once the next job is the earliest deadline, as vTaskDelayUntil()
+ * does.
+ *
+ * \defgroup vTaskWaitForNextPeriod vTaskWaitForNextPeriod
+ * \ingroup TaskCtrl
+ */
+void vTaskWaitForNextPeriod( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>UBaseType_t uxTaskGetDeadlineMisses( TaskHandle_t xTask );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xTask Handle of the task to be queried.  Passing a NULL handle
+ * queries the calling task.
+ *
+ * @return The number of jobs of xTask that completed after their deadline
+ * since it last called vTaskSetPeriod().
+ *
+ * \defgroup uxTaskGetDeadlineMisses uxTaskGetDeadlineMisses
+ * \ingroup TaskCtrl
+ */
+UBaseType_t uxTaskGetDeadlineMisses( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <pre>UBaseType_t uxTaskPriorityGet( TaskHandle_t xTask );</pre>
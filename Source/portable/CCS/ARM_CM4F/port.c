@@ -83,6 +83,10 @@
 #include "FreeRTOS.h"
 #include "task.h"
 
+#if ( configUSE_CRITICAL_MONITOR == 1 )
+	#include "Drivers/Critical_Monitor.h"
+#endif
+
 #ifndef __TI_VFP_SUPPORT__
 #error This port can only be used when the project options are configured to enable hardware floating point support.
 #endif
@@ -376,11 +380,64 @@ void vPortExitCritical( void )
 
     if ( uxCriticalNesting == 0 )
     {
+        #if ( configUSE_CRITICAL_MONITOR == 1 )
+        {
+            CriticalMonitor_End();
+        }
+        #endif
+
         portENABLE_INTERRUPTS();
     }
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_CRITICAL_MONITOR == 1 )
+
+void vPortEnterCriticalAt( const char *pcFile, uint32_t ulLine )
+{
+    vPortEnterCritical();
+
+    /* Only the outermost critical section is timed.  Before the scheduler
+    starts uxCriticalNesting is not counted from 0, so nothing is timed. */
+    if ( uxCriticalNesting == 1 )
+    {
+        CriticalMonitor_Begin( pcFile, ulLine );
+    }
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPortSetInterruptMaskAt( const char *pcFile, uint32_t ulLine )
+{
+uint32_t ulOriginalMask;
+
+    ulOriginalMask = _set_interrupt_priority( configMAX_SYSCALL_INTERRUPT_PRIORITY );
+    __asm( "	dsb" );
+    __asm( "	isb" );
+
+    /* Interrupts were unmasked, so this starts a masked period.  Otherwise
+    the mask is nested in a critical section or another mask. */
+    if ( ulOriginalMask == 0 )
+    {
+        CriticalMonitor_Begin( pcFile, ulLine );
+    }
+
+    return ulOriginalMask;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( uint32_t ulNewMask )
+{
+    if ( ulNewMask == 0 )
+    {
+        CriticalMonitor_End();
+    }
+
+    _set_interrupt_priority( ulNewMask );
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_CRITICAL_MONITOR */
+
 //
 //--GJM	B60212 --	Add a SysTickCount that is available to
 //--GJM				other parts of the application.
@@ -388,10 +445,20 @@ void vPortExitCritical( void )
 //
 extern uint32_t xPortSysTickCount = 0;
 
+//
+//	Number of times xPortSysTickCount has wrapped, the high word of
+//	a 64-bit tick count (see Drivers/Timestamp.h).
+//
+extern volatile uint32_t xPortSysTickCountHigh = 0;
+
 void xPortSysTickHandler( void )
 {
 
 	xPortSysTickCount++;			//	GJM -- B60212
+	if( xPortSysTickCount == 0 )
+	{
+		xPortSysTickCountHigh++;
+	}
 
     /* The SysTick runs at the lowest interrupt priority, so when this interrupt
     executes all interrupts must be unmasked.  There is therefore no need to
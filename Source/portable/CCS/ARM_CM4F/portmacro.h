@@ -175,10 +175,35 @@ extern void vPortExitCritical( void );
 }
 
 #define portENABLE_INTERRUPTS()                 _set_interrupt_priority( 0 )
+
+/* When set to 1 the critical section and interrupt mask macros record how
+long interrupts stay masked and where the mask was set (see
+Drivers/Critical_Monitor.h).  This file is read before FreeRTOSConfig.h, so
+configUSE_CRITICAL_MONITOR must be set in the project's predefined symbols
+rather than in FreeRTOSConfig.h. */
+#ifndef configUSE_CRITICAL_MONITOR
+	#define configUSE_CRITICAL_MONITOR 0
+#endif
+
+#if ( configUSE_CRITICAL_MONITOR == 1 )
+
+extern void vPortEnterCriticalAt( const char *pcFile, uint32_t ulLine );
+extern uint32_t ulPortSetInterruptMaskAt( const char *pcFile, uint32_t ulLine );
+extern void vPortClearInterruptMask( uint32_t ulNewMask );
+
+#define portENTER_CRITICAL()                    vPortEnterCriticalAt( __FILE__, __LINE__ )
+#define portEXIT_CRITICAL()                     vPortExitCritical()
+#define portSET_INTERRUPT_MASK_FROM_ISR()       ulPortSetInterruptMaskAt( __FILE__, __LINE__ )
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)    vPortClearInterruptMask( x )
+
+#else
+
 #define portENTER_CRITICAL()                    vPortEnterCritical()
 #define portEXIT_CRITICAL()                     vPortExitCritical()
 #define portSET_INTERRUPT_MASK_FROM_ISR()       _set_interrupt_priority( configMAX_SYSCALL_INTERRUPT_PRIORITY ); __asm( "	dsb" ); __asm( "	isb" )
 #define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)    _set_interrupt_priority( x )
+
+#endif /* configUSE_CRITICAL_MONITOR */
 /*-----------------------------------------------------------*/
 
 /* Tickless idle/low power functionality. */
@@ -192,12 +192,63 @@ typedef struct tskTaskControlBlock
 		volatile eNotifyValue eNotifyState;
 	#endif
 
+	#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+		UBaseType_t		uxDelayedHeapIndex;	/*< Position of the task in the delayed task heap that xGenericListItem references, if any. */
+	#endif
+
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xPeriod;			/*< Ticks between job releases, 0 if the task is not periodic.  See vTaskSetPeriod(). */
+		TickType_t		xRelativeDeadline;	/*< Ticks from the release of a job to its deadline. */
+		TickType_t		xReleaseTime;		/*< Release time of the current job. */
+		TickType_t		xAbsoluteDeadline;	/*< Deadline of the current job, the ready list order at configEDF_PRIORITY. */
+		UBaseType_t		uxDeadlineMisses;	/*< Jobs completed after their deadline. */
+	#endif
+
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
 below to enable the use of older kernel aware debuggers. */
 typedef tskTCB TCB_t;
 
+/*
+ * The delayed task lists.  By default these are ordinary lists kept in wake
+ * time order, so adding a task walks the list.  With configUSE_DELAYED_TASK_HEAP
+ * set to 1 they are binary min-heaps of wake time instead: adding and removing
+ * a task take O(log n) and the next task to wake is always at the root.
+ *
+ * The xGenericListItem of a task in a heap references the heap as its
+ * container, so the state tests that compare a task's container against
+ * pxDelayedTaskList keep working.  The item must then be removed with
+ * taskREMOVE_STATE_LIST_ITEM() rather than uxListRemove() wherever the task
+ * might be delayed.  Tasks waking on the same tick may be readied in a
+ * different order than with the lists.
+ */
+#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+
+	typedef struct tskDelayedTaskHeap
+	{
+		UBaseType_t uxNumberOfItems;
+		TCB_t *pxTCBs[ configDELAYED_TASK_HEAP_SIZE ];
+	} DelayedTaskList_t;
+
+	#define taskDELAYED_LIST_INITIALISE( pxList )		( ( pxList )->uxNumberOfItems = ( UBaseType_t ) 0U )
+	#define taskDELAYED_LIST_IS_EMPTY( pxList )			( ( BaseType_t ) ( ( pxList )->uxNumberOfItems == ( UBaseType_t ) 0U ) )
+	#define taskDELAYED_LIST_HEAD( pxList )				( ( pxList )->pxTCBs[ 0 ] )
+	#define taskDELAYED_LIST_INSERT( pxList, pxTCB )	prvDelayedHeapInsert( ( pxList ), ( pxTCB ) )
+	#define taskREMOVE_STATE_LIST_ITEM( pxTCB )			prvRemoveStateListItem( pxTCB )
+
+#else
+
+	typedef List_t DelayedTaskList_t;
+
+	#define taskDELAYED_LIST_INITIALISE( pxList )		vListInitialise( pxList )
+	#define taskDELAYED_LIST_IS_EMPTY( pxList )			listLIST_IS_EMPTY( pxList )
+	#define taskDELAYED_LIST_HEAD( pxList )				( ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxList ) )
+	#define taskDELAYED_LIST_INSERT( pxList, pxTCB )	vListInsert( ( pxList ), &( ( pxTCB )->xGenericListItem ) )
+	#define taskREMOVE_STATE_LIST_ITEM( pxTCB )			uxListRemove( &( ( pxTCB )->xGenericListItem ) )
+
+#endif /* configUSE_DELAYED_TASK_HEAP */
+
 /*
  * Some kernel aware debuggers require the data the debugger needs access to to
  * be global, rather than file scope.
@@ -213,10 +264,10 @@ PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
 
 /* Lists for ready and blocked tasks. --------------------*/
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ];/*< Prioritised ready tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+PRIVILEGED_DATA static DelayedTaskList_t xDelayedTaskList1;						/*< Delayed tasks. */
+PRIVILEGED_DATA static DelayedTaskList_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+PRIVILEGED_DATA static DelayedTaskList_t * volatile pxDelayedTaskList;			/*< Points to the delayed task list currently being used. */
+PRIVILEGED_DATA static DelayedTaskList_t * volatile pxOverflowDelayedTaskList;	/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -315,7 +366,7 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 																										\
 		/* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of						\
 		the	same priority get an equal share of the processor time. */									\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopReadyPriority ] ) );		\
+		taskSELECT_FROM_READY_LIST( uxTopReadyPriority );												\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
 	/*-----------------------------------------------------------*/
@@ -344,7 +395,7 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 		/* Find the highest priority queue that contains ready tasks. */							\
 		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );								\
 		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
+		taskSELECT_FROM_READY_LIST( uxTopPriority );												\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 	/*-----------------------------------------------------------*/
@@ -368,10 +419,10 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 count overflows. */
 #define taskSWITCH_DELAYED_LISTS()																	\
 {																									\
-	List_t *pxTemp;																					\
+	DelayedTaskList_t *pxTemp;																		\
 																									\
 	/* The delayed tasks list should be empty when the lists are switched. */						\
-	configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );										\
+	configASSERT( ( taskDELAYED_LIST_IS_EMPTY( pxDelayedTaskList ) ) );								\
 																									\
 	pxTemp = pxDelayedTaskList;																		\
 	pxDelayedTaskList = pxOverflowDelayedTaskList;													\
@@ -382,14 +433,66 @@ count overflows. */
 
 /*-----------------------------------------------------------*/
 
+/*
+ * The ready list at configEDF_PRIORITY is kept in order of absolute deadline
+ * (held in the xGenericListItem value, which ready lists do not otherwise
+ * use), and its head is always the task selected.  Other ready lists are
+ * appended to and indexed through round robin.
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	#if ( configUSE_TIMERS == 1 )
+		/* The timer service task must not share the deadline scheduled
+		priority: it has no period, so it would be ordered among the jobs.
+		configTIMER_TASK_PRIORITY may contain a cast, which #if cannot
+		evaluate, so an array of negative size fails the build instead. */
+		typedef char EDFTimerPriorityCheck_t[ ( ( UBaseType_t ) configEDF_PRIORITY != ( UBaseType_t ) configTIMER_TASK_PRIORITY ) ? 1 : -1 ];
+	#endif
+
+	#define taskINSERT_INTO_READY_LIST( pxTCB )																	\
+		if( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY )										\
+		{																										\
+			listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xGenericListItem ), ( pxTCB )->xAbsoluteDeadline );			\
+			vListInsert( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xGenericListItem ) );	\
+		}																										\
+		else																									\
+		{																										\
+			vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xGenericListItem ) );	\
+		}
+
+	#define taskSELECT_FROM_READY_LIST( uxPriority )																\
+	{																											\
+		if( ( uxPriority ) == ( UBaseType_t ) configEDF_PRIORITY )												\
+		{																										\
+			pxCurrentTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ ( uxPriority ) ] ) );	\
+		}																										\
+		else																									\
+		{																										\
+			listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) );				\
+		}																										\
+	}
+
+#else
+
+	#define taskINSERT_INTO_READY_LIST( pxTCB )																	\
+		vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xGenericListItem ) )
+
+	#define taskSELECT_FROM_READY_LIST( uxPriority )																\
+		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+/*-----------------------------------------------------------*/
+
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * the task.  It is inserted at the end of the list, or in deadline order at
+ * configEDF_PRIORITY.
  */
 #define prvAddTaskToReadyList( pxTCB )																\
 	traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
 	taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
-	vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xGenericListItem ) )
+	taskINSERT_INTO_READY_LIST( pxTCB )
 /*-----------------------------------------------------------*/
 
 /*
@@ -501,6 +604,7 @@ static TCB_t *prvAllocateTCBAndStack( const uint16_t usStackDepth, StackType_t *
  */
 #if ( configUSE_TRACE_FACILITY == 1 )
 
+	static void prvFillTaskStatus( TaskStatus_t *pxTaskStatus, volatile TCB_t *pxTCB, eTaskState eState ) PRIVILEGED_FUNCTION;
 	static UBaseType_t prvListTaskWithinSingleList( TaskStatus_t *pxTaskStatusArray, List_t *pxList, eTaskState eState ) PRIVILEGED_FUNCTION;
 
 #endif
@@ -537,6 +641,32 @@ static TCB_t *prvAllocateTCBAndStack( const uint16_t usStackDepth, StackType_t *
  */
 static void prvResetNextTaskUnblockTime( void );
 
+#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+
+	/*
+	 * Add pxTCB to a delayed task heap, ordered by the wake time held in its
+	 * xGenericListItem, or remove it from whichever heap it is in.
+	 */
+	static void prvDelayedHeapInsert( DelayedTaskList_t * const pxHeap, TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+	static UBaseType_t prvDelayedHeapRemove( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Remove the xGenericListItem of pxTCB from the heap or list it is in.
+	 * Returns the number of items left there, as uxListRemove().
+	 */
+	static UBaseType_t prvRemoveStateListItem( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+	#if ( configUSE_TRACE_FACILITY == 1 )
+
+		/*
+		 * As prvListTaskWithinSingleList() for a delayed task heap.
+		 */
+		static UBaseType_t prvListTasksWithinDelayedHeap( TaskStatus_t *pxTaskStatusArray, DelayedTaskList_t *pxHeap ) PRIVILEGED_FUNCTION;
+
+	#endif
+
+#endif /* configUSE_DELAYED_TASK_HEAP */
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	/*
@@ -650,6 +780,14 @@ StackType_t *pxTopOfStack;
 		updated. */
 		taskENTER_CRITICAL();
 		{
+			#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+			{
+				/* Any task may be delayed at the same time as all the others,
+				so a delayed task heap must hold every task. */
+				configASSERT( uxCurrentNumberOfTasks < ( UBaseType_t ) configDELAYED_TASK_HEAP_SIZE );
+			}
+			#endif /* configUSE_DELAYED_TASK_HEAP */
+
 			uxCurrentNumberOfTasks++;
 			if( pxCurrentTCB == NULL )
 			{
@@ -755,7 +893,7 @@ StackType_t *pxTopOfStack;
 			This will stop the task from be scheduled.  The idle task will check
 			the termination list and free up any memory allocated by the
 			scheduler for the TCB and stack. */
-			if( uxListRemove( &( pxTCB->xGenericListItem ) ) == ( UBaseType_t ) 0 )
+			if( taskREMOVE_STATE_LIST_ITEM( pxTCB ) == ( UBaseType_t ) 0 )
 			{
 				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
 			}
@@ -917,6 +1055,124 @@ StackType_t *pxTopOfStack;
 #endif /* INCLUDE_vTaskDelayUntil */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	void vTaskSetPeriod( const TickType_t xPeriod, const TickType_t xRelativeDeadline )
+	{
+		configASSERT( ( xPeriod > 0U ) );
+		configASSERT( ( xRelativeDeadline > 0U ) );
+		configASSERT( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_PRIORITY );
+		configASSERT( uxSchedulerSuspended == 0 );
+
+		vTaskSuspendAll();
+		{
+			pxCurrentTCB->xPeriod = xPeriod;
+			pxCurrentTCB->xRelativeDeadline = xRelativeDeadline;
+			pxCurrentTCB->xReleaseTime = xTickCount;
+			pxCurrentTCB->xAbsoluteDeadline = pxCurrentTCB->xReleaseTime + xRelativeDeadline;
+			pxCurrentTCB->uxDeadlineMisses = ( UBaseType_t ) 0U;
+
+			/* Move to the place of the first deadline in the ready list.  The
+			ready lists are not accessed by interrupts while the scheduler is
+			suspended. */
+			if( uxListRemove( &( pxCurrentTCB->xGenericListItem ) ) == ( UBaseType_t ) 0 )
+			{
+				portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			prvAddTaskToReadyList( pxCurrentTCB );
+		}
+
+		/* A task with an earlier deadline may now be at the head. */
+		if( xTaskResumeAll() == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskWaitForNextPeriod( void )
+	{
+	TickType_t xElapsed;
+	BaseType_t xAlreadyYielded;
+
+		configASSERT( ( pxCurrentTCB->xPeriod > 0U ) );
+		configASSERT( uxSchedulerSuspended == 0 );
+
+		vTaskSuspendAll();
+		{
+			/* Ticks since the release of the job just completed.  Unsigned
+			subtraction keeps this right across a tick count overflow. */
+			xElapsed = xTickCount - pxCurrentTCB->xReleaseTime;
+
+			if( xElapsed > pxCurrentTCB->xRelativeDeadline )
+			{
+				( pxCurrentTCB->uxDeadlineMisses )++;
+				traceTASK_DEADLINE_MISSED( pxCurrentTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* The next job. */
+			pxCurrentTCB->xReleaseTime += pxCurrentTCB->xPeriod;
+			pxCurrentTCB->xAbsoluteDeadline = pxCurrentTCB->xReleaseTime + pxCurrentTCB->xRelativeDeadline;
+
+			/* Leave the ready list either to wait for the release, or to
+			return to it in the place of the new deadline. */
+			if( uxListRemove( &( pxCurrentTCB->xGenericListItem ) ) == ( UBaseType_t ) 0 )
+			{
+				portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xElapsed < pxCurrentTCB->xPeriod )
+			{
+				traceTASK_DELAY_UNTIL();
+				prvAddCurrentTaskToDelayedList( pxCurrentTCB->xReleaseTime );
+			}
+			else
+			{
+				/* The next job has been released already. */
+				prvAddTaskToReadyList( pxCurrentTCB );
+			}
+		}
+		xAlreadyYielded = xTaskResumeAll();
+
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxTaskGetDeadlineMisses( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+		return pxTCB->uxDeadlineMisses;
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskDelay == 1 )
 
 	void vTaskDelay( const TickType_t xTicksToDelay )
@@ -1006,7 +1262,7 @@ StackType_t *pxTopOfStack;
 			}
 			taskEXIT_CRITICAL();
 
-			if( ( pxStateList == pxDelayedTaskList ) || ( pxStateList == pxOverflowDelayedTaskList ) )
+			if( ( ( void * ) pxStateList == ( void * ) pxDelayedTaskList ) || ( ( void * ) pxStateList == ( void * ) pxOverflowDelayedTaskList ) )
 			{
 				/* The task being queried is referenced from one of the Blocked
 				lists. */
@@ -1295,7 +1551,7 @@ StackType_t *pxTopOfStack;
 
 			/* Remove task from the ready/delayed list and place in the
 			suspended list. */
-			if( uxListRemove( &( pxTCB->xGenericListItem ) ) == ( UBaseType_t ) 0 )
+			if( taskREMOVE_STATE_LIST_ITEM( pxTCB ) == ( UBaseType_t ) 0 )
 			{
 				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
 			}
@@ -1696,7 +1952,7 @@ BaseType_t xAlreadyYielded = pdFALSE;
 				{
 					pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) );
 					( void ) uxListRemove( &( pxTCB->xEventListItem ) );
-					( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+					( void ) taskREMOVE_STATE_LIST_ITEM( pxTCB );
 					prvAddTaskToReadyList( pxTCB );
 
 					/* If the moved task has a priority higher than the current
@@ -1852,8 +2108,17 @@ UBaseType_t uxTaskGetNumberOfTasks( void )
 
 				/* Fill in an TaskStatus_t structure with information on each
 				task in the Blocked state. */
-				uxTask += prvListTaskWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-				uxTask += prvListTaskWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+				{
+					uxTask += prvListTasksWithinDelayedHeap( &( pxTaskStatusArray[ uxTask ] ), ( DelayedTaskList_t * ) pxDelayedTaskList );
+					uxTask += prvListTasksWithinDelayedHeap( &( pxTaskStatusArray[ uxTask ] ), ( DelayedTaskList_t * ) pxOverflowDelayedTaskList );
+				}
+				#else
+				{
+					uxTask += prvListTaskWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+					uxTask += prvListTaskWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				}
+				#endif
 
 				#if( INCLUDE_vTaskDelete == 1 )
 				{
@@ -1974,7 +2239,7 @@ BaseType_t xSwitchRequired = pdFALSE;
 			{
 				for( ;; )
 				{
-					if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+					if( taskDELAYED_LIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
 					{
 						/* The delayed list is empty.  Set xNextTaskUnblockTime
 						to the maximum possible value so it is extremely
@@ -1990,7 +2255,7 @@ BaseType_t xSwitchRequired = pdFALSE;
 						item at the head of the delayed list.  This is the time
 						at which the task at the head of the delayed list must
 						be removed from the Blocked state. */
-						pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
+						pxTCB = taskDELAYED_LIST_HEAD( pxDelayedTaskList );
 						xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xGenericListItem ) );
 
 						if( xConstTickCount < xItemValue )
@@ -2009,7 +2274,7 @@ BaseType_t xSwitchRequired = pdFALSE;
 						}
 
 						/* It is time to remove the item from the Blocked state. */
-						( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+						( void ) taskREMOVE_STATE_LIST_ITEM( pxTCB );
 
 						/* Is the task waiting on an event also?  If so remove
 						it from the event list. */
@@ -2486,7 +2751,7 @@ BaseType_t xReturn;
 
 	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 	{
-		( void ) uxListRemove( &( pxUnblockedTCB->xGenericListItem ) );
+		( void ) taskREMOVE_STATE_LIST_ITEM( pxUnblockedTCB );
 		prvAddTaskToReadyList( pxUnblockedTCB );
 	}
 	else
@@ -2551,7 +2816,7 @@ BaseType_t xReturn;
 	/* Remove the task from the delayed list and add it to the ready list.  The
 	scheduler is suspended so interrupts will not be accessing the ready
 	lists. */
-	( void ) uxListRemove( &( pxUnblockedTCB->xGenericListItem ) );
+	( void ) taskREMOVE_STATE_LIST_ITEM( pxUnblockedTCB );
 	prvAddTaskToReadyList( pxUnblockedTCB );
 
 	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
@@ -2931,6 +3196,18 @@ UBaseType_t x;
 	}
 	#endif
 
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+	{
+		/* Not periodic.  A deadline of 0 places the task at the head of the
+		deadline ordered ready list should it run at configEDF_PRIORITY. */
+		pxTCB->xPeriod = ( TickType_t ) 0U;
+		pxTCB->xRelativeDeadline = ( TickType_t ) 0U;
+		pxTCB->xReleaseTime = ( TickType_t ) 0U;
+		pxTCB->xAbsoluteDeadline = ( TickType_t ) 0U;
+		pxTCB->uxDeadlineMisses = ( UBaseType_t ) 0U;
+	}
+	#endif
+
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 	{
 		/* Initialise this task's Newlib reent structure. */
@@ -3004,8 +3281,8 @@ UBaseType_t uxPriority;
 		vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
 	}
 
-	vListInitialise( &xDelayedTaskList1 );
-	vListInitialise( &xDelayedTaskList2 );
+	taskDELAYED_LIST_INITIALISE( &xDelayedTaskList1 );
+	taskDELAYED_LIST_INITIALISE( &xDelayedTaskList2 );
 	vListInitialise( &xPendingReadyList );
 
 	#if ( INCLUDE_vTaskDelete == 1 )
@@ -3076,12 +3353,12 @@ static void prvAddCurrentTaskToDelayedList( const TickType_t xTimeToWake )
 	if( xTimeToWake < xTickCount )
 	{
 		/* Wake time has overflowed.  Place this item in the overflow list. */
-		vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xGenericListItem ) );
+		taskDELAYED_LIST_INSERT( pxOverflowDelayedTaskList, pxCurrentTCB );
 	}
 	else
 	{
 		/* The wake time has not overflowed, so the current block list is used. */
-		vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xGenericListItem ) );
+		taskDELAYED_LIST_INSERT( pxDelayedTaskList, pxCurrentTCB );
 
 		/* If the task entering the blocked state was placed at the head of the
 		list of blocked tasks then xNextTaskUnblockTime needs to be updated
@@ -3173,6 +3450,67 @@ TCB_t *pxNewTCB;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	static void prvFillTaskStatus( TaskStatus_t *pxTaskStatus, volatile TCB_t *pxTCB, eTaskState eState )
+	{
+		/* See the definition of TaskStatus_t in task.h for the meaning of
+		each TaskStatus_t structure member. */
+		pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
+		pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName [ 0 ] );
+		pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
+		pxTaskStatus->eCurrentState = eState;
+		pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
+
+		#if ( INCLUDE_vTaskSuspend == 1 )
+		{
+			/* If the task is in the suspended list then there is a chance
+			it is actually just blocked indefinitely - so really it should
+			be reported as being in the Blocked state. */
+			if( eState == eSuspended )
+			{
+				if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+				{
+					pxTaskStatus->eCurrentState = eBlocked;
+				}
+			}
+		}
+		#endif /* INCLUDE_vTaskSuspend */
+
+		#if ( configUSE_MUTEXES == 1 )
+		{
+			pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
+		}
+		#else
+		{
+			pxTaskStatus->uxBasePriority = 0;
+		}
+		#endif
+
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+		}
+		#else
+		{
+			pxTaskStatus->ulRunTimeCounter = 0;
+		}
+		#endif
+
+		#if ( portSTACK_GROWTH > 0 )
+		{
+			pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
+		}
+		#else
+		{
+			pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
+		}
+		#endif
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TRACE_FACILITY == 1 )
 
 	static UBaseType_t prvListTaskWithinSingleList( TaskStatus_t *pxTaskStatusArray, List_t *pxList, eTaskState eState )
@@ -3192,57 +3530,7 @@ TCB_t *pxNewTCB;
 			{
 				listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList );
 
-				pxTaskStatusArray[ uxTask ].xHandle = ( TaskHandle_t ) pxNextTCB;
-				pxTaskStatusArray[ uxTask ].pcTaskName = ( const char * ) &( pxNextTCB->pcTaskName [ 0 ] );
-				pxTaskStatusArray[ uxTask ].xTaskNumber = pxNextTCB->uxTCBNumber;
-				pxTaskStatusArray[ uxTask ].eCurrentState = eState;
-				pxTaskStatusArray[ uxTask ].uxCurrentPriority = pxNextTCB->uxPriority;
-
-				#if ( INCLUDE_vTaskSuspend == 1 )
-				{
-					/* If the task is in the suspended list then there is a chance
-					it is actually just blocked indefinitely - so really it should
-					be reported as being in the Blocked state. */
-					if( eState == eSuspended )
-					{
-						if( listLIST_ITEM_CONTAINER( &( pxNextTCB->xEventListItem ) ) != NULL )
-						{
-							pxTaskStatusArray[ uxTask ].eCurrentState = eBlocked;
-						}
-					}
-				}
-				#endif /* INCLUDE_vTaskSuspend */
-
-				#if ( configUSE_MUTEXES == 1 )
-				{
-					pxTaskStatusArray[ uxTask ].uxBasePriority = pxNextTCB->uxBasePriority;
-				}
-				#else
-				{
-					pxTaskStatusArray[ uxTask ].uxBasePriority = 0;
-				}
-				#endif
-
-				#if ( configGENERATE_RUN_TIME_STATS == 1 )
-				{
-					pxTaskStatusArray[ uxTask ].ulRunTimeCounter = pxNextTCB->ulRunTimeCounter;
-				}
-				#else
-				{
-					pxTaskStatusArray[ uxTask ].ulRunTimeCounter = 0;
-				}
-				#endif
-
-				#if ( portSTACK_GROWTH > 0 )
-				{
-					pxTaskStatusArray[ uxTask ].usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxNextTCB->pxEndOfStack );
-				}
-				#else
-				{
-					pxTaskStatusArray[ uxTask ].usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxNextTCB->pxStack );
-				}
-				#endif
-
+				prvFillTaskStatus( &( pxTaskStatusArray[ uxTask ] ), pxNextTCB, eState );
 				uxTask++;
 
 			} while( pxNextTCB != pxFirstTCB );
@@ -3348,7 +3636,7 @@ static void prvResetNextTaskUnblockTime( void )
 {
 TCB_t *pxTCB;
 
-	if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+	if( taskDELAYED_LIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
 	{
 		/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
 		the maximum possible value so it is	extremely unlikely that the
@@ -3362,12 +3650,169 @@ TCB_t *pxTCB;
 		the item at the head of the delayed list.  This is the time at
 		which the task at the head of the delayed list should be removed
 		from the Blocked state. */
-		( pxTCB ) = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
+		( pxTCB ) = taskDELAYED_LIST_HEAD( pxDelayedTaskList );
 		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xGenericListItem ) );
 	}
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+
+	/* The wake time a delayed task heap is ordered by. */
+	#define prvHEAP_KEY( pxHeap, uxIndex ) listGET_LIST_ITEM_VALUE( &( ( pxHeap )->pxTCBs[ ( uxIndex ) ]->xGenericListItem ) )
+
+	/* Place pxTCB at uxIndex of pxHeap. */
+	#define prvHEAP_SET( pxHeap, uxIndex, pxTCB )			\
+	{														\
+		( pxHeap )->pxTCBs[ ( uxIndex ) ] = ( pxTCB );		\
+		( pxTCB )->uxDelayedHeapIndex = ( uxIndex );		\
+	}
+
+	static void prvDelayedHeapSiftUp( DelayedTaskList_t * const pxHeap, UBaseType_t uxIndex )
+	{
+	TCB_t * const pxTCB = pxHeap->pxTCBs[ uxIndex ];
+	const TickType_t xKey = listGET_LIST_ITEM_VALUE( &( pxTCB->xGenericListItem ) );
+	UBaseType_t uxParent;
+
+		/* Move parents that wake later down until pxTCB's place is found. */
+		while( uxIndex > ( UBaseType_t ) 0U )
+		{
+			uxParent = ( uxIndex - ( UBaseType_t ) 1U ) >> 1;
+
+			if( prvHEAP_KEY( pxHeap, uxParent ) <= xKey )
+			{
+				break;
+			}
+
+			prvHEAP_SET( pxHeap, uxIndex, pxHeap->pxTCBs[ uxParent ] );
+			uxIndex = uxParent;
+		}
+
+		prvHEAP_SET( pxHeap, uxIndex, pxTCB );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvDelayedHeapSiftDown( DelayedTaskList_t * const pxHeap, UBaseType_t uxIndex )
+	{
+	TCB_t * const pxTCB = pxHeap->pxTCBs[ uxIndex ];
+	const TickType_t xKey = listGET_LIST_ITEM_VALUE( &( pxTCB->xGenericListItem ) );
+	UBaseType_t uxChild;
+
+		for( ;; )
+		{
+			uxChild = ( uxIndex << 1 ) + ( UBaseType_t ) 1U;
+
+			if( uxChild >= pxHeap->uxNumberOfItems )
+			{
+				break;
+			}
+
+			/* The earlier waking of the two children. */
+			if( ( ( uxChild + ( UBaseType_t ) 1U ) < pxHeap->uxNumberOfItems ) && ( prvHEAP_KEY( pxHeap, uxChild + ( UBaseType_t ) 1U ) < prvHEAP_KEY( pxHeap, uxChild ) ) )
+			{
+				uxChild++;
+			}
+
+			if( xKey <= prvHEAP_KEY( pxHeap, uxChild ) )
+			{
+				break;
+			}
+
+			prvHEAP_SET( pxHeap, uxIndex, pxHeap->pxTCBs[ uxChild ] );
+			uxIndex = uxChild;
+		}
+
+		prvHEAP_SET( pxHeap, uxIndex, pxTCB );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvDelayedHeapInsert( DelayedTaskList_t * const pxHeap, TCB_t * const pxTCB )
+	{
+		configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xGenericListItem ) ) == NULL );
+
+		/* Each task is in at most one heap, and xTaskGenericCreate() does not
+		create more tasks than a heap holds, so there is always room. */
+		configASSERT( pxHeap->uxNumberOfItems < ( UBaseType_t ) configDELAYED_TASK_HEAP_SIZE );
+
+		/* The heap stands in for the list the item would be in. */
+		pxTCB->xGenericListItem.pvContainer = ( void * ) pxHeap;
+
+		pxHeap->pxTCBs[ pxHeap->uxNumberOfItems ] = pxTCB;
+		( pxHeap->uxNumberOfItems )++;
+		prvDelayedHeapSiftUp( pxHeap, pxHeap->uxNumberOfItems - ( UBaseType_t ) 1U );
+	}
+	/*-----------------------------------------------------------*/
+
+	static UBaseType_t prvDelayedHeapRemove( TCB_t * const pxTCB )
+	{
+	DelayedTaskList_t * const pxHeap = ( DelayedTaskList_t * ) listLIST_ITEM_CONTAINER( &( pxTCB->xGenericListItem ) );
+	const UBaseType_t uxIndex = pxTCB->uxDelayedHeapIndex;
+	TCB_t *pxLast;
+
+		configASSERT( pxHeap->pxTCBs[ uxIndex ] == pxTCB );
+
+		( pxHeap->uxNumberOfItems )--;
+		pxTCB->xGenericListItem.pvContainer = NULL;
+
+		/* Fill the hole with the last task, then restore the order around
+		it.  It can only need to move one way. */
+		if( uxIndex != pxHeap->uxNumberOfItems )
+		{
+			pxLast = pxHeap->pxTCBs[ pxHeap->uxNumberOfItems ];
+			prvHEAP_SET( pxHeap, uxIndex, pxLast );
+
+			if( ( uxIndex > ( UBaseType_t ) 0U ) && ( listGET_LIST_ITEM_VALUE( &( pxLast->xGenericListItem ) ) < prvHEAP_KEY( pxHeap, ( uxIndex - ( UBaseType_t ) 1U ) >> 1 ) ) )
+			{
+				prvDelayedHeapSiftUp( pxHeap, uxIndex );
+			}
+			else
+			{
+				prvDelayedHeapSiftDown( pxHeap, uxIndex );
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxHeap->uxNumberOfItems;
+	}
+	/*-----------------------------------------------------------*/
+
+	static UBaseType_t prvRemoveStateListItem( TCB_t * const pxTCB )
+	{
+	void * const pvContainer = listLIST_ITEM_CONTAINER( &( pxTCB->xGenericListItem ) );
+
+		if( ( pvContainer == ( void * ) &xDelayedTaskList1 ) || ( pvContainer == ( void * ) &xDelayedTaskList2 ) )
+		{
+			return prvDelayedHeapRemove( pxTCB );
+		}
+		else
+		{
+			return uxListRemove( &( pxTCB->xGenericListItem ) );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	#if ( configUSE_TRACE_FACILITY == 1 )
+
+		static UBaseType_t prvListTasksWithinDelayedHeap( TaskStatus_t *pxTaskStatusArray, DelayedTaskList_t *pxHeap )
+		{
+		UBaseType_t uxTask;
+
+			for( uxTask = 0; uxTask < pxHeap->uxNumberOfItems; uxTask++ )
+			{
+				prvFillTaskStatus( &( pxTaskStatusArray[ uxTask ] ), pxHeap->pxTCBs[ uxTask ], eBlocked );
+			}
+
+			return uxTask;
+		}
+
+	#endif /* configUSE_TRACE_FACILITY */
+
+#endif /* configUSE_DELAYED_TASK_HEAP */
+/*-----------------------------------------------------------*/
+
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
 
 	TaskHandle_t xTaskGetCurrentTaskHandle( void )
@@ -4194,7 +4639,7 @@ TickType_t uxReturn;
 			notification then unblock it now. */
 			if( eOriginalNotifyState == eWaitingNotification )
 			{
-				( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+				( void ) taskREMOVE_STATE_LIST_ITEM( pxTCB );
 				prvAddTaskToReadyList( pxTCB );
 
 				/* The task should not have been on an event list. */
@@ -4324,7 +4769,7 @@ TickType_t uxReturn;
 
 				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 				{
-					( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+					( void ) taskREMOVE_STATE_LIST_ITEM( pxTCB );
 					prvAddTaskToReadyList( pxTCB );
 				}
 				else
@@ -4407,7 +4852,7 @@ TickType_t uxReturn;
 
 				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 				{
-					( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+					( void ) taskREMOVE_STATE_LIST_ITEM( pxTCB );
 					prvAddTaskToReadyList( pxTCB );
 				}
 				else
@@ -100,6 +100,45 @@ configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
 /* Misc definitions. */
 #define tmrNO_DELAY		( TickType_t ) 0U
 
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+	/* Each level of the timing wheel has 32 slots so the occupied slots of a
+	level fit in one 32-bit word.  Level n slots are 32^n ticks wide, so with
+	the default of 4 levels timers up to 2^20 ticks away are held in the
+	wheel.  Timers further away wait in xTimerWheelFarList. */
+	#define tmrWHEEL_SLOT_BITS			( 5U )
+	#define tmrWHEEL_SLOTS				( 1U << tmrWHEEL_SLOT_BITS )
+	#define tmrWHEEL_SLOT_MASK			( tmrWHEEL_SLOTS - 1U )
+	#define tmrWHEEL_LEVEL_SHIFT( uxLevel )	( ( uxLevel ) * tmrWHEEL_SLOT_BITS )
+	#define tmrWHEEL_LEVEL_SPAN( uxLevel )	( ( TickType_t ) 1U << tmrWHEEL_LEVEL_SHIFT( uxLevel ) )
+
+	#if ( configTIMER_WHEEL_LEVELS < 1 )
+		#error configTIMER_WHEEL_LEVELS must be at least 1.
+	#endif
+
+	#if ( configUSE_16_BIT_TICKS == 1 ) && ( configTIMER_WHEEL_LEVELS > 3 )
+		#error configTIMER_WHEEL_LEVELS cannot be more than 3 when configUSE_16_BIT_TICKS is 1.
+	#endif
+
+	#if ( configTIMER_WHEEL_LEVELS > 6 )
+		#error configTIMER_WHEEL_LEVELS cannot be more than 6 with a 32-bit tick count.
+	#endif
+
+	/* Find the lowest occupied slot in a non-zero occupancy word.  The port's
+	count leading zeros based priority selection is used when available. */
+	#ifdef portGET_HIGHEST_PRIORITY
+		#define tmrWHEEL_LOWEST_SET_BIT( uxBit, ulBits ) portGET_HIGHEST_PRIORITY( uxBit, ( ( ulBits ) & ( 0UL - ( ulBits ) ) ) )
+	#else
+		#define tmrWHEEL_LOWEST_SET_BIT( uxBit, ulBits )						\
+		{																		\
+			for( ( uxBit ) = 0U; ( ( ( ulBits ) >> ( uxBit ) ) & 1UL ) == 0UL; ( uxBit )++ ) \
+			{																	\
+			}																	\
+		}
+	#endif
+
+#endif /* configUSE_TIMER_WHEEL */
+
 /* The definition of the timers themselves. */
 typedef struct tmrTimerControl
 {
@@ -157,13 +196,32 @@ typedef struct tmrTimerQueueMessage
 /*lint -e956 A manual analysis and inspection has been used to determine which
 static variables must be declared volatile. */
 
-/* The list in which active timers are stored.  Timers are referenced in expire
-time order, with the nearest expiry time at the front of the list.  Only the
-timer service task is allowed to access these lists. */
-PRIVILEGED_DATA static List_t xActiveTimerList1;
-PRIVILEGED_DATA static List_t xActiveTimerList2;
-PRIVILEGED_DATA static List_t *pxCurrentTimerList;
-PRIVILEGED_DATA static List_t *pxOverflowTimerList;
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+	/* The timing wheel in which active timers are stored.  A timer is kept in
+	the level whose span covers the time to its expiry, in the slot selected
+	by the bits of its expiry time for that level, so starting, stopping and
+	expiring a timer never searches a list.  Slots of higher levels are
+	cascaded into lower levels as the wheel time reaches them.
+	ulTimerWheelOccupied has one bit per non-empty slot.  xTimerWheelTime is
+	the first tick that has not yet been processed.  Only the timer service
+	task is allowed to access these variables. */
+	PRIVILEGED_DATA static List_t xTimerWheel[ configTIMER_WHEEL_LEVELS ][ tmrWHEEL_SLOTS ];
+	PRIVILEGED_DATA static uint32_t ulTimerWheelOccupied[ configTIMER_WHEEL_LEVELS ];
+	PRIVILEGED_DATA static List_t xTimerWheelFarList;
+	PRIVILEGED_DATA static TickType_t xTimerWheelTime = ( TickType_t ) 0U;
+
+#else
+
+	/* The list in which active timers are stored.  Timers are referenced in expire
+	time order, with the nearest expiry time at the front of the list.  Only the
+	timer service task is allowed to access these lists. */
+	PRIVILEGED_DATA static List_t xActiveTimerList1;
+	PRIVILEGED_DATA static List_t xActiveTimerList2;
+	PRIVILEGED_DATA static List_t *pxCurrentTimerList;
+	PRIVILEGED_DATA static List_t *pxOverflowTimerList;
+
+#endif /* configUSE_TIMER_WHEEL */
 
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
@@ -203,17 +261,53 @@ static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
  */
 static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
 
-/*
- * An active timer has reached its expire time.  Reload the timer if it is an
- * auto reload timer, then call its callback.
- */
-static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
-
-/*
- * The tick count has overflowed.  Switch the timer lists after ensuring the
- * current timer list does not still reference some timers.
- */
-static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+	/*
+	 * Place a timer in the wheel slot for the expiry time held in its list
+	 * item value, relative to xTimerWheelTime.
+	 */
+	static void prvWheelInsert( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Remove a timer from its wheel slot, clearing the slot's occupied bit if
+	 * the slot becomes empty.
+	 */
+	static void prvWheelRemove( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Remove every timer from pxList and insert it again relative to the
+	 * current wheel time.
+	 */
+	static void prvWheelRedistribute( List_t * const pxList ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Cascade the higher level slots that start at xTick, then expire the
+	 * timers in the level 0 slot for xTick.
+	 */
+	static void prvWheelProcessTick( const TickType_t xTick ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Process every tick up to and including xTimeNow that has a slot to
+	 * cascade or expire.
+	 */
+	static void prvWheelAdvance( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+#else
+
+	/*
+	 * An active timer has reached its expire time.  Reload the timer if it is an
+	 * auto reload timer, then call its callback.
+	 */
+	static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The tick count has overflowed.  Switch the timer lists after ensuring the
+	 * current timer list does not still reference some timers.
+	 */
+	static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_WHEEL */
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
@@ -378,6 +472,8 @@ Timer_t *pxTimer = ( Timer_t * ) xTimer;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMER_WHEEL == 0 )
+
 static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
 {
 BaseType_t xResult;
@@ -418,6 +514,8 @@ Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTi
 }
 /*-----------------------------------------------------------*/
 
+#endif /* configUSE_TIMER_WHEEL */
+
 static void prvTimerTask( void *pvParameters )
 {
 TickType_t xNextExpireTime;
@@ -442,6 +540,331 @@ BaseType_t xListWasEmpty;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+static void prvWheelInsert( Timer_t * const pxTimer )
+{
+const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+const TickType_t xTicksToExpiry = xExpiryTime - xTimerWheelTime;
+UBaseType_t uxLevel = 0U, uxSlot;
+
+	/* Find the lowest level whose span covers the time to expiry.  This is
+	bounded by configTIMER_WHEEL_LEVELS, not by the number of timers. */
+	while( ( uxLevel < ( ( UBaseType_t ) configTIMER_WHEEL_LEVELS - 1U ) ) && ( ( xTicksToExpiry >> tmrWHEEL_LEVEL_SHIFT( uxLevel ) ) >= tmrWHEEL_SLOTS ) )
+	{
+		uxLevel++;
+	}
+
+	if( ( xTicksToExpiry >> tmrWHEEL_LEVEL_SHIFT( uxLevel ) ) < tmrWHEEL_SLOTS )
+	{
+		uxSlot = ( UBaseType_t ) ( xExpiryTime >> tmrWHEEL_LEVEL_SHIFT( uxLevel ) ) & tmrWHEEL_SLOT_MASK;
+		vListInsertEnd( &( xTimerWheel[ uxLevel ][ uxSlot ] ), &( pxTimer->xTimerListItem ) );
+		ulTimerWheelOccupied[ uxLevel ] |= ( 1UL << uxSlot );
+	}
+	else
+	{
+		/* Beyond the span of the wheel.  The far list is redistributed each
+		time the top level completes a rotation. */
+		vListInsertEnd( &xTimerWheelFarList, &( pxTimer->xTimerListItem ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWheelRemove( Timer_t * const pxTimer )
+{
+List_t * const pxList = ( List_t * ) listLIST_ITEM_CONTAINER( &( pxTimer->xTimerListItem ) );
+UBaseType_t uxIndex;
+
+	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+
+	if( ( pxList != &xTimerWheelFarList ) && ( listLIST_IS_EMPTY( pxList ) != pdFALSE ) )
+	{
+		uxIndex = ( UBaseType_t ) ( pxList - &( xTimerWheel[ 0 ][ 0 ] ) );
+		ulTimerWheelOccupied[ uxIndex / tmrWHEEL_SLOTS ] &= ~( 1UL << ( uxIndex % tmrWHEEL_SLOTS ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWheelRedistribute( List_t * const pxList )
+{
+UBaseType_t uxItems;
+Timer_t *pxTimer;
+
+	/* Only the timers present on entry are moved.  A timer that lands in the
+	same list again is left at its end. */
+	uxItems = listCURRENT_LIST_LENGTH( pxList );
+	while( uxItems > 0U )
+	{
+		uxItems--;
+		pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxList );
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+		prvWheelInsert( pxTimer );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWheelProcessTick( const TickType_t xTick )
+{
+UBaseType_t uxLevel, uxSlot, uxItems;
+List_t *pxSlot;
+Timer_t *pxTimer;
+
+	/* Timers moved down from the upper levels are inserted relative to the
+	tick being processed. */
+	xTimerWheelTime = xTick;
+
+	if( ( xTick & ( tmrWHEEL_LEVEL_SPAN( configTIMER_WHEEL_LEVELS ) - 1U ) ) == ( TickType_t ) 0U )
+	{
+		prvWheelRedistribute( &xTimerWheelFarList );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Cascade from the highest level down, so a timer can fall through
+	several levels within this tick. */
+	for( uxLevel = ( UBaseType_t ) configTIMER_WHEEL_LEVELS - 1U; uxLevel > 0U; uxLevel-- )
+	{
+		if( ( xTick & ( tmrWHEEL_LEVEL_SPAN( uxLevel ) - 1U ) ) == ( TickType_t ) 0U )
+		{
+			uxSlot = ( UBaseType_t ) ( xTick >> tmrWHEEL_LEVEL_SHIFT( uxLevel ) ) & tmrWHEEL_SLOT_MASK;
+			ulTimerWheelOccupied[ uxLevel ] &= ~( 1UL << uxSlot );
+			prvWheelRedistribute( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	/* Every timer in the level 0 slot expires at xTick.  Reloaded timers are
+	inserted relative to the following tick, so a reload that lands in this
+	slot again is not expired a second time below. */
+	xTimerWheelTime = xTick + ( TickType_t ) 1U;
+	uxSlot = ( UBaseType_t ) xTick & tmrWHEEL_SLOT_MASK;
+	pxSlot = &( xTimerWheel[ 0 ][ uxSlot ] );
+	ulTimerWheelOccupied[ 0 ] &= ~( 1UL << uxSlot );
+
+	uxItems = listCURRENT_LIST_LENGTH( pxSlot );
+	while( uxItems > 0U )
+	{
+		uxItems--;
+		pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+		traceTIMER_EXPIRED( pxTimer );
+
+		if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
+		{
+			/* The reload time is relative to the expiry time, not to the time
+			now.  If the timer service task ran late the reload time may already
+			have passed, in which case it is expired again later in this same
+			call to prvWheelAdvance(). */
+			listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), ( xTick + pxTimer->xTimerPeriodInTicks ) );
+			prvWheelInsert( pxTimer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWheelAdvance( const TickType_t xTimeNow )
+{
+TickType_t xNextEventTime;
+BaseType_t xWheelWasEmpty;
+
+	/* Ticks without a slot to cascade or expire are skipped, so the cost
+	depends on the number of timers processed rather than on the number of
+	ticks since the wheel was last advanced. */
+	for( ;; )
+	{
+		xNextEventTime = prvGetNextExpireTime( &xWheelWasEmpty );
+
+		if( ( xWheelWasEmpty == pdFALSE ) && ( ( xNextEventTime - xTimerWheelTime ) < ( ( xTimeNow + ( TickType_t ) 1U ) - xTimerWheelTime ) ) )
+		{
+			prvWheelProcessTick( xNextEventTime );
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	xTimerWheelTime = xTimeNow + ( TickType_t ) 1U;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseType_t xListWasEmpty )
+{
+TickType_t xTimeNow;
+BaseType_t xTimerListsWereSwitched;
+
+	vTaskSuspendAll();
+	{
+		/* The wheel does not need the timer lists to be switched when the tick
+		count overflows, so xTimerListsWereSwitched is always pdFALSE. */
+		xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+		( void ) xTimerListsWereSwitched;
+
+		/* All times are compared as distances from xTimerWheelTime, which is
+		at most one tick ahead of xTimeNow, so the comparison holds across a
+		tick count overflow. */
+		if( ( xListWasEmpty == pdFALSE ) && ( ( xNextExpireTime - xTimerWheelTime ) < ( ( xTimeNow + ( TickType_t ) 1U ) - xTimerWheelTime ) ) )
+		{
+			( void ) xTaskResumeAll();
+			prvWheelAdvance( xTimeNow );
+		}
+		else
+		{
+			/* Block until the next slot is due or a command is received.  If
+			the wheel is empty the block time is ignored and the task waits
+			indefinitely. */
+			vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
+
+			if( xTaskResumeAll() == pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
+{
+TickType_t xNextExpireTime = ( TickType_t ) 0U, xBoundary, xCandidate;
+UBaseType_t uxLevel, uxIndex, uxDistance;
+uint32_t ulRotated;
+
+	/* Returns the first tick at or after xTimerWheelTime at which a slot has
+	to be cascaded or expired.  For each level this is the first occupied
+	slot reached from the next slot boundary, found from the occupancy word
+	without looking at the timers themselves.  A cascade can be earlier than
+	the expiry of the timers it moves, in which case the task simply blocks
+	again afterwards. */
+	*pxListWasEmpty = pdTRUE;
+
+	for( uxLevel = 0U; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+	{
+		if( ulTimerWheelOccupied[ uxLevel ] != 0UL )
+		{
+			/* Round the wheel time up to the start of a slot of this level. */
+			xBoundary = ( xTimerWheelTime + ( tmrWHEEL_LEVEL_SPAN( uxLevel ) - 1U ) ) & ~( tmrWHEEL_LEVEL_SPAN( uxLevel ) - 1U );
+			uxIndex = ( UBaseType_t ) ( xBoundary >> tmrWHEEL_LEVEL_SHIFT( uxLevel ) ) & tmrWHEEL_SLOT_MASK;
+
+			/* Rotate so the slot at xBoundary is bit 0. */
+			ulRotated = ( ulTimerWheelOccupied[ uxLevel ] >> uxIndex ) | ( ulTimerWheelOccupied[ uxLevel ] << ( ( tmrWHEEL_SLOTS - uxIndex ) & tmrWHEEL_SLOT_MASK ) );
+			tmrWHEEL_LOWEST_SET_BIT( uxDistance, ulRotated );
+			xCandidate = xBoundary + ( ( TickType_t ) uxDistance << tmrWHEEL_LEVEL_SHIFT( uxLevel ) );
+
+			if( ( *pxListWasEmpty != pdFALSE ) || ( ( xCandidate - xTimerWheelTime ) < ( xNextExpireTime - xTimerWheelTime ) ) )
+			{
+				xNextExpireTime = xCandidate;
+				*pxListWasEmpty = pdFALSE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	if( listLIST_IS_EMPTY( &xTimerWheelFarList ) == pdFALSE )
+	{
+		/* The far list is redistributed when the top level wraps. */
+		xCandidate = ( xTimerWheelTime + ( tmrWHEEL_LEVEL_SPAN( configTIMER_WHEEL_LEVELS ) - 1U ) ) & ~( tmrWHEEL_LEVEL_SPAN( configTIMER_WHEEL_LEVELS ) - 1U );
+
+		if( ( *pxListWasEmpty != pdFALSE ) || ( ( xCandidate - xTimerWheelTime ) < ( xNextExpireTime - xTimerWheelTime ) ) )
+		{
+			xNextExpireTime = xCandidate;
+			*pxListWasEmpty = pdFALSE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xNextExpireTime;
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
+{
+TickType_t xTimeNow, xNextEventTime;
+BaseType_t xWheelWasEmpty;
+
+	xTimeNow = xTaskGetTickCount();
+
+	/* If nothing is due up to xTimeNow the wheel time can be moved straight
+	to the next tick.  This keeps xTimerWheelTime within one tick of the
+	tick count while the task is blocked for a long time, which is what makes
+	the distance comparisons safe across a tick count overflow.  There are no
+	lists to switch. */
+	xNextEventTime = prvGetNextExpireTime( &xWheelWasEmpty );
+	if( ( xWheelWasEmpty != pdFALSE ) || ( ( xNextEventTime - xTimerWheelTime ) >= ( ( xTimeNow + ( TickType_t ) 1U ) - xTimerWheelTime ) ) )
+	{
+		xTimerWheelTime = xTimeNow + ( TickType_t ) 1U;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	*pxTimerListsWereSwitched = pdFALSE;
+
+	return xTimeNow;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime )
+{
+BaseType_t xProcessTimerNow = pdFALSE;
+
+	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+	/* The expiry time is xCommandTime plus the period, so the timer has
+	already expired exactly when the time since the command is at least the
+	period.  The unsigned subtraction covers an overflow of either the tick
+	count or the expiry time, the cases prvSwitchTimerLists() deals with for
+	the list implementation. */
+	if( ( xTimeNow - xCommandTime ) >= pxTimer->xTimerPeriodInTicks )
+	{
+		xProcessTimerNow = pdTRUE;
+	}
+	else
+	{
+		prvWheelInsert( pxTimer );
+	}
+
+	return xProcessTimerNow;
+}
+/*-----------------------------------------------------------*/
+
+#else /* configUSE_TIMER_WHEEL */
+
 static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseType_t xListWasEmpty )
 {
 TickType_t xTimeNow;
@@ -592,6 +1015,8 @@ BaseType_t xProcessTimerNow = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
+#endif /* configUSE_TIMER_WHEEL */
+
 static void	prvProcessReceivedCommands( void )
 {
 DaemonTaskMessage_t xMessage;
@@ -634,7 +1059,15 @@ TickType_t xTimeNow;
 			if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
 			{
 				/* The timer is in a list, remove it. */
-				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+				#if ( configUSE_TIMER_WHEEL == 1 )
+				{
+					prvWheelRemove( pxTimer );
+				}
+				#else
+				{
+					( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+				}
+				#endif /* configUSE_TIMER_WHEEL */
 			}
 			else
 			{
@@ -718,6 +1151,8 @@ TickType_t xTimeNow;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMER_WHEEL == 0 )
+
 static void prvSwitchTimerLists( void )
 {
 TickType_t xNextExpireTime, xReloadTime;
@@ -777,6 +1212,8 @@ BaseType_t xResult;
 }
 /*-----------------------------------------------------------*/
 
+#endif /* configUSE_TIMER_WHEEL */
+
 static void prvCheckForValidListAndQueue( void )
 {
 	/* Check that the list from which active timers are referenced, and the
@@ -786,10 +1223,29 @@ static void prvCheckForValidListAndQueue( void )
 	{
 		if( xTimerQueue == NULL )
 		{
-			vListInitialise( &xActiveTimerList1 );
-			vListInitialise( &xActiveTimerList2 );
-			pxCurrentTimerList = &xActiveTimerList1;
-			pxOverflowTimerList = &xActiveTimerList2;
+			#if ( configUSE_TIMER_WHEEL == 1 )
+			{
+			UBaseType_t uxLevel, uxSlot;
+
+				for( uxLevel = 0U; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+				{
+					for( uxSlot = 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+					{
+						vListInitialise( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+					}
+					ulTimerWheelOccupied[ uxLevel ] = 0UL;
+				}
+				vListInitialise( &xTimerWheelFarList );
+				xTimerWheelTime = xTaskGetTickCount();
+			}
+			#else
+			{
+				vListInitialise( &xActiveTimerList1 );
+				vListInitialise( &xActiveTimerList2 );
+				pxCurrentTimerList = &xActiveTimerList1;
+				pxOverflowTimerList = &xActiveTimerList2;
+			}
+			#endif /* configUSE_TIMER_WHEEL */
 			xTimerQueue = xQueueCreate( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, sizeof( DaemonTaskMessage_t ) );
 			configASSERT( xTimerQueue );
 
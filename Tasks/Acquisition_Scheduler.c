@@ -0,0 +1,533 @@
+/**
+* @Filename: Acquisition_Scheduler.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [6:20pm]
+* @Version:  1.0.0
+*
+* @Description: Sensor state machines sharing one stack, driven by a task of
+*               their own, by software timers or by co-routines
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Drivers/CycleCounter.h"
+
+#include "Tasks/Acquisition_Scheduler.h"
+#include "Tasks/Log.h"
+#include "Tasks/Metrics.h"
+
+#include "FreeRTOS.h"
+#include "croutine.h"
+#include "queue.h"
+#include "task.h"
+#include "timers.h"
+
+#if ACQUISITION_USE_COROUTINES && ACQUISITION_USE_TIMERS
+#error Set only one of ACQUISITION_USE_COROUTINES and ACQUISITION_USE_TIMERS
+#endif
+
+#if ACQUISITION_USE_COROUTINES
+#if (configUSE_CO_ROUTINES != 1)
+#error ACQUISITION_USE_COROUTINES requires configUSE_CO_ROUTINES
+#endif
+#elif ACQUISITION_USE_TIMERS
+#if (configUSE_TIMERS != 1) || (INCLUDE_xTimerPendFunctionCall != 1)
+#error ACQUISITION_USE_TIMERS requires configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall
+#endif
+// Log_Printf only skips the console mutex wait on the timer service task
+// when it can tell that task apart
+#if (INCLUDE_xTimerGetTimerDaemonTaskHandle != 1)
+#error ACQUISITION_USE_TIMERS requires INCLUDE_xTimerGetTimerDaemonTaskHandle
+#endif
+// The steps run on the timer service task. configTIMER_TASK_STACK_DEPTH is
+// often a cast, which #if cannot evaluate, so an array of negative size
+// fails the build instead.
+typedef char Acquisition_Timer_Stack_Check[(configTIMER_TASK_STACK_DEPTH >= ACQUISITION_STACK_DEPTH) ? 1 : -1];
+#endif
+
+
+/************************************************
+* Local constant variables
+************************************************/
+// Upper bounds, in microseconds, of the I2C transaction time buckets
+const uint32_t Acquisition_IO_Bounds[] = { 50, 100, 200, 500, 1000, 2000, 5000 };
+
+
+/************************************************
+* Local variables
+************************************************/
+Acquisition_Sensor* Acquisition_Sensors[ACQUISITION_MAX_SENSORS];
+uint32_t Acquisition_Sensors_Nbr = 0;
+
+// Time of every transaction timed with Acquisition_BeginIO, all sensors
+volatile uint32_t Acquisition_IO_Buckets[sizeof(Acquisition_IO_Bounds) / sizeof(Acquisition_IO_Bounds[0]) + 1];
+uint32_t Acquisition_IO_BucketSnapshots[sizeof(Acquisition_IO_Bounds) / sizeof(Acquisition_IO_Bounds[0]) + 1];
+Metrics_Metric Acquisition_IO_Time = METRICS_HISTOGRAM("I2C transaction us", Acquisition_IO_Bounds,
+                                                       Acquisition_IO_Buckets, Acquisition_IO_BucketSnapshots);
+
+#if ACQUISITION_USE_COROUTINES
+// Co-routine mode: the task running every co-routine
+TaskHandle_t Acquisition_CoRoutine_Task = NULL;
+#elif !ACQUISITION_USE_TIMERS
+// Task mode: the task running every sensor
+TaskHandle_t Acquisition_Task = NULL;
+#endif
+
+
+/************************************************
+* Local function declarations
+************************************************/
+static uint32_t run_steps(Acquisition_Sensor* sensor);
+static void account_dispatch(Acquisition_Sensor* sensor);
+#if ACQUISITION_USE_COROUTINES
+static void sensor_coroutine(CoRoutineHandle_t xHandle, UBaseType_t uxIndex);
+static void Task_Acquisition_CoRoutines(void* pvParameters);
+#elif ACQUISITION_USE_TIMERS
+static void arm_timer(Acquisition_Sensor* sensor, uint32_t ticks);
+static void timer_expired(TimerHandle_t timer);
+static void io_completed(void* pvParameter1, uint32_t ulParameter2);
+#else
+static void schedule(Acquisition_Sensor* sensor, uint32_t ticks);
+static void Task_Acquisition(void* pvParameters);
+#endif
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: run_steps
+* Description:   Run the sensor's step function until it asks to wait
+* Parameters:    Acquisition_Sensor* sensor
+* Return:        uint32_t - ticks to wait, or ACQUISITION_WAIT_IO
+*************************************************************************/
+static uint32_t run_steps(Acquisition_Sensor* sensor) {
+  uint32_t ticks = 0;
+
+  do {
+    uint32_t start = CycleCounter_Get();
+    ticks = sensor->step(sensor);
+    uint32_t cycles = CycleCounter_Get() - start;
+
+    // Acquisition_PrintSensors reads the 64 bit total from another task
+    taskENTER_CRITICAL();
+    sensor->steps++;
+    sensor->cyclesTotal += cycles;
+    if (cycles > sensor->cyclesMax) {
+      sensor->cyclesMax = cycles;
+    }
+    taskEXIT_CRITICAL();
+  } while (ticks == 0);
+
+  return ticks;
+}
+
+
+/*************************************************************************
+* Function Name: account_dispatch
+* Description:   Record the latency from the I2C completion interrupt to
+*                the step about to consume it
+* Parameters:    Acquisition_Sensor* sensor
+* Return:        void
+*************************************************************************/
+static void account_dispatch(Acquisition_Sensor* sensor) {
+  uint32_t cycles = CycleCounter_Get() - sensor->ioCycle;
+
+  taskENTER_CRITICAL();
+  sensor->dispatches++;
+  sensor->dispatchCyclesTotal += cycles;
+  if (cycles > sensor->dispatchCyclesMax) {
+    sensor->dispatchCyclesMax = cycles;
+  }
+  taskEXIT_CRITICAL();
+}
+
+
+#if ACQUISITION_USE_COROUTINES
+
+/*************************************************************************
+* Function Name: sensor_coroutine
+* Description:   Co-routine running one sensor's steps. Locals do not
+*                survive a block, so all state is kept in the sensor.
+* Parameters:    CoRoutineHandle_t xHandle
+*                UBaseType_t uxIndex - index into Acquisition_Sensors
+* Return:        void
+*************************************************************************/
+static void sensor_coroutine(CoRoutineHandle_t xHandle, UBaseType_t uxIndex) {
+  Acquisition_Sensor* sensor = Acquisition_Sensors[uxIndex];
+  BaseType_t xResult = pdFAIL;
+
+  crSTART(xHandle);
+
+  // First step one tick after the scheduler starts, as in timer mode
+  crDELAY(xHandle, 1);
+
+  for (;;) {
+    sensor->delayTicks = run_steps(sensor);
+
+    if (sensor->delayTicks == ACQUISITION_WAIT_IO) {
+      // A co-routine cannot wait forever, so wait again on timeout
+      do {
+        crQUEUE_RECEIVE(xHandle, sensor->ioQueue, &sensor->status, portMAX_DELAY, &xResult);
+      } while (xResult != pdPASS);
+      account_dispatch(sensor);
+    }
+    else {
+      crDELAY(xHandle, sensor->delayTicks);
+    }
+  }
+
+  crEND();
+}
+
+
+/*************************************************************************
+* Function Name: Task_Acquisition_CoRoutines
+* Description:   Run the co-routines at idle priority, blocking until the
+*                next co-routine wakes or an I2C completion readies one
+* Parameters:    void* pvParameters;
+* Return:        void
+*************************************************************************/
+static void Task_Acquisition_CoRoutines(void* pvParameters) {
+  while (1) {
+    vCoRoutineSchedule();
+    ulTaskNotifyTake(pdTRUE, xCoRoutineGetTicksToNextWake());
+  }
+}
+
+#elif ACQUISITION_USE_TIMERS
+
+/*************************************************************************
+* Function Name: arm_timer
+* Description:   Start the sensor's timer for the next step. Runs on the
+*                timer service task.
+* Parameters:    Acquisition_Sensor* sensor
+*                uint32_t ticks - from run_steps
+* Return:        void
+*************************************************************************/
+static void arm_timer(Acquisition_Sensor* sensor, uint32_t ticks) {
+  if (ticks != ACQUISITION_WAIT_IO) {
+    // Changing the period of a dormant timer also starts it. The timer
+    // service task must not block on its own queue.
+    if (xTimerChangePeriod(sensor->timer, ticks, 0) != pdPASS) {
+      sensor->lostCommands++;
+    }
+  }
+}
+
+
+/*************************************************************************
+* Function Name: timer_expired
+* Description:   Software timer callback, the sensor's delay has elapsed
+* Parameters:    TimerHandle_t timer - the timer ID is the sensor
+* Return:        void
+*************************************************************************/
+static void timer_expired(TimerHandle_t timer) {
+  Acquisition_Sensor* sensor = (Acquisition_Sensor*)pvTimerGetTimerID(timer);
+  arm_timer(sensor, run_steps(sensor));
+}
+
+
+/*************************************************************************
+* Function Name: io_completed
+* Description:   Pended from Acquisition_I2CCallback to run the next step
+*                on the timer service task
+* Parameters:    void* pvParameter1    - the sensor
+*                uint32_t ulParameter2 - I2C status
+* Return:        void
+*************************************************************************/
+static void io_completed(void* pvParameter1, uint32_t ulParameter2) {
+  Acquisition_Sensor* sensor = (Acquisition_Sensor*)pvParameter1;
+  sensor->status = (uint_fast8_t)ulParameter2;
+  account_dispatch(sensor);
+  arm_timer(sensor, run_steps(sensor));
+}
+
+#else
+
+/*************************************************************************
+* Function Name: schedule
+* Description:   Record when the sensor's next step is due
+* Parameters:    Acquisition_Sensor* sensor
+*                uint32_t ticks - from run_steps
+* Return:        void
+*************************************************************************/
+static void schedule(Acquisition_Sensor* sensor, uint32_t ticks) {
+  if (ticks == ACQUISITION_WAIT_IO) {
+    sensor->waitingIO = true;
+  }
+  else {
+    sensor->waitingIO = false;
+    sensor->wakeTick = xTaskGetTickCount() + ticks;
+  }
+}
+
+
+/*************************************************************************
+* Function Name: Task_Acquisition
+* Description:   Run the steps that are due, then sleep until the
+*                earliest delay ends or an I2C transaction completes.
+*                A completion notified while the steps run is kept in
+*                the notification count, so it is not missed.
+* Parameters:    void* pvParameters
+* Return:        void
+*************************************************************************/
+static void Task_Acquisition(void* pvParameters) {
+  while (1) {
+    TickType_t now = xTaskGetTickCount();
+    TickType_t timeout = portMAX_DELAY;
+    uint32_t i = 0;
+
+    for (i = 0; i < Acquisition_Sensors_Nbr; ++i) {
+      Acquisition_Sensor* sensor = Acquisition_Sensors[i];
+
+      if (sensor->waitingIO) {
+        if (sensor->ioDone) {
+          sensor->ioDone = false;
+          account_dispatch(sensor);
+          schedule(sensor, run_steps(sensor));
+        }
+      }
+      else if ((int32_t)(now - sensor->wakeTick) >= 0) {
+        schedule(sensor, run_steps(sensor));
+      }
+    }
+
+    now = xTaskGetTickCount();
+    for (i = 0; i < Acquisition_Sensors_Nbr; ++i) {
+      const Acquisition_Sensor* sensor = Acquisition_Sensors[i];
+      TickType_t remaining = 0;
+
+      if (sensor->waitingIO) {
+        remaining = sensor->ioDone ? 0 : portMAX_DELAY;
+      }
+      else if ((int32_t)(sensor->wakeTick - now) > 0) {
+        remaining = sensor->wakeTick - now;
+      }
+
+      if (remaining < timeout) {
+        timeout = remaining;
+      }
+    }
+
+    if (timeout > 0) {
+      ulTaskNotifyTake(pdTRUE, timeout);
+    }
+  }
+}
+
+#endif /* ACQUISITION_USE_COROUTINES */
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: Acquisition_Start
+* Description:   Register a sensor and schedule its first step
+* Parameters:    Acquisition_Sensor* sensor
+*                const char* name
+*                Acquisition_StepFunction step
+*                void* context
+* Return:        bool - false if the sensor could not be registered
+*************************************************************************/
+extern bool Acquisition_Start(Acquisition_Sensor* sensor, const char* name,
+                              Acquisition_StepFunction step, void* context) {
+  if (Acquisition_Sensors_Nbr >= ACQUISITION_MAX_SENSORS) {
+    return false;
+  }
+
+  CycleCounter_Initialization();
+  Metrics_Register(&Acquisition_IO_Time);
+
+  sensor->name = name;
+  sensor->step = step;
+  sensor->context = context;
+  sensor->status = 0;
+  sensor->steps = 0;
+  sensor->cyclesTotal = 0;
+  sensor->cyclesMax = 0;
+  sensor->ioCycle = 0;
+  sensor->ioStartCycle = 0;
+  sensor->ioHistogram = NULL;
+  sensor->dispatches = 0;
+  sensor->dispatchCyclesTotal = 0;
+  sensor->dispatchCyclesMax = 0;
+  sensor->lostCommands = 0;
+
+#if ACQUISITION_USE_COROUTINES
+  sensor->delayTicks = 0;
+  sensor->ioQueue = xQueueCreate(1, sizeof(uint_fast8_t));
+  if (sensor->ioQueue == NULL) {
+    return false;
+  }
+
+  // The co-routine finds its sensor through its index
+  Acquisition_Sensors[Acquisition_Sensors_Nbr] = sensor;
+  if (xCoRoutineCreate(sensor_coroutine, 0, Acquisition_Sensors_Nbr) != pdPASS) {
+    return false;
+  }
+
+  if (!Acquisition_StartCoRoutines()) {
+    return false;
+  }
+#elif ACQUISITION_USE_TIMERS
+  sensor->timer = xTimerCreate(name, 1, pdFALSE, sensor, timer_expired);
+  if (sensor->timer == NULL) {
+    return false;
+  }
+
+  if (xTimerStart(sensor->timer, 0) != pdPASS) {
+    return false;
+  }
+#else
+  sensor->wakeTick = xTaskGetTickCount() + 1;
+  sensor->waitingIO = false;
+  sensor->ioDone = false;
+
+  if (Acquisition_Task == NULL) {
+    if (xTaskCreate(Task_Acquisition, "Acquisition", ACQUISITION_STACK_DEPTH, NULL, ACQUISITION_TASK_PRIORITY,
+                    &Acquisition_Task) != pdPASS) {
+      return false;
+    }
+  }
+#endif
+
+  Acquisition_Sensors[Acquisition_Sensors_Nbr++] = sensor;
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: Acquisition_BeginIO
+* Description:   Time the transaction the step is about to start
+* Parameters:    Acquisition_Sensor* sensor
+*                LatencyHistogram* histogram
+* Return:        void
+*************************************************************************/
+extern void Acquisition_BeginIO(Acquisition_Sensor* sensor, LatencyHistogram* histogram) {
+  sensor->ioHistogram = histogram;
+  sensor->ioStartCycle = CycleCounter_Get();
+}
+
+
+/*************************************************************************
+* Function Name: Acquisition_I2CCallback
+* Description:   I2C completion, called from the I2C interrupt
+* Parameters:    void* pvData - the Acquisition_Sensor*
+*                uint_fast8_t ui8Status
+* Return:        void
+*************************************************************************/
+extern void Acquisition_I2CCallback(void* pvData, uint_fast8_t ui8Status) {
+  Acquisition_Sensor* sensor = (Acquisition_Sensor*)pvData;
+
+  sensor->ioCycle = CycleCounter_Get();
+
+  if (sensor->ioHistogram != NULL) {
+    uint32_t cycles = sensor->ioCycle - sensor->ioStartCycle;
+
+    LatencyHistogram_Record(sensor->ioHistogram, cycles);
+    Metrics_Record(&Acquisition_IO_Time, cycles / CYCLECOUNTER_CYCLES_PER_US);
+    sensor->ioHistogram = NULL;
+  }
+
+#if ACQUISITION_USE_COROUTINES
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+  // Ready the co-routine, and wake the task in case it blocked first
+  crQUEUE_SEND_FROM_ISR(sensor->ioQueue, &ui8Status, pdFALSE);
+  vTaskNotifyGiveFromISR(Acquisition_CoRoutine_Task, &xHigherPriorityTaskWoken);
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+#elif ACQUISITION_USE_TIMERS
+  portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+  if (xTimerPendFunctionCallFromISR(io_completed, pvData, ui8Status, &xHigherPriorityTaskWoken) != pdPASS) {
+    sensor->lostCommands++;
+  }
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+#else
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+  // The status must be in place before the task sees ioDone
+  sensor->status = ui8Status;
+  sensor->ioDone = true;
+  vTaskNotifyGiveFromISR(Acquisition_Task, &xHigherPriorityTaskWoken);
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+#endif
+}
+
+
+#if ACQUISITION_USE_COROUTINES
+/*************************************************************************
+* Function Name: Acquisition_StartCoRoutines
+* Description:   Create the task that runs the co-routines, once
+* Parameters:    N/A
+* Return:        bool - false if the task could not be created
+*************************************************************************/
+extern bool Acquisition_StartCoRoutines() {
+  if (Acquisition_CoRoutine_Task == NULL) {
+    if (xTaskCreate(Task_Acquisition_CoRoutines, "CoRoutines", ACQUISITION_STACK_DEPTH, NULL, tskIDLE_PRIORITY,
+                    &Acquisition_CoRoutine_Task) != pdPASS) {
+      return false;
+    }
+  }
+  else {
+    // A co-routine created after the task blocked has its wake time looked at
+    xTaskNotifyGive(Acquisition_CoRoutine_Task);
+  }
+
+  return true;
+}
+#endif
+
+
+/*************************************************************************
+* Function Name: Acquisition_PrintSensors
+* Description:   Print per-sensor step counts, step cost and dispatch
+*                latency, and the unused words of the stack the steps
+*                share where the kernel can tell
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void Acquisition_PrintSensors() {
+  uint32_t i = 0;
+
+  Log_Printf("sensor,steps,avg cycles,max cycles,avg dispatch cycles,max dispatch cycles,lost commands\n");
+  for (i = 0; i < Acquisition_Sensors_Nbr; ++i) {
+    Acquisition_Sensor sensor;
+
+    taskENTER_CRITICAL();
+    sensor = *Acquisition_Sensors[i];
+    taskEXIT_CRITICAL();
+
+    Log_Printf("%s,%u,%u,%u,%u,%u,%u\n",
+               sensor.name, sensor.steps,
+               (sensor.steps == 0) ? 0 : (uint32_t)(sensor.cyclesTotal / sensor.steps),
+               sensor.cyclesMax,
+               (sensor.dispatches == 0) ? 0 : (uint32_t)(sensor.dispatchCyclesTotal / sensor.dispatches),
+               sensor.dispatchCyclesMax, sensor.lostCommands);
+  }
+
+#if (INCLUDE_uxTaskGetStackHighWaterMark == 1) && !ACQUISITION_USE_TIMERS
+  // Measured headroom to size ACQUISITION_STACK_DEPTH from
+#if ACQUISITION_USE_COROUTINES
+  if (Acquisition_CoRoutine_Task != NULL) {
+    Log_Printf("stack,%u of %u words never used\n",
+               (uint32_t)uxTaskGetStackHighWaterMark(Acquisition_CoRoutine_Task), ACQUISITION_STACK_DEPTH);
+  }
+#else
+  if (Acquisition_Task != NULL) {
+    Log_Printf("stack,%u of %u words never used\n",
+               (uint32_t)uxTaskGetStackHighWaterMark(Acquisition_Task), ACQUISITION_STACK_DEPTH);
+  }
+#endif
+#endif
+}
@@ -0,0 +1,191 @@
+/**
+* @Filename: Acquisition_Scheduler.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [6:20pm]
+* @Version:  1.0.0
+*
+* @Description: Runs sensors as state machines sharing one stack instead
+*               of one task per sensor.
+*
+*               A sensor is a step function. Each step does a bounded amount
+*               of work and returns either the number of ticks until the next
+*               step, or ACQUISITION_WAIT_IO after it started an I2C
+*               transaction with Acquisition_I2CCallback as the callback.
+*               A step must never block. Steps run in one of three modes:
+*
+*               Task mode (the default)
+*                 One task, Acquisition, runs every sensor. It sleeps in
+*                 ulTaskNotifyTake until the earliest sensor delay ends,
+*                 and Acquisition_I2CCallback wakes it with
+*                 vTaskNotifyGiveFromISR when a transaction completes.
+*                 Needs nothing beyond the task notifications FreeRTOS
+*                 enables by default. Its stack is
+*                 ACQUISITION_STACK_DEPTH words at
+*                 ACQUISITION_TASK_PRIORITY.
+*                 Against the baseline's BMP180, MPU9150 and ReportTime
+*                 tasks (512 words each) and 32 word Blinky task, the
+*                 one task and the LED's software timer save 1056 words
+*                 (4224 bytes) of stack and three TCBs. The rest of the
+*                 ~6 KB first estimated needs a smaller shared stack;
+*                 512 words stays until the "stats" command's stack
+*                 headroom has been measured on the board.
+*
+*               Timer mode (ACQUISITION_USE_TIMERS 1)
+*                 Delays use the sensor's one-shot software timer, and I2C
+*                 completions are handed to the timer service task with
+*                 xTimerPendFunctionCallFromISR, so every step runs on the
+*                 timer service task's stack.
+*                 Requires configUSE_TIMERS, INCLUDE_xTimerPendFunctionCall,
+*                 INCLUDE_xTimerGetTimerDaemonTaskHandle (so Log_Printf
+*                 does not wait for the console on the timer service
+*                 task) and a configTIMER_TASK_STACK_DEPTH of at least
+*                 ACQUISITION_STACK_DEPTH, all set in FreeRTOSConfig.h.
+*                 configTIMER_QUEUE_LENGTH must hold at least one command
+*                 per sensor; a refused command stalls that sensor and is
+*                 counted in lostCommands.
+*
+*               Co-routine mode (ACQUISITION_USE_COROUTINES 1)
+*                 Each sensor is a co-routine that delays with crDELAY and
+*                 waits for I2C completions with crQUEUE_RECEIVE on a one
+*                 item queue filled by crQUEUE_SEND_FROM_ISR. The LED
+*                 blinker becomes a co-routine too. All of them share the
+*                 stack of the CoRoutines task, ACQUISITION_STACK_DEPTH
+*                 words at idle priority. Steps may block briefly (e.g.
+*                 Log_Printf) and need more than the idle task's stack,
+*                 so they are not run from the idle hook. Between
+*                 co-routines the task blocks until the next crDELAY
+*                 ends (xCoRoutineGetTicksToNextWake) or the I2C
+*                 interrupt notifies it, leaving the idle band idle.
+*                 Requires configUSE_CO_ROUTINES in FreeRTOSConfig.h.
+*                 Against a 512 word task per sensor and a 32 word
+*                 Blinky task, the CoRoutines task's one stack and TCB
+*                 replace three, and 3 co-routine control blocks (56
+*                 bytes each) and 2 one item queues (84 bytes each) are
+*                 added: 1840 bytes and two TCBs saved.
+*
+*               Either way the per-sensor statistics include the dispatch
+*               latency, in cycles, from the I2C completion interrupt to
+*               the step that consumes it. A step that calls
+*               Acquisition_BeginIO before starting a transaction also
+*               gets the transaction's own latency recorded in a
+*               LatencyHistogram, and in the "I2C transaction us" metric
+*               histogram shared by all sensors.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TASKS_ACQUISITION_SCHEDULER_H_
+#define TASKS_ACQUISITION_SCHEDULER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Tasks/Latency_Histogram.h"
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "timers.h"
+
+/************************************************
+* Configuration
+************************************************/
+#define ACQUISITION_MAX_SENSORS 8
+
+#ifndef ACQUISITION_USE_TIMERS
+#define ACQUISITION_USE_TIMERS 0
+#endif
+
+#ifndef ACQUISITION_USE_COROUTINES
+#define ACQUISITION_USE_COROUTINES 0
+#endif
+
+// Words of stack the steps need: 512 (2 KiB), what each sensor task had.
+// The deepest step is the MPU9150 sample, sensor fusion and
+// floating-point conversions followed by Log_Printf's LOG_LINE_SIZE line
+// and vsnprintf.
+#define ACQUISITION_STACK_DEPTH 512
+
+// Task mode: priority of the Acquisition task, above the tasks that print
+#ifndef ACQUISITION_TASK_PRIORITY
+#define ACQUISITION_TASK_PRIORITY (tskIDLE_PRIORITY + 2)
+#endif
+
+// Returned by a step that is waiting for Acquisition_I2CCallback
+#define ACQUISITION_WAIT_IO 0xFFFFFFFF
+
+
+/************************************************
+* Types
+************************************************/
+struct Acquisition_Sensor;
+
+// Run one step. Returns the ticks until the next step (0 runs it again
+// immediately) or ACQUISITION_WAIT_IO.
+typedef uint32_t (*Acquisition_StepFunction)(struct Acquisition_Sensor* sensor);
+
+typedef struct Acquisition_Sensor {
+  const char* name;
+  Acquisition_StepFunction step;
+  void* context;                 // For the step function
+#if ACQUISITION_USE_COROUTINES
+  QueueHandle_t ioQueue;         // I2C status, sent from the interrupt
+  uint32_t delayTicks;           // Co-routine locals do not survive crDELAY
+#elif ACQUISITION_USE_TIMERS
+  TimerHandle_t timer;
+#else
+  TickType_t wakeTick;           // Tick of the next step, unless waitingIO
+  bool waitingIO;                // Last step returned ACQUISITION_WAIT_IO
+  volatile bool ioDone;          // Set by Acquisition_I2CCallback
+#endif
+
+  // Status of the last I2C transaction, valid in the step after
+  // ACQUISITION_WAIT_IO
+  uint_fast8_t status;
+
+  // Statistics
+  uint32_t steps;
+  uint64_t cyclesTotal;          // Cycles spent in the step function;
+                                 // 32 bits wrap within minutes
+  uint32_t cyclesMax;
+  uint32_t ioCycle;              // Cycle count at the last I2C completion
+  uint32_t ioStartCycle;         // Cycle count at Acquisition_BeginIO
+  LatencyHistogram* ioHistogram; // Latency of the pending transaction
+  uint32_t dispatches;
+  uint64_t dispatchCyclesTotal;  // I2C completion to step
+  uint32_t dispatchCyclesMax;
+  uint32_t lostCommands;         // Timer commands the timer queue refused,
+                                 // timer mode only
+} Acquisition_Sensor;
+
+
+/************************************************
+* Function declarations
+************************************************/
+// Register a sensor and schedule its first step one tick from now. May be
+// called before the scheduler is started.
+extern bool Acquisition_Start(Acquisition_Sensor* sensor, const char* name,
+                              Acquisition_StepFunction step, void* context);
+
+// tSensorCallback for I2C transactions started by a step. pvData must be
+// the Acquisition_Sensor*.
+extern void Acquisition_I2CCallback(void* pvData, uint_fast8_t ui8Status);
+
+// Time the transaction the step is about to start into histogram. Call
+// just before starting the transaction.
+extern void Acquisition_BeginIO(Acquisition_Sensor* sensor, LatencyHistogram* histogram);
+
+// Print per-sensor step counts, step cost and dispatch latency, and the
+// shared stack's unused words when the kernel provides them
+extern void Acquisition_PrintSensors();
+
+#if ACQUISITION_USE_COROUTINES
+// Create the CoRoutines task, once, or wake it to see a new co-routine.
+// Acquisition_Start calls it; other modules call it after creating a
+// co-routine of their own.
+extern bool Acquisition_StartCoRoutines();
+#endif
+
+#endif /* TASKS_ACQUISITION_SCHEDULER_H_ */
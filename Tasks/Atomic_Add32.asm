@@ -0,0 +1,41 @@
+;;*****************************************************************************
+;;
+;;	Atomic_Add32.asm
+;;
+;;		Author: 		Kaiser Mittenburg, Ben Sokol
+;;		Organization:	KU/EECS/EECS 690
+;;		Date:			2026-10-19
+;;		Version:		1.0
+;;
+;;		Purpose:		Add R1 to the word at address R0 atomically and
+;;						return the new value
+;;
+;;		Notes:			Safe against tasks and interrupts of any priority.
+;;						An exception between LDREX and STREX clears the
+;;						exclusive monitor, the STREX fails and the add is
+;;						retried.
+;;
+;;*****************************************************************************
+
+;;	Declare sections and external references
+
+		.global		Atomic_Add32			; Declare entry point as a global symbol
+
+;;	No constant data
+
+;;	No variable allocation
+
+;;	Program instructions
+
+		.text								; Program section
+
+Atomic_Add32:								; Entry point
+
+		LDREX	R2,[R0]       ; Load the word and claim the exclusive monitor
+		ADD		R2,R2,R1      ; Add the increment
+		STREX	R3,R2,[R0]    ; Store if the monitor is still ours, R3 = 0 on success
+		CMP		R3,#0
+		BNE		Atomic_Add32  ; Interrupted, try again
+		MOV		R0,R2         ; Return the new value
+		BX		LR            ; Branch back to Link Register
+		.end
@@ -0,0 +1,159 @@
+/**
+* @Filename: Console_Parser.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [4:05pm]
+* @Version:  1.0.0
+*
+* @Description: Line editing and command dispatch of the console
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Tasks/Console_Parser.h"
+#include "Tasks/Log.h"
+
+
+/************************************************
+* Local function declarations
+************************************************/
+static bool is_separator(char ch);
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: is_separator
+* Description:   Whether ch separates arguments
+* Parameters:    char ch
+* Return:        bool
+*************************************************************************/
+static bool is_separator(char ch) {
+  return (ch == ' ') || (ch == '\t');
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: ConsoleParser_Reset
+* Description:   Empty the line
+* Parameters:    Console_LineEditor* editor
+* Return:        void
+*************************************************************************/
+extern void ConsoleParser_Reset(Console_LineEditor* editor) {
+  editor->length = 0;
+  editor->overflowed = false;
+  editor->line[0] = '\0';
+}
+
+
+/*************************************************************************
+* Function Name: ConsoleParser_Putc
+* Description:   Add a received character to the line
+* Parameters:    Console_LineEditor* editor
+*                char ch
+* Return:        bool - true when the line is complete
+*************************************************************************/
+extern bool ConsoleParser_Putc(Console_LineEditor* editor, char ch) {
+  if ((ch == '\r') || (ch == '\n')) {
+    editor->line[editor->length] = '\0';
+    return true;
+  }
+
+  if ((ch == '\b') || (ch == 0x7F)) {
+    // Once characters are lost the line is refused, so do not edit it
+    if ((editor->length > 0) && !editor->overflowed) {
+      editor->length--;
+    }
+  }
+  else if (editor->length < (CONSOLE_LINE_SIZE - 1)) {
+    editor->line[editor->length++] = ch;
+  }
+  else {
+    editor->overflowed = true;
+  }
+
+  return false;
+}
+
+
+/*************************************************************************
+* Function Name: ConsoleParser_Execute
+* Description:   Split the completed line into arguments and run the
+*                command
+* Parameters:    Console_LineEditor* editor
+*                const Console_Command* commands
+*                uint32_t commandsNbr
+* Return:        Console_Result
+*************************************************************************/
+extern Console_Result ConsoleParser_Execute(Console_LineEditor* editor, const Console_Command* commands,
+                                            uint32_t commandsNbr) {
+  char* argv[CONSOLE_MAX_ARGS];
+  int argc = 0;
+  char* pcChar = editor->line;
+  Console_Result result = CONSOLE_UNKNOWN;
+  uint32_t i = 0;
+
+  if (editor->overflowed) {
+    Log_Printf("line longer than %u characters ignored\n", CONSOLE_LINE_SIZE - 1);
+    ConsoleParser_Reset(editor);
+    return CONSOLE_TOO_LONG;
+  }
+
+  editor->line[editor->length] = '\0';
+  while (*pcChar != '\0') {
+    while (is_separator(*pcChar)) {
+      *pcChar++ = '\0';
+    }
+    if (*pcChar == '\0') {
+      break;
+    }
+
+    if (argc == CONSOLE_MAX_ARGS) {
+      Log_Printf("more than %u arguments, line ignored\n", CONSOLE_MAX_ARGS);
+      ConsoleParser_Reset(editor);
+      return CONSOLE_TOO_MANY_ARGS;
+    }
+    argv[argc++] = pcChar;
+
+    while ((*pcChar != '\0') && !is_separator(*pcChar)) {
+      pcChar++;
+    }
+  }
+
+  if (argc == 0) {
+    ConsoleParser_Reset(editor);
+    return CONSOLE_EMPTY;
+  }
+
+  for (i = 0; i < commandsNbr; ++i) {
+    if (strcmp(argv[0], commands[i].name) == 0) {
+      break;
+    }
+  }
+
+  if (i == commandsNbr) {
+    Log_Printf("unknown command: %s, try help\n", argv[0]);
+  }
+  else if (commands[i].handler(argc, argv)) {
+    result = CONSOLE_DONE;
+  }
+  else {
+    Log_Printf("usage: %s\n", commands[i].usage);
+    result = CONSOLE_USAGE;
+  }
+
+  ConsoleParser_Reset(editor);
+  return result;
+}
@@ -0,0 +1,84 @@
+/**
+* @Filename: Console_Parser.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [4:05pm]
+* @Version:  1.0.0
+*
+* @Description: Line editing and command dispatch of the console,
+*               independent of the UART so it can be tested on the host.
+*
+*               ConsoleParser_Putc collects received characters into a
+*               line. Backspace and DEL remove the last character. A line
+*               longer than CONSOLE_LINE_SIZE - 1 characters is discarded
+*               whole at its end, rather than run cut short.
+*
+*               ConsoleParser_Execute splits a line at spaces and tabs and
+*               runs the command named by its first word. A line of more
+*               than CONSOLE_MAX_ARGS words is refused, so no argument is
+*               silently dropped. A handler returning false prints the
+*               command's usage.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TASKS_CONSOLE_PARSER_H_
+#define TASKS_CONSOLE_PARSER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/************************************************
+* Configuration
+************************************************/
+#define CONSOLE_LINE_SIZE 80
+#define CONSOLE_MAX_ARGS 8
+
+
+/************************************************
+* Types
+************************************************/
+// Runs a command. Returns false if the arguments are wrong, which prints
+// the usage.
+typedef bool (*Console_Handler)(int argc, char* argv[]);
+
+typedef struct Console_Command {
+  const char* name;
+  const char* usage;
+  Console_Handler handler;
+} Console_Command;
+
+typedef struct Console_LineEditor {
+  char line[CONSOLE_LINE_SIZE];
+  uint32_t length;
+  bool overflowed;  // characters were lost since the line began
+} Console_LineEditor;
+
+typedef enum Console_Result {
+  CONSOLE_EMPTY,          // nothing but spaces
+  CONSOLE_DONE,           // the handler accepted its arguments
+  CONSOLE_USAGE,          // the handler refused them; usage printed
+  CONSOLE_UNKNOWN,        // no such command
+  CONSOLE_TOO_MANY_ARGS,  // more than CONSOLE_MAX_ARGS words
+  CONSOLE_TOO_LONG        // the line overflowed the editor
+} Console_Result;
+
+
+/************************************************
+* Function declarations
+************************************************/
+// Empty the line
+extern void ConsoleParser_Reset(Console_LineEditor* editor);
+
+// Add a received character. Returns true on CR or LF, when editor->line
+// holds the completed line (or editor->overflowed is set).
+extern bool ConsoleParser_Putc(Console_LineEditor* editor, char ch);
+
+// Run the completed line of the editor with the commands given, and
+// start a new line. Messages go to Log_Printf.
+extern Console_Result ConsoleParser_Execute(Console_LineEditor* editor, const Console_Command* commands,
+                                            uint32_t commandsNbr);
+
+#endif /* TASKS_CONSOLE_PARSER_H_ */
@@ -0,0 +1,246 @@
+/**
+* @Filename: Deadline_Monitor.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [3:40am]
+* @Version:  1.0.0
+*
+* @Description: Release, start and finish times of periodic jobs
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Drivers/CycleCounter.h"
+#include "Drivers/Timestamp.h"
+
+#include "Tasks/Deadline_Monitor.h"
+#include "Tasks/Log.h"
+#include "Tasks/Task_ReportData.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+// Microseconds per tick
+#define DEADLINE_MONITOR_US_PER_TICK (TIMESTAMP_TICK_NS / 1000)
+
+
+/************************************************
+* Local variables
+************************************************/
+DeadlineMonitor* DeadlineMonitor_List[DEADLINE_MONITOR_MAX_MONITORS];
+volatile uint32_t DeadlineMonitor_List_Nbr = 0;
+
+
+/************************************************
+* Local function declarations
+************************************************/
+static void reset(DeadlineMonitor* monitor);
+static void alert(DeadlineMonitor* monitor, uint32_t now);
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: reset
+* Description:   Forget the statistics. A job in progress is still
+*                counted when it finishes.
+* Parameters:    DeadlineMonitor* monitor
+* Return:        void
+*************************************************************************/
+static void reset(DeadlineMonitor* monitor) {
+  monitor->jobs = 0;
+  monitor->late = 0;
+  monitor->misses = 0;
+  monitor->overruns = 0;
+  monitor->startDelayMax = 0;
+  monitor->responseMax = 0;
+  monitor->executionMax = 0;
+  monitor->executionTotal = 0;
+  monitor->alerted = false;
+  monitor->alertTick = 0;
+}
+
+
+/*************************************************************************
+* Function Name: alert
+* Description:   Send a ReportName_DeadlineMiss record unless one was sent
+*                less than DEADLINE_MONITOR_ALERT_TICKS ago
+* Parameters:    DeadlineMonitor* monitor
+*                uint32_t now - tick count
+* Return:        void
+*************************************************************************/
+static void alert(DeadlineMonitor* monitor, uint32_t now) {
+  ReportData_Item item;
+
+  if (monitor->alerted && ((now - monitor->alertTick) < DEADLINE_MONITOR_ALERT_TICKS)) {
+    return;
+  }
+  monitor->alerted = true;
+  monitor->alertTick = now;
+
+  ReportData_Stamp(&item);
+  item.ReportName = ReportName_DeadlineMiss;
+  item.ReportValueType_Flg = 0b0000;
+  item.ReportValue_0 = monitor->index;
+  item.ReportValue_1 = monitor->late;
+  item.ReportValue_2 = monitor->misses;
+  item.ReportValue_3 = monitor->overruns;
+  ReportData_Send(&item);
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: DeadlineMonitor_Init
+* Description:   Clear a monitor and add it to the printed list
+* Parameters:    DeadlineMonitor* monitor
+*                const char* name
+*                uint32_t period   - ticks
+*                uint32_t deadline - ticks after the release
+* Return:        bool - false if the list is full
+*************************************************************************/
+extern bool DeadlineMonitor_Init(DeadlineMonitor* monitor, const char* name, uint32_t period, uint32_t deadline) {
+  uint32_t i = 0;
+
+  CycleCounter_Initialization();
+
+  monitor->name = name;
+  monitor->period = period;
+  monitor->deadline = deadline;
+  monitor->release = 0;
+  monitor->startTick = 0;
+  monitor->startCycle = 0;
+  reset(monitor);
+
+  for (i = 0; i < DeadlineMonitor_List_Nbr; ++i) {
+    if (DeadlineMonitor_List[i] == monitor) {
+      return true;
+    }
+  }
+
+  if (DeadlineMonitor_List_Nbr >= DEADLINE_MONITOR_MAX_MONITORS) {
+    monitor->index = DEADLINE_MONITOR_NO_INDEX;
+    return false;
+  }
+
+  // Fill the slot before publishing it to the console
+  monitor->index = DeadlineMonitor_List_Nbr;
+  DeadlineMonitor_List[DeadlineMonitor_List_Nbr] = monitor;
+  DeadlineMonitor_List_Nbr++;
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: DeadlineMonitor_Start
+* Description:   A job due at release starts now
+* Parameters:    DeadlineMonitor* monitor
+*                uint32_t release - tick the job was due
+* Return:        void
+*************************************************************************/
+extern void DeadlineMonitor_Start(DeadlineMonitor* monitor, uint32_t release) {
+  monitor->release = release;
+  monitor->startTick = xTaskGetTickCount();
+  monitor->startCycle = CycleCounter_Get();
+}
+
+
+/*************************************************************************
+* Function Name: DeadlineMonitor_Finish
+* Description:   The job started last has finished
+* Parameters:    DeadlineMonitor* monitor
+* Return:        void
+*************************************************************************/
+extern void DeadlineMonitor_Finish(DeadlineMonitor* monitor) {
+  uint32_t execution = CycleCounter_Get() - monitor->startCycle;
+  uint32_t now = xTaskGetTickCount();
+  uint32_t startDelay = monitor->startTick - monitor->release;
+  uint32_t response = now - monitor->release;
+  bool failed = false;
+
+  monitor->jobs++;
+  monitor->executionTotal += execution;
+  if (execution > monitor->executionMax) {
+    monitor->executionMax = execution;
+  }
+  if (startDelay > monitor->startDelayMax) {
+    monitor->startDelayMax = startDelay;
+  }
+  if (response > monitor->responseMax) {
+    monitor->responseMax = response;
+  }
+
+  if (startDelay >= monitor->period) {
+    monitor->late++;
+    failed = true;
+  }
+  if (response > monitor->deadline) {
+    monitor->misses++;
+    failed = true;
+  }
+  if (execution > (monitor->period * TIMESTAMP_COUNTS_PER_TICK)) {
+    monitor->overruns++;
+    failed = true;
+  }
+
+  if (failed) {
+    alert(monitor, now);
+  }
+}
+
+
+/*************************************************************************
+* Function Name: DeadlineMonitor_PrintAll
+* Description:   Print a summary line per monitor
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void DeadlineMonitor_PrintAll() {
+  uint32_t i = 0;
+
+  Log_Printf("monitor,index,period us,deadline us,jobs,late,missed,overrun,"
+             "max start delay us,max response us,mean execution us,max execution us\n");
+  for (i = 0; i < DeadlineMonitor_List_Nbr; ++i) {
+    const DeadlineMonitor* monitor = DeadlineMonitor_List[i];
+
+    Log_Printf("%s,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u\n", monitor->name, monitor->index,
+               monitor->period * DEADLINE_MONITOR_US_PER_TICK, monitor->deadline * DEADLINE_MONITOR_US_PER_TICK,
+               monitor->jobs, monitor->late, monitor->misses, monitor->overruns,
+               monitor->startDelayMax * DEADLINE_MONITOR_US_PER_TICK,
+               monitor->responseMax * DEADLINE_MONITOR_US_PER_TICK,
+               (monitor->jobs == 0) ? 0 : (uint32_t)(monitor->executionTotal / monitor->jobs) / CYCLECOUNTER_CYCLES_PER_US,
+               monitor->executionMax / CYCLECOUNTER_CYCLES_PER_US);
+  }
+}
+
+
+/*************************************************************************
+* Function Name: DeadlineMonitor_ResetAll
+* Description:   Forget the statistics of every monitor
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void DeadlineMonitor_ResetAll() {
+  uint32_t i = 0;
+
+  // Not to be interrupted by the writer half way through
+  vTaskSuspendAll();
+  for (i = 0; i < DeadlineMonitor_List_Nbr; ++i) {
+    reset(DeadlineMonitor_List[i]);
+  }
+  xTaskResumeAll();
+}
@@ -0,0 +1,101 @@
+/**
+* @Filename: Deadline_Monitor.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [3:40am]
+* @Version:  1.0.0
+*
+* @Description: Release, start and finish times of periodic jobs, such as
+*               the samples of an acquisition state machine.
+*
+*               A job is due at its release tick and must finish within
+*               the deadline after it. DeadlineMonitor_Start is called when
+*               the job starts, with the tick it was due;
+*               DeadlineMonitor_Finish when it is done. A job counts as
+*                 - late       when it starts a period or more after its
+*                              release, so a whole sample period was lost
+*                 - missed     when it finishes more than the deadline
+*                              after its release
+*                 - overrun    when it takes longer than the period from
+*                              start to finish (e.g. a slow I2C read)
+*
+*               Each missed or overrun job sends a ReportName_DeadlineMiss
+*               record to ReportData, at most one per monitor every
+*               DEADLINE_MONITOR_ALERT_TICKS; the totals in the next one
+*               include those not sent. The "deadline" console command
+*               prints the summary of every monitor.
+*
+*               A monitor must have a single writer; the console may print
+*               a job half recorded.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TASKS_DEADLINE_MONITOR_H_
+#define TASKS_DEADLINE_MONITOR_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/************************************************
+* Configuration
+************************************************/
+#define DEADLINE_MONITOR_MAX_MONITORS 4
+
+// Index, and value 0 of the alerts, of a monitor that did not fit in the
+// list. It still counts its jobs but is not printed.
+#define DEADLINE_MONITOR_NO_INDEX 0xFFFFFFFF
+
+// Minimum ticks between two alerts of a monitor
+#define DEADLINE_MONITOR_ALERT_TICKS configTICK_RATE_HZ
+
+
+/************************************************
+* Types
+************************************************/
+typedef struct DeadlineMonitor {
+  const char* name;
+  uint32_t index;           // Value 0 of its alerts
+  uint32_t period;          // ticks
+  uint32_t deadline;        // ticks after the release
+
+  // Job in progress
+  uint32_t release;         // tick the job was due
+  uint32_t startTick;
+  uint32_t startCycle;
+
+  // Statistics
+  uint32_t jobs;
+  uint32_t late;
+  uint32_t misses;
+  uint32_t overruns;
+  uint32_t startDelayMax;   // ticks from release to start
+  uint32_t responseMax;     // ticks from release to finish
+  uint32_t executionMax;    // cycles from start to finish
+  uint64_t executionTotal;
+
+  // Alerts
+  bool alerted;
+  uint32_t alertTick;       // tick of the last alert sent
+} DeadlineMonitor;
+
+
+/************************************************
+* Function declarations
+************************************************/
+// Clear a monitor and add it to the list printed by
+// DeadlineMonitor_PrintAll. period and deadline are in ticks. Returns
+// false, leaving the monitor unlisted, if the list is full.
+extern bool DeadlineMonitor_Init(DeadlineMonitor* monitor, const char* name, uint32_t period, uint32_t deadline);
+
+// A job due at release starts now, or has finished
+extern void DeadlineMonitor_Start(DeadlineMonitor* monitor, uint32_t release);
+extern void DeadlineMonitor_Finish(DeadlineMonitor* monitor);
+
+// Print a summary line per monitor, or forget the statistics of all
+extern void DeadlineMonitor_PrintAll();
+extern void DeadlineMonitor_ResetAll();
+
+#endif /* TASKS_DEADLINE_MONITOR_H_ */
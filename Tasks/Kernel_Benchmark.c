@@ -0,0 +1,1286 @@
+/**
+* @Filename: Kernel_Benchmark.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [2:15am]
+* @Version:  1.0.0
+*
+* @Description: Microbenchmarks of the FreeRTOS primitives the application
+*               uses, in DWT cycles, or host nanoseconds in the host build
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include "inc/hw_ints.h"
+#ifndef KERNEL_BENCHMARK_HOST
+#include "inc/hw_memmap.h"
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "driverlib/interrupt.h"
+#ifndef KERNEL_BENCHMARK_HOST
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#endif
+
+#include "Drivers/CycleCounter.h"
+#include "Drivers/Interrupt_Priorities.h"
+#include "Drivers/Timestamp.h"
+
+#include "Tasks/Kernel_Benchmark.h"
+#include "Tasks/Log.h"
+#include "Tasks/Startup_Sync.h"
+#include "Tasks/Task_ReportData.h"
+
+#include "FreeRTOS.h"
+#include "event_groups.h"
+#include "queue.h"
+#include "semphr.h"
+#include "task.h"
+#include "timers.h"
+
+#ifdef KERNEL_BENCHMARK
+
+/************************************************
+* Local constant variables
+************************************************/
+// Unused interrupt triggered to give a semaphore from an ISR
+#define KERNEL_BENCHMARK_INTERRUPT INT_TIMER2A
+
+// Event group bits of the benchmark task and of sync_helper
+#define KERNEL_BENCHMARK_BENCH_BIT  (1 << 0)
+#define KERNEL_BENCHMARK_HELPER_BIT (1 << 1)
+#define KERNEL_BENCHMARK_BOTH_BITS  (KERNEL_BENCHMARK_BENCH_BIT | KERNEL_BENCHMARK_HELPER_BIT)
+
+// Timer whose timeouts measure interrupt latency. It counts down at the
+// system clock and reloads at each timeout, so the count its handler reads
+// tells how long ago the interrupt was raised.
+#define KERNEL_BENCHMARK_LATENCY_TIMER      TIMER3_BASE
+#define KERNEL_BENCHMARK_LATENCY_PERIPHERAL SYSCTL_PERIPH_TIMER3
+#define KERNEL_BENCHMARK_LATENCY_INTERRUPT  INT_TIMER3A
+
+// Cycles between latency timer interrupts, not a multiple of the tick so
+// they fall anywhere in the critical sections
+#define KERNEL_BENCHMARK_LATENCY_PERIOD 12007
+
+// Stack of the helper tasks, in words
+#define KERNEL_BENCHMARK_HELPER_STACK 128
+
+
+/************************************************
+* Local types
+************************************************/
+typedef struct KernelBenchmark_Result {
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint64_t total;
+} KernelBenchmark_Result;
+
+typedef struct KernelBenchmark_Baseline {
+  const char* name;
+  uint32_t mean;  // cycles, 0 if none recorded
+} KernelBenchmark_Baseline;
+
+typedef struct KernelBenchmark_Level {
+  const char* name;
+  uint32_t priority;
+} KernelBenchmark_Level;
+
+typedef struct KernelBenchmark_Queue {
+  const char* name;
+  uint32_t itemSize;
+} KernelBenchmark_Queue;
+
+// A periodic task of the scheduling comparison, deadline equal to period
+typedef struct KernelBenchmark_Periodic {
+  const char* name;
+  TickType_t period;
+  TickType_t execution;  // ticks of CPU time per job
+  bool edf;              // scheduled earliest deadline first
+  uint32_t jobs;
+  uint32_t misses;
+  TickType_t maxResponse;
+} KernelBenchmark_Periodic;
+
+
+/************************************************
+* Local constant variables
+************************************************/
+// Queues benchmarked, by item size
+const KernelBenchmark_Queue KERNEL_BENCHMARK_QUEUES[] = {
+  { "4 B", 4 },
+  { "ReportData_Item", sizeof(ReportData_Item) },
+  { "64 B", 64 }
+};
+#define KERNEL_BENCHMARK_QUEUES_NBR (sizeof(KERNEL_BENCHMARK_QUEUES) / sizeof(KERNEL_BENCHMARK_QUEUES[0]))
+
+// Batch sizes of the xQueueSendMultiple / xQueueReceiveMultiple benchmark
+const uint32_t KERNEL_BENCHMARK_BATCHES[] = { 1, 8, 64 };
+#define KERNEL_BENCHMARK_BATCHES_NBR (sizeof(KERNEL_BENCHMARK_BATCHES) / sizeof(KERNEL_BENCHMARK_BATCHES[0]))
+#define KERNEL_BENCHMARK_BATCH_MAX   64
+
+// Allocation sizes benchmarked
+const uint32_t KERNEL_BENCHMARK_MALLOC_SIZES[] = { 16, 64, 256 };
+#define KERNEL_BENCHMARK_MALLOC_SIZES_NBR (sizeof(KERNEL_BENCHMARK_MALLOC_SIZES) / sizeof(KERNEL_BENCHMARK_MALLOC_SIZES[0]))
+
+// Delayed task counts of the delayed list benchmark, ascending. Sleeper i
+// delays KERNEL_BENCHMARK_SLEEPER_PERIOD + i ticks at a time. With
+// configUSE_DELAYED_TASK_HEAP the heap must hold every task, so
+// configDELAYED_TASK_HEAP_SIZE must leave room for the other tasks.
+const uint32_t KERNEL_BENCHMARK_SLEEPERS[] = { 10, 50, 100, 200 };
+#define KERNEL_BENCHMARK_SLEEPERS_NBR   (sizeof(KERNEL_BENCHMARK_SLEEPERS) / sizeof(KERNEL_BENCHMARK_SLEEPERS[0]))
+#define KERNEL_BENCHMARK_SLEEPERS_MAX   200
+#define KERNEL_BENCHMARK_SLEEPER_PERIOD 100
+
+#if ( configUSE_DELAYED_TASK_HEAP == 1 ) && ( configDELAYED_TASK_HEAP_SIZE <= KERNEL_BENCHMARK_SLEEPERS_MAX )
+#error "configDELAYED_TASK_HEAP_SIZE must hold KERNEL_BENCHMARK_SLEEPERS_MAX sleepers and every other task"
+#endif
+
+// Active timer counts of the software timer benchmark, ascending. Timer i
+// expires KERNEL_BENCHMARK_TIMER_PERIOD + i ticks after it is started, so
+// none expires while the probe timer is measured. Tests/Test_Timers.c
+// compares both timer stores at 10, 100 and 1000 timers on the host.
+const uint32_t KERNEL_BENCHMARK_TIMERS[] = { 10, 50, 100 };
+#define KERNEL_BENCHMARK_TIMERS_NBR  (sizeof(KERNEL_BENCHMARK_TIMERS) / sizeof(KERNEL_BENCHMARK_TIMERS[0]))
+#define KERNEL_BENCHMARK_TIMERS_MAX  100
+#define KERNEL_BENCHMARK_TIMER_PERIOD (10 * configTICK_RATE_HZ)
+
+// Probe timer periods: started behind every active timer, which is the
+// longest sorted list insert, and expiring within a few ticks
+#define KERNEL_BENCHMARK_TIMER_LAST  (2 * KERNEL_BENCHMARK_TIMER_PERIOD)
+#define KERNEL_BENCHMARK_TIMER_SHORT 3
+
+// Name of the active timer store, see configUSE_TIMER_WHEEL
+#if ( configUSE_TIMER_WHEEL == 1 )
+#define KERNEL_BENCHMARK_TIMER_STORE "wheel"
+#else
+#define KERNEL_BENCHMARK_TIMER_STORE "list"
+#endif
+
+// Interrupt priorities whose latency is measured, see
+// Interrupt_Priorities.h
+const KernelBenchmark_Level KERNEL_BENCHMARK_LEVELS[] = {
+  { "zero latency", INTERRUPT_PRIORITY_PROFILER },
+  { "max syscall", configMAX_SYSCALL_INTERRUPT_PRIORITY },
+  { "kernel", configKERNEL_INTERRUPT_PRIORITY }
+};
+#define KERNEL_BENCHMARK_LEVELS_NBR (sizeof(KERNEL_BENCHMARK_LEVELS) / sizeof(KERNEL_BENCHMARK_LEVELS[0]))
+
+// Periodic task set of the scheduling comparison, name, period and
+// execution in ticks. Utilization 20/50 + 31/70 = 0.84: rate monotonic
+// priorities miss the deadlines of the second task, EDF meets all of them.
+const KernelBenchmark_Periodic KERNEL_BENCHMARK_PERIODIC[] = {
+  { "t1", 50, 20, false, 0, 0, 0 },
+  { "t2", 70, 31, false, 0, 0, 0 }
+};
+#define KERNEL_BENCHMARK_PERIODIC_NBR (sizeof(KERNEL_BENCHMARK_PERIODIC) / sizeof(KERNEL_BENCHMARK_PERIODIC[0]))
+
+// Ticks each scheduler of the comparison runs the task set for
+#define KERNEL_BENCHMARK_PERIODIC_TICKS (2 * configTICK_RATE_HZ)
+
+// Mean of a reference run per benchmark, 0 where none is recorded, which
+// prints "no baseline" with no change. To record one, copy the mean column
+// here and note the machine, compiler options and kernel options the run
+// used.
+#ifdef KERNEL_BENCHMARK_HOST
+// Nanoseconds, the median mean of 7 runs of Tests/Test_Kernel_Benchmark:
+// one core of an Intel Xeon, Debian gcc 12.2.0 -O2, Tests/Kernel
+// FreeRTOSConfig.h. Each includes a clock_gettime call of about 20 ns;
+// means vary about 15% between runs on a shared machine.
+const KernelBenchmark_Baseline KERNEL_BENCHMARK_BASELINE[] = {
+  { "queue send 4 B", 51 },
+  { "queue receive 4 B", 47 },
+  { "queue send ReportData_Item", 51 },
+  { "queue receive ReportData_Item", 49 },
+  { "queue send 64 B", 55 },
+  { "queue receive 64 B", 54 },
+  { "queue send multiple per item 1", 52 },
+  { "queue receive multiple per item 1", 49 },
+  { "queue send multiple per item 8", 12 },
+  { "queue receive multiple per item 8", 10 },
+  { "queue send multiple per item 64", 8 },
+  { "queue receive multiple per item 64", 7 },
+  { "semaphore give", 55 },
+  { "semaphore take", 53 }
+};
+#else
+// Cycles on the board. No board run has been recorded: the host run above
+// is the reference the queue changes are measured against.
+const KernelBenchmark_Baseline KERNEL_BENCHMARK_BASELINE[] = {
+  { "queue send 4 B", 0 },
+  { "queue receive 4 B", 0 },
+  { "queue send ReportData_Item", 0 },
+  { "queue receive ReportData_Item", 0 },
+  { "queue send 64 B", 0 },
+  { "queue receive 64 B", 0 },
+  { "queue send multiple per item 1", 0 },
+  { "queue receive multiple per item 1", 0 },
+  { "queue send multiple per item 8", 0 },
+  { "queue receive multiple per item 8", 0 },
+  { "queue send multiple per item 64", 0 },
+  { "queue receive multiple per item 64", 0 },
+  { "semaphore give", 0 },
+  { "semaphore take", 0 },
+  { "semaphore give from ISR", 0 },
+  { "ISR give to task running", 0 },
+  { "task give to task running", 0 },
+  { "yield to task running", 0 },
+  { "tick to vTaskDelay return", 0 },
+  { "pvPortMalloc 16", 0 },
+  { "vPortFree 16", 0 },
+  { "pvPortMalloc 64", 0 },
+  { "vPortFree 64", 0 },
+  { "pvPortMalloc 256", 0 },
+  { "vPortFree 256", 0 },
+  { "event group sync", 0 },
+  { "delay block, delayed 10", 0 },
+  { "delay wake, delayed 10", 0 },
+  { "delay block, delayed 50", 0 },
+  { "delay wake, delayed 50", 0 },
+  { "delay block, delayed 100", 0 },
+  { "delay wake, delayed 100", 0 },
+  { "delay block, delayed 200", 0 },
+  { "delay wake, delayed 200", 0 },
+  { "timer start list, active 10", 0 },
+  { "timer expire list, active 10", 0 },
+  { "timer start list, active 50", 0 },
+  { "timer expire list, active 50", 0 },
+  { "timer start list, active 100", 0 },
+  { "timer expire list, active 100", 0 },
+  { "timer start wheel, active 10", 0 },
+  { "timer expire wheel, active 10", 0 },
+  { "timer start wheel, active 50", 0 },
+  { "timer expire wheel, active 50", 0 },
+  { "timer start wheel, active 100", 0 },
+  { "timer expire wheel, active 100", 0 },
+  { "interrupt latency zero latency", 0 },
+  { "interrupt latency max syscall", 0 },
+  { "interrupt latency kernel", 0 }
+};
+#endif
+#define KERNEL_BENCHMARK_BASELINE_NBR (sizeof(KERNEL_BENCHMARK_BASELINE) / sizeof(KERNEL_BENCHMARK_BASELINE[0]))
+
+
+/************************************************
+* Local variables
+************************************************/
+SemaphoreHandle_t KernelBenchmark_Requested = NULL;
+
+// Given to wake_helper, and to start yield_helper
+SemaphoreHandle_t KernelBenchmark_Wake = NULL;
+SemaphoreHandle_t KernelBenchmark_YieldStart = NULL;
+SemaphoreHandle_t KernelBenchmark_BlockStart = NULL;
+EventGroupHandle_t KernelBenchmark_Group = NULL;
+
+// Cycle count when a wake-up was started, and where the woken task adds
+// the time it took
+volatile uint32_t KernelBenchmark_Start = 0;
+KernelBenchmark_Result* volatile KernelBenchmark_Woken = NULL;
+
+// Set by yield_helper each time it runs
+volatile bool KernelBenchmark_Yielding = false;
+volatile uint32_t KernelBenchmark_YieldStamp = 0;
+
+// Set by block_helper when the benchmark task blocks
+volatile uint32_t KernelBenchmark_BlockStamp = 0;
+
+// Periodic tasks filling the delayed list
+TaskHandle_t KernelBenchmark_Sleepers[KERNEL_BENCHMARK_SLEEPERS_MAX];
+
+#if ( configUSE_TIMERS == 1 )
+// Timers filling the active timer store, and the probe timer's expiry
+// times, given by its callback
+TimerHandle_t KernelBenchmark_Timers[KERNEL_BENCHMARK_TIMERS_MAX];
+KernelBenchmark_Result KernelBenchmark_TimerExpire;
+SemaphoreHandle_t KernelBenchmark_TimerExpired = NULL;
+#endif
+
+KernelBenchmark_Result KernelBenchmark_IsrGive;
+
+// Filled by latency_isr
+KernelBenchmark_Result KernelBenchmark_Latency;
+
+// Scheduling comparison: the running task set, busy loop iterations per
+// tick of CPU time, and the stop request and its acknowledgements
+KernelBenchmark_Periodic KernelBenchmark_Periodics[KERNEL_BENCHMARK_PERIODIC_NBR];
+uint32_t KernelBenchmark_SpinsPerTick = 0;
+volatile bool KernelBenchmark_PeriodicStop = false;
+SemaphoreHandle_t KernelBenchmark_PeriodicDone = NULL;
+volatile uint32_t KernelBenchmark_Spin = 0;
+
+
+/************************************************
+* Local function declarations
+************************************************/
+static void result_reset(KernelBenchmark_Result* result);
+static void result_add(KernelBenchmark_Result* result, uint32_t cycles);
+static void result_print(const char* prefix, const char* name, const KernelBenchmark_Result* result);
+static void bench_queue(const KernelBenchmark_Queue* queue);
+static void bench_queue_multiple(uint32_t batch);
+static void bench_semaphore();
+#ifndef KERNEL_BENCHMARK_HOST
+static void wake_helper(void* pvParameters);
+static void sync_helper(void* pvParameters);
+static void yield_helper(void* pvParameters);
+static void block_helper(void* pvParameters);
+static void sleeper(void* pvParameters);
+static void timer_idle(TimerHandle_t xTimer);
+static void timer_probe(TimerHandle_t xTimer);
+static void spin(uint32_t iterations);
+static void periodic(void* pvParameters);
+static void isr_give(void);
+static void latency_isr(void);
+static void bench_wake();
+static void bench_yield();
+static void bench_delay();
+static void bench_malloc(uint32_t size);
+static void bench_event_group();
+static void bench_delayed_tasks();
+static void bench_timers();
+static void bench_scheduler(bool edf);
+static void bench_interrupt_latency(const KernelBenchmark_Level* level);
+#endif /* KERNEL_BENCHMARK_HOST */
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: result_reset
+* Description:   Clear a result
+* Parameters:    KernelBenchmark_Result* result
+* Return:        void
+*************************************************************************/
+static void result_reset(KernelBenchmark_Result* result) {
+  result->count = 0;
+  result->min = UINT32_MAX;
+  result->max = 0;
+  result->total = 0;
+}
+
+
+/*************************************************************************
+* Function Name: result_add
+* Description:   Count one run
+* Parameters:    KernelBenchmark_Result* result
+*                uint32_t cycles
+* Return:        void
+*************************************************************************/
+static void result_add(KernelBenchmark_Result* result, uint32_t cycles) {
+  result->count++;
+  result->total += cycles;
+  if (cycles < result->min) {
+    result->min = cycles;
+  }
+  if (cycles > result->max) {
+    result->max = cycles;
+  }
+}
+
+
+/*************************************************************************
+* Function Name: result_print
+* Description:   Print one result and its change from the baseline
+* Parameters:    const char* prefix
+*                const char* name - appended to prefix, may be ""
+*                const KernelBenchmark_Result* result
+* Return:        void
+*************************************************************************/
+static void result_print(const char* prefix, const char* name, const KernelBenchmark_Result* result) {
+  char fullName[40];
+  uint32_t mean = 0;
+  uint32_t baseline = 0;
+  uint32_t i = 0;
+
+  strncpy(fullName, prefix, sizeof(fullName) - 1);
+  fullName[sizeof(fullName) - 1] = '\0';
+  if (name[0] != '\0') {
+    strncat(fullName, " ", sizeof(fullName) - strlen(fullName) - 1);
+    strncat(fullName, name, sizeof(fullName) - strlen(fullName) - 1);
+  }
+
+  if (result->count == 0) {
+    Log_Printf("bench,%s,0,,,,,\n", fullName);
+    return;
+  }
+  mean = (uint32_t)(result->total / result->count);
+
+  for (i = 0; i < KERNEL_BENCHMARK_BASELINE_NBR; ++i) {
+    if (strcmp(KERNEL_BENCHMARK_BASELINE[i].name, fullName) == 0) {
+      baseline = KERNEL_BENCHMARK_BASELINE[i].mean;
+      break;
+    }
+  }
+
+  if (baseline == 0) {
+    // Nothing recorded to compare against, a change would be meaningless
+    Log_Printf("bench,%s,%u,%u,%u,%u,no baseline,\n", fullName, result->count, result->min, mean, result->max);
+  }
+  else {
+    // Tenths of a percent
+    int32_t change = (int32_t)(((int64_t)mean - baseline) * 1000 / baseline);
+    uint32_t magnitude = (change < 0) ? -change : change;
+
+    Log_Printf("bench,%s,%u,%u,%u,%u,%u,%s%u.%u\n", fullName, result->count, result->min, mean,
+               result->max, baseline, (change < 0) ? "-" : "", magnitude / 10, magnitude % 10);
+  }
+}
+
+
+#ifndef KERNEL_BENCHMARK_HOST
+/*************************************************************************
+* Function Name: wake_helper
+* Description:   Take KernelBenchmark_Wake and time how long the wake-up
+*                took
+* Parameters:    void* pvParameters
+* Return:        void
+*************************************************************************/
+static void wake_helper(void* pvParameters) {
+  while (1) {
+    xSemaphoreTake(KernelBenchmark_Wake, portMAX_DELAY);
+    result_add(KernelBenchmark_Woken, CycleCounter_Get() - KernelBenchmark_Start);
+  }
+}
+
+
+/*************************************************************************
+* Function Name: sync_helper
+* Description:   Meet the benchmark task at KernelBenchmark_Group and time
+*                how long the meeting took
+* Parameters:    void* pvParameters
+* Return:        void
+*************************************************************************/
+static void sync_helper(void* pvParameters) {
+  while (1) {
+    xEventGroupSync(KernelBenchmark_Group, KERNEL_BENCHMARK_HELPER_BIT, KERNEL_BENCHMARK_BOTH_BITS,
+                    portMAX_DELAY);
+    result_add(KernelBenchmark_Woken, CycleCounter_Get() - KernelBenchmark_Start);
+  }
+}
+
+
+/*************************************************************************
+* Function Name: yield_helper
+* Description:   While KernelBenchmark_Yielding, stamp and yield back to
+*                the benchmark task
+* Parameters:    void* pvParameters
+* Return:        void
+*************************************************************************/
+static void yield_helper(void* pvParameters) {
+  while (1) {
+    xSemaphoreTake(KernelBenchmark_YieldStart, portMAX_DELAY);
+
+    while (KernelBenchmark_Yielding) {
+      KernelBenchmark_YieldStamp = CycleCounter_Get();
+      taskYIELD();
+    }
+  }
+}
+
+
+/*************************************************************************
+* Function Name: block_helper
+* Description:   Stamp the first time it runs after each give of
+*                KernelBenchmark_BlockStart
+* Parameters:    void* pvParameters
+* Return:        void
+*************************************************************************/
+static void block_helper(void* pvParameters) {
+  while (1) {
+    xSemaphoreTake(KernelBenchmark_BlockStart, portMAX_DELAY);
+    KernelBenchmark_BlockStamp = CycleCounter_Get();
+  }
+}
+
+
+/*************************************************************************
+* Function Name: sleeper
+* Description:   Periodic task that keeps itself on the delayed list
+* Parameters:    void* pvParameters - index, added to the period
+* Return:        void
+*************************************************************************/
+static void sleeper(void* pvParameters) {
+  const TickType_t period = KERNEL_BENCHMARK_SLEEPER_PERIOD + (TickType_t)(uint32_t)pvParameters;
+
+  while (1) {
+    vTaskDelay(period);
+  }
+}
+
+
+/*************************************************************************
+* Function Name: timer_idle
+* Description:   Callback of the timers filling the active timer store
+* Parameters:    TimerHandle_t xTimer
+* Return:        void
+*************************************************************************/
+static void timer_idle(TimerHandle_t xTimer) {
+  (void)xTimer;
+}
+
+
+/*************************************************************************
+* Function Name: timer_probe
+* Description:   Time from the tick to the probe timer's callback, from
+*                the SysTick count
+* Parameters:    TimerHandle_t xTimer
+* Return:        void
+*************************************************************************/
+static void timer_probe(TimerHandle_t xTimer) {
+  (void)xTimer;
+
+#if ( configUSE_TIMERS == 1 )
+  result_add(&KernelBenchmark_TimerExpire, TIMESTAMP_SYSTICK_LOAD - TIMESTAMP_SYSTICK_CURRENT);
+  xSemaphoreGive(KernelBenchmark_TimerExpired);
+#endif
+}
+
+
+/*************************************************************************
+* Function Name: spin
+* Description:   Busy loop, KernelBenchmark_SpinsPerTick iterations per
+*                tick of CPU time
+* Parameters:    uint32_t iterations
+* Return:        void
+*************************************************************************/
+static void spin(uint32_t iterations) {
+  uint32_t i = 0;
+
+  for (i = 0; i < iterations; ++i) {
+    KernelBenchmark_Spin++;
+  }
+}
+
+
+/*************************************************************************
+* Function Name: periodic
+* Description:   Task of the scheduling comparison. Runs jobs of its
+*                execution time each period, released together with the
+*                rest of the set, until KernelBenchmark_PeriodicStop.
+* Parameters:    void* pvParameters - KernelBenchmark_Periodic*
+* Return:        void
+*************************************************************************/
+static void periodic(void* pvParameters) {
+  KernelBenchmark_Periodic* task = (KernelBenchmark_Periodic*)pvParameters;
+  TickType_t release = xTaskGetTickCount();
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+  if (task->edf) {
+    vTaskSetPeriod(task->period, task->period);
+  }
+#endif
+
+  while (!KernelBenchmark_PeriodicStop) {
+    TickType_t response = 0;
+
+    spin(task->execution * KernelBenchmark_SpinsPerTick);
+
+    response = xTaskGetTickCount() - release;
+    task->jobs++;
+    if (response > task->period) {
+      task->misses++;
+    }
+    if (response > task->maxResponse) {
+      task->maxResponse = response;
+    }
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    if (task->edf) {
+      release += task->period;
+      vTaskWaitForNextPeriod();
+      continue;
+    }
+#endif
+
+    vTaskDelayUntil(&release, task->period);
+  }
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+  // The kernel's count, from releases it timed itself
+  if (task->edf) {
+    task->misses = uxTaskGetDeadlineMisses(NULL);
+  }
+#endif
+
+  xSemaphoreGive(KernelBenchmark_PeriodicDone);
+  vTaskDelete(NULL);
+}
+
+
+/*************************************************************************
+* Function Name: isr_give
+* Description:   Give KernelBenchmark_Wake from an interrupt
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void isr_give(void) {
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  uint32_t start = CycleCounter_Get();
+
+  xSemaphoreGiveFromISR(KernelBenchmark_Wake, &xHigherPriorityTaskWoken);
+  result_add(&KernelBenchmark_IsrGive, CycleCounter_Get() - start);
+
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+
+/*************************************************************************
+* Function Name: latency_isr
+* Description:   Record the cycles since the latency timer timed out. Does
+*                not call FreeRTOS, so it may run at any priority.
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void latency_isr(void) {
+  uint32_t cycles = (KERNEL_BENCHMARK_LATENCY_PERIOD - 1) - TimerValueGet(KERNEL_BENCHMARK_LATENCY_TIMER, TIMER_A);
+
+  TimerIntClear(KERNEL_BENCHMARK_LATENCY_TIMER, TIMER_TIMA_TIMEOUT);
+  result_add(&KernelBenchmark_Latency, cycles);
+}
+#endif /* KERNEL_BENCHMARK_HOST */
+
+
+/*************************************************************************
+* Function Name: bench_queue
+* Description:   Send to and receive from a queue without blocking
+* Parameters:    const KernelBenchmark_Queue* queue
+* Return:        void
+*************************************************************************/
+static void bench_queue(const KernelBenchmark_Queue* queue) {
+  KernelBenchmark_Result send;
+  KernelBenchmark_Result receive;
+  uint8_t item[64];
+  QueueHandle_t handle = xQueueCreate(1, queue->itemSize);
+  uint32_t i = 0;
+
+  result_reset(&send);
+  result_reset(&receive);
+  memset(item, 0, sizeof(item));
+
+  if (handle != NULL) {
+    for (i = 0; i < KERNEL_BENCHMARK_RUNS; ++i) {
+      uint32_t start = CycleCounter_Get();
+      xQueueSend(handle, item, 0);
+      result_add(&send, CycleCounter_Get() - start);
+
+      start = CycleCounter_Get();
+      xQueueReceive(handle, item, 0);
+      result_add(&receive, CycleCounter_Get() - start);
+    }
+    vQueueDelete(handle);
+  }
+
+  result_print("queue send", queue->name, &send);
+  result_print("queue receive", queue->name, &receive);
+}
+
+
+
+
+/*************************************************************************
+* Function Name: bench_queue_multiple
+* Description:   Send and receive ReportData_Items a batch at a time, per
+*                item
+* Parameters:    uint32_t batch - at most KERNEL_BENCHMARK_BATCH_MAX
+* Return:        void
+*************************************************************************/
+static void bench_queue_multiple(uint32_t batch) {
+  static ReportData_Item items[KERNEL_BENCHMARK_BATCH_MAX];
+  KernelBenchmark_Result send;
+  KernelBenchmark_Result receive;
+  QueueHandle_t handle = xQueueCreate(KERNEL_BENCHMARK_BATCH_MAX, sizeof(ReportData_Item));
+  char name[12];
+  uint32_t i = 0;
+
+  result_reset(&send);
+  result_reset(&receive);
+  memset(items, 0, sizeof(items));
+
+  if (handle != NULL) {
+    for (i = 0; i < KERNEL_BENCHMARK_RUNS; ++i) {
+      uint32_t start = CycleCounter_Get();
+      xQueueSendMultiple(handle, items, batch, 0);
+      result_add(&send, (CycleCounter_Get() - start) / batch);
+
+      start = CycleCounter_Get();
+      xQueueReceiveMultiple(handle, items, batch, 0);
+      result_add(&receive, (CycleCounter_Get() - start) / batch);
+    }
+    vQueueDelete(handle);
+  }
+
+  snprintf(name, sizeof(name), "%u", batch);
+  result_print("queue send multiple per item", name, &send);
+  result_print("queue receive multiple per item", name, &receive);
+}
+
+
+/*************************************************************************
+* Function Name: bench_semaphore
+* Description:   Give and take a binary semaphore nobody waits on
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void bench_semaphore() {
+  KernelBenchmark_Result give;
+  KernelBenchmark_Result take;
+  SemaphoreHandle_t semaphore = xSemaphoreCreateBinary();
+  uint32_t i = 0;
+
+  result_reset(&give);
+  result_reset(&take);
+
+  if (semaphore != NULL) {
+    for (i = 0; i < KERNEL_BENCHMARK_RUNS; ++i) {
+      uint32_t start = CycleCounter_Get();
+      xSemaphoreGive(semaphore);
+      result_add(&give, CycleCounter_Get() - start);
+
+      start = CycleCounter_Get();
+      xSemaphoreTake(semaphore, 0);
+      result_add(&take, CycleCounter_Get() - start);
+    }
+    vSemaphoreDelete(semaphore);
+  }
+
+  result_print("semaphore give", "", &give);
+  result_print("semaphore take", "", &take);
+}
+
+
+#ifndef KERNEL_BENCHMARK_HOST
+/*************************************************************************
+* Function Name: bench_wake
+* Description:   Wake wake_helper by giving its semaphore from this task
+*                and from an interrupt
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void bench_wake() {
+  KernelBenchmark_Result fromTask;
+  KernelBenchmark_Result fromIsr;
+  uint32_t i = 0;
+
+  result_reset(&fromTask);
+  result_reset(&fromIsr);
+  result_reset(&KernelBenchmark_IsrGive);
+
+  KernelBenchmark_Woken = &fromTask;
+  for (i = 0; i < KERNEL_BENCHMARK_RUNS; ++i) {
+    KernelBenchmark_Start = CycleCounter_Get();
+    xSemaphoreGive(KernelBenchmark_Wake);
+  }
+
+  IntRegister(KERNEL_BENCHMARK_INTERRUPT, isr_give);
+  IntPrioritySet(KERNEL_BENCHMARK_INTERRUPT, INTERRUPT_PRIORITY_SOFTWARE);
+  IntEnable(KERNEL_BENCHMARK_INTERRUPT);
+
+  KernelBenchmark_Woken = &fromIsr;
+  for (i = 0; i < KERNEL_BENCHMARK_RUNS; ++i) {
+    KernelBenchmark_Start = CycleCounter_Get();
+    IntTrigger(KERNEL_BENCHMARK_INTERRUPT);
+  }
+
+  IntDisable(KERNEL_BENCHMARK_INTERRUPT);
+  IntUnregister(KERNEL_BENCHMARK_INTERRUPT);
+
+  result_print("semaphore give from ISR", "", &KernelBenchmark_IsrGive);
+  result_print("ISR give to task running", "", &fromIsr);
+  result_print("task give to task running", "", &fromTask);
+}
+
+
+/*************************************************************************
+* Function Name: bench_yield
+* Description:   Switch to yield_helper and back with taskYIELD
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void bench_yield() {
+  KernelBenchmark_Result result;
+  uint32_t i = 0;
+
+  result_reset(&result);
+
+  // yield_helper has this task's priority, so it waits for the first yield
+  KernelBenchmark_Yielding = true;
+  xSemaphoreGive(KernelBenchmark_YieldStart);
+  taskYIELD();
+
+  for (i = 0; i < KERNEL_BENCHMARK_RUNS; ++i) {
+    uint32_t start = CycleCounter_Get();
+    taskYIELD();
+    result_add(&result, KernelBenchmark_YieldStamp - start);
+  }
+
+  KernelBenchmark_Yielding = false;
+  taskYIELD();
+
+  result_print("yield to task running", "", &result);
+}
+
+
+/*************************************************************************
+* Function Name: bench_delay
+* Description:   Time from the tick to vTaskDelay( 1 ) returning, from the
+*                SysTick count
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void bench_delay() {
+  KernelBenchmark_Result result;
+  uint32_t i = 0;
+
+  result_reset(&result);
+
+  // Start just after a tick
+  vTaskDelay(1);
+
+  for (i = 0; i < KERNEL_BENCHMARK_DELAY_RUNS; ++i) {
+    vTaskDelay(1);
+    result_add(&result, TIMESTAMP_SYSTICK_LOAD - TIMESTAMP_SYSTICK_CURRENT);
+  }
+
+  result_print("tick to vTaskDelay return", "", &result);
+}
+
+
+/*************************************************************************
+* Function Name: bench_malloc
+* Description:   Allocate and free one block
+* Parameters:    uint32_t size
+* Return:        void
+*************************************************************************/
+static void bench_malloc(uint32_t size) {
+  KernelBenchmark_Result allocate;
+  KernelBenchmark_Result release;
+  char name[12];
+  uint32_t i = 0;
+
+  result_reset(&allocate);
+  result_reset(&release);
+
+  for (i = 0; i < KERNEL_BENCHMARK_RUNS; ++i) {
+    uint32_t start = CycleCounter_Get();
+    void* block = pvPortMalloc(size);
+    result_add(&allocate, CycleCounter_Get() - start);
+
+    if (block == NULL) {
+      break;
+    }
+
+    start = CycleCounter_Get();
+    vPortFree(block);
+    result_add(&release, CycleCounter_Get() - start);
+  }
+
+  snprintf(name, sizeof(name), "%u", size);
+  result_print("pvPortMalloc", name, &allocate);
+  result_print("vPortFree", name, &release);
+}
+
+
+/*************************************************************************
+* Function Name: bench_event_group
+* Description:   Meet sync_helper at an event group
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void bench_event_group() {
+  KernelBenchmark_Result result;
+  uint32_t i = 0;
+
+  result_reset(&result);
+  KernelBenchmark_Woken = &result;
+
+  for (i = 0; i < KERNEL_BENCHMARK_RUNS; ++i) {
+    KernelBenchmark_Start = CycleCounter_Get();
+    xEventGroupSync(KernelBenchmark_Group, KERNEL_BENCHMARK_BENCH_BIT, KERNEL_BENCHMARK_BOTH_BITS,
+                    portMAX_DELAY);
+  }
+
+  result_print("event group sync", "", &result);
+}
+
+
+/*************************************************************************
+* Function Name: bench_delayed_tasks
+* Description:   Block in and wake from vTaskDelay with growing numbers of
+*                periodic tasks on the delayed list. The benchmark task
+*                wakes after all of them, so with sorted delayed lists it is
+*                inserted behind every one.
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void bench_delayed_tasks() {
+  KernelBenchmark_Result block;
+  KernelBenchmark_Result wake;
+  char name[12];
+  uint32_t created = 0;
+  uint32_t n = 0;
+  uint32_t i = 0;
+
+  for (n = 0; n < KERNEL_BENCHMARK_SLEEPERS_NBR; ++n) {
+    const uint32_t count = KERNEL_BENCHMARK_SLEEPERS[n];
+
+#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+    // xTaskCreate asserts the heap holds every task; stop short of that
+    if ((uxTaskGetNumberOfTasks() - created + count) > configDELAYED_TASK_HEAP_SIZE) {
+      Log_Printf("kernel benchmark: %u delayed tasks skipped, the delayed task heap holds %u tasks\n", count,
+                 configDELAYED_TASK_HEAP_SIZE);
+      break;
+    }
+#endif
+
+    for (; created < count; ++created) {
+      if (xTaskCreate(sleeper, "BenchSleep", configMINIMAL_STACK_SIZE, (void*)created, tskIDLE_PRIORITY + 1,
+                      &KernelBenchmark_Sleepers[created]) != pdPASS) {
+        break;
+      }
+    }
+
+    if (created < count) {
+      Log_Printf("kernel benchmark: heap full after %u delayed tasks\n", created);
+      break;
+    }
+
+    // Let every sleeper reach its first vTaskDelay
+    vTaskDelay(KERNEL_BENCHMARK_SLEEPER_PERIOD);
+
+    result_reset(&block);
+    result_reset(&wake);
+
+    for (i = 0; i < KERNEL_BENCHMARK_DELAY_RUNS; ++i) {
+      uint32_t start = 0;
+
+      // block_helper runs as soon as this task blocks
+      xSemaphoreGive(KernelBenchmark_BlockStart);
+      start = CycleCounter_Get();
+      vTaskDelay(KERNEL_BENCHMARK_SLEEPER_PERIOD + count);
+      result_add(&block, KernelBenchmark_BlockStamp - start);
+      result_add(&wake, TIMESTAMP_SYSTICK_LOAD - TIMESTAMP_SYSTICK_CURRENT);
+    }
+
+    snprintf(name, sizeof(name), "%u", count);
+    result_print("delay block, delayed", name, &block);
+    result_print("delay wake, delayed", name, &wake);
+  }
+
+  // The idle task frees them
+  for (i = 0; i < created; ++i) {
+    vTaskDelete(KernelBenchmark_Sleepers[i]);
+  }
+}
+
+
+/*************************************************************************
+* Function Name: bench_timers
+* Description:   Start and expiry of a software timer with
+*                KERNEL_BENCHMARK_TIMERS other timers active, in the store
+*                selected by configUSE_TIMER_WHEEL. A start is timed from
+*                xTimerChangePeriod, which starts the timer, to its return,
+*                which includes the timer service task inserting the timer
+*                when that task has the higher priority.
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void bench_timers() {
+#if ( configUSE_TIMERS == 1 )
+  KernelBenchmark_Result start;
+  TimerHandle_t probe = NULL;
+  char name[24];
+  uint32_t created = 0;
+  uint32_t n = 0;
+  uint32_t i = 0;
+
+  if (configTIMER_TASK_PRIORITY <= KERNEL_BENCHMARK_PRIORITY) {
+    Log_Printf("kernel benchmark: timer task priority %u, timer start times exclude the insert\n",
+               configTIMER_TASK_PRIORITY);
+  }
+
+  probe = xTimerCreate("BenchProbe", KERNEL_BENCHMARK_TIMER_LAST, pdFALSE, NULL, timer_probe);
+  if (probe == NULL) {
+    Log_Printf("kernel benchmark: no heap for the probe timer\n");
+    return;
+  }
+
+  for (n = 0; n < KERNEL_BENCHMARK_TIMERS_NBR; ++n) {
+    const uint32_t count = KERNEL_BENCHMARK_TIMERS[n];
+
+    for (; created < count; ++created) {
+      KernelBenchmark_Timers[created] = xTimerCreate("BenchTimer", KERNEL_BENCHMARK_TIMER_PERIOD + created, pdFALSE,
+                                                     NULL, timer_idle);
+      if (KernelBenchmark_Timers[created] == NULL) {
+        break;
+      }
+    }
+
+    if (created < count) {
+      Log_Printf("kernel benchmark: heap full after %u timers\n", created);
+      break;
+    }
+
+    // Every timer restarts its period, so none expires during this count
+    for (i = 0; i < count; ++i) {
+      xTimerStart(KernelBenchmark_Timers[i], portMAX_DELAY);
+    }
+
+    result_reset(&start);
+    for (i = 0; i < KERNEL_BENCHMARK_RUNS; ++i) {
+      uint32_t begin = CycleCounter_Get();
+      xTimerChangePeriod(probe, KERNEL_BENCHMARK_TIMER_LAST, portMAX_DELAY);
+      result_add(&start, CycleCounter_Get() - begin);
+      xTimerStop(probe, portMAX_DELAY);
+    }
+
+    result_reset(&KernelBenchmark_TimerExpire);
+    xSemaphoreTake(KernelBenchmark_TimerExpired, 0);
+    for (i = 0; i < KERNEL_BENCHMARK_DELAY_RUNS; ++i) {
+      xTimerChangePeriod(probe, KERNEL_BENCHMARK_TIMER_SHORT, portMAX_DELAY);
+      if (xSemaphoreTake(KernelBenchmark_TimerExpired, KERNEL_BENCHMARK_TIMER_PERIOD) != pdPASS) {
+        break;
+      }
+    }
+
+    snprintf(name, sizeof(name), KERNEL_BENCHMARK_TIMER_STORE ", active %u", count);
+    result_print("timer start", name, &start);
+    result_print("timer expire", name, &KernelBenchmark_TimerExpire);
+  }
+
+  for (i = 0; i < created; ++i) {
+    xTimerDelete(KernelBenchmark_Timers[i], portMAX_DELAY);
+  }
+  xTimerDelete(probe, portMAX_DELAY);
+#else
+  Log_Printf("kernel benchmark: timers not built, define configUSE_TIMERS=1\n");
+#endif
+}
+
+
+/*************************************************************************
+* Function Name: bench_scheduler
+* Description:   Run KERNEL_BENCHMARK_PERIODIC for
+*                KERNEL_BENCHMARK_PERIODIC_TICKS with rate monotonic
+*                priorities from KERNEL_BENCHMARK_PRIORITY up, or earliest
+*                deadline first at configEDF_PRIORITY, and print the jobs,
+*                deadline misses and worst response time of each task
+* Parameters:    bool edf
+* Return:        void
+*************************************************************************/
+static void bench_scheduler(bool edf) {
+  const char* scheduler = edf ? "edf" : "rate monotonic";
+  uint32_t created = 0;
+  uint32_t i = 0;
+
+#if ( configUSE_EDF_SCHEDULING == 0 )
+  if (edf) {
+    Log_Printf("sched,edf not built, define configUSE_EDF_SCHEDULING=1\n");
+    return;
+  }
+#endif
+
+  memcpy(KernelBenchmark_Periodics, KERNEL_BENCHMARK_PERIODIC, sizeof(KernelBenchmark_Periodics));
+  KernelBenchmark_PeriodicStop = false;
+
+  // Release the whole set at once. KERNEL_BENCHMARK_PERIODIC is in rate
+  // monotonic order, shortest period first.
+  vTaskSuspendAll();
+  for (i = 0; i < KERNEL_BENCHMARK_PERIODIC_NBR; ++i) {
+    UBaseType_t priority = KERNEL_BENCHMARK_PRIORITY + KERNEL_BENCHMARK_PERIODIC_NBR - 1 - i;
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    if (edf) {
+      priority = configEDF_PRIORITY;
+    }
+#endif
+
+    KernelBenchmark_Periodics[i].edf = edf;
+    if (xTaskCreate(periodic, "BenchPeriodic", KERNEL_BENCHMARK_HELPER_STACK, &KernelBenchmark_Periodics[i], priority,
+                    NULL) == pdPASS) {
+      created++;
+    }
+  }
+  xTaskResumeAll();
+
+  vTaskDelay(KERNEL_BENCHMARK_PERIODIC_TICKS);
+
+  KernelBenchmark_PeriodicStop = true;
+  for (i = 0; i < created; ++i) {
+    xSemaphoreTake(KernelBenchmark_PeriodicDone, portMAX_DELAY);
+  }
+
+  if (created < KERNEL_BENCHMARK_PERIODIC_NBR) {
+    Log_Printf("kernel benchmark: heap full after %u periodic tasks\n", created);
+    return;
+  }
+
+  for (i = 0; i < KERNEL_BENCHMARK_PERIODIC_NBR; ++i) {
+    const KernelBenchmark_Periodic* task = &KernelBenchmark_Periodics[i];
+
+    Log_Printf("sched,%s,%s,%u,%u,%u,%u,%u\n", scheduler, task->name, task->period, task->execution, task->jobs,
+               task->misses, task->maxResponse);
+  }
+}
+
+
+/*************************************************************************
+* Function Name: bench_interrupt_latency
+* Description:   Cycles from a timer timeout to its handler at one
+*                priority, while this task keeps entering critical
+*                sections of about a tenth of a tick. Kernel aware
+*                priorities wait for the critical section to end, zero
+*                latency ones do not.
+* Parameters:    const KernelBenchmark_Level* level
+* Return:        void
+*************************************************************************/
+static void bench_interrupt_latency(const KernelBenchmark_Level* level) {
+  result_reset(&KernelBenchmark_Latency);
+
+  IntRegister(KERNEL_BENCHMARK_LATENCY_INTERRUPT, latency_isr);
+  IntPrioritySet(KERNEL_BENCHMARK_LATENCY_INTERRUPT, level->priority);
+  TimerConfigure(KERNEL_BENCHMARK_LATENCY_TIMER, TIMER_CFG_PERIODIC);
+  TimerLoadSet(KERNEL_BENCHMARK_LATENCY_TIMER, TIMER_A, KERNEL_BENCHMARK_LATENCY_PERIOD - 1);
+  TimerIntEnable(KERNEL_BENCHMARK_LATENCY_TIMER, TIMER_TIMA_TIMEOUT);
+  IntEnable(KERNEL_BENCHMARK_LATENCY_INTERRUPT);
+  TimerEnable(KERNEL_BENCHMARK_LATENCY_TIMER, TIMER_A);
+
+  while (KernelBenchmark_Latency.count < KERNEL_BENCHMARK_RUNS) {
+    taskENTER_CRITICAL();
+    spin(KernelBenchmark_SpinsPerTick / 10);
+    taskEXIT_CRITICAL();
+    spin(KernelBenchmark_SpinsPerTick / 10);
+  }
+
+  TimerDisable(KERNEL_BENCHMARK_LATENCY_TIMER, TIMER_A);
+  IntDisable(KERNEL_BENCHMARK_LATENCY_INTERRUPT);
+  TimerIntClear(KERNEL_BENCHMARK_LATENCY_TIMER, TIMER_TIMA_TIMEOUT);
+  IntUnregister(KERNEL_BENCHMARK_LATENCY_INTERRUPT);
+
+  result_print("interrupt latency", level->name, &KernelBenchmark_Latency);
+}
+#endif /* KERNEL_BENCHMARK_HOST */
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: KernelBenchmark_RunQueues
+* Description:   Time the queue and semaphore calls that need no other
+*                task
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void KernelBenchmark_RunQueues() {
+  uint32_t i = 0;
+
+  for (i = 0; i < KERNEL_BENCHMARK_QUEUES_NBR; ++i) {
+    bench_queue(&KERNEL_BENCHMARK_QUEUES[i]);
+  }
+  for (i = 0; i < KERNEL_BENCHMARK_BATCHES_NBR; ++i) {
+    bench_queue_multiple(KERNEL_BENCHMARK_BATCHES[i]);
+  }
+  bench_semaphore();
+}
+
+
+#ifndef KERNEL_BENCHMARK_HOST
+/*************************************************************************
+* Function Name: Task_KernelBenchmark
+* Description:   Run the suite now and on each KernelBenchmark_Request
+* Parameters:    void* pvParameters
+* Return:        void
+*************************************************************************/
+extern void Task_KernelBenchmark(void* pvParameters) {
+  uint32_t i = 0;
+
+  CycleCounter_Initialization();
+  SysCtlPeripheralEnable(KERNEL_BENCHMARK_LATENCY_PERIPHERAL);
+
+  KernelBenchmark_Requested = xSemaphoreCreateBinary();
+  KernelBenchmark_Wake = xSemaphoreCreateBinary();
+  KernelBenchmark_YieldStart = xSemaphoreCreateBinary();
+  KernelBenchmark_BlockStart = xSemaphoreCreateBinary();
+  KernelBenchmark_Group = xEventGroupCreate();
+  KernelBenchmark_PeriodicDone = xSemaphoreCreateCounting(KERNEL_BENCHMARK_PERIODIC_NBR, 0);
+#if ( configUSE_TIMERS == 1 )
+  KernelBenchmark_TimerExpired = xSemaphoreCreateBinary();
+#endif
+
+  // Busy loop iterations per tick of CPU time
+  taskENTER_CRITICAL();
+  KernelBenchmark_SpinsPerTick = CycleCounter_Get();
+  spin(1000);
+  KernelBenchmark_SpinsPerTick = CycleCounter_Get() - KernelBenchmark_SpinsPerTick;
+  taskEXIT_CRITICAL();
+  KernelBenchmark_SpinsPerTick = (1000 * TIMESTAMP_COUNTS_PER_TICK) / KernelBenchmark_SpinsPerTick;
+
+  xTaskCreate(wake_helper, "BenchWake", KERNEL_BENCHMARK_HELPER_STACK, NULL, KERNEL_BENCHMARK_PRIORITY + 1, NULL);
+  xTaskCreate(sync_helper, "BenchSync", KERNEL_BENCHMARK_HELPER_STACK, NULL, KERNEL_BENCHMARK_PRIORITY + 1, NULL);
+  xTaskCreate(yield_helper, "BenchYield", KERNEL_BENCHMARK_HELPER_STACK, NULL, KERNEL_BENCHMARK_PRIORITY, NULL);
+  xTaskCreate(block_helper, "BenchBlock", KERNEL_BENCHMARK_HELPER_STACK, NULL, KERNEL_BENCHMARK_PRIORITY - 1, NULL);
+
+  // Results go to the console, which ReportData also writes
+  Startup_Wait(STARTUP_REPORTDATA, portMAX_DELAY);
+
+  while (1) {
+    Log_Printf("bench,name,runs,min cycles,mean cycles,max cycles,baseline cycles,change %%\n");
+
+    KernelBenchmark_RunQueues();
+    bench_wake();
+    bench_yield();
+    bench_delay();
+    for (i = 0; i < KERNEL_BENCHMARK_MALLOC_SIZES_NBR; ++i) {
+      bench_malloc(KERNEL_BENCHMARK_MALLOC_SIZES[i]);
+    }
+    bench_event_group();
+    bench_delayed_tasks();
+    bench_timers();
+    for (i = 0; i < KERNEL_BENCHMARK_LEVELS_NBR; ++i) {
+      bench_interrupt_latency(&KERNEL_BENCHMARK_LEVELS[i]);
+    }
+
+    Log_Printf("sched,scheduler,task,period ticks,execution ticks,jobs,deadline misses,max response ticks\n");
+    bench_scheduler(false);
+    bench_scheduler(true);
+
+    xSemaphoreTake(KernelBenchmark_Requested, portMAX_DELAY);
+  }
+}
+
+
+/*************************************************************************
+* Function Name: KernelBenchmark_Request
+* Description:   Ask Task_KernelBenchmark to run the suite again
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void KernelBenchmark_Request() {
+  if (KernelBenchmark_Requested != NULL) {
+    xSemaphoreGive(KernelBenchmark_Requested);
+  }
+}
+#endif /* KERNEL_BENCHMARK_HOST */
+
+#else
+
+/*************************************************************************
+* Function Name: KernelBenchmark_Request
+* Description:   Benchmarks not built
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void KernelBenchmark_Request() {
+  Log_Printf("kernel benchmarks not built, define KERNEL_BENCHMARK\n");
+}
+
+#endif /* KERNEL_BENCHMARK */
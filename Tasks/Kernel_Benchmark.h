@@ -0,0 +1,87 @@
+/**
+* @Filename: Kernel_Benchmark.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [2:15am]
+* @Version:  1.0.0
+*
+* @Description: Microbenchmarks of the FreeRTOS primitives the application
+*               uses, in DWT cycles.
+*
+*               Built when KERNEL_BENCHMARK is defined in the project's
+*               predefined symbols. main then creates Task_KernelBenchmark,
+*               which runs the suite once ReportData is up, and again on
+*               each "bench" console command. Each benchmark prints
+*
+*                 bench,<name>,<runs>,<min>,<mean>,<max>,<baseline>,<change %>
+*
+*               where baseline is the mean stored in
+*               KERNEL_BENCHMARK_BASELINE (Kernel_Benchmark.c) and change
+*               is the mean relative to it. Without a stored mean the
+*               baseline column reads "no baseline" and change is empty. Benchmarks that wake or switch
+*               tasks use helper tasks from one below to one above
+*               KERNEL_BENCHMARK_PRIORITY, so tasks and interrupts of higher
+*               priority show up in max.
+*
+*               "timer start" and "timer expire" lines time a software
+*               timer with 10 to 100 others active, in the sorted lists or,
+*               with configUSE_TIMER_WHEEL, the timing wheel; build both
+*               ways to compare them.
+*
+*               "interrupt latency" lines time a Timer3A timeout to its
+*               handler at each band of Interrupt_Priorities.h while the
+*               benchmark task keeps entering critical sections.
+*
+*               The suite ends with a periodic task set run under rate
+*               monotonic priorities and, with configUSE_EDF_SCHEDULING,
+*               earliest deadline first, printed as "sched" lines of
+*               deadline misses and worst response times. Lower priority
+*               tasks get little CPU time while it runs.
+*
+*               Tests/Test_Kernel_Benchmark.c builds the queue and
+*               semaphore benchmarks (KernelBenchmark_RunQueues) on the
+*               host against the kernel sources, with KERNEL_BENCHMARK_HOST
+*               defined. It counts nanoseconds of the host's monotonic
+*               clock instead of cycles and compares against a baseline of
+*               its own.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TASKS_KERNEL_BENCHMARK_H_
+#define TASKS_KERNEL_BENCHMARK_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/************************************************
+* Configuration
+************************************************/
+// Priority of the benchmark task and the task it yields to. The task woken
+// by the wake-up benchmarks runs one above, the one that runs when the
+// benchmark task blocks one below.
+#define KERNEL_BENCHMARK_PRIORITY (configMAX_PRIORITIES - 2)
+
+// Runs per benchmark, and per vTaskDelay benchmark (one tick each)
+#define KERNEL_BENCHMARK_RUNS       1000
+#define KERNEL_BENCHMARK_DELAY_RUNS 100
+
+
+/************************************************
+* Function declarations
+************************************************/
+// Run the suite now and on each KernelBenchmark_Request
+extern void Task_KernelBenchmark(void* pvParameters);
+
+// Run the queue and semaphore benchmarks, the part of the suite that needs
+// no other task or interrupt. Called by Task_KernelBenchmark, and by the
+// host build.
+extern void KernelBenchmark_RunQueues();
+
+// Ask Task_KernelBenchmark to run the suite again. Prints a message when
+// built without KERNEL_BENCHMARK.
+extern void KernelBenchmark_Request();
+
+#endif /* TASKS_KERNEL_BENCHMARK_H_ */
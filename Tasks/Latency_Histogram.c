@@ -0,0 +1,287 @@
+/**
+* @Filename: Latency_Histogram.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [9:25pm]
+* @Version:  1.0.0
+*
+* @Description: Log-linear (HDR style) latency histograms in CPU cycles
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Drivers/CycleCounter.h"
+
+#include "Tasks/Latency_Histogram.h"
+#include "Tasks/Log.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+#define LATENCY_HISTOGRAM_SUB_MASK (LATENCY_HISTOGRAM_SUB_BUCKETS - 1)
+
+// Index of the highest set bit, x must not be 0
+#if defined(__TI_ARM__)
+#define LATENCY_HISTOGRAM_LOG2(x) (31 - __clz(x))
+#else
+#define LATENCY_HISTOGRAM_LOG2(x) (31 - __builtin_clz(x))
+#endif
+
+
+/************************************************
+* Local variables
+************************************************/
+LatencyHistogram* LatencyHistogram_List[LATENCY_HISTOGRAM_MAX_HISTOGRAMS];
+volatile uint32_t LatencyHistogram_List_Nbr = 0;
+
+// Scratch for LatencyHistogram_PrintAll, too large for a task stack
+LatencyHistogram LatencyHistogram_All;
+
+
+/************************************************
+* Local function declarations
+************************************************/
+static void print_summary(const LatencyHistogram* histogram);
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: print_summary
+* Description:   Print count, min, percentiles, max and mean in
+*                microseconds
+* Parameters:    const LatencyHistogram* histogram
+* Return:        void
+*************************************************************************/
+static void print_summary(const LatencyHistogram* histogram) {
+  if (histogram->count == 0) {
+    Log_Printf("%s,0,,,,,,\n", histogram->name);
+    return;
+  }
+
+  Log_Printf("%s,%u,%u,%u,%u,%u,%u,%u\n", histogram->name, histogram->count,
+             histogram->min / CYCLECOUNTER_CYCLES_PER_US,
+             LatencyHistogram_Percentile(histogram, 500) / CYCLECOUNTER_CYCLES_PER_US,
+             LatencyHistogram_Percentile(histogram, 900) / CYCLECOUNTER_CYCLES_PER_US,
+             LatencyHistogram_Percentile(histogram, 990) / CYCLECOUNTER_CYCLES_PER_US,
+             histogram->max / CYCLECOUNTER_CYCLES_PER_US,
+             (uint32_t)(histogram->total / histogram->count) / CYCLECOUNTER_CYCLES_PER_US);
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: LatencyHistogram_Init
+* Description:   Clear a histogram and add it to the printed list
+* Parameters:    LatencyHistogram* histogram
+*                const char* name
+* Return:        void
+*************************************************************************/
+extern void LatencyHistogram_Init(LatencyHistogram* histogram, const char* name) {
+  uint32_t i = 0;
+
+  memset(histogram, 0, sizeof(LatencyHistogram));
+  histogram->name = name;
+  histogram->min = UINT32_MAX;
+
+  for (i = 0; i < LatencyHistogram_List_Nbr; ++i) {
+    if (LatencyHistogram_List[i] == histogram) {
+      return;
+    }
+  }
+
+  if (LatencyHistogram_List_Nbr < LATENCY_HISTOGRAM_MAX_HISTOGRAMS) {
+    // Fill the slot before publishing it to the console
+    LatencyHistogram_List[LatencyHistogram_List_Nbr] = histogram;
+    LatencyHistogram_List_Nbr++;
+  }
+}
+
+
+/*************************************************************************
+* Function Name: LatencyHistogram_BucketIndex
+* Description:   Bucket of a value
+* Parameters:    uint32_t cycles
+* Return:        uint32_t - 0 .. LATENCY_HISTOGRAM_BUCKETS - 1
+*************************************************************************/
+extern uint32_t LatencyHistogram_BucketIndex(uint32_t cycles) {
+  uint32_t exponent = 0;
+
+  if (cycles < LATENCY_HISTOGRAM_SUB_BUCKETS) {
+    return cycles;
+  }
+
+  exponent = LATENCY_HISTOGRAM_LOG2(cycles);
+  if (exponent > LATENCY_HISTOGRAM_MAX_EXPONENT) {
+    return LATENCY_HISTOGRAM_BUCKETS - 1;
+  }
+
+  // The top LATENCY_HISTOGRAM_SUB_BITS bits below the leading one pick
+  // the bucket within the power of two
+  return ((exponent - LATENCY_HISTOGRAM_SUB_BITS + 1) << LATENCY_HISTOGRAM_SUB_BITS) +
+         ((cycles >> (exponent - LATENCY_HISTOGRAM_SUB_BITS)) & LATENCY_HISTOGRAM_SUB_MASK);
+}
+
+
+/*************************************************************************
+* Function Name: LatencyHistogram_BucketLowest
+* Description:   Lowest value counted in a bucket
+* Parameters:    uint32_t index
+* Return:        uint32_t
+*************************************************************************/
+extern uint32_t LatencyHistogram_BucketLowest(uint32_t index) {
+  uint32_t exponent = 0;
+
+  if (index < LATENCY_HISTOGRAM_SUB_BUCKETS) {
+    return index;
+  }
+
+  if (index >= (LATENCY_HISTOGRAM_BUCKETS - 1)) {
+    return 1UL << (LATENCY_HISTOGRAM_MAX_EXPONENT + 1);
+  }
+
+  exponent = (index >> LATENCY_HISTOGRAM_SUB_BITS) + LATENCY_HISTOGRAM_SUB_BITS - 1;
+  return (LATENCY_HISTOGRAM_SUB_BUCKETS + (index & LATENCY_HISTOGRAM_SUB_MASK))
+         << (exponent - LATENCY_HISTOGRAM_SUB_BITS);
+}
+
+
+/*************************************************************************
+* Function Name: LatencyHistogram_Record
+* Description:   Count one value
+* Parameters:    LatencyHistogram* histogram
+*                uint32_t cycles
+* Return:        void
+*************************************************************************/
+extern void LatencyHistogram_Record(LatencyHistogram* histogram, uint32_t cycles) {
+  histogram->buckets[LatencyHistogram_BucketIndex(cycles)]++;
+  histogram->count++;
+  histogram->total += cycles;
+  if (cycles < histogram->min) {
+    histogram->min = cycles;
+  }
+  if (cycles > histogram->max) {
+    histogram->max = cycles;
+  }
+}
+
+
+/*************************************************************************
+* Function Name: LatencyHistogram_Merge
+* Description:   Add the counts of source to destination
+* Parameters:    LatencyHistogram* destination
+*                const LatencyHistogram* source
+* Return:        void
+*************************************************************************/
+extern void LatencyHistogram_Merge(LatencyHistogram* destination, const LatencyHistogram* source) {
+  uint32_t i = 0;
+
+  if (source->count == 0) {
+    return;
+  }
+
+  for (i = 0; i < LATENCY_HISTOGRAM_BUCKETS; ++i) {
+    destination->buckets[i] += source->buckets[i];
+  }
+
+  destination->count += source->count;
+  destination->total += source->total;
+  if (source->min < destination->min) {
+    destination->min = source->min;
+  }
+  if (source->max > destination->max) {
+    destination->max = source->max;
+  }
+}
+
+
+/*************************************************************************
+* Function Name: LatencyHistogram_Percentile
+* Description:   Lowest value of the bucket holding the given permille of
+*                the recorded values
+* Parameters:    const LatencyHistogram* histogram
+*                uint32_t permille - 0..1000
+* Return:        uint32_t - cycles, 0 if nothing was recorded
+*************************************************************************/
+extern uint32_t LatencyHistogram_Percentile(const LatencyHistogram* histogram, uint32_t permille) {
+  uint64_t target = ((uint64_t)histogram->count * permille + 999) / 1000;
+  uint64_t seen = 0;
+  uint32_t i = 0;
+
+  if (target == 0) {
+    target = 1;
+  }
+
+  for (i = 0; i < LATENCY_HISTOGRAM_BUCKETS; ++i) {
+    seen += histogram->buckets[i];
+    if (seen >= target) {
+      return LatencyHistogram_BucketLowest(i);
+    }
+  }
+
+  return 0;
+}
+
+
+/*************************************************************************
+* Function Name: LatencyHistogram_PrintAll
+* Description:   Print a summary line per histogram and one for all of
+*                them merged
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void LatencyHistogram_PrintAll() {
+  uint32_t i = 0;
+
+  memset(&LatencyHistogram_All, 0, sizeof(LatencyHistogram));
+  LatencyHistogram_All.name = "all";
+  LatencyHistogram_All.min = UINT32_MAX;
+
+  Log_Printf("histogram,count,min us,p50 us,p90 us,p99 us,max us,mean us\n");
+  for (i = 0; i < LatencyHistogram_List_Nbr; ++i) {
+    print_summary(LatencyHistogram_List[i]);
+    LatencyHistogram_Merge(&LatencyHistogram_All, LatencyHistogram_List[i]);
+  }
+  print_summary(&LatencyHistogram_All);
+}
+
+
+/*************************************************************************
+* Function Name: LatencyHistogram_PrintBuckets
+* Description:   Print the non-empty buckets of one histogram
+* Parameters:    const char* name
+* Return:        bool - false if there is no histogram called name
+*************************************************************************/
+extern bool LatencyHistogram_PrintBuckets(const char* name) {
+  uint32_t i = 0;
+  uint32_t j = 0;
+
+  for (i = 0; i < LatencyHistogram_List_Nbr; ++i) {
+    const LatencyHistogram* histogram = LatencyHistogram_List[i];
+    if (strcmp(histogram->name, name) != 0) {
+      continue;
+    }
+
+    Log_Printf("lowest cycles,count\n");
+    for (j = 0; j < LATENCY_HISTOGRAM_BUCKETS; ++j) {
+      if (histogram->buckets[j] != 0) {
+        Log_Printf("%u,%u\n", LatencyHistogram_BucketLowest(j), histogram->buckets[j]);
+      }
+    }
+    return true;
+  }
+
+  return false;
+}
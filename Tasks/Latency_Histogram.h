@@ -0,0 +1,84 @@
+/**
+* @Filename: Latency_Histogram.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [9:25pm]
+* @Version:  1.0.0
+*
+* @Description: Log-linear (HDR style) latency histograms in CPU cycles.
+*
+*               Values below 2^LATENCY_HISTOGRAM_SUB_BITS are counted
+*               exactly. Above that, every power of two is split into
+*               2^LATENCY_HISTOGRAM_SUB_BITS equal buckets, so a bucket is
+*               never wider than 1/8 of its lowest value (12.5%) whatever
+*               the magnitude. Values of 2^(LATENCY_HISTOGRAM_MAX_EXPONENT
+*               + 1) cycles (~140 ms) and more share the last bucket.
+*
+*               A histogram must have a single writer (e.g. one interrupt
+*               handler); readers may see a record half applied.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TASKS_LATENCY_HISTOGRAM_H_
+#define TASKS_LATENCY_HISTOGRAM_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/************************************************
+* Configuration
+************************************************/
+#define LATENCY_HISTOGRAM_SUB_BITS     3
+#define LATENCY_HISTOGRAM_MAX_EXPONENT 23
+#define LATENCY_HISTOGRAM_MAX_HISTOGRAMS 12
+
+#define LATENCY_HISTOGRAM_SUB_BUCKETS (1 << LATENCY_HISTOGRAM_SUB_BITS)
+
+// Exact buckets, the log-linear buckets, and the overflow bucket
+#define LATENCY_HISTOGRAM_BUCKETS \
+  (((LATENCY_HISTOGRAM_MAX_EXPONENT - LATENCY_HISTOGRAM_SUB_BITS + 2) << LATENCY_HISTOGRAM_SUB_BITS) + 1)
+
+
+/************************************************
+* Types
+************************************************/
+typedef struct LatencyHistogram {
+  const char* name;
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint64_t total;
+  uint32_t buckets[LATENCY_HISTOGRAM_BUCKETS];
+} LatencyHistogram;
+
+
+/************************************************
+* Function declarations
+************************************************/
+// Clear a histogram and add it to the list printed by
+// LatencyHistogram_PrintAll
+extern void LatencyHistogram_Init(LatencyHistogram* histogram, const char* name);
+
+// Bucket of a value, and the lowest value counted in a bucket
+extern uint32_t LatencyHistogram_BucketIndex(uint32_t cycles);
+extern uint32_t LatencyHistogram_BucketLowest(uint32_t index);
+
+// Count one value
+extern void LatencyHistogram_Record(LatencyHistogram* histogram, uint32_t cycles);
+
+// Add the counts of source to destination
+extern void LatencyHistogram_Merge(LatencyHistogram* destination, const LatencyHistogram* source);
+
+// Lowest value of the bucket holding the given permille (0..1000) of the
+// recorded values
+extern uint32_t LatencyHistogram_Percentile(const LatencyHistogram* histogram, uint32_t permille);
+
+// Print a summary line per histogram and one for all merged, or the
+// non-empty buckets of the histogram called name
+extern void LatencyHistogram_PrintAll();
+extern bool LatencyHistogram_PrintBuckets(const char* name);
+
+#endif /* TASKS_LATENCY_HISTOGRAM_H_ */
@@ -0,0 +1,323 @@
+/**
+* @Filename: Log.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [11:20pm]
+* @Version:  1.0.0
+*
+* @Description: Line-buffered console output for tasks and a deferred path
+*               for interrupt handlers
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Drivers/uartstdio.h"
+
+#include "Tasks/Log.h"
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "semphr.h"
+#include "task.h"
+#include "timers.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+// Interrupt Control and State Register, VECTACTIVE is non-zero in a
+// handler. Host builds (the tests under Tests/) define LOG_HOST and set
+// Log_Host_ICSR instead.
+#ifdef LOG_HOST
+extern volatile uint32_t Log_Host_ICSR;
+#define LOG_ICSR (Log_Host_ICSR)
+#else
+#define LOG_ICSR (*((volatile uint32_t*)0xE000ED04))
+#endif
+#define LOG_ICSR_VECTACTIVE 0x000001FF
+
+
+/************************************************
+* Local types
+************************************************/
+typedef struct Log_ISR_Record {
+  const char* format;
+  uint32_t arg0;
+  uint32_t arg1;
+} Log_ISR_Record;
+
+
+/************************************************
+* Local variables
+************************************************/
+static bool Log_Initialized = false;
+
+SemaphoreHandle_t Log_Mutex = NULL;
+QueueHandle_t Log_ISR_Queue = NULL;
+
+volatile uint32_t Log_Dropped_Nbr = 0;
+
+
+/************************************************
+* Local function declarations
+************************************************/
+static TickType_t log_timeout();
+static bool log_fits(const char* line, int length, bool wait);
+static void log_write(const char* line, int length, bool wait);
+static void log_vprintf(const char* format, va_list args, bool wait);
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: log_timeout
+* Description:   Ticks the calling task may wait for the console
+* Parameters:    N/A
+* Return:        TickType_t
+*************************************************************************/
+static TickType_t log_timeout() {
+#if (configUSE_TIMERS == 1) && (INCLUDE_xTimerGetTimerDaemonTaskHandle == 1)
+  // Every software timer waits while the timer service task does
+  if (xTaskGetCurrentTaskHandle() == xTimerGetTimerDaemonTaskHandle()) {
+    return 0;
+  }
+#endif
+
+  return LOG_MUTEX_TIMEOUT_TICKS;
+}
+
+
+/*************************************************************************
+* Function Name: log_fits
+* Description:   With UART_BUFFERED, whether the TX buffer has room for
+*                the whole line, waiting for it if asked to. UARTwrite
+*                would cut the line short instead.
+* Parameters:    const char* line
+*                int length
+*                bool wait
+* Return:        bool - false if the line does not fit
+*************************************************************************/
+static bool log_fits(const char* line, int length, bool wait) {
+#ifdef UART_BUFFERED
+  uint32_t needed = (uint32_t)length;
+  int i = 0;
+
+  // UARTwrite adds a CR before every LF
+  for (i = 0; i < length; ++i) {
+    if (line[i] == '\n') {
+      needed++;
+    }
+  }
+
+  // The ring buffer holds one byte less than its size
+  while ((uint32_t)UARTTxBytesFree() <= needed) {
+    if (!wait) {
+      return false;
+    }
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+      vTaskDelay(1);
+    }
+  }
+#else
+  (void)line;
+  (void)length;
+  (void)wait;
+#endif
+
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: log_write
+* Description:   Write one formatted line to the UART, holding the mutex
+*                once the scheduler runs. Unless asked to wait, the line is
+*                dropped if another task holds the console for longer than
+*                log_timeout or the TX buffer has no room for it.
+* Parameters:    const char* line
+*                int length - value returned by vsnprintf
+*                bool wait
+* Return:        void
+*************************************************************************/
+static void log_write(const char* line, int length, bool wait) {
+  bool locked = false;
+
+  if (length <= 0) {
+    return;
+  }
+
+  // Cut to the buffer, the line was truncated by vsnprintf
+  if (length >= LOG_LINE_SIZE) {
+    length = LOG_LINE_SIZE - 1;
+  }
+
+  if ((Log_Mutex != NULL) && (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)) {
+    if (xSemaphoreTake(Log_Mutex, wait ? portMAX_DELAY : log_timeout()) != pdPASS) {
+      Log_Dropped_Nbr++;
+      return;
+    }
+    locked = true;
+  }
+
+  if (log_fits(line, length, wait)) {
+    UARTwrite(line, length);
+  }
+  else {
+    Log_Dropped_Nbr++;
+  }
+
+  if (locked) {
+    xSemaphoreGive(Log_Mutex);
+  }
+}
+
+
+/*************************************************************************
+* Function Name: log_vprintf
+* Description:   Format into a line buffer on the caller's stack and write
+*                it in one piece
+* Parameters:    const char* format
+*                va_list args
+*                bool wait
+* Return:        void
+*************************************************************************/
+static void log_vprintf(const char* format, va_list args, bool wait) {
+  char line[LOG_LINE_SIZE];
+  int length = 0;
+
+  // Neither the mutex nor the UART driver may be used from a handler
+  if ((LOG_ICSR & LOG_ICSR_VECTACTIVE) != 0) {
+    Log_Dropped_Nbr++;
+    return;
+  }
+
+  length = vsnprintf(line, LOG_LINE_SIZE, format, args);
+  log_write(line, length, wait);
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: Log_Initialization
+* Description:   Create the mutex and the interrupt queue
+* Parameters:    N/A
+* Return:        uint32_t
+*************************************************************************/
+extern uint32_t Log_Initialization() {
+  if (!Log_Initialized) {
+    Log_Mutex = xSemaphoreCreateMutex();
+    Log_ISR_Queue = xQueueCreate(LOG_ISR_QUEUE_LENGTH, sizeof(Log_ISR_Record));
+    Log_Initialized = true;
+  }
+
+  return (1);
+}
+
+
+/*************************************************************************
+* Function Name: Log_Printf
+* Description:   Write a formatted line in one piece, or drop it if the
+*                console stays busy
+* Parameters:    const char* format
+*                ...
+* Return:        void
+*************************************************************************/
+extern void Log_Printf(const char* format, ...) {
+  va_list args;
+
+  va_start(args, format);
+  log_vprintf(format, args, false);
+  va_end(args);
+}
+
+
+/*************************************************************************
+* Function Name: Log_PrintfWait
+* Description:   Write a formatted line in one piece, waiting for the
+*                console as long as it takes
+* Parameters:    const char* format
+*                ...
+* Return:        void
+*************************************************************************/
+extern void Log_PrintfWait(const char* format, ...) {
+  va_list args;
+
+  va_start(args, format);
+  log_vprintf(format, args, true);
+  va_end(args);
+}
+
+
+/*************************************************************************
+* Function Name: Log_PrintfFromISR
+* Description:   Queue a format string and its arguments for Task_Log
+* Parameters:    const char* format
+*                uint32_t arg0
+*                uint32_t arg1
+* Return:        void
+*************************************************************************/
+extern void Log_PrintfFromISR(const char* format, uint32_t arg0, uint32_t arg1) {
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  Log_ISR_Record record;
+
+  if (Log_ISR_Queue == NULL) {
+    Log_Dropped_Nbr++;
+    return;
+  }
+
+  record.format = format;
+  record.arg0 = arg0;
+  record.arg1 = arg1;
+
+  if (xQueueSendFromISR(Log_ISR_Queue, &record, &xHigherPriorityTaskWoken) != pdPASS) {
+    Log_Dropped_Nbr++;
+  }
+
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+
+/*************************************************************************
+* Function Name: Task_Log
+* Description:   Format and write the lines queued by interrupt handlers
+* Parameters:    void* pvParameters
+* Return:        void
+*************************************************************************/
+extern void Task_Log(void* pvParameters) {
+  Log_ISR_Record record;
+  char line[LOG_LINE_SIZE];
+  int length = 0;
+
+  Log_Initialization();
+
+  while (1) {
+    if (xQueueReceive(Log_ISR_Queue, &record, portMAX_DELAY) == pdPASS) {
+      length = snprintf(line, LOG_LINE_SIZE, record.format, record.arg0, record.arg1);
+      log_write(line, length, false);
+    }
+  }
+}
+
+
+/*************************************************************************
+* Function Name: Log_DroppedCount
+* Description:   Lines dropped by Log_Printf, Log_PrintfFromISR and
+*                Task_Log
+* Parameters:    N/A
+* Return:        uint32_t
+*************************************************************************/
+extern uint32_t Log_DroppedCount() {
+  return Log_Dropped_Nbr;
+}
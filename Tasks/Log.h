@@ -0,0 +1,91 @@
+/**
+* @Filename: Log.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [11:20pm]
+* @Version:  1.0.0
+*
+* @Description: Console output that does not interleave.
+*
+*               Log_Printf formats the whole message into a line buffer on
+*               the calling task's stack, then writes it to the UART while
+*               holding a mutex, so each call reaches the console in one
+*               piece. UARTvprintf on its own writes every format fragment
+*               separately, and two tasks printing at once mix their
+*               output. Before the scheduler starts, lines are written
+*               directly.
+*
+*               Interrupt handlers must not format or take the mutex.
+*               Log_PrintfFromISR queues the format string and two
+*               arguments, and Task_Log formats and writes the line later.
+*               The format string and any %s arguments must stay valid
+*               (string literals). Lines that do not fit in the queue, and
+*               Log_Printf calls made from an interrupt, are dropped and
+*               counted.
+*
+*               A task waits at most LOG_MUTEX_TIMEOUT_TICKS for another
+*               task's line to be written, then drops its own and counts
+*               it. The timer service task does not wait at all when
+*               INCLUDE_xTimerGetTimerDaemonTaskHandle is set, so a print
+*               from a timer callback never holds up the other timers.
+*               With UART_BUFFERED, a line that does not fit in the TX
+*               buffer is dropped whole and counted, never cut.
+*
+*               Log_PrintfWait is for output that must not be lost
+*               (ReportData records): it waits for the console and for
+*               room in the TX buffer as long as it takes. It must not be
+*               called from the timer service task.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TASKS_LOG_H_
+#define TASKS_LOG_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/************************************************
+* Configuration
+************************************************/
+// Longest line, including the terminating NUL. Longer lines are cut.
+#define LOG_LINE_SIZE 128
+
+// Lines queued by interrupt handlers
+#define LOG_ISR_QUEUE_LENGTH 16
+
+// Longest wait for the console, a little over one LOG_LINE_SIZE line at
+// 115200 baud (11 ms)
+#ifndef LOG_MUTEX_TIMEOUT_TICKS
+#define LOG_MUTEX_TIMEOUT_TICKS (configTICK_RATE_HZ / 50)
+#endif
+
+
+/************************************************
+* Function declarations
+************************************************/
+// Create the mutex and the interrupt queue. Called from main before the
+// scheduler starts.
+extern uint32_t Log_Initialization();
+
+// printf to the console, one atomic write per call. Tasks only.
+extern void Log_Printf(const char* format, ...);
+
+// Log_Printf that waits for the console instead of dropping the line.
+// Tasks other than the timer service task only.
+extern void Log_PrintfWait(const char* format, ...);
+
+// Queue a line for Task_Log. Interrupt handlers only.
+extern void Log_PrintfFromISR(const char* format, uint32_t arg0, uint32_t arg1);
+
+// Writes the lines queued by Log_PrintfFromISR
+extern void Task_Log(void* pvParameters);
+
+// Lines dropped because the interrupt queue was full, Log_Printf was
+// called from an interrupt, the console stayed busy too long or the TX
+// buffer was full
+extern uint32_t Log_DroppedCount();
+
+#endif /* TASKS_LOG_H_ */
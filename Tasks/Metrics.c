@@ -0,0 +1,170 @@
+/**
+* @Filename: Metrics.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [8:40pm]
+* @Version:  1.0.0
+*
+* @Description: Registry of runtime counters, gauges and histograms
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if !defined(__TI_ARM__)
+#include <stdatomic.h>
+#endif
+
+#include "Tasks/Log.h"
+#include "Tasks/Metrics.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+const char* const METRICS_TYPE_NAMES[] = { "counter", "gauge", "histogram" };
+
+
+/************************************************
+* Local variables
+************************************************/
+Metrics_Metric* Metrics_Registry[METRICS_MAX_METRICS];
+volatile uint32_t Metrics_Registry_Nbr = 0;
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+#if !defined(__TI_ARM__)
+/*************************************************************************
+* Function Name: Atomic_Add32
+* Description:   Host builds: atomically add value to *address. The
+*                target uses LDREX/STREX in Atomic_Add32.asm.
+* Parameters:    volatile uint32_t* address
+*                uint32_t value
+* Return:        uint32_t - the new value
+*************************************************************************/
+extern uint32_t Atomic_Add32(volatile uint32_t* address, uint32_t value) {
+  return atomic_fetch_add((volatile _Atomic uint32_t*)address, value) + value;
+}
+#endif
+
+
+/*************************************************************************
+* Function Name: Metrics_Register
+* Description:   Add a metric to the registry
+* Parameters:    Metrics_Metric* metric
+* Return:        bool - false if the registry is full
+*************************************************************************/
+extern bool Metrics_Register(Metrics_Metric* metric) {
+  bool registered = true;
+  uint32_t i = 0;
+
+  taskENTER_CRITICAL();
+  for (i = 0; i < Metrics_Registry_Nbr; ++i) {
+    if (Metrics_Registry[i] == metric) {
+      break;
+    }
+  }
+
+  if (i == Metrics_Registry_Nbr) {
+    if (Metrics_Registry_Nbr < METRICS_MAX_METRICS) {
+      // Fill the slot before publishing it to readers
+      Metrics_Registry[Metrics_Registry_Nbr] = metric;
+      Metrics_Registry_Nbr++;
+    }
+    else {
+      registered = false;
+    }
+  }
+  taskEXIT_CRITICAL();
+
+  return registered;
+}
+
+
+/*************************************************************************
+* Function Name: Metrics_Record
+* Description:   Count one sample in a histogram. The value of a
+*                histogram is its total number of samples.
+* Parameters:    Metrics_Metric* metric
+*                uint32_t sample
+* Return:        void
+*************************************************************************/
+extern void Metrics_Record(Metrics_Metric* metric, uint32_t sample) {
+  uint32_t i = 0;
+
+  while ((i < (metric->bucketsNbr - 1)) && (sample > metric->bounds[i])) {
+    ++i;
+  }
+
+  Atomic_Add32(&metric->buckets[i], 1);
+  Atomic_Add32(&metric->value, 1);
+}
+
+
+/*************************************************************************
+* Function Name: Metrics_Count
+* Description:   Number of registered metrics
+* Parameters:    N/A
+* Return:        uint32_t
+*************************************************************************/
+extern uint32_t Metrics_Count() {
+  return Metrics_Registry_Nbr;
+}
+
+
+/*************************************************************************
+* Function Name: Metrics_Get
+* Description:   Registered metric by index
+* Parameters:    uint32_t index
+* Return:        Metrics_Metric* - NULL if index is out of range
+*************************************************************************/
+extern Metrics_Metric* Metrics_Get(uint32_t index) {
+  return (index < Metrics_Registry_Nbr) ? Metrics_Registry[index] : NULL;
+}
+
+
+/*************************************************************************
+* Function Name: Metrics_Print
+* Description:   Print the index, name, type and value of each metric,
+*                followed by the buckets of each histogram
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void Metrics_Print() {
+  uint32_t count = Metrics_Registry_Nbr;
+  uint32_t i = 0;
+  uint32_t j = 0;
+
+  Log_Printf("index,name,type,value\n");
+  for (i = 0; i < count; ++i) {
+    const Metrics_Metric* metric = Metrics_Registry[i];
+    Log_Printf("%u,%s,%s,%u\n", i, metric->name, METRICS_TYPE_NAMES[metric->type], metric->value);
+  }
+
+  for (i = 0; i < count; ++i) {
+    const Metrics_Metric* metric = Metrics_Registry[i];
+    if (metric->type != METRICS_TYPE_HISTOGRAM) {
+      continue;
+    }
+
+    Log_Printf("%s bucket,upper bound,count\n", metric->name);
+    for (j = 0; j < metric->bucketsNbr; ++j) {
+      if (j < (metric->bucketsNbr - 1)) {
+        Log_Printf("%u,%u,%u\n", j, metric->bounds[j], metric->buckets[j]);
+      }
+      else {
+        Log_Printf("%u,inf,%u\n", j, metric->buckets[j]);
+      }
+    }
+  }
+}
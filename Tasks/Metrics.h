@@ -0,0 +1,107 @@
+/**
+* @Filename: Metrics.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [8:40pm]
+* @Version:  1.0.0
+*
+* @Description: Registry of runtime counters, gauges and histograms.
+*
+*               Metrics are defined statically with the METRICS_* macros
+*               and registered once with Metrics_Register. Updates are
+*               safe from tasks and interrupts of any priority: counters
+*               and histogram buckets are incremented with LDREX/STREX
+*               (Atomic_Add32.asm; C11 atomics in host builds), and a
+*               gauge is a single aligned word store.
+*
+*               Task_Metrics periodically snapshots every registered metric
+*               and sends it as ReportData records:
+*
+*                 ReportName_Metric         index, value, change since the
+*                                           last record, period (ms)
+*                 ReportName_MetricBucket   index, bucket, count, change
+*                                           since the last record (only
+*                                           buckets that changed)
+*
+*               The "metrics" console command prints the index to name
+*               table.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TASKS_METRICS_H_
+#define TASKS_METRICS_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/************************************************
+* Configuration
+************************************************/
+#define METRICS_MAX_METRICS 32
+
+
+/************************************************
+* Types
+************************************************/
+typedef enum { METRICS_TYPE_COUNTER, METRICS_TYPE_GAUGE, METRICS_TYPE_HISTOGRAM } Metrics_Type;
+
+typedef struct Metrics_Metric {
+  const char* name;
+  Metrics_Type type;
+  volatile uint32_t value;       // Counter total or gauge value
+  uint32_t snapshot;             // Value at the last record sent
+
+  // Histograms only. Sample s goes in the first bucket i with
+  // s <= bounds[i]; the last bucket takes everything larger.
+  const uint32_t* bounds;        // bucketsNbr - 1 entries
+  volatile uint32_t* buckets;
+  uint32_t* bucketSnapshots;
+  uint32_t bucketsNbr;
+} Metrics_Metric;
+
+
+/************************************************
+* Macros
+************************************************/
+// Initializers for a static Metrics_Metric
+#define METRICS_COUNTER(name) { (name), METRICS_TYPE_COUNTER, 0, 0, NULL, NULL, NULL, 0 }
+#define METRICS_GAUGE(name) { (name), METRICS_TYPE_GAUGE, 0, 0, NULL, NULL, NULL, 0 }
+
+// buckets and bucketSnapshots must be arrays of the same length, bounds
+// one shorter
+#define METRICS_HISTOGRAM(name, bounds, buckets, bucketSnapshots) \
+  { (name), METRICS_TYPE_HISTOGRAM, 0, 0, (bounds), (buckets), (bucketSnapshots), \
+    sizeof(buckets) / sizeof((buckets)[0]) }
+
+// Count n events
+#define Metrics_Add(metric, n) Atomic_Add32(&(metric)->value, (n))
+#define Metrics_Increment(metric) Atomic_Add32(&(metric)->value, 1)
+
+// Set a gauge
+#define Metrics_Set(metric, v) ((metric)->value = (uint32_t)(v))
+
+
+/************************************************
+* Function declarations
+************************************************/
+// Atomically add value to *address and return the new value
+extern uint32_t Atomic_Add32(volatile uint32_t* address, uint32_t value);
+
+// Add a metric to the registry. Registering the same metric twice has no
+// effect. Returns false if the registry is full.
+extern bool Metrics_Register(Metrics_Metric* metric);
+
+// Count one sample in a histogram
+extern void Metrics_Record(Metrics_Metric* metric, uint32_t sample);
+
+// Number of registered metrics and access by index
+extern uint32_t Metrics_Count();
+extern Metrics_Metric* Metrics_Get(uint32_t index);
+
+// Print the index, name, type and value of each metric
+extern void Metrics_Print();
+
+#endif /* TASKS_METRICS_H_ */
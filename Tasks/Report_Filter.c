@@ -0,0 +1,372 @@
+/**
+* @Filename: Report_Filter.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [4:10pm]
+* @Version:  1.0.0
+*
+* @Description: Per-ReportName deadband, rate-of-change and hysteresis
+*               filter applied by ReportData_Send
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <float.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#include "Tasks/Log.h"
+#include "Tasks/Report_Filter.h"
+#include "Tasks/Task_ReportData.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+
+/************************************************
+* Local task variables
+************************************************/
+ReportFilter_Rule ReportFilter_Rules[REPORT_FILTER_MAX_RULES];
+
+
+/************************************************
+* Local function declarations
+************************************************/
+static ReportFilter_Rule* find_rule(uint32_t reportName);
+static void item_values(const ReportData_Item* item, float values[4]);
+static float max_difference(const float a[4], const float b[4]);
+static bool parse_unsigned(const char* text, uint32_t* value);
+static bool parse_float(const char* text, float* value);
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: find_rule
+* Description:   Find the rule for reportName
+* Parameters:    uint32_t reportName
+* Return:        ReportFilter_Rule* - NULL if there is no rule
+*************************************************************************/
+static ReportFilter_Rule* find_rule(uint32_t reportName) {
+  uint32_t i = 0;
+  for (i = 0; i < REPORT_FILTER_MAX_RULES; ++i) {
+    if (ReportFilter_Rules[i].inUse && (ReportFilter_Rules[i].reportName == reportName)) {
+      return &ReportFilter_Rules[i];
+    }
+  }
+  return NULL;
+}
+
+
+/*************************************************************************
+* Function Name: item_values
+* Description:   Convert the four record values to float according to
+*                ReportValueType_Flg
+* Parameters:    const ReportData_Item* item
+*                float values[4]
+* Return:        void
+*************************************************************************/
+static void item_values(const ReportData_Item* item, float values[4]) {
+  const int32_t raw[4] = { item->ReportValue_0, item->ReportValue_1,
+                           item->ReportValue_2, item->ReportValue_3 };
+  uint32_t i = 0;
+  for (i = 0; i < 4; ++i) {
+    if (item->ReportValueType_Flg & (1 << i)) {
+      values[i] = *(float*)&raw[i];
+    }
+    else {
+      values[i] = (float)raw[i];
+    }
+  }
+}
+
+
+/*************************************************************************
+* Function Name: max_difference
+* Description:   Largest absolute difference between two value sets
+* Parameters:    const float a[4]
+*                const float b[4]
+* Return:        float
+*************************************************************************/
+static float max_difference(const float a[4], const float b[4]) {
+  float result = 0.0f;
+  uint32_t i = 0;
+  for (i = 0; i < 4; ++i) {
+    float difference = fabsf(a[i] - b[i]);
+    if (difference > result) {
+      result = difference;
+    }
+  }
+  return result;
+}
+
+
+/*************************************************************************
+* Function Name: parse_unsigned
+* Description:   Parse a whole decimal argument
+* Parameters:    const char* text
+*                uint32_t* value
+* Return:        bool - false if text is not a number below 2^32
+*************************************************************************/
+static bool parse_unsigned(const char* text, uint32_t* value) {
+  char* end = NULL;
+  unsigned long result = 0;
+
+  if ((*text < '0') || (*text > '9')) {
+    return false;
+  }
+  result = strtoul(text, &end, 10);
+  if ((*end != '\0') || (result > UINT32_MAX)) {
+    return false;
+  }
+  *value = (uint32_t)result;
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: parse_float
+* Description:   Parse a whole non-negative argument that fits a float
+* Parameters:    const char* text
+*                float* value
+* Return:        bool - false if text is not such a number
+*************************************************************************/
+static bool parse_float(const char* text, float* value) {
+  char* end = NULL;
+  double result = strtod(text, &end);
+
+  if ((end == text) || (*end != '\0') || !(result >= 0.0) || (result > FLT_MAX)) {
+    return false;
+  }
+  *value = (float)result;
+  return true;
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: ReportFilter_SetRule
+* Description:   Add or replace the rule for a ReportName
+* Parameters:    uint32_t reportName
+*                float deadband
+*                float rate            - units per second, 0 = unused
+*                float hysteresis      - 0 .. deadband
+*                uint32_t heartbeatTicks - 0 = unused
+* Return:        bool - false if the rule table is full
+*************************************************************************/
+extern bool ReportFilter_SetRule(uint32_t reportName, float deadband, float rate,
+                                 float hysteresis, uint32_t heartbeatTicks) {
+  bool result = false;
+
+  vTaskSuspendAll();
+  {
+    ReportFilter_Rule* rule = find_rule(reportName);
+    uint32_t i = 0;
+
+    for (i = 0; (rule == NULL) && (i < REPORT_FILTER_MAX_RULES); ++i) {
+      if (!ReportFilter_Rules[i].inUse) {
+        rule = &ReportFilter_Rules[i];
+      }
+    }
+
+    if (rule != NULL) {
+      memset(rule, 0, sizeof(ReportFilter_Rule));
+      rule->inUse = true;
+      rule->reportName = reportName;
+      rule->deadband = deadband;
+      rule->rate = rate;
+      rule->hysteresis = (hysteresis > deadband) ? deadband : hysteresis;
+      rule->heartbeatTicks = heartbeatTicks;
+      result = true;
+    }
+  }
+  xTaskResumeAll();
+
+  return result;
+}
+
+
+/*************************************************************************
+* Function Name: ReportFilter_ClearRule
+* Description:   Remove the rule for a ReportName; its records always pass
+* Parameters:    uint32_t reportName
+* Return:        bool - false if there was no rule
+*************************************************************************/
+extern bool ReportFilter_ClearRule(uint32_t reportName) {
+  bool result = false;
+
+  vTaskSuspendAll();
+  {
+    ReportFilter_Rule* rule = find_rule(reportName);
+    if (rule != NULL) {
+      rule->inUse = false;
+      result = true;
+    }
+  }
+  xTaskResumeAll();
+
+  return result;
+}
+
+
+/*************************************************************************
+* Function Name: ReportFilter_Accept
+* Description:   Apply the record's rule
+* Parameters:    const ReportData_Item* item
+* Return:        bool - true if the record should be sent
+*************************************************************************/
+extern bool ReportFilter_Accept(const ReportData_Item* item) {
+  bool send = true;
+
+  vTaskSuspendAll();
+  {
+    ReportFilter_Rule* rule = find_rule(item->ReportName);
+
+    if (rule != NULL) {
+      float values[4];
+      item_values(item, values);
+
+      if (rule->hasSent) {
+        float fromSent = max_difference(values, rule->lastSent);
+        float step = max_difference(values, rule->lastSeen);
+        uint32_t stepTicks = item->TimeStamp - rule->lastSeenTime;
+
+        send = false;
+
+        if (fromSent > rule->deadband) {
+          // Significant change
+          send = true;
+          rule->active = true;
+        }
+        else if (rule->active && (fromSent > (rule->deadband - rule->hysteresis))) {
+          // Still changing, inside the hysteresis band
+          send = true;
+        }
+        else {
+          rule->active = false;
+        }
+
+        if ((rule->rate > 0.0f) && (stepTicks > 0) &&
+            ((step * configTICK_RATE_HZ) > (rule->rate * stepTicks))) {
+          // Changing faster than the rate limit, send now
+          send = true;
+          rule->active = true;
+        }
+
+        if ((rule->heartbeatTicks > 0) && ((item->TimeStamp - rule->lastSentTime) >= rule->heartbeatTicks)) {
+          send = true;
+        }
+      }
+
+      memcpy(rule->lastSeen, values, sizeof(values));
+      rule->lastSeenTime = item->TimeStamp;
+
+      if (send) {
+        memcpy(rule->lastSent, values, sizeof(values));
+        rule->lastSentTime = item->TimeStamp;
+        rule->hasSent = true;
+        rule->passed++;
+      }
+      else {
+        rule->suppressed++;
+      }
+    }
+  }
+  xTaskResumeAll();
+
+  return send;
+}
+
+
+/*************************************************************************
+* Function Name: ReportFilter_PrintRules
+* Description:   Print each rule and how many records it passed and
+*                suppressed
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void ReportFilter_PrintRules() {
+  char line[128];
+  uint32_t i = 0;
+
+  Log_Printf("name,deadband,rate,hysteresis,heartbeat,passed,suppressed\n");
+  for (i = 0; i < REPORT_FILTER_MAX_RULES; ++i) {
+    const ReportFilter_Rule* rule = &ReportFilter_Rules[i];
+    if (rule->inUse) {
+      // %g keeps FLT_MAX to 12 characters where %.3f needs 43
+      snprintf(line, sizeof(line), "%04u,%g,%g,%g,%u,%u,%u\n",
+               (unsigned)rule->reportName, rule->deadband, rule->rate, rule->hysteresis,
+               (unsigned)rule->heartbeatTicks, (unsigned)rule->passed, (unsigned)rule->suppressed);
+      Log_Printf("%s", line);
+    }
+  }
+}
+
+
+/*************************************************************************
+* Function Name: ReportFilter_Command
+* Description:   Console command:
+*                  filter list
+*                  filter set <name> <deadband> <rate> <hysteresis> [<heartbeat ms>]
+*                  filter clear <name>
+* Parameters:    int argc
+*                char* argv[] - argv[0] is "filter"
+* Return:        bool - false on a syntax error or a number that does
+*                not parse whole, is negative or does not fit
+*************************************************************************/
+extern bool ReportFilter_Command(int argc, char* argv[]) {
+  uint32_t reportName = 0;
+
+  if ((argc == 2) && (strcmp(argv[1], "list") == 0)) {
+    ReportFilter_PrintRules();
+    return true;
+  }
+
+  if (((argc == 6) || (argc == 7)) && (strcmp(argv[1], "set") == 0)) {
+    float deadband = 0.0f;
+    float rate = 0.0f;
+    float hysteresis = 0.0f;
+    uint32_t heartbeatMs = 0;
+    uint64_t heartbeatTicks = 0;
+
+    if (!parse_unsigned(argv[2], &reportName) || !parse_float(argv[3], &deadband) ||
+        !parse_float(argv[4], &rate) || !parse_float(argv[5], &hysteresis) ||
+        ((argc == 7) && !parse_unsigned(argv[6], &heartbeatMs))) {
+      return false;
+    }
+
+    heartbeatTicks = ((uint64_t)heartbeatMs * configTICK_RATE_HZ) / 1000;
+    if (heartbeatTicks > UINT32_MAX) {
+      return false;
+    }
+
+    if (!ReportFilter_SetRule(reportName, deadband, rate, hysteresis, (uint32_t)heartbeatTicks)) {
+      Log_Printf("filter: rule table full\n");
+    }
+    return true;
+  }
+
+  if ((argc == 3) && (strcmp(argv[1], "clear") == 0)) {
+    if (!parse_unsigned(argv[2], &reportName)) {
+      return false;
+    }
+    if (!ReportFilter_ClearRule(reportName)) {
+      Log_Printf("filter: no rule for %s\n", argv[2]);
+    }
+    return true;
+  }
+
+  return false;
+}
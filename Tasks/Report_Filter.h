@@ -0,0 +1,86 @@
+/**
+* @Filename: Report_Filter.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [4:10pm]
+* @Version:  1.0.0
+*
+* @Description: Event-triggered reporting. Records whose ReportName has a
+*               rule are only sent when they changed significantly:
+*
+*               deadband   - send when any value moved more than this
+*                            from the last value sent
+*               rate       - send immediately when any value changes
+*                            faster than this (units per second)
+*               hysteresis - once a change was sent, keep sending while
+*                            values move more than (deadband - hysteresis)
+*                            between samples, so a slow drift right after a
+*                            step is not cut off at the deadband
+*               heartbeat  - send at least once per this many ticks
+*                            (0 = never forced)
+*
+*               Records without a rule always pass.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TASKS_REPORT_FILTER_H_
+#define TASKS_REPORT_FILTER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Tasks/Task_ReportData.h"
+
+/************************************************
+* Configuration
+************************************************/
+#define REPORT_FILTER_MAX_RULES 16
+
+
+/************************************************
+* Types
+************************************************/
+typedef struct ReportFilter_Rule {
+  bool inUse;
+  uint32_t reportName;
+  float deadband;
+  float rate;
+  float hysteresis;
+  uint32_t heartbeatTicks;
+
+  // State
+  bool active;          // Inside a significant change (hysteresis band)
+  bool hasSent;         // lastSent holds a valid record
+  float lastSent[4];
+  uint32_t lastSentTime;
+  float lastSeen[4];
+  uint32_t lastSeenTime;
+
+  // Statistics
+  uint32_t passed;
+  uint32_t suppressed;
+} ReportFilter_Rule;
+
+
+/************************************************
+* Function declarations
+************************************************/
+// Add or replace the rule for reportName. Returns false if the table is full.
+extern bool ReportFilter_SetRule(uint32_t reportName, float deadband, float rate,
+                                 float hysteresis, uint32_t heartbeatTicks);
+extern bool ReportFilter_ClearRule(uint32_t reportName);
+
+// Decide whether the record should be sent, updating the rule state
+extern bool ReportFilter_Accept(const ReportData_Item* item);
+
+// Print rules and per-rule pass/suppress counts to the console
+extern void ReportFilter_PrintRules();
+
+// Parse and run "filter ..." console arguments. Returns false on a syntax
+// error or a bad number.
+extern bool ReportFilter_Command(int argc, char* argv[]);
+
+#endif /* TASKS_REPORT_FILTER_H_ */
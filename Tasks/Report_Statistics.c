@@ -0,0 +1,201 @@
+/**
+* @Filename: Report_Statistics.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [3:05pm]
+* @Version:  1.0.0
+*
+* @Description: Windowed min/max/mean/variance per channel using Welford's
+*               online algorithm, which stays accurate when the mean is
+*               large compared to the spread (e.g. pressure in Pa).
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Drivers/CycleCounter.h"
+
+#include "Tasks/Report_Statistics.h"
+#include "Tasks/Task_ReportData.h"
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "task.h"
+
+
+/************************************************
+* External variables
+************************************************/
+// Access to current SysTick
+extern volatile long int xPortSysTickCount;
+
+
+/************************************************
+* Local variables
+************************************************/
+// Cost of ReportStatistics_Add, for the update-only path. 64 bits, a
+// 32 bit total of ~100 cycles per update wraps within hours.
+uint64_t ReportStatistics_Cycles_Total = 0;
+uint32_t ReportStatistics_Cycles_Max = 0;
+uint64_t ReportStatistics_Updates_Nbr = 0;
+
+
+/************************************************
+* Local function declarations
+************************************************/
+static void reset_window(ReportStatistics_Channel* channel, uint32_t windowStart);
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: reset_window
+* Description:   Start a new, empty window at windowStart
+* Parameters:    ReportStatistics_Channel* channel
+*                uint32_t windowStart
+* Return:        void
+*************************************************************************/
+static void reset_window(ReportStatistics_Channel* channel, uint32_t windowStart) {
+  channel->windowStart = windowStart;
+  channel->count = 0;
+  channel->min = 0.0f;
+  channel->max = 0.0f;
+  channel->mean = 0.0f;
+  channel->m2 = 0.0f;
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: ReportStatistics_Init
+* Description:   Initialize a channel
+* Parameters:    ReportStatistics_Channel* channel
+*                uint32_t reportName  - ReportName of the summary record
+*                uint32_t windowTicks - window length
+* Return:        void
+*************************************************************************/
+extern void ReportStatistics_Init(ReportStatistics_Channel* channel, uint32_t reportName, uint32_t windowTicks) {
+  channel->reportName = reportName;
+  channel->windowTicks = (windowTicks == 0) ? 1 : windowTicks;
+  reset_window(channel, xPortSysTickCount);
+
+  CycleCounter_Initialization();
+}
+
+
+/*************************************************************************
+* Function Name: ReportStatistics_SetWindow
+* Description:   Change the window length, effective from the next window
+* Parameters:    ReportStatistics_Channel* channel
+*                uint32_t windowTicks
+* Return:        void
+*************************************************************************/
+extern void ReportStatistics_SetWindow(ReportStatistics_Channel* channel, uint32_t windowTicks) {
+  channel->windowTicks = (windowTicks == 0) ? 1 : windowTicks;
+}
+
+
+/*************************************************************************
+* Function Name: ReportStatistics_Add
+* Description:   Add one sample to the channel's window
+* Parameters:    ReportStatistics_Channel* channel
+*                float value
+*                uint32_t timeStamp - SysTick of the sample
+* Return:        void
+*************************************************************************/
+extern void ReportStatistics_Add(ReportStatistics_Channel* channel, float value, uint32_t timeStamp) {
+  if ((timeStamp - channel->windowStart) >= channel->windowTicks) {
+    ReportStatistics_Flush(channel, timeStamp);
+  }
+
+  uint32_t start = CycleCounter_Get();
+
+  // Welford's update
+  float delta = value - channel->mean;
+  channel->count++;
+  channel->mean += delta / channel->count;
+  channel->m2 += delta * (value - channel->mean);
+
+  if ((channel->count == 1) || (value < channel->min)) {
+    channel->min = value;
+  }
+  if ((channel->count == 1) || (value > channel->max)) {
+    channel->max = value;
+  }
+
+  uint32_t cycles = CycleCounter_Get() - start;
+
+  // The sensors may run in different tasks; the 64 bit totals take two
+  // stores each
+  taskENTER_CRITICAL();
+  ReportStatistics_Cycles_Total += cycles;
+  ReportStatistics_Updates_Nbr++;
+  taskEXIT_CRITICAL();
+  if (cycles > ReportStatistics_Cycles_Max) {
+    ReportStatistics_Cycles_Max = cycles;
+  }
+}
+
+
+/*************************************************************************
+* Function Name: ReportStatistics_Flush
+* Description:   Send the summary record for the current window and start
+*                the one timeStamp falls in. The start advances by whole
+*                windows, so the boundaries do not drift with the jitter
+*                of the sample that closes a window, and windows without
+*                samples are skipped.
+* Parameters:    ReportStatistics_Channel* channel
+*                uint32_t timeStamp
+* Return:        void
+*************************************************************************/
+extern void ReportStatistics_Flush(ReportStatistics_Channel* channel, uint32_t timeStamp) {
+  if (channel->count > 0) {
+    float standardDeviation = sqrtf(channel->m2 / channel->count);
+
+    ReportData_Item item;
+    item.TimeStamp = timeStamp;
+    item.TimeStamp_SubTick_ns = 0;
+    item.ReportName = channel->reportName;
+    item.ReportValueType_Flg = 0b1111;
+    item.ReportValue_0 = *(int32_t*)&channel->min;
+    item.ReportValue_1 = *(int32_t*)&channel->max;
+    item.ReportValue_2 = *(int32_t*)&channel->mean;
+    item.ReportValue_3 = *(int32_t*)&standardDeviation;
+
+    ReportData_Send(&item);
+  }
+
+  uint32_t elapsed = timeStamp - channel->windowStart;
+  reset_window(channel, channel->windowStart + (elapsed / channel->windowTicks) * channel->windowTicks);
+}
+
+
+/*************************************************************************
+* Function Name: ReportStatistics_GetUpdateCost
+* Description:   Average and maximum cycles spent updating a window
+* Parameters:    uint32_t* averageCycles
+*                uint32_t* maxCycles
+* Return:        void
+*************************************************************************/
+extern void ReportStatistics_GetUpdateCost(uint32_t* averageCycles, uint32_t* maxCycles) {
+  uint64_t total = 0;
+  uint64_t updates = 0;
+
+  taskENTER_CRITICAL();
+  total = ReportStatistics_Cycles_Total;
+  updates = ReportStatistics_Updates_Nbr;
+  *maxCycles = ReportStatistics_Cycles_Max;
+  taskEXIT_CRITICAL();
+
+  *averageCycles = (updates == 0) ? 0 : (uint32_t)(total / updates);
+}
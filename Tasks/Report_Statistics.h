@@ -0,0 +1,67 @@
+/**
+* @Filename: Report_Statistics.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [3:05pm]
+* @Version:  1.0.0
+*
+* @Description: Windowed statistics between the sensor handlers and
+*               ReportData. Each channel keeps a streaming min, max, mean
+*               and variance (Welford) of one value and sends a single
+*               summary record to ReportData_Queue per window.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TASKS_REPORT_STATISTICS_H_
+#define TASKS_REPORT_STATISTICS_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+/************************************************
+* Configuration
+************************************************/
+// Default window length in ticks
+#define REPORT_STATISTICS_WINDOW configTICK_RATE_HZ
+
+
+/************************************************
+* Types
+************************************************/
+typedef struct ReportStatistics_Channel {
+  uint32_t reportName;   // ReportName of the summary record
+  uint32_t windowTicks;  // Window length
+  uint32_t windowStart;  // Tick the current window started
+  uint32_t count;        // Samples in the current window
+  float min;
+  float max;
+  float mean;
+  float m2;              // Sum of squared differences from the mean
+} ReportStatistics_Channel;
+
+
+/************************************************
+* Function declarations
+************************************************/
+extern void ReportStatistics_Init(ReportStatistics_Channel* channel, uint32_t reportName, uint32_t windowTicks);
+extern void ReportStatistics_SetWindow(ReportStatistics_Channel* channel, uint32_t windowTicks);
+
+// Add a sample taken at timeStamp. When the window has elapsed, a summary
+// record (min, max, mean, standard deviation as floats) is sent first and
+// this sample starts the window it falls in. Windows are windowTicks apart
+// from the first one, however late the samples that close them are.
+extern void ReportStatistics_Add(ReportStatistics_Channel* channel, float value, uint32_t timeStamp);
+
+// Send the summary for the current window, if it has samples, and reset.
+// The next window starts at the window boundary at or before timeStamp.
+extern void ReportStatistics_Flush(ReportStatistics_Channel* channel, uint32_t timeStamp);
+
+// Cycles per ReportStatistics_Add, excluding windows that sent a summary
+extern void ReportStatistics_GetUpdateCost(uint32_t* averageCycles, uint32_t* maxCycles);
+
+#endif /* TASKS_REPORT_STATISTICS_H_ */
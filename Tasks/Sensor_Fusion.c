@@ -0,0 +1,308 @@
+/**
+* @Filename: Sensor_Fusion.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [9:30am]
+* @Version:  1.0.0
+*
+* @Description: Madgwick orientation filter. Implementation follows
+*               S. Madgwick, "An efficient orientation filter for inertial
+*               and inertial/magnetic sensor arrays", 2010.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Tasks/Sensor_Fusion.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+static const float RADIANS_TO_DEGREES = 57.29577951f;
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: invSqrt
+* Description:   1 / sqrt(x)
+* Parameters:    float x
+* Return:        float
+*************************************************************************/
+static float invSqrt(float x) {
+  return 1.0f / sqrtf(x);
+}
+
+
+/*************************************************************************
+* Function Name: integrate
+* Description:   Integrate the rate of change of the quaternion, apply the
+*                gradient descent correction and normalise.
+* Parameters:    SensorFusion_State* state
+*                float qDot1..qDot4 - rate of change from the gyroscope
+*                float s0..s3       - normalised correction step
+* Return:        void
+*************************************************************************/
+static void integrate(SensorFusion_State* state,
+                      float qDot1, float qDot2, float qDot3, float qDot4,
+                      float s0, float s1, float s2, float s3) {
+  float recipNorm;
+
+  qDot1 -= state->beta * s0;
+  qDot2 -= state->beta * s1;
+  qDot3 -= state->beta * s2;
+  qDot4 -= state->beta * s3;
+
+  state->q0 += qDot1 * state->samplePeriod;
+  state->q1 += qDot2 * state->samplePeriod;
+  state->q2 += qDot3 * state->samplePeriod;
+  state->q3 += qDot4 * state->samplePeriod;
+
+  recipNorm = invSqrt(state->q0 * state->q0 + state->q1 * state->q1 +
+                      state->q2 * state->q2 + state->q3 * state->q3);
+  state->q0 *= recipNorm;
+  state->q1 *= recipNorm;
+  state->q2 *= recipNorm;
+  state->q3 *= recipNorm;
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: SensorFusion_Init
+* Description:   Reset the filter to the identity orientation
+* Parameters:    SensorFusion_State* state
+*                float sampleRateHz - update rate
+*                float beta         - filter gain
+* Return:        void
+*************************************************************************/
+extern void SensorFusion_Init(SensorFusion_State* state, float sampleRateHz, float beta) {
+  state->q0 = 1.0f;
+  state->q1 = 0.0f;
+  state->q2 = 0.0f;
+  state->q3 = 0.0f;
+  state->beta = beta;
+  state->samplePeriod = 1.0f / sampleRateHz;
+}
+
+
+/*************************************************************************
+* Function Name: SensorFusion_UpdateIMU
+* Description:   Filter update from gyroscope and accelerometer only
+* Parameters:    SensorFusion_State* state
+*                float gx, gy, gz - rad/s
+*                float ax, ay, az
+* Return:        void
+*************************************************************************/
+extern void SensorFusion_UpdateIMU(SensorFusion_State* state,
+                                   float gx, float gy, float gz,
+                                   float ax, float ay, float az) {
+  const float q0 = state->q0;
+  const float q1 = state->q1;
+  const float q2 = state->q2;
+  const float q3 = state->q3;
+  float recipNorm;
+  float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+
+  // Rate of change of quaternion from gyroscope
+  const float qDot1 = 0.5f * (-q1 * gx - q2 * gy - q3 * gz);
+  const float qDot2 = 0.5f * (q0 * gx + q2 * gz - q3 * gy);
+  const float qDot3 = 0.5f * (q0 * gy - q1 * gz + q3 * gx);
+  const float qDot4 = 0.5f * (q0 * gz + q1 * gy - q2 * gx);
+
+  // Only correct if the accelerometer reading is valid (avoids NaN)
+  if (!((ax == 0.0f) && (ay == 0.0f) && (az == 0.0f))) {
+    const float _2q0 = 2.0f * q0;
+    const float _2q1 = 2.0f * q1;
+    const float _2q2 = 2.0f * q2;
+    const float _2q3 = 2.0f * q3;
+    const float _4q0 = 4.0f * q0;
+    const float _4q1 = 4.0f * q1;
+    const float _4q2 = 4.0f * q2;
+    const float _8q1 = 8.0f * q1;
+    const float _8q2 = 8.0f * q2;
+    const float q0q0 = q0 * q0;
+    const float q1q1 = q1 * q1;
+    const float q2q2 = q2 * q2;
+    const float q3q3 = q3 * q3;
+
+    recipNorm = invSqrt(ax * ax + ay * ay + az * az);
+    ax *= recipNorm;
+    ay *= recipNorm;
+    az *= recipNorm;
+
+    // Gradient descent corrective step
+    s0 = _4q0 * q2q2 + _2q2 * ax + _4q0 * q1q1 - _2q1 * ay;
+    s1 = _4q1 * q3q3 - _2q3 * ax + 4.0f * q0q0 * q1 - _2q0 * ay - _4q1 + _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * az;
+    s2 = 4.0f * q0q0 * q2 + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2 + _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az;
+    s3 = 4.0f * q1q1 * q3 - _2q1 * ax + 4.0f * q2q2 * q3 - _2q2 * ay;
+
+    // A reading that matches the estimate exactly has no gradient, and
+    // normalising it would give NaN
+    recipNorm = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+    if (recipNorm > 0.0f) {
+      recipNorm = invSqrt(recipNorm);
+      s0 *= recipNorm;
+      s1 *= recipNorm;
+      s2 *= recipNorm;
+      s3 *= recipNorm;
+    }
+  }
+
+  integrate(state, qDot1, qDot2, qDot3, qDot4, s0, s1, s2, s3);
+}
+
+
+/*************************************************************************
+* Function Name: SensorFusion_UpdateMARG
+* Description:   Filter update from gyroscope, accelerometer and
+*                magnetometer
+* Parameters:    SensorFusion_State* state
+*                float gx, gy, gz - rad/s
+*                float ax, ay, az
+*                float mx, my, mz
+* Return:        void
+*************************************************************************/
+extern void SensorFusion_UpdateMARG(SensorFusion_State* state,
+                                    float gx, float gy, float gz,
+                                    float ax, float ay, float az,
+                                    float mx, float my, float mz) {
+  const float q0 = state->q0;
+  const float q1 = state->q1;
+  const float q2 = state->q2;
+  const float q3 = state->q3;
+  float recipNorm;
+  float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+
+  // Magnetometer not ready, use the IMU algorithm
+  if ((mx == 0.0f) && (my == 0.0f) && (mz == 0.0f)) {
+    SensorFusion_UpdateIMU(state, gx, gy, gz, ax, ay, az);
+    return;
+  }
+
+  // Rate of change of quaternion from gyroscope
+  const float qDot1 = 0.5f * (-q1 * gx - q2 * gy - q3 * gz);
+  const float qDot2 = 0.5f * (q0 * gx + q2 * gz - q3 * gy);
+  const float qDot3 = 0.5f * (q0 * gy - q1 * gz + q3 * gx);
+  const float qDot4 = 0.5f * (q0 * gz + q1 * gy - q2 * gx);
+
+  // Only correct if the accelerometer reading is valid (avoids NaN)
+  if (!((ax == 0.0f) && (ay == 0.0f) && (az == 0.0f))) {
+    const float _2q0 = 2.0f * q0;
+    const float _2q1 = 2.0f * q1;
+    const float _2q2 = 2.0f * q2;
+    const float _2q3 = 2.0f * q3;
+    const float _2q0q2 = 2.0f * q0 * q2;
+    const float _2q2q3 = 2.0f * q2 * q3;
+    const float q0q0 = q0 * q0;
+    const float q0q1 = q0 * q1;
+    const float q0q2 = q0 * q2;
+    const float q0q3 = q0 * q3;
+    const float q1q1 = q1 * q1;
+    const float q1q2 = q1 * q2;
+    const float q1q3 = q1 * q3;
+    const float q2q2 = q2 * q2;
+    const float q2q3 = q2 * q3;
+    const float q3q3 = q3 * q3;
+    float _2q0mx, _2q0my, _2q0mz, _2q1mx;
+    float hx, hy, _2bx, _2bz, _4bx, _4bz;
+
+    recipNorm = invSqrt(ax * ax + ay * ay + az * az);
+    ax *= recipNorm;
+    ay *= recipNorm;
+    az *= recipNorm;
+
+    recipNorm = invSqrt(mx * mx + my * my + mz * mz);
+    mx *= recipNorm;
+    my *= recipNorm;
+    mz *= recipNorm;
+
+    // Reference direction of Earth's magnetic field
+    _2q0mx = 2.0f * q0 * mx;
+    _2q0my = 2.0f * q0 * my;
+    _2q0mz = 2.0f * q0 * mz;
+    _2q1mx = 2.0f * q1 * mx;
+    hx = mx * q0q0 - _2q0my * q3 + _2q0mz * q2 + mx * q1q1 + _2q1 * my * q2 + _2q1 * mz * q3 - mx * q2q2 - mx * q3q3;
+    hy = _2q0mx * q3 + my * q0q0 - _2q0mz * q1 + _2q1mx * q2 - my * q1q1 + my * q2q2 + _2q2 * mz * q3 - my * q3q3;
+    _2bx = sqrtf(hx * hx + hy * hy);
+    _2bz = -_2q0mx * q2 + _2q0my * q1 + mz * q0q0 + _2q1mx * q3 - mz * q1q1 + _2q2 * my * q3 - mz * q2q2 + mz * q3q3;
+    _4bx = 2.0f * _2bx;
+    _4bz = 2.0f * _2bz;
+
+    // Gradient descent corrective step
+    s0 = -_2q2 * (2.0f * q1q3 - _2q0q2 - ax) + _2q1 * (2.0f * q0q1 + _2q2q3 - ay) - _2bz * q2 * (_2bx * (0.5f - q2q2 - q3q3) + _2bz * (q1q3 - q0q2) - mx) + (-_2bx * q3 + _2bz * q1) * (_2bx * (q1q2 - q0q3) + _2bz * (q0q1 + q2q3) - my) + _2bx * q2 * (_2bx * (q0q2 + q1q3) + _2bz * (0.5f - q1q1 - q2q2) - mz);
+    s1 = _2q3 * (2.0f * q1q3 - _2q0q2 - ax) + _2q0 * (2.0f * q0q1 + _2q2q3 - ay) - 4.0f * q1 * (1 - 2.0f * q1q1 - 2.0f * q2q2 - az) + _2bz * q3 * (_2bx * (0.5f - q2q2 - q3q3) + _2bz * (q1q3 - q0q2) - mx) + (_2bx * q2 + _2bz * q0) * (_2bx * (q1q2 - q0q3) + _2bz * (q0q1 + q2q3) - my) + (_2bx * q3 - _4bz * q1) * (_2bx * (q0q2 + q1q3) + _2bz * (0.5f - q1q1 - q2q2) - mz);
+    s2 = -_2q0 * (2.0f * q1q3 - _2q0q2 - ax) + _2q3 * (2.0f * q0q1 + _2q2q3 - ay) - 4.0f * q2 * (1 - 2.0f * q1q1 - 2.0f * q2q2 - az) + (-_4bx * q2 - _2bz * q0) * (_2bx * (0.5f - q2q2 - q3q3) + _2bz * (q1q3 - q0q2) - mx) + (_2bx * q1 + _2bz * q3) * (_2bx * (q1q2 - q0q3) + _2bz * (q0q1 + q2q3) - my) + (_2bx * q0 - _4bz * q2) * (_2bx * (q0q2 + q1q3) + _2bz * (0.5f - q1q1 - q2q2) - mz);
+    s3 = _2q1 * (2.0f * q1q3 - _2q0q2 - ax) + _2q2 * (2.0f * q0q1 + _2q2q3 - ay) + (-_4bx * q3 + _2bz * q1) * (_2bx * (0.5f - q2q2 - q3q3) + _2bz * (q1q3 - q0q2) - mx) + (-_2bx * q0 + _2bz * q2) * (_2bx * (q1q2 - q0q3) + _2bz * (q0q1 + q2q3) - my) + _2bx * q1 * (_2bx * (q0q2 + q1q3) + _2bz * (0.5f - q1q1 - q2q2) - mz);
+
+    // A reading that matches the estimate exactly has no gradient, and
+    // normalising it would give NaN
+    recipNorm = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+    if (recipNorm > 0.0f) {
+      recipNorm = invSqrt(recipNorm);
+      s0 *= recipNorm;
+      s1 *= recipNorm;
+      s2 *= recipNorm;
+      s3 *= recipNorm;
+    }
+  }
+
+  integrate(state, qDot1, qDot2, qDot3, qDot4, s0, s1, s2, s3);
+}
+
+
+/*************************************************************************
+* Function Name: SensorFusion_UpdateMPU9150
+* Description:   Filter update with the magnetometer in AK8975 axes
+* Parameters:    SensorFusion_State* state
+*                float gx, gy, gz - rad/s
+*                float ax, ay, az
+*                float mx, my, mz - AK8975 X, Y, Z
+* Return:        void
+*************************************************************************/
+extern void SensorFusion_UpdateMPU9150(SensorFusion_State* state,
+                                       float gx, float gy, float gz,
+                                       float ax, float ay, float az,
+                                       float mx, float my, float mz) {
+  SensorFusion_UpdateMARG(state, gx, gy, gz, ax, ay, az, my, mx, -mz);
+}
+
+
+/*************************************************************************
+* Function Name: SensorFusion_GetEuler
+* Description:   Convert the current quaternion to Euler angles
+* Parameters:    const SensorFusion_State* state
+*                float* roll, pitch, yaw - degrees
+* Return:        void
+*************************************************************************/
+extern void SensorFusion_GetEuler(const SensorFusion_State* state,
+                                  float* roll, float* pitch, float* yaw) {
+  const float q0 = state->q0;
+  const float q1 = state->q1;
+  const float q2 = state->q2;
+  const float q3 = state->q3;
+  float sinPitch = 2.0f * (q0 * q2 - q3 * q1);
+
+  // Clamp to avoid NaN from asinf at the poles
+  if (sinPitch > 1.0f) {
+    sinPitch = 1.0f;
+  }
+  else if (sinPitch < -1.0f) {
+    sinPitch = -1.0f;
+  }
+
+  *roll = atan2f(2.0f * (q0 * q1 + q2 * q3), 1.0f - 2.0f * (q1 * q1 + q2 * q2)) * RADIANS_TO_DEGREES;
+  *pitch = asinf(sinPitch) * RADIANS_TO_DEGREES;
+  *yaw = atan2f(2.0f * (q0 * q3 + q1 * q2), 1.0f - 2.0f * (q2 * q2 + q3 * q3)) * RADIANS_TO_DEGREES;
+}
@@ -0,0 +1,78 @@
+/**
+* @Filename: Sensor_Fusion.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [9:30am]
+* @Version:  1.0.0
+*
+* @Description: Madgwick orientation filter fusing MPU9150 accelerometer,
+*               gyroscope and AK8975 magnetometer samples into a
+*               quaternion and Euler angles.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TASKS_SENSOR_FUSION_H_
+#define TASKS_SENSOR_FUSION_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/************************************************
+* Configuration
+************************************************/
+// Rate the MPU9150 is sampled and the filter is updated at
+#define SENSOR_FUSION_SAMPLE_RATE_HZ 100
+
+// Default rate orientation records are sent to ReportData
+#define SENSOR_FUSION_REPORT_RATE_HZ 1
+
+// Filter gain. sqrt(3/4) * gyroscope measurement error (5 deg/s)
+#define SENSOR_FUSION_BETA 0.0756f
+
+
+/************************************************
+* Types
+************************************************/
+typedef struct SensorFusion_State {
+  float q0;            // Orientation quaternion, scalar part
+  float q1;            // Orientation quaternion, x
+  float q2;            // Orientation quaternion, y
+  float q3;            // Orientation quaternion, z
+  float beta;          // Gradient descent step gain
+  float samplePeriod;  // Seconds between updates
+} SensorFusion_State;
+
+
+/************************************************
+* Function declarations
+************************************************/
+extern void SensorFusion_Init(SensorFusion_State* state, float sampleRateHz, float beta);
+
+// Gyroscope in rad/s, accelerometer in any unit (normalized).
+extern void SensorFusion_UpdateIMU(SensorFusion_State* state,
+                                   float gx, float gy, float gz,
+                                   float ax, float ay, float az);
+
+// As above, with magnetometer in any unit (normalized). Falls back to
+// SensorFusion_UpdateIMU when the magnetometer reading is all zero.
+extern void SensorFusion_UpdateMARG(SensorFusion_State* state,
+                                    float gx, float gy, float gz,
+                                    float ax, float ay, float az,
+                                    float mx, float my, float mz);
+
+// SensorFusion_UpdateMARG with the magnetometer in the AK8975's own axes,
+// as the MPU9150 driver returns it. The AK8975's X and Y are the
+// accelerometer's Y and X, its Z points the opposite direction.
+extern void SensorFusion_UpdateMPU9150(SensorFusion_State* state,
+                                       float gx, float gy, float gz,
+                                       float ax, float ay, float az,
+                                       float mx, float my, float mz);
+
+// Roll, pitch and yaw in degrees
+extern void SensorFusion_GetEuler(const SensorFusion_State* state,
+                                  float* roll, float* pitch, float* yaw);
+
+#endif /* TASKS_SENSOR_FUSION_H_ */
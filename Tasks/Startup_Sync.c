@@ -0,0 +1,148 @@
+/**
+* @Filename: Startup_Sync.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [7:30pm]
+* @Version:  1.0.0
+*
+* @Description: Event group based start-up barrier
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+#include "Tasks/Log.h"
+#include "Tasks/Startup_Sync.h"
+
+#include "FreeRTOS.h"
+#include "event_groups.h"
+#include "task.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+const char* const STARTUP_SUBSYSTEM_NAMES[STARTUP_SUBSYSTEMS_NBR] = {
+  "ReportData", "I2C7", "BMP180", "MPU9150"
+};
+
+
+/************************************************
+* Local variables
+************************************************/
+uint32_t StartupInitFlag = 0;
+
+EventGroupHandle_t Startup_EventGroup = NULL;
+
+// Subsystems that have signalled, and the tick at which each first did.
+// Updated together in a critical section, so two signals of the same bit
+// cannot both record a tick.
+volatile EventBits_t Startup_Signalled = 0;
+TickType_t Startup_Ready_Ticks[STARTUP_SUBSYSTEMS_NBR];
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: Startup_Initialization
+* Description:   Create the start-up event group
+* Parameters:    N/A
+* Return:        uint32_t - 1
+*************************************************************************/
+extern uint32_t Startup_Initialization() {
+  if (StartupInitFlag == 0) {
+    Startup_EventGroup = xEventGroupCreate();
+    configASSERT(Startup_EventGroup);
+
+    StartupInitFlag = 1;
+  }
+
+  return (1);
+}
+
+
+/*************************************************************************
+* Function Name: Startup_Signal
+* Description:   Mark subsystems ready and wake anything waiting on them.
+*                Cheap once the bits are set, so it can be called for
+*                every sample.
+* Parameters:    EventBits_t ready
+* Return:        void
+*************************************************************************/
+extern void Startup_Signal(EventBits_t ready) {
+  EventBits_t newlyReady = 0;
+  uint32_t i = 0;
+
+  if ((ready & ~Startup_Signalled) == 0) {
+    return;
+  }
+
+  taskENTER_CRITICAL();
+  newlyReady = ready & ~Startup_Signalled;
+  Startup_Signalled |= newlyReady;
+  for (i = 0; i < STARTUP_SUBSYSTEMS_NBR; ++i) {
+    if (newlyReady & (1 << i)) {
+      Startup_Ready_Ticks[i] = xTaskGetTickCount();
+    }
+  }
+  taskEXIT_CRITICAL();
+
+  if (newlyReady != 0) {
+    xEventGroupSetBits(Startup_EventGroup, newlyReady);
+  }
+}
+
+
+/*************************************************************************
+* Function Name: Startup_Wait
+* Description:   Block until all dependencies are ready
+* Parameters:    EventBits_t dependencies
+*                TickType_t timeout
+* Return:        bool - false on timeout
+*************************************************************************/
+extern bool Startup_Wait(EventBits_t dependencies, TickType_t timeout) {
+  EventBits_t bits = xEventGroupWaitBits(Startup_EventGroup, dependencies, pdFALSE, pdTRUE, timeout);
+  return ((bits & dependencies) == dependencies);
+}
+
+
+/*************************************************************************
+* Function Name: Startup_IsReady
+* Description:   Check dependencies without blocking
+* Parameters:    EventBits_t dependencies
+* Return:        bool
+*************************************************************************/
+extern bool Startup_IsReady(EventBits_t dependencies) {
+  return ((xEventGroupGetBits(Startup_EventGroup) & dependencies) == dependencies);
+}
+
+
+/*************************************************************************
+* Function Name: Startup_PrintTimes
+* Description:   Print the time from scheduler start to each subsystem
+*                becoming ready
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void Startup_PrintTimes() {
+  EventBits_t bits = xEventGroupGetBits(Startup_EventGroup);
+  uint32_t i = 0;
+
+  Log_Printf("subsystem,ready tick,ready ms\n");
+  for (i = 0; i < STARTUP_SUBSYSTEMS_NBR; ++i) {
+    if (bits & (1 << i)) {
+      Log_Printf("%s,%u,%u\n", STARTUP_SUBSYSTEM_NAMES[i], Startup_Ready_Ticks[i],
+                 (uint32_t)(((uint64_t)Startup_Ready_Ticks[i] * 1000) / configTICK_RATE_HZ));
+    }
+    else {
+      Log_Printf("%s,waiting,\n", STARTUP_SUBSYSTEM_NAMES[i]);
+    }
+  }
+}
@@ -0,0 +1,65 @@
+/**
+* @Filename: Startup_Sync.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [7:30pm]
+* @Version:  1.0.0
+*
+* @Description: Start-up barrier. Each subsystem owns one bit of an event
+*               group and sets it with Startup_Signal once it is ready.
+*               Anything that depends on a subsystem waits for its bit
+*               instead of delaying for a fixed time:
+*
+*                 Tasks                 Startup_Wait (xEventGroupWaitBits)
+*                 Acquisition steps     Startup_IsReady, retried next tick,
+*                                       since a step must not block
+*
+*               The tick at which each bit was first set is kept, so the
+*               time from reset to each subsystem's first sample can be
+*               printed with Startup_PrintTimes.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TASKS_STARTUP_SYNC_H_
+#define TASKS_STARTUP_SYNC_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "event_groups.h"
+
+/************************************************
+* Subsystem bits
+************************************************/
+#define STARTUP_REPORTDATA (1 << 0)  // ReportData_Queue has been created
+#define STARTUP_I2C7       (1 << 1)  // I2C7 master driver initialized
+#define STARTUP_BMP180     (1 << 2)  // First BMP180 sample compensated
+#define STARTUP_MPU9150    (1 << 3)  // First MPU9150 sample fused
+
+#define STARTUP_SUBSYSTEMS_NBR 4
+
+
+/************************************************
+* Function declarations
+************************************************/
+// Create the event group. Called from main before the scheduler starts.
+extern uint32_t Startup_Initialization();
+
+// Mark subsystems ready
+extern void Startup_Signal(EventBits_t ready);
+
+// Block the calling task until all dependencies are ready. Returns false
+// on timeout.
+extern bool Startup_Wait(EventBits_t dependencies, TickType_t timeout);
+
+// True if all dependencies are ready. Never blocks.
+extern bool Startup_IsReady(EventBits_t dependencies);
+
+// Print the tick at which each subsystem became ready
+extern void Startup_PrintTimes();
+
+#endif /* TASKS_STARTUP_SYNC_H_ */
@@ -7,7 +7,8 @@
 * @Modified: October 18th, 2018 [6:41am]
 * @Version:  1.0.0
 *
-* @Description: Periodically read and report temperature and pressure
+* @Description: Periodically read and report temperature and pressure.
+*               Runs as a state machine under Acquisition_Scheduler.h.
 *
 * Copyright (C) 2018 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
 */
@@ -26,12 +27,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "Drivers/BMP180_Acquisition.h"
+#include "Drivers/BMP180_Compensation.h"
 #include "Drivers/I2C7_Handler.h"
 #include "Drivers/UARTStdio_Initialization.h"
 #include "Drivers/uartstdio.h"
 
-#include "sensorlib/bmp180.h"
-#include "sensorlib/hw_bmp180.h"
 #include "sensorlib/i2cm_drv.h"
 
 #include "driverlib/gpio.h"
@@ -40,10 +41,16 @@
 #include "driverlib/sysctl.h"
 #include "driverlib/timer.h"
 
+#include "Tasks/Acquisition_Scheduler.h"
+#include "Tasks/Deadline_Monitor.h"
+#include "Tasks/Latency_Histogram.h"
+#include "Tasks/Log.h"
+#include "Tasks/Metrics.h"
+#include "Tasks/Report_Statistics.h"
+#include "Tasks/Startup_Sync.h"
 #include "Tasks/Task_ReportData.h"
 
 #include "FreeRTOS.h"
-#include "semphr.h"
 #include "task.h"
 
 
@@ -63,28 +70,71 @@ extern volatile long int xPortSysTickCount;
 // The I2C Address of the BMP180
 const int BMP180_ADDRESS = 0x77;
 
+// Oversampling setting and number of pressure conversions that reuse one
+// temperature conversion
+const uint32_t BMP180_OVERSAMPLING = BMP180_OSS_STANDARD;
+const uint32_t BMP180_PRESSURE_PER_TEMPERATURE = 8;
+
+// Ticks between reports. The BMP180 is sampled as fast as the
+// oversampling setting allows; the latest sample is reported.
+const uint32_t BMP180_REPORT_PERIOD = SysTickFrequency;
+
+
+/************************************************
+* Local task constant types
+************************************************/
+typedef enum BMP180_HANDLER_PHASE_t {
+  BMP180_HANDLER_INITIALIZE,  // One-time set-up on the first step
+  BMP180_HANDLER_START,       // Issue the next transaction
+  BMP180_HANDLER_COMPLETE     // Consume the completed transaction
+} BMP180_HANDLER_PHASE_t;
+
 
 /************************************************
 * Local task variables
 ************************************************/
-// The BMP180 control block
-tBMP180 sBMP180;
+// The BMP180 acquisition engine and its scheduler entry
+BMP180_Acquisition sBMP180Acq;
+Acquisition_Sensor BMP180_Sensor;
+BMP180_HANDLER_PHASE_t BMP180_Phase = BMP180_HANDLER_INITIALIZE;
+
+// Samples since the last report and the tick of the last report
+uint32_t BMP180_Samples_Since_Report = 0;
+TickType_t BMP180_Last_Report_Time = 0;
+
+// Each transaction is a job due when the previous conversion wait ends,
+// with one pressure conversion time as its period and deadline: a
+// transaction held up longer costs a sample
+DeadlineMonitor BMP180_Deadline;
+TickType_t BMP180_Next_Start_Time = 0;
 
-// A boolean that is set when an I2C transaction is completed.
-volatile bool BMP180SimpleDone = false;
+// Windowed statistics of pressure (Pa) and temperature (0.1 degrees C)
+ReportStatistics_Channel BMP180_Pressure_Statistics;
+ReportStatistics_Channel BMP180_Temperature_Statistics;
 
-// The number of BMP180 callbacks taken.
-uint32_t BMP180_Callbacks_Nbr = 0;
+// I2C latency of each transaction type, indexed by BMP180Acq_State_t
+#define BMP180_LATENCY_OPERATIONS 5
+const char* const BMP180_LATENCY_NAMES[BMP180_LATENCY_OPERATIONS] = {
+  "BMP180.calibration", "BMP180.start_temperature", "BMP180.read_temperature",
+  "BMP180.start_pressure", "BMP180.read_pressure"
+};
+LatencyHistogram BMP180_Latency[BMP180_LATENCY_OPERATIONS];
 
-// Semaphore to indicate completion of an I/O operation
-xSemaphoreHandle BMP180_Semaphore;
+// The number of BMP180 transactions completed.
+Metrics_Metric BMP180_Callbacks_Nbr = METRICS_COUNTER("BMP180 callbacks");
+
+// Cycles of the integer compensation of the latest sample
+Metrics_Metric BMP180_Compensation_Cycles = METRICS_GAUGE("BMP180 compensation cycles");
 
 
 /************************************************
 * Local task function declarations
 ************************************************/
-extern void BMP180SimpleCallback(void* pvData, uint_fast8_t ui8Status);
-extern void Task_BMP180_Handler(void* pvParameters);
+extern void BMP180_Handler_Start();
+static uint32_t bmp180_step(Acquisition_Sensor* sensor);
+static void bmp180_initialize();
+static void bmp180_report();
+static void report_bmp180_timing_model();
 
 
 /************************************************
@@ -92,89 +142,178 @@ extern void Task_BMP180_Handler(void* pvParameters);
 ************************************************/
 
 /*************************************************************************
-* Function Name: BMP180SimpleCallback
-* Description:   Callback Routine for the BMP180 for when
-*                transactions have completed
-* Parameters:    void* pvData
-*                uint_fast8_t ui8Status
+* Function Name: report_bmp180_timing_model
+* Description:   Print the achievable sample rate and bus load of each
+*                oversampling setting for the configured temperature reuse
+* Parameters:    N/A
 * Return:        void
 *************************************************************************/
-void BMP180SimpleCallback(void* pvData, uint_fast8_t ui8Status) {
-  portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
-  BMP180_Callbacks_Nbr++;
-
-  if (ui8Status != I2CM_STATUS_SUCCESS) {
-    // An error occurred
-    UARTprintf(">>>>BMP180 Error: %02X\n", ui8Status);
+static void report_bmp180_timing_model() {
+  uint32_t oss = 0;
+  for (oss = BMP180_OSS_ULTRA_LOW_POWER; oss <= BMP180_OSS_ULTRA_HIGH_RESOLUTION; ++oss) {
+    Log_Printf(">>>>BMP180: OSS %u: %u samples/s, %u I2C bytes/sample (1 temperature per %u)\n",
+               oss,
+               BMP180Acq_ModelSamplesPerSecond(oss, BMP180_PRESSURE_PER_TEMPERATURE),
+               BMP180Acq_ModelBusBytesPerSample(BMP180_PRESSURE_PER_TEMPERATURE),
+               BMP180_PRESSURE_PER_TEMPERATURE);
   }
-  // Indicate that the I2C transaction has completed.
-  BMP180SimpleDone = true;
-
-  // "Give" the BMP180_Semaphore
-  xSemaphoreGiveFromISR(BMP180_Semaphore, &xHigherPriorityTaskWoken);
-  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
 
 /*************************************************************************
-* Function Name: Task_BMP180_Handler
-* Description:   Task to report Temperature and Pressure from
-*                BMP180 sensor
-* Parameters:    void* pvParameters;
+* Function Name: bmp180_initialize
+* Description:   One-time set-up, run by the first step
+* Parameters:    N/A
 * Return:        void
 *************************************************************************/
-extern void Task_BMP180_Handler(void* pvParameters) {
+static void bmp180_initialize() {
   // Initialize UART
   UARTStdio_Initialization();
 
-  // Initialize I2C7
-  I2C7_Initialization();
-
-  // Initialize BMP180_Semaphore
-  vSemaphoreCreateBinary(BMP180_Semaphore);
-
-  // Initialize the BMP180.
-  BMP180SimpleDone = false;
-  BMP180Init(&sBMP180, I2C7_Instance_Ref, BMP180_ADDRESS, BMP180SimpleCallback, 0);
-  xSemaphoreTake(BMP180_Semaphore, portMAX_DELAY);
-  UARTprintf(">>>>BMP180: Initialized!\n");
-
-  // Loop forever reading and reporting data from the BMP180.
-  while (1) {
-    float fTemperature = 0.0;
-    float fPressure = 0.0;
-
-    // Request a reading from the BMP180.
-    BMP180DataRead(&sBMP180, BMP180SimpleCallback, 0);
-    xSemaphoreTake(BMP180_Semaphore, portMAX_DELAY);
-
-    // Get the new pressure and temperature reading.
-    BMP180DataPressureGetFloat(&sBMP180, &fPressure);
-    BMP180DataTemperatureGetFloat(&sBMP180, &fTemperature);
-
-    ReportData_Item pressureItem;
-    pressureItem.TimeStamp = xPortSysTickCount;
-    pressureItem.ReportName = 0002;
-    pressureItem.ReportValueType_Flg = 0b0001;
-    pressureItem.ReportValue_0 = *(int32_t*)&fPressure;
-    pressureItem.ReportValue_1 = fPressure;
-    pressureItem.ReportValue_2 = 0;
-    pressureItem.ReportValue_3 = 0;
-
-    ReportData_Item tempItem;
-    tempItem.TimeStamp = xPortSysTickCount;
-    tempItem.ReportName = 0003;
-    tempItem.ReportValueType_Flg = 0b0001;
-    tempItem.ReportValue_0 = *(int32_t*)&fTemperature;
-    tempItem.ReportValue_1 = 0;
-    tempItem.ReportValue_2 = 0;
-    tempItem.ReportValue_3 = 0;
-
-    // Send ReportData_Items to queue to print
-    xQueueSend(ReportData_Queue, &pressureItem, 0);
-    xQueueSend(ReportData_Queue, &tempItem, 0);
-
-    // Delay
-    vTaskDelay((SysTickFrequency * 1000) / 1000);
+  report_bmp180_timing_model();
+
+  uint32_t operation = 0;
+  for (operation = 0; operation < BMP180_LATENCY_OPERATIONS; ++operation) {
+    LatencyHistogram_Init(&BMP180_Latency[operation], BMP180_LATENCY_NAMES[operation]);
+  }
+
+  // Initialize the acquisition engine. The first transaction reads the
+  // calibration E2PROM.
+  BMP180Acq_Init(&sBMP180Acq, I2C7_Instance_Ref, BMP180_ADDRESS,
+                 BMP180_OVERSAMPLING, BMP180_PRESSURE_PER_TEMPERATURE);
+  Log_Printf(">>>>BMP180: Initialized!\n");
+
+  ReportStatistics_Init(&BMP180_Pressure_Statistics, ReportName_Statistics(ReportName_Pressure, 0), REPORT_STATISTICS_WINDOW);
+  ReportStatistics_Init(&BMP180_Temperature_Statistics, ReportName_Statistics(ReportName_Temperature, 0), REPORT_STATISTICS_WINDOW);
+
+  BMP180_Samples_Since_Report = 0;
+  BMP180_Last_Report_Time = xTaskGetTickCount();
+
+  uint32_t conversionTicks = BMP180Acq_ConversionTicks(BMP180ACQ_PRESSURE_US(BMP180_OVERSAMPLING));
+  BMP180_Next_Start_Time = xTaskGetTickCount();
+  if (!DeadlineMonitor_Init(&BMP180_Deadline, "BMP180", conversionTicks, conversionTicks)) {
+    Log_Printf(">>>>BMP180: Deadline monitor list full, not listed\n");
+  }
+}
+
+
+/*************************************************************************
+* Function Name: bmp180_report
+* Description:   Report the latest pressure and temperature
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void bmp180_report() {
+  ReportData_Item pressureItem;
+  ReportData_Stamp(&pressureItem);
+  pressureItem.ReportName = ReportName_Pressure;
+  pressureItem.ReportValueType_Flg = 0b0000;
+  pressureItem.ReportValue_0 = sBMP180Acq.pressure;
+  pressureItem.ReportValue_1 = BMP180_Samples_Since_Report;
+  pressureItem.ReportValue_2 = sBMP180Acq.oss;
+  pressureItem.ReportValue_3 = sBMP180Acq.errors;
+
+  ReportData_Item tempItem;
+  ReportData_Stamp(&tempItem);
+  tempItem.ReportName = ReportName_Temperature;
+  tempItem.ReportValueType_Flg = 0b0000;
+  tempItem.ReportValue_0 = sBMP180Acq.temperature;
+  tempItem.ReportValue_1 = 0;
+  tempItem.ReportValue_2 = 0;
+  tempItem.ReportValue_3 = 0;
+
+  // Send ReportData_Items to queue to print
+  ReportData_Send(&pressureItem);
+  ReportData_Send(&tempItem);
+}
+
+
+/*************************************************************************
+* Function Name: bmp180_step
+* Description:   BMP180 state machine. Alternates between issuing a
+*                transaction and consuming it, sampling as fast as the
+*                oversampling setting allows and reporting the latest
+*                sample every BMP180_REPORT_PERIOD ticks.
+* Parameters:    Acquisition_Sensor* sensor
+* Return:        uint32_t - ticks until the next step, or
+*                           ACQUISITION_WAIT_IO
+*************************************************************************/
+static uint32_t bmp180_step(Acquisition_Sensor* sensor) {
+  switch (BMP180_Phase) {
+    case BMP180_HANDLER_INITIALIZE:
+      // Start initializing I2C7, or finish it once its first transaction
+      // is done. Samples are reported, so wait for ReportData too.
+      I2C7_Initialization();
+      if (!Startup_IsReady(STARTUP_REPORTDATA | STARTUP_I2C7)) {
+        return 1;
+      }
+      bmp180_initialize();
+      BMP180_Phase = BMP180_HANDLER_START;
+      return 0;
+
+    case BMP180_HANDLER_START: {
+      bool bSampleReady = false;
+
+      // Issue the next transaction; the previous sample is compensated
+      // while it runs.
+      DeadlineMonitor_Start(&BMP180_Deadline, BMP180_Next_Start_Time);
+      Acquisition_BeginIO(sensor, &BMP180_Latency[sBMP180Acq.state]);
+      BMP180Acq_Start(&sBMP180Acq, Acquisition_I2CCallback, sensor, &bSampleReady);
+      BMP180_Phase = BMP180_HANDLER_COMPLETE;
+
+      if (bSampleReady) {
+        Startup_Signal(STARTUP_BMP180);
+        BMP180_Samples_Since_Report++;
+        Metrics_Set(&BMP180_Compensation_Cycles, sBMP180Acq.compensationCycles);
+        ReportStatistics_Add(&BMP180_Pressure_Statistics, (float)sBMP180Acq.pressure, xPortSysTickCount);
+        ReportStatistics_Add(&BMP180_Temperature_Statistics, (float)sBMP180Acq.temperature, xPortSysTickCount);
+
+        if ((xTaskGetTickCount() - BMP180_Last_Report_Time) >= BMP180_REPORT_PERIOD) {
+          bmp180_report();
+          BMP180_Samples_Since_Report = 0;
+          BMP180_Last_Report_Time += BMP180_REPORT_PERIOD;
+        }
+      }
+      return ACQUISITION_WAIT_IO;
+    }
+
+    case BMP180_HANDLER_COMPLETE:
+    default: {
+      uint32_t ticks = 0;
+
+      Metrics_Increment(&BMP180_Callbacks_Nbr);
+      DeadlineMonitor_Finish(&BMP180_Deadline);
+      if (sensor->status != I2CM_STATUS_SUCCESS) {
+        // An error occurred
+        Log_Printf(">>>>BMP180 Error: %02X\n", sensor->status);
+      }
+
+      // Wait for the conversion the transaction started
+      BMP180_Phase = BMP180_HANDLER_START;
+      ticks = BMP180Acq_Complete(&sBMP180Acq, sensor->status);
+      BMP180_Next_Start_Time = xTaskGetTickCount() + ticks;
+      return ticks;
+    }
+  }
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: BMP180_Handler_Start
+* Description:   Schedule the BMP180 state machine. Replaces the
+*                Task_BMP180_Handler task.
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void BMP180_Handler_Start() {
+  Metrics_Register(&BMP180_Callbacks_Nbr);
+  Metrics_Register(&BMP180_Compensation_Cycles);
+
+  if (!Acquisition_Start(&BMP180_Sensor, "BMP180", bmp180_step, NULL)) {
+    Log_Printf(">>>>BMP180: Could not be scheduled\n");
   }
 }
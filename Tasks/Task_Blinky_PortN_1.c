@@ -6,6 +6,14 @@
  *
  *  Description:	Blinks LED D1 on Tiva TMC41294 Evaluation board
  *
+ *  Modification:	2026-10-19
+ *  				Toggled from an auto-reload software timer instead
+ *  				of a task of its own.
+ *
+ *  Modification:	2026-10-20
+ *  				A co-routine sharing the sensors' stack when
+ *  				ACQUISITION_USE_COROUTINES is 1.
+ *
  */
 
 #include	"inc/hw_ints.h"
@@ -22,13 +30,61 @@
 #include	"driverlib/pin_map.h"
 #include	"driverlib/gpio.h"
 
+#include	"Tasks/Acquisition_Scheduler.h"
+
 #include	"FreeRTOS.h"
+#include	"croutine.h"
 #include	"task.h"
+#include	"timers.h"
+
+//
+//	Ticks between LED toggles
+//
+#define		Blink_Period_Ticks		( ( 500 * configTICK_RATE_HZ ) / 10000 )
 
-extern void Task_Blink_LED_PortN_1( void *pvParameters ) {
+static void Blink_LED_PortN_1_Toggle( void ) {
 
 	uint32_t	LED_Data;
 
+	//
+	// Toggle the LED.
+	//
+	LED_Data = GPIOPinRead( GPIO_PORTN_BASE, GPIO_PIN_1 );
+	LED_Data = LED_Data ^ 0x02;
+	GPIOPinWrite( GPIO_PORTN_BASE, GPIO_PIN_1, LED_Data );
+}
+
+#if ACQUISITION_USE_COROUTINES
+
+static void Blink_LED_PortN_1_CoRoutine( CoRoutineHandle_t xHandle, UBaseType_t uxIndex ) {
+
+	crSTART( xHandle );
+
+	for ( ;; ) {
+		Blink_LED_PortN_1_Toggle();
+		crDELAY( xHandle, Blink_Period_Ticks );
+	}
+
+	crEND();
+}
+
+#else
+
+static void Blink_LED_PortN_1_Callback( TimerHandle_t xTimer ) {
+
+	( void ) xTimer;
+
+	Blink_LED_PortN_1_Toggle();
+}
+
+#endif
+
+extern void Blink_LED_PortN_1_Start( void ) {
+
+#if !ACQUISITION_USE_COROUTINES
+	TimerHandle_t	Blink_Timer;
+#endif
+
     //
     // Enable the GPIO Port N.
     //
@@ -41,16 +97,22 @@ extern void Task_Blink_LED_PortN_1( void *pvParameters ) {
     GPIOPadConfigSet( GPIO_PORTN_BASE,
     					GPIO_PIN_1, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD );
 
-	while ( 1 ) {
-        //
-        // Toggle the LED.
-        //
-		LED_Data = GPIOPinRead( GPIO_PORTN_BASE, GPIO_PIN_1 );
-		LED_Data = LED_Data ^ 0x02;
-        GPIOPinWrite( GPIO_PORTN_BASE, GPIO_PIN_1, LED_Data );
-
-		vTaskDelay( ( 500 * configTICK_RATE_HZ ) / 10000 );
+#if ACQUISITION_USE_COROUTINES
+	//
+	//	The CoRoutines task toggles the LED.
+	//
+	if ( xCoRoutineCreate( Blink_LED_PortN_1_CoRoutine, 0, 0 ) == pdPASS ) {
+		Acquisition_StartCoRoutines();
+	}
+#else
+	//
+	//	The timer service task toggles the LED.
+	//
+	Blink_Timer = xTimerCreate( "Blinky", Blink_Period_Ticks, pdTRUE, NULL, Blink_LED_PortN_1_Callback );
+	if ( Blink_Timer != NULL ) {
+		xTimerStart( Blink_Timer, 0 );
 	}
+#endif
 }
 
 
@@ -0,0 +1,577 @@
+/**
+* @Filename: Task_Console.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [4:55pm]
+* @Version:  1.0.0
+*
+* @Description: Reads command lines from the UART0 console and runs them.
+*               Characters are polled so the task never spins waiting for
+*               input, and commands only set variables or print, so the
+*               console never holds up ReportData. Commands are listed in
+*               CONSOLE_COMMANDS; "help" prints their usage. Line editing
+*               and dispatch are in Console_Parser.c.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "driverlib/uart.h"
+
+#include "Drivers/Critical_Monitor.h"
+#include "Drivers/ISR_Accounting.h"
+#include "Drivers/Timestamp.h"
+#include "Drivers/UARTStdio_Initialization.h"
+#include "Drivers/uartstdio.h"
+
+#include "Tasks/Acquisition_Scheduler.h"
+#include "Tasks/Console_Parser.h"
+#include "Tasks/Deadline_Monitor.h"
+#include "Tasks/Kernel_Benchmark.h"
+#include "Tasks/Latency_Histogram.h"
+#include "Tasks/Log.h"
+#include "Tasks/Metrics.h"
+#include "Tasks/Report_Filter.h"
+#include "Tasks/Report_Statistics.h"
+#include "Tasks/Startup_Sync.h"
+#include "Tasks/Task_MPU9150_Handler.h"
+#include "Tasks/Task_ProgramTrace.h"
+#include "Tasks/Task_ReportData.h"
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "task.h"
+
+// After FreeRTOS.h, which sets configUSE_TRACE_RECORDER
+#include "Drivers/Trace_Recorder.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+// Ticks between polls of the UART receiver
+const uint32_t CONSOLE_POLL_PERIOD = configTICK_RATE_HZ / 50;
+
+// Throughput test pattern, written without line ends so that no CR is
+// added
+const char CONSOLE_TEST_PATTERN[] = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+#define CONSOLE_TEST_PATTERN_SIZE (sizeof(CONSOLE_TEST_PATTERN) - 1)
+
+
+/************************************************
+* Local task function declarations
+************************************************/
+extern void Task_Console(void* pvParameters);
+static bool console_getc(char* pcChar);
+static bool console_format(int argc, char* argv[]);
+static bool console_rate(int argc, char* argv[]);
+static bool console_stats(int argc, char* argv[]);
+static bool console_profiler(int argc, char* argv[]);
+static bool console_latency(int argc, char* argv[]);
+static bool console_trace(int argc, char* argv[]);
+static bool console_isr(int argc, char* argv[]);
+static bool console_critical(int argc, char* argv[]);
+static bool console_deadline(int argc, char* argv[]);
+static bool console_bench(int argc, char* argv[]);
+static bool console_uart(int argc, char* argv[]);
+static void console_uart_test(uint32_t bytes);
+static bool console_print(int argc, char* argv[]);
+static bool console_help(int argc, char* argv[]);
+
+
+/************************************************
+* Local task constant variables
+************************************************/
+const Console_Command CONSOLE_COMMANDS[] = {
+  { "help", "help", console_help },
+  { "format", "format <csv|mathematica|c>", console_format },
+  { "rate", "rate <MPU9150 report rate, Hz>", console_rate },
+  { "stats", "stats", console_stats },
+  { "profiler", "profiler <start|stop> | profiler output <on|off>", console_profiler },
+  { "filter", "filter list | filter set <name> <deadband> <rate> <hysteresis> [<heartbeat ms>] | filter clear <name>", ReportFilter_Command },
+  { "latency", "latency [<histogram>]", console_latency },
+  { "trace", "trace [start|stop|dump|cost|stream on|stream off]", console_trace },
+  { "isr", "isr [cost]", console_isr },
+  { "critical", "critical [reset]", console_critical },
+  { "deadline", "deadline [reset]", console_deadline },
+  { "bench", "bench", console_bench },
+  { "uart", "uart | uart baud <rate> | uart test <bytes>", console_uart },
+  { "metrics", "metrics", console_print },
+  { "sensors", "sensors", console_print },
+  { "startup", "startup", console_print },
+  { "time", "time", console_print }
+};
+#define CONSOLE_COMMANDS_NBR (sizeof(CONSOLE_COMMANDS) / sizeof(CONSOLE_COMMANDS[0]))
+
+
+/************************************************
+* Local task variables
+************************************************/
+Console_LineEditor Console_Editor;
+
+
+/************************************************
+* Local task function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: console_getc
+* Description:   Read one received character without waiting
+* Parameters:    char* pcChar
+* Return:        bool - false if nothing has been received
+*************************************************************************/
+static bool console_getc(char* pcChar) {
+#ifdef UART_BUFFERED
+  if (UARTRxBytesAvail() == 0) {
+    return false;
+  }
+  *pcChar = UARTgetc();
+#else
+  if (!UARTCharsAvail(UART0_BASE)) {
+    return false;
+  }
+  *pcChar = UARTCharGetNonBlocking(UART0_BASE);
+#endif
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: console_format
+* Description:   format <csv|mathematica|c>
+* Parameters:    int argc
+*                char* argv[]
+* Return:        bool - false prints the usage
+*************************************************************************/
+static bool console_format(int argc, char* argv[]) {
+  if (argc != 2) {
+    return false;
+  }
+
+  if (strcmp(argv[1], "csv") == 0) {
+    ReportData_SetOutputFormat(Excel_CSV);
+  }
+  else if (strcmp(argv[1], "mathematica") == 0) {
+    ReportData_SetOutputFormat(Mathematica_List);
+  }
+  else if (strcmp(argv[1], "c") == 0) {
+    ReportData_SetOutputFormat(C_Format);
+  }
+  else {
+    return false;
+  }
+
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: console_rate
+* Description:   rate <hz>
+* Parameters:    int argc
+*                char* argv[]
+* Return:        bool - false prints the usage
+*************************************************************************/
+static bool console_rate(int argc, char* argv[]) {
+  char* end = NULL;
+  uint32_t rateHz = 0;
+
+  if (argc != 2) {
+    return false;
+  }
+
+  rateHz = strtoul(argv[1], &end, 10);
+  if ((*end != '\0') || (rateHz == 0)) {
+    return false;
+  }
+
+  MPU9150_SetReportRate(rateHz);
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: console_stats
+* Description:   stats
+* Parameters:    int argc
+*                char* argv[]
+* Return:        bool - false prints the usage
+*************************************************************************/
+static bool console_stats(int argc, char* argv[]) {
+  uint32_t averageCycles = 0;
+  uint32_t maxCycles = 0;
+
+  ReportStatistics_GetUpdateCost(&averageCycles, &maxCycles);
+  Log_Printf("statistics update cycles avg %u max %u\n", averageCycles, maxCycles);
+
+  if (ReportData_Queue != NULL) {
+    Log_Printf("report queue %u waiting, %u free, %u lost\n", uxQueueMessagesWaiting(ReportData_Queue),
+               uxQueueSpacesAvailable(ReportData_Queue), ReportData_LostCount());
+  }
+
+  Acquisition_PrintSensors();
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: console_profiler
+* Description:   profiler <start|stop|output> [on|off]
+* Parameters:    int argc
+*                char* argv[]
+* Return:        bool - false prints the usage
+*************************************************************************/
+static bool console_profiler(int argc, char* argv[]) {
+  if ((argc == 2) && (strcmp(argv[1], "start") == 0)) {
+    ProgramTrace_Start();
+  }
+  else if ((argc == 2) && (strcmp(argv[1], "stop") == 0)) {
+    ProgramTrace_Stop();
+  }
+  else if ((argc == 3) && (strcmp(argv[1], "output") == 0) && (strcmp(argv[2], "on") == 0)) {
+    ProgramTrace_SetOutput(true);
+  }
+  else if ((argc == 3) && (strcmp(argv[1], "output") == 0) && (strcmp(argv[2], "off") == 0)) {
+    ProgramTrace_SetOutput(false);
+  }
+  else {
+    return false;
+  }
+
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: console_latency
+* Description:   latency [<histogram>]
+* Parameters:    int argc
+*                char* argv[]
+* Return:        bool - false prints the usage
+*************************************************************************/
+static bool console_latency(int argc, char* argv[]) {
+  if (argc == 1) {
+    LatencyHistogram_PrintAll();
+    return true;
+  }
+
+  return (argc == 2) && LatencyHistogram_PrintBuckets(argv[1]);
+}
+
+
+/*************************************************************************
+* Function Name: console_isr
+* Description:   isr [cost]
+* Parameters:    int argc
+*                char* argv[]
+* Return:        bool - false prints the usage
+*************************************************************************/
+static bool console_isr(int argc, char* argv[]) {
+  if (argc == 1) {
+    ISRAccounting_Print();
+  }
+  else if ((argc == 2) && (strcmp(argv[1], "cost") == 0)) {
+    ISRAccounting_PrintCost();
+  }
+  else {
+    return false;
+  }
+
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: console_critical
+* Description:   critical [reset]
+* Parameters:    int argc
+*                char* argv[]
+* Return:        bool - false prints the usage
+*************************************************************************/
+static bool console_critical(int argc, char* argv[]) {
+  if (argc == 1) {
+    CriticalMonitor_Print();
+  }
+  else if ((argc == 2) && (strcmp(argv[1], "reset") == 0)) {
+    CriticalMonitor_Reset();
+  }
+  else {
+    return false;
+  }
+
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: console_deadline
+* Description:   deadline [reset]
+* Parameters:    int argc
+*                char* argv[]
+* Return:        bool - false prints the usage
+*************************************************************************/
+static bool console_deadline(int argc, char* argv[]) {
+  if (argc == 1) {
+    DeadlineMonitor_PrintAll();
+  }
+  else if ((argc == 2) && (strcmp(argv[1], "reset") == 0)) {
+    DeadlineMonitor_ResetAll();
+  }
+  else {
+    return false;
+  }
+
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: console_bench
+* Description:   bench
+* Parameters:    int argc
+*                char* argv[]
+* Return:        bool - false prints the usage
+*************************************************************************/
+static bool console_bench(int argc, char* argv[]) {
+  if (argc != 1) {
+    return false;
+  }
+
+  KernelBenchmark_Request();
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: console_trace
+* Description:   trace [start|stop|dump|cost|stream on|stream off]
+* Parameters:    int argc
+*                char* argv[]
+* Return:        bool - false prints the usage
+*************************************************************************/
+static bool console_trace(int argc, char* argv[]) {
+  if (argc == 1) {
+    TraceRecorder_PrintStatus();
+  }
+  else if ((argc == 2) && (strcmp(argv[1], "start") == 0)) {
+    TraceRecorder_Start();
+  }
+  else if ((argc == 2) && (strcmp(argv[1], "stop") == 0)) {
+    TraceRecorder_Stop();
+  }
+  else if ((argc == 2) && (strcmp(argv[1], "dump") == 0)) {
+    TraceRecorder_PrintChromeTrace();
+  }
+  else if ((argc == 2) && (strcmp(argv[1], "cost") == 0)) {
+    TraceRecorder_PrintCost();
+  }
+  else if ((argc == 3) && (strcmp(argv[1], "stream") == 0) && (strcmp(argv[2], "on") == 0)) {
+    TraceRecorder_StreamStart();
+  }
+  else if ((argc == 3) && (strcmp(argv[1], "stream") == 0) && (strcmp(argv[2], "off") == 0)) {
+    TraceRecorder_StreamStop();
+  }
+  else {
+    return false;
+  }
+
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: console_uart_test
+* Description:   Write bytes to the console as fast as the UART takes them
+*                and print the throughput and, in buffered mode, the
+*                interrupts per byte. Output from other tasks during the
+*                test is counted too.
+* Parameters:    uint32_t bytes
+* Return:        void
+*************************************************************************/
+static void console_uart_test(uint32_t bytes) {
+  uint32_t remaining = bytes;
+  uint32_t dropped = Log_DroppedCount();
+  uint64_t startNs = 0;
+  uint64_t elapsedNs = 0;
+#ifdef UART_BUFFERED
+  uint32_t startInts = 0;
+  uint32_t startTxBytes = 0;
+  uint32_t ints = 0;
+  uint32_t txBytes = 0;
+  uint32_t rxBytes = 0;
+
+  // Start with an empty buffer
+  while (UARTTxBytesFree() < UART_TX_BUFFER_SIZE) {
+    vTaskDelay(1);
+  }
+  UARTStdioGetCounts(&startInts, &startTxBytes, &rxBytes);
+#endif
+
+  startNs = Timestamp_GetNs();
+  while (remaining > 0) {
+    uint32_t chunk = (remaining < CONSOLE_TEST_PATTERN_SIZE) ? remaining : CONSOLE_TEST_PATTERN_SIZE;
+#ifdef UART_BUFFERED
+    // Never overflow the buffer, output that does not fit is dropped.
+    // The ring buffer holds one byte less than its size.
+    if ((uint32_t)UARTTxBytesFree() <= chunk) {
+      vTaskDelay(1);
+      continue;
+    }
+#endif
+    // Through the console lock, so other tasks' lines are not split
+    Log_Printf("%.*s", (int)chunk, CONSOLE_TEST_PATTERN);
+    remaining -= chunk;
+  }
+
+#ifdef UART_BUFFERED
+  while (UARTTxBytesFree() < UART_TX_BUFFER_SIZE) {
+    vTaskDelay(1);
+  }
+#endif
+  elapsedNs = Timestamp_GetNs() - startNs;
+  dropped = Log_DroppedCount() - dropped;
+
+  if (dropped != 0) {
+    Log_Printf("\n%u chunks dropped, the console was busy", dropped);
+  }
+  Log_Printf("\n%u bytes in %u us at %u baud, %u bytes/s\n", bytes, (uint32_t)(elapsedNs / 1000),
+             UARTStdio_GetBaudRate(), (elapsedNs == 0) ? 0 : (uint32_t)(((uint64_t)bytes * 1000000000) / elapsedNs));
+
+#ifdef UART_BUFFERED
+  UARTStdioGetCounts(&ints, &txBytes, &rxBytes);
+  ints -= startInts;
+  txBytes -= startTxBytes;
+  Log_Printf("%u interrupts for %u bytes, %u interrupts per 1000 bytes\n", ints, txBytes,
+             (txBytes == 0) ? 0 : (ints * 1000) / txBytes);
+#endif
+}
+
+
+/*************************************************************************
+* Function Name: console_uart
+* Description:   uart | uart baud <rate> | uart test <bytes>
+* Parameters:    int argc
+*                char* argv[]
+* Return:        bool - false prints the usage
+*************************************************************************/
+static bool console_uart(int argc, char* argv[]) {
+  char* end = NULL;
+  uint32_t value = 0;
+
+  if (argc == 1) {
+#ifdef UART_BUFFERED
+    uint32_t ints = 0;
+    uint32_t txBytes = 0;
+    uint32_t rxBytes = 0;
+
+    UARTStdioGetCounts(&ints, &txBytes, &rxBytes);
+    Log_Printf("baud %u, buffered, %u interrupts, %u bytes sent, %u bytes received\n",
+               UARTStdio_GetBaudRate(), ints, txBytes, rxBytes);
+#else
+    Log_Printf("baud %u, unbuffered\n", UARTStdio_GetBaudRate());
+#endif
+    return true;
+  }
+
+  if (argc != 3) {
+    return false;
+  }
+
+  value = strtoul(argv[2], &end, 10);
+  if ((*end != '\0') || (value == 0)) {
+    return false;
+  }
+
+  if (strcmp(argv[1], "baud") == 0) {
+    Log_Printf("switching to %u baud\n", value);
+    UARTStdio_SetBaudRate(value);
+  }
+  else if (strcmp(argv[1], "test") == 0) {
+    console_uart_test(value);
+  }
+  else {
+    return false;
+  }
+
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: console_print
+* Description:   Commands that only print: metrics, sensors, startup, time
+* Parameters:    int argc
+*                char* argv[]
+* Return:        bool - false prints the usage
+*************************************************************************/
+static bool console_print(int argc, char* argv[]) {
+  if (argc != 1) {
+    return false;
+  }
+
+  if (strcmp(argv[0], "metrics") == 0) {
+    Metrics_Print();
+  }
+  else if (strcmp(argv[0], "sensors") == 0) {
+    Acquisition_PrintSensors();
+  }
+  else if (strcmp(argv[0], "startup") == 0) {
+    Startup_PrintTimes();
+  }
+  else {
+    Timestamp_PrintReadCost();
+  }
+
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: console_help
+* Description:   help
+* Parameters:    int argc
+*                char* argv[]
+* Return:        bool - false prints the usage
+*************************************************************************/
+static bool console_help(int argc, char* argv[]) {
+  uint32_t i = 0;
+
+  for (i = 0; i < CONSOLE_COMMANDS_NBR; ++i) {
+    Log_Printf("%s\n", CONSOLE_COMMANDS[i].usage);
+  }
+
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: Task_Console
+* Description:   Collect characters into a line and run it on CR or LF
+* Parameters:    void* pvParameters;
+* Return:        void
+*************************************************************************/
+extern void Task_Console(void* pvParameters) {
+  UARTStdio_Initialization();
+  ConsoleParser_Reset(&Console_Editor);
+
+  while (1) {
+    char ch;
+
+    while (console_getc(&ch)) {
+      if (ConsoleParser_Putc(&Console_Editor, ch)) {
+        ConsoleParser_Execute(&Console_Editor, CONSOLE_COMMANDS, CONSOLE_COMMANDS_NBR);
+      }
+    }
+
+    vTaskDelay(CONSOLE_POLL_PERIOD);
+  }
+}
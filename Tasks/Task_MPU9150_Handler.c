@@ -7,8 +7,10 @@
 * @Modified: October 18th, 2018 [6:45am]
 * @Version:  1.0.0
 *
-* @Description: Periodically read and report accelerometer and
-*               gyroscope readings
+* @Description: Sample the accelerometer, gyroscope and magnetometer,
+*               fuse them into an orientation and periodically report
+*               the readings and the orientation. Runs as a state
+*               machine under Acquisition_Scheduler.h.
 *
 * Copyright (C) 2018 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
 */
@@ -42,10 +44,20 @@
 #include "driverlib/sysctl.h"
 #include "driverlib/timer.h"
 
+#include "Drivers/CycleCounter.h"
+
+#include "Tasks/Acquisition_Scheduler.h"
+#include "Tasks/Deadline_Monitor.h"
+#include "Tasks/Latency_Histogram.h"
+#include "Tasks/Log.h"
+#include "Tasks/Metrics.h"
+#include "Tasks/Report_Statistics.h"
+#include "Tasks/Sensor_Fusion.h"
+#include "Tasks/Startup_Sync.h"
+#include "Tasks/Task_MPU9150_Handler.h"
 #include "Tasks/Task_ReportData.h"
 
 #include "FreeRTOS.h"
-#include "semphr.h"
 #include "task.h"
 
 
@@ -65,28 +77,75 @@ extern volatile long int xPortSysTickCount;
 // The I2C Address of the MPU9150
 const int MPU9150_ADDRESS = 0x68;
 
+// Ticks between MPU9150 samples (filter updates)
+const uint32_t MPU9150_SAMPLE_PERIOD = SysTickFrequency / SENSOR_FUSION_SAMPLE_RATE_HZ;
+
+// The sample period must be a whole number of ticks, at least one, or the
+// schedule would free-run or drift from SENSOR_FUSION_SAMPLE_RATE_HZ.
+// configTICK_RATE_HZ is usually a cast, which #if cannot evaluate, so an
+// array of negative size fails the build instead.
+typedef char MPU9150_Sample_Period_Check[((SysTickFrequency >= SENSOR_FUSION_SAMPLE_RATE_HZ) &&
+                                          ((SysTickFrequency % SENSOR_FUSION_SAMPLE_RATE_HZ) == 0)) ? 1 : -1];
+
+
+/************************************************
+* Local task constant types
+************************************************/
+typedef enum MPU9150_HANDLER_PHASE_t {
+  MPU9150_HANDLER_INITIALIZE,  // Set-up and start MPU9150Init
+  MPU9150_HANDLER_INITIALIZED, // MPU9150Init completed
+  MPU9150_HANDLER_SAMPLE,      // Request a reading
+  MPU9150_HANDLER_PROCESS      // Fuse and report the reading
+} MPU9150_HANDLER_PHASE_t;
+
 
 /************************************************
 * Local task variables
 ************************************************/
-// The MPU9150 control block
+// The MPU9150 control block and its scheduler entry
 tMPU9150 sMPU9150;
+Acquisition_Sensor MPU9150_Sensor;
+MPU9150_HANDLER_PHASE_t MPU9150_Phase = MPU9150_HANDLER_INITIALIZE;
+
+// Tick the next sample is due
+TickType_t MPU9150_Next_Sample_Time = 0;
+
+// Each sample, from its due tick through the read to the end of its
+// processing, is due before the next one
+DeadlineMonitor MPU9150_Deadline;
+
+// I2C latency of MPU9150Init (several chained transactions) and of each
+// MPU9150DataRead
+LatencyHistogram MPU9150_Init_Latency;
+LatencyHistogram MPU9150_Read_Latency;
+
+// The number of MPU9150 transactions completed.
+Metrics_Metric MPU9150_Callbacks_Nbr = METRICS_COUNTER("MPU9150 callbacks");
+
+// Samples and filter cost since the last report
+uint32_t MPU9150_Sample_Count = 0;
+uint32_t MPU9150_Fusion_Cycles_Total = 0;
+uint32_t MPU9150_Fusion_Cycles_Max = 0;
 
-// A boolean that is set when an I2C transaction is completed.
-volatile bool MPU9150SimpleDone = false;
+// Orientation filter state
+SensorFusion_State sFusion;
 
-// The number of MPU9150 callbacks taken.
-uint32_t MPU9150_Callbacks_Nbr = 0;
+// Windowed statistics of each accelerometer and gyroscope axis
+ReportStatistics_Channel MPU9150_Statistics[6];
 
-// Semaphore to indicate completion of an I/O operation
-xSemaphoreHandle MPU9150_Semaphore;
+// Number of samples between reports, derived from the report rate
+volatile uint32_t MPU9150_Report_Divider = SENSOR_FUSION_SAMPLE_RATE_HZ / SENSOR_FUSION_REPORT_RATE_HZ;
 
 
 /************************************************
 * Local task function declarations
 ************************************************/
-extern void MPU9150SimpleCallback(void* pvData, uint_fast8_t ui8Status);
-extern void Task_MPU9150_Handler(void* pvParameters);
+extern void MPU9150_Handler_Start();
+extern void MPU9150_SetReportRate(uint32_t reportRateHz);
+static uint32_t mpu9150_step(Acquisition_Sensor* sensor);
+static void mpu9150_initialized();
+static void mpu9150_process();
+static void report_float_item(uint32_t reportName, uint32_t typeFlags, float value0, float value1, float value2, float value3);
 
 
 /************************************************
@@ -94,100 +153,242 @@ extern void Task_MPU9150_Handler(void* pvParameters);
 ************************************************/
 
 /*************************************************************************
-* Function Name: MPU9150SimpleCallback
-* Description:   Callback Routine for the MPU9150 for when
-*                transactions have completed
-* Parameters:    void* pvData
-*                uint_fast8_t ui8Status
+* Function Name: MPU9150_SetReportRate
+* Description:   Set how often raw and orientation records are reported.
+*                The MPU9150 is still sampled and fused at
+*                SENSOR_FUSION_SAMPLE_RATE_HZ.
+* Parameters:    uint32_t reportRateHz - 1 .. SENSOR_FUSION_SAMPLE_RATE_HZ
 * Return:        void
 *************************************************************************/
-void MPU9150SimpleCallback(void* pvData, uint_fast8_t ui8Status) {
-  portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
-  MPU9150_Callbacks_Nbr++;
+extern void MPU9150_SetReportRate(uint32_t reportRateHz) {
+  if (reportRateHz == 0) {
+    reportRateHz = 1;
+  }
+  else if (reportRateHz > SENSOR_FUSION_SAMPLE_RATE_HZ) {
+    reportRateHz = SENSOR_FUSION_SAMPLE_RATE_HZ;
+  }
+
+  MPU9150_Report_Divider = SENSOR_FUSION_SAMPLE_RATE_HZ / reportRateHz;
+}
+
+
+/*************************************************************************
+* Function Name: report_float_item
+* Description:   Build a ReportData_Item from four floats and send it to
+*                ReportData_Queue. Values whose bit is set in typeFlags are
+*                sent as float, the others are sent as 0.
+* Parameters:    uint32_t reportName
+*                uint32_t typeFlags
+*                float value0..value3
+* Return:        void
+*************************************************************************/
+static void report_float_item(uint32_t reportName, uint32_t typeFlags, float value0, float value1, float value2, float value3) {
+  ReportData_Item item;
+  ReportData_Stamp(&item);
+  item.ReportName = reportName;
+  item.ReportValueType_Flg = typeFlags;
+  item.ReportValue_0 = (typeFlags & 0b0001) ? *(int32_t*)&value0 : 0;
+  item.ReportValue_1 = (typeFlags & 0b0010) ? *(int32_t*)&value1 : 0;
+  item.ReportValue_2 = (typeFlags & 0b0100) ? *(int32_t*)&value2 : 0;
+  item.ReportValue_3 = (typeFlags & 0b1000) ? *(int32_t*)&value3 : 0;
+
+  ReportData_Send(&item);
+}
+
 
-  if (ui8Status != I2CM_STATUS_SUCCESS) {
-    // An error occurred
-    UARTprintf(">>>>MPU9150 Error: %02X\n", ui8Status);
+/*************************************************************************
+* Function Name: mpu9150_initialized
+* Description:   Set-up once MPU9150Init has completed
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void mpu9150_initialized() {
+  Log_Printf(">>>>MPU9150: Initialized!\n");
+
+  // Initialize the orientation filter and the cycle counter used to
+  // measure its update cost.
+  SensorFusion_Init(&sFusion, SENSOR_FUSION_SAMPLE_RATE_HZ, SENSOR_FUSION_BETA);
+  CycleCounter_Initialization();
+
+  // One statistics channel per axis: acceleration X/Y/Z, gyroscope X/Y/Z
+  uint32_t axis = 0;
+  for (axis = 0; axis < 3; ++axis) {
+    ReportStatistics_Init(&MPU9150_Statistics[axis], ReportName_Statistics(ReportName_Acceleration, axis), REPORT_STATISTICS_WINDOW);
+    ReportStatistics_Init(&MPU9150_Statistics[axis + 3], ReportName_Statistics(ReportName_Gyroscope, axis), REPORT_STATISTICS_WINDOW);
   }
-  // Indicate that the I2C transaction has completed.
-  MPU9150SimpleDone = true;
 
-  // "Give" the MPU9150_Semaphore
-  xSemaphoreGiveFromISR(MPU9150_Semaphore, &xHigherPriorityTaskWoken);
-  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+  MPU9150_Sample_Count = 0;
+  MPU9150_Fusion_Cycles_Total = 0;
+  MPU9150_Fusion_Cycles_Max = 0;
+  MPU9150_Next_Sample_Time = xTaskGetTickCount();
+  if (!DeadlineMonitor_Init(&MPU9150_Deadline, "MPU9150", MPU9150_SAMPLE_PERIOD, MPU9150_SAMPLE_PERIOD)) {
+    Log_Printf(">>>>MPU9150: Deadline monitor list full, not listed\n");
+  }
 }
 
 
 /*************************************************************************
-* Function Name: Task_MPU9150_Handler
-* Description:   Task to report Gyroscope and Accelerometer from
-*                MPU9150 sensor
-* Parameters:    void* pvParameters;
+* Function Name: mpu9150_process
+* Description:   Fuse the completed reading and report every
+*                MPU9150_Report_Divider samples
+* Parameters:    N/A
 * Return:        void
 *************************************************************************/
-extern void Task_MPU9150_Handler(void* pvParameters) {
-  // Initialize UART
-  UARTStdio_Initialization();
-
-  // Initialize I2C7
-  I2C7_Initialization();
-
-  // Initialize MPU9150_Semaphore
-  vSemaphoreCreateBinary(MPU9150_Semaphore);
-
-  // Initialize the MPU9150.
-  MPU9150SimpleDone = false;
-  MPU9150Init(&sMPU9150, I2C7_Instance_Ref, MPU9150_ADDRESS, MPU9150SimpleCallback, 0);
-  xSemaphoreTake(MPU9150_Semaphore, portMAX_DELAY);
-  UARTprintf(">>>>MPU9150: Initialized!\n");
-
-  // Loop forever reading and reporting data from the MPU9150.
-  while (1) {
-    float fAccelX = 0.0;
-    float fAccelY = 0.0;
-    float fAccelZ = 0.0;
-    float fGyroX = 0.0;
-    float fGyroY = 0.0;
-    float fGyroZ = 0.0;
-
-    // Request a reading from the MPU9150.
-    MPU9150DataRead(&sMPU9150, MPU9150SimpleCallback, 0);
-    xSemaphoreTake(MPU9150_Semaphore, portMAX_DELAY);
-
-    // Get the new accelerometer and pressure reading.
-    MPU9150DataAccelGetFloat(&sMPU9150, &fAccelX, &fAccelY, &fAccelZ);
-    MPU9150DataGyroGetFloat(&sMPU9150, &fGyroX, &fGyroY, &fGyroZ);
+static void mpu9150_process() {
+  float fAccelX = 0.0;
+  float fAccelY = 0.0;
+  float fAccelZ = 0.0;
+  float fGyroX = 0.0;
+  float fGyroY = 0.0;
+  float fGyroZ = 0.0;
+  float fMagnetoX = 0.0;
+  float fMagnetoY = 0.0;
+  float fMagnetoZ = 0.0;
+
+  // Get the new accelerometer, gyroscope and magnetometer reading.
+  MPU9150DataAccelGetFloat(&sMPU9150, &fAccelX, &fAccelY, &fAccelZ);
+  MPU9150DataGyroGetFloat(&sMPU9150, &fGyroX, &fGyroY, &fGyroZ);
+  MPU9150DataMagnetoGetFloat(&sMPU9150, &fMagnetoX, &fMagnetoY, &fMagnetoZ);
+
+  // The AK8975 axes are not aligned with the accelerometer and gyroscope,
+  // SensorFusion_UpdateMPU9150 maps them.
+  uint32_t fusionStart = CycleCounter_Get();
+  SensorFusion_UpdateMPU9150(&sFusion,
+                             fGyroX, fGyroY, fGyroZ,
+                             fAccelX, fAccelY, fAccelZ,
+                             fMagnetoX, fMagnetoY, fMagnetoZ);
+  uint32_t fusionCycles = CycleCounter_Get() - fusionStart;
+
+  MPU9150_Fusion_Cycles_Total += fusionCycles;
+  if (fusionCycles > MPU9150_Fusion_Cycles_Max) {
+    MPU9150_Fusion_Cycles_Max = fusionCycles;
+  }
+
+  // Every sample feeds the windowed statistics
+  uint32_t sampleTime = xPortSysTickCount;
+  ReportStatistics_Add(&MPU9150_Statistics[0], fAccelX, sampleTime);
+  ReportStatistics_Add(&MPU9150_Statistics[1], fAccelY, sampleTime);
+  ReportStatistics_Add(&MPU9150_Statistics[2], fAccelZ, sampleTime);
+  ReportStatistics_Add(&MPU9150_Statistics[3], fGyroX, sampleTime);
+  ReportStatistics_Add(&MPU9150_Statistics[4], fGyroY, sampleTime);
+  ReportStatistics_Add(&MPU9150_Statistics[5], fGyroZ, sampleTime);
+
+  if (++MPU9150_Sample_Count >= MPU9150_Report_Divider) {
+    float fRoll = 0.0;
+    float fPitch = 0.0;
+    float fYaw = 0.0;
+    SensorFusion_GetEuler(&sFusion, &fRoll, &fPitch, &fYaw);
 
     // By taking the reference of a float, casting that pointer to an int32_t
     // pointer, then dereferencing that, the float is converted to an int32_t
     // bitwise, without any conversions. This is done instead of using an
     // assembly function such as Float_to_Int32.
+    report_float_item(ReportName_Acceleration, 0b0111, fAccelX, fAccelY, fAccelZ, 0.0);
+    report_float_item(ReportName_Gyroscope, 0b0111, fGyroX, fGyroY, fGyroZ, 0.0);
+    report_float_item(ReportName_Magnetometer, 0b0111, fMagnetoX, fMagnetoY, fMagnetoZ, 0.0);
+    report_float_item(ReportName_Quaternion, 0b1111, sFusion.q0, sFusion.q1, sFusion.q2, sFusion.q3);
+    report_float_item(ReportName_EulerAngles, 0b0111, fRoll, fPitch, fYaw, 0.0);
+
+    // Filter cost: average and maximum cycles per update, sample count
+    ReportData_Item itemCycles;
+    ReportData_Stamp(&itemCycles);
+    itemCycles.ReportName = ReportName_FusionCycles;
+    itemCycles.ReportValueType_Flg = 0b0000;
+    itemCycles.ReportValue_0 = MPU9150_Fusion_Cycles_Total / MPU9150_Sample_Count;
+    itemCycles.ReportValue_1 = MPU9150_Fusion_Cycles_Max;
+    itemCycles.ReportValue_2 = MPU9150_Sample_Count;
+    itemCycles.ReportValue_3 = 0;
+    ReportData_Send(&itemCycles);
+
+    MPU9150_Sample_Count = 0;
+    MPU9150_Fusion_Cycles_Total = 0;
+    MPU9150_Fusion_Cycles_Max = 0;
+  }
+}
+
+
+/*************************************************************************
+* Function Name: mpu9150_step
+* Description:   MPU9150 state machine. Samples at
+*                SENSOR_FUSION_SAMPLE_RATE_HZ on a fixed schedule.
+* Parameters:    Acquisition_Sensor* sensor
+* Return:        uint32_t - ticks until the next step, or
+*                           ACQUISITION_WAIT_IO
+*************************************************************************/
+static uint32_t mpu9150_step(Acquisition_Sensor* sensor) {
+  switch (MPU9150_Phase) {
+    case MPU9150_HANDLER_INITIALIZE:
+      // Start initializing I2C7, or finish it once its first transaction
+      // is done. Samples are reported, so wait for ReportData too.
+      I2C7_Initialization();
+      if (!Startup_IsReady(STARTUP_REPORTDATA | STARTUP_I2C7)) {
+        return 1;
+      }
+
+      // Initialize UART
+      UARTStdio_Initialization();
+
+      LatencyHistogram_Init(&MPU9150_Init_Latency, "MPU9150.init");
+      LatencyHistogram_Init(&MPU9150_Read_Latency, "MPU9150.read");
+
+      // Initialize the MPU9150.
+      Acquisition_BeginIO(sensor, &MPU9150_Init_Latency);
+      MPU9150Init(&sMPU9150, I2C7_Instance_Ref, MPU9150_ADDRESS, Acquisition_I2CCallback, sensor);
+      MPU9150_Phase = MPU9150_HANDLER_INITIALIZED;
+      return ACQUISITION_WAIT_IO;
+
+    case MPU9150_HANDLER_INITIALIZED:
+      mpu9150_initialized();
+      MPU9150_Phase = MPU9150_HANDLER_SAMPLE;
+      return 0;
+
+    case MPU9150_HANDLER_SAMPLE:
+      // Request a reading from the MPU9150.
+      DeadlineMonitor_Start(&MPU9150_Deadline, MPU9150_Next_Sample_Time);
+      Acquisition_BeginIO(sensor, &MPU9150_Read_Latency);
+      MPU9150DataRead(&sMPU9150, Acquisition_I2CCallback, sensor);
+      MPU9150_Phase = MPU9150_HANDLER_PROCESS;
+      return ACQUISITION_WAIT_IO;
+
+    case MPU9150_HANDLER_PROCESS:
+    default: {
+      Metrics_Increment(&MPU9150_Callbacks_Nbr);
+      if (sensor->status != I2CM_STATUS_SUCCESS) {
+        // An error occurred
+        Log_Printf(">>>>MPU9150 Error: %02X\n", sensor->status);
+      }
+      else {
+        mpu9150_process();
+        Startup_Signal(STARTUP_MPU9150);
+      }
+      DeadlineMonitor_Finish(&MPU9150_Deadline);
+
+      // Wait until the next sample period. Like vTaskDelayUntil, a late
+      // sample is taken immediately so the schedule does not drift.
+      MPU9150_Phase = MPU9150_HANDLER_SAMPLE;
+      MPU9150_Next_Sample_Time += MPU9150_SAMPLE_PERIOD;
+      int32_t ticks = (int32_t)(MPU9150_Next_Sample_Time - xTaskGetTickCount());
+      return (ticks > 0) ? (uint32_t)ticks : 0;
+    }
+  }
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: MPU9150_Handler_Start
+* Description:   Schedule the MPU9150 state machine. Replaces the
+*                Task_MPU9150_Handler task.
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void MPU9150_Handler_Start() {
+  Metrics_Register(&MPU9150_Callbacks_Nbr);
 
-    // Create ReportData_Item for Acceleration
-    ReportData_Item itemAccel;
-    itemAccel.TimeStamp = xPortSysTickCount;
-    itemAccel.ReportName = 0004;
-    itemAccel.ReportValueType_Flg = 0b0111;
-    itemAccel.ReportValue_0 = *(int32_t*)&fAccelX;
-    itemAccel.ReportValue_1 = *(int32_t*)&fAccelY;
-    itemAccel.ReportValue_2 = *(int32_t*)&fAccelZ;
-    itemAccel.ReportValue_3 = 0;
-
-    // Create ReportData_Item for Gyroscope
-    ReportData_Item itemGyro;
-    itemGyro.TimeStamp = xPortSysTickCount;
-    itemGyro.ReportName = 0005;
-    itemGyro.ReportValueType_Flg = 0b0111;
-    itemGyro.ReportValue_0 = *(int32_t*)&fGyroX;
-    itemGyro.ReportValue_1 = *(int32_t*)&fGyroY;
-    itemGyro.ReportValue_2 = *(int32_t*)&fGyroZ;
-    itemGyro.ReportValue_3 = 0;
-
-    // Send ReportData_Items to queue to print
-    xQueueSend(ReportData_Queue, &itemAccel, 0);
-    xQueueSend(ReportData_Queue, &itemGyro, 0);
-
-    // Delay
-    vTaskDelay((SysTickFrequency * 1000) / 1000);
+  if (!Acquisition_Start(&MPU9150_Sensor, "MPU9150", mpu9150_step, NULL)) {
+    Log_Printf(">>>>MPU9150: Could not be scheduled\n");
   }
 }
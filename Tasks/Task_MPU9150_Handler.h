@@ -0,0 +1,27 @@
+/**
+* @Filename: Task_MPU9150_Handler.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [10:05am]
+* @Version:  1.0.0
+*
+* @Description: API for the MPU9150 handler
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TASKS_TASK_MPU9150_HANDLER_H_
+#define TASKS_TASK_MPU9150_HANDLER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/************************************************
+* Function declarations
+************************************************/
+extern void MPU9150_Handler_Start();
+extern void MPU9150_SetReportRate(uint32_t reportRateHz);
+
+#endif /* TASKS_TASK_MPU9150_HANDLER_H_ */
@@ -0,0 +1,111 @@
+/**
+* @Filename: Task_Metrics.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [8:40pm]
+* @Version:  1.0.0
+*
+* @Description: Periodically snapshots the metrics registry and sends each
+*               metric as ReportData records
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Tasks/Metrics.h"
+#include "Tasks/Startup_Sync.h"
+#include "Tasks/Task_ReportData.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+// Ticks between snapshots
+const uint32_t METRICS_REPORT_PERIOD = configTICK_RATE_HZ;
+
+
+/************************************************
+* Local task function declarations
+************************************************/
+extern void Task_Metrics(void* pvParameters);
+static void metrics_report(uint32_t index, Metrics_Metric* metric, TickType_t timeStamp);
+
+
+/************************************************
+* Local task function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: metrics_report
+* Description:   Send one metric and remember what was sent
+* Parameters:    uint32_t index
+*                Metrics_Metric* metric
+*                TickType_t timeStamp
+* Return:        void
+*************************************************************************/
+static void metrics_report(uint32_t index, Metrics_Metric* metric, TickType_t timeStamp) {
+  ReportData_Item theReport;
+  uint32_t value = metric->value;
+  uint32_t j = 0;
+
+  theReport.TimeStamp = timeStamp;
+  theReport.TimeStamp_SubTick_ns = 0;
+  theReport.ReportName = ReportName_Metric;
+  theReport.ReportValueType_Flg = 0x0;
+  theReport.ReportValue_0 = index;
+  theReport.ReportValue_1 = value;
+  theReport.ReportValue_2 = value - metric->snapshot;
+  theReport.ReportValue_3 = (METRICS_REPORT_PERIOD * 1000) / configTICK_RATE_HZ;
+  ReportData_Send(&theReport);
+  metric->snapshot = value;
+
+  if (metric->type != METRICS_TYPE_HISTOGRAM) {
+    return;
+  }
+
+  theReport.ReportName = ReportName_MetricBucket;
+  for (j = 0; j < metric->bucketsNbr; ++j) {
+    uint32_t count = metric->buckets[j];
+
+    if (count != metric->bucketSnapshots[j]) {
+      theReport.ReportValue_1 = j;
+      theReport.ReportValue_2 = count;
+      theReport.ReportValue_3 = count - metric->bucketSnapshots[j];
+      ReportData_Send(&theReport);
+      metric->bucketSnapshots[j] = count;
+    }
+  }
+}
+
+
+/*************************************************************************
+* Function Name: Task_Metrics
+* Description:   Report every registered metric once a period
+* Parameters:    void* pvParameters;
+* Return:        void
+*************************************************************************/
+extern void Task_Metrics(void* pvParameters) {
+  TickType_t lastWakeTime;
+
+  Startup_Wait(STARTUP_REPORTDATA, portMAX_DELAY);
+
+  lastWakeTime = xTaskGetTickCount();
+  while (1) {
+    uint32_t count = 0;
+    uint32_t i = 0;
+
+    vTaskDelayUntil(&lastWakeTime, METRICS_REPORT_PERIOD);
+
+    count = Metrics_Count();
+    for (i = 0; i < count; ++i) {
+      metrics_report(i, Metrics_Get(i), lastWakeTime);
+    }
+  }
+}
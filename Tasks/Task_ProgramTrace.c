@@ -25,6 +25,8 @@
 #include <stdlib.h>
 #include <math.h>
 
+#include "Drivers/ISR_Accounting.h"
+#include "Drivers/Interrupt_Priorities.h"
 #include "Drivers/UARTStdio_Initialization.h"
 #include "Drivers/uartstdio.h"
 
@@ -34,6 +36,9 @@
 #include "driverlib/sysctl.h"
 #include "driverlib/timer.h"
 
+#include "Tasks/Log.h"
+#include "Tasks/Startup_Sync.h"
+#include "Tasks/Task_ProgramTrace.h"
 #include "Tasks/Task_ReportData.h"
 
 #include "FreeRTOS.h"
@@ -41,7 +46,7 @@
 #include "task.h"
 
 #define DEBUG
-#define ENABLE_OUTPUT FALSE
+#define ENABLE_OUTPUT false
 
 /************************************************
 * External variables
@@ -51,13 +56,6 @@
 extern volatile long int xPortSysTickCount;
 
 
-/************************************************
-* External functions declarations
-************************************************/
-
-// Assembly function to get PC from the stack
-extern uint32_t Get_Value_From_Stack(uint32_t);
-
 /************************************************
 * Local task constant types
 ************************************************/
@@ -78,13 +76,21 @@ typedef enum ISR_STATUS_t {
 // The PRE_SCALE_VALUE (K) must be < 256. Solving, K = 24
 // Since K is zero indexed, K = 23
 // We are only interested in memory <= 32KiB which is 2^15
-const uint32_t PC_OFFSET = 32;
 const uint32_t LOAD_VALUE = 50000;
 const uint32_t PRE_SCALE_VALUE = 23;
 const uint32_t SIZE_OF_HISTOGRAM_ARRAY = 512;  // (512 << 6) == 32KiB
 const uint32_t ONE_SECOND_DELTA_SYS_TICK = 10000;
 const uint32_t REPORT_FREQUENCY_IN_SECONDS = 60;
 
+// Timer_0_A_ISR runs above configMAX_SYSCALL_INTERRUPT_PRIORITY and may
+// not call FreeRTOS. It triggers this unused vector, at a kernel aware
+// priority, to give Timer_0_A_Semaphore when a collection period ends.
+#define PROGRAM_TRACE_HANDOFF_INTERRUPT INT_TIMER0B
+
+// Histogram entries per ReportData_SendMultiple, a divisor of 512. Sized
+// for a short critical section and a small stack buffer.
+#define PROGRAM_TRACE_REPORT_BATCH 16
+
 
 /************************************************
 * Local task variables
@@ -109,12 +115,28 @@ uint32_t stop_Sys_Tick = 0;   // Sys_Tick when ISR needs to stop collecting
 
 uint32_t current_Histogram_Report = 0; // How many reports have been output
 
+// Duration of Timer_0_A_ISR and of its hand-off
+ISRAccounting_Vector Timer0A_ISR_Accounting = ISR_ACCOUNTING_VECTOR("Timer0A");
+ISRAccounting_Vector Timer0A_Handoff_ISR_Accounting = ISR_ACCOUNTING_VECTOR("Timer0A hand-off");
+
+// Samples outside the histogram since the last report
+uint32_t program_Trace_Out_Of_Range = 0;
+
+// Whether Timer_0_A is sampling, and whether histograms are sent to
+// ReportData. Both can be changed from the console.
+bool program_Trace_Running = false;
+bool program_Trace_Output = ENABLE_OUTPUT;
+
 
 /************************************************
 * Local task function declarations
 ************************************************/
 extern void Timer_0_A_ISR();
+static void Timer_0_A_Handoff_ISR();
 extern void Task_ProgramTrace(void* pvParameters);
+extern void ProgramTrace_Start();
+extern void ProgramTrace_Stop();
+extern void ProgramTrace_SetOutput(bool enabled);
 extern void report_histogram_data();
 extern void zero_histogram_array();
 
@@ -124,7 +146,8 @@ extern void zero_histogram_array();
 
 /*************************************************************************
 * Function Name: Timer_0_A_ISR
-* Description:   Interrupt Service Routine used to profile tasks
+* Description:   Interrupt Service Routine used to profile tasks. Runs at
+*                INTERRUPT_PRIORITY_PROFILER, so it must not call FreeRTOS.
 * Parameters:    N/A
 * Return:        void
 *************************************************************************/
@@ -132,8 +155,8 @@ extern void Timer_0_A_ISR() {
   TimerIntClear(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
 
   if (current_ISR_Status == COLLECTING) {
-    // Get the value from the PC
-    current_PC = Get_Value_From_Stack(PC_OFFSET);
+    // Get the PC at which the timer interrupted, from the exception frame
+    current_PC = ISRAccounting_InterruptedPC();
     current_PC = floor( current_PC / 64.0 );
 
     // Validate Current_PC value is within size of array and store
@@ -142,30 +165,34 @@ extern void Timer_0_A_ISR() {
       histogram_array[current_PC]++;
     }
     else {
-      #if ENABLE_OUTPUT
-          // Current_PC is out of range. In theory should never enter this else statement
-            UARTprintf("ERROR: ( Current_PC / 64 ) >= %i", SIZE_OF_HISTOGRAM_ARRAY);
-          }
-          else {
-            UARTprintf("ERROR: ( Current_PC / 64 ) < 0");
-          }
-          UARTprintf(" (Current_PC = %u\n");
-      #endif
+      // Current_PC is out of range. In theory should never enter this else
+      // statement. Counted, since Log_PrintfFromISR calls FreeRTOS.
+      program_Trace_Out_Of_Range++;
     }
 
     if (xPortSysTickCount > stop_Sys_Tick) {
       current_ISR_Status = DONE_COLLECTING;
+
+      // Task_ProgramTrace is woken by Timer_0_A_Handoff_ISR
+      IntTrigger(PROGRAM_TRACE_HANDOFF_INTERRUPT);
     }
   }
+}
+
+
+/*************************************************************************
+* Function Name: Timer_0_A_Handoff_ISR
+* Description:   Give Timer_0_A_Semaphore for Timer_0_A_ISR, from a kernel
+*                aware priority
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void Timer_0_A_Handoff_ISR() {
+  xHigherPriorityTaskWoken = pdFALSE;
 
   // "Give" the Timer_0_A_Semaphore
   xSemaphoreGiveFromISR(Timer_0_A_Semaphore, &xHigherPriorityTaskWoken);
-
-  // If xHigherPriorityTaskWoken was set to true, we should yield.
-  // The actual macro used here is port specific.
-  // if (xHigherPriorityTaskWoken) {
-  //   portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-  // }
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
 
@@ -181,7 +208,11 @@ extern void Task_ProgramTrace(void* pvParameters) {
 
   SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER0);
 
-  IntRegister(INT_TIMER0A, Timer_0_A_ISR);
+  ISRAccounting_Register(&Timer0A_ISR_Accounting, INT_TIMER0A, Timer_0_A_ISR);
+  ISRAccounting_Register(&Timer0A_Handoff_ISR_Accounting, PROGRAM_TRACE_HANDOFF_INTERRUPT, Timer_0_A_Handoff_ISR);
+  IntPrioritySet(INT_TIMER0A, INTERRUPT_PRIORITY_PROFILER);
+  IntPrioritySet(PROGRAM_TRACE_HANDOFF_INTERRUPT, INTERRUPT_PRIORITY_SOFTWARE);
+  IntEnable(PROGRAM_TRACE_HANDOFF_INTERRUPT);
 
   TimerConfigure(TIMER0_BASE, TIMER_CFG_SPLIT_PAIR | TIMER_CFG_A_PERIODIC);
 
@@ -194,18 +225,14 @@ extern void Task_ProgramTrace(void* pvParameters) {
   //Enable Timer_0_A interrupt in NVIC
   IntEnable(INT_TIMER0A);
 
-  // Enable (Start) Timer
-  TimerEnable(TIMER0_BASE, TIMER_A);
+  // Histograms are reported, so wait for ReportData before collecting
+  Startup_Wait(STARTUP_REPORTDATA, portMAX_DELAY);
 
   // Set data report to Excel format
   ReportData_SetOutputFormat(Excel_CSV);
 
-  // Init the data array
-  zero_histogram_array();
-
-  // Set start time based on current systick, stop time = 1 minute later.
-  start_Sys_Tick = xPortSysTickCount;
-  stop_Sys_Tick = start_Sys_Tick + (REPORT_FREQUENCY_IN_SECONDS * ONE_SECOND_DELTA_SYS_TICK);
+  // Zero the histogram and enable (start) the timer
+  ProgramTrace_Start();
 
   // Add values to the histogram when appropriate
   while (1) {
@@ -213,9 +240,13 @@ extern void Task_ProgramTrace(void* pvParameters) {
     if (current_ISR_Status == DONE_COLLECTING) {
       current_Histogram_Report++;
 
-      #if ENABLE_OUTPUT
-        UARTprintf("DONE COLLECTING (%u)- BEGIN OUTPUT\n", current_Histogram_Report);
-      #endif
+      if (program_Trace_Output) {
+        Log_Printf("DONE COLLECTING (%u)- BEGIN OUTPUT\n", current_Histogram_Report);
+      }
+      if (program_Trace_Out_Of_Range != 0) {
+        Log_Printf("ERROR: %u samples ( Current_PC / 64 ) >= %u\n", program_Trace_Out_Of_Range, SIZE_OF_HISTOGRAM_ARRAY);
+        program_Trace_Out_Of_Range = 0;
+      }
       report_histogram_data();
 
       // Zero array to make sure overflow doesnt happen
@@ -232,22 +263,78 @@ extern void Task_ProgramTrace(void* pvParameters) {
 }
 
 
+/*************************************************************************
+* Function Name: ProgramTrace_Start
+* Description:   Start a fresh collection period. Does nothing if the
+*                timer is already running.
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void ProgramTrace_Start() {
+  if (program_Trace_Running) {
+    return;
+  }
+
+  // The timer is stopped, so the ISR cannot touch the histogram
+  zero_histogram_array();
+  start_Sys_Tick = xPortSysTickCount;
+  stop_Sys_Tick = start_Sys_Tick + (REPORT_FREQUENCY_IN_SECONDS * ONE_SECOND_DELTA_SYS_TICK);
+  current_ISR_Status = COLLECTING;
+
+  program_Trace_Running = true;
+  TimerEnable(TIMER0_BASE, TIMER_A);
+}
+
+
+/*************************************************************************
+* Function Name: ProgramTrace_Stop
+* Description:   Stop the sampling timer. Samples collected so far are
+*                discarded by the next ProgramTrace_Start.
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+extern void ProgramTrace_Stop() {
+  TimerDisable(TIMER0_BASE, TIMER_A);
+  program_Trace_Running = false;
+}
+
+
+/*************************************************************************
+* Function Name: ProgramTrace_SetOutput
+* Description:   Enable or disable sending histograms to ReportData
+* Parameters:    bool enabled
+* Return:        void
+*************************************************************************/
+extern void ProgramTrace_SetOutput(bool enabled) {
+  program_Trace_Output = enabled;
+}
+
+
 extern void report_histogram_data() {
+  ReportData_Item items[PROGRAM_TRACE_REPORT_BATCH];
   uint32_t i = 0;
-  for (i = 0; i < 512; ++i) {
-    ReportData_Item item;
-    item.TimeStamp = xPortSysTickCount;
-    item.ReportName = 42;
-    item.ReportValueType_Flg = 0x0;
-    item.ReportValue_0 = i;
-    item.ReportValue_1 = histogram_array[i];
-    item.ReportValue_2 = 0;
-    item.ReportValue_3 = 0;
-
-    // This sends copy of data
-    #if ENABLE_OUTPUT
-      xQueueSend(ReportData_Queue, &item, 0);
-    #endif
+  uint32_t n = 0;
+
+  if (!program_Trace_Output) {
+    return;
+  }
+
+  // Send the histogram a batch at a time, one critical section and at most
+  // one wakeup of ReportData per batch
+  for (i = 0; i < 512; i += PROGRAM_TRACE_REPORT_BATCH) {
+    for (n = 0; n < PROGRAM_TRACE_REPORT_BATCH; ++n) {
+      ReportData_Item* item = &items[n];
+      ReportData_Stamp(item);
+      item->ReportName = ReportName_ProgramTrace;
+      item->ReportValueType_Flg = 0x0;
+      item->ReportValue_0 = i + n;
+      item->ReportValue_1 = histogram_array[i + n];
+      item->ReportValue_2 = 0;
+      item->ReportValue_3 = 0;
+    }
+
+    // This sends copies of the data
+    ReportData_SendMultiple(items, PROGRAM_TRACE_REPORT_BATCH);
   }
 }
 
@@ -0,0 +1,33 @@
+/**
+* @Filename: Task_ProgramTrace.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 19th, 2026 [10:40pm]
+* @Version:  1.0.0
+*
+* @Description: API for the program counter profiler
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TASKS_TASK_PROGRAMTRACE_H_
+#define TASKS_TASK_PROGRAMTRACE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/************************************************
+* Function declarations
+************************************************/
+extern void Task_ProgramTrace(void* pvParameters);
+
+// Start sampling with a fresh histogram, or stop the sampling timer
+extern void ProgramTrace_Start();
+extern void ProgramTrace_Stop();
+
+// Send each histogram to ReportData when a collection period ends
+extern void ProgramTrace_SetOutput(bool enabled);
+
+#endif /* TASKS_TASK_PROGRAMTRACE_H_ */
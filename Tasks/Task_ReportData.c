@@ -26,6 +26,45 @@
  *  				(3) Added a global subroutine to
  *  					set the output format
  *
+ *  Modification:	2026-10-19
+ *  				Added ReportData_Send, which applies the
+ *  				report filter before queueing a record.
+ *
+ *  Modification:	2026-10-19
+ *  				Signal STARTUP_REPORTDATA once ReportData_Queue
+ *  				exists; ReportData_Send drops records until then.
+ *
+ *  Modification:	2026-10-19
+ *  				Added ReportData_Stamp. The nanoseconds since the
+ *  				tick began follow the time stamp in every output
+ *  				format.
+ *
+ *  Modification:	2026-10-19
+ *  				Records are written with Log_Printf, one line per
+ *  				write, so they no longer interleave with other
+ *  				console output.
+ *
+ *  Modification:	2026-10-20
+ *  				Added ReportData_SendMultiple. Task_ReportData
+ *  				receives up to ReportBatchSize records per
+ *  				xQueueReceiveMultiple; the output rate is unchanged.
+ *
+ *  Modification:	2026-10-20
+ *  				Task_ReportData delays once per batch instead of
+ *  				once per record, so it prints up to ReportBatchSize
+ *  				records per wake-up.
+ *
+ *  Modification:	2026-10-20
+ *  				Task_ReportData prints a ReportName_Time record
+ *  				every ReportTimePeriod ticks with the high word of
+ *  				the tick count. TimeStamp is printed unsigned.
+ *
+ *  Modification:	2026-10-20
+ *  				Records are written with Log_PrintfWait, which
+ *  				waits for the console rather than dropping a line.
+ *  				Records ReportData_Send and ReportData_SendMultiple
+ *  				cannot queue are counted by ReportData_LostCount.
+ *
  */
 
 #include	<stddef.h>
@@ -33,9 +72,13 @@
 #include	<stdint.h>
 #include	<stdarg.h>
 
+#include	"Drivers/Timestamp.h"
 #include	"Drivers/UARTStdio_Initialization.h"
 #include	"Drivers/uartstdio.h"
+#include	"Tasks/Log.h"
 #include	"Tasks/Task_ReportData.h"
+#include	"Tasks/Report_Filter.h"
+#include	"Tasks/Startup_Sync.h"
 
 #include	<stdio.h>
 
@@ -48,6 +91,11 @@
 //
 extern QueueHandle_t ReportData_Queue = NULL;
 
+//
+//	Records the filter accepted but the queue did not
+//
+static volatile uint32_t ReportData_Lost_Nbr = 0;
+
 //
 //	Define output format and subroutine to set output format.
 //
@@ -58,16 +106,119 @@ extern void ReportData_SetOutputFormat( ReportData_OutputFormat newFormat ) {
 	ReportData_CurrentFormat = newFormat;
 }
 
+//
+//	Time stamp a record from one consistent reading of the tick
+//	count and SysTick.
+//
+extern void ReportData_Stamp( ReportData_Item *theReport ) {
+
+	Timestamp		Now;
+
+	Timestamp_Read( &Now );
+	theReport->TimeStamp = Now.ticks;
+	theReport->TimeStamp_SubTick_ns = Now.subTickNs;
+}
+
+//
+//	Count records lost on the way to ReportData_Queue
+//
+static void ReportData_Lose( uint32_t Count ) {
+
+	taskENTER_CRITICAL();
+	ReportData_Lost_Nbr += Count;
+	taskEXIT_CRITICAL();
+}
+
+//
+//	Send a ReportData_Item to ReportData_Queue, unless the report
+//	filter decides it has not changed enough to be worth sending.
+//	Does not block if the queue is full. Records sent before
+//	Task_ReportData has created the queue are dropped; producers
+//	that must not lose records wait for STARTUP_REPORTDATA.
+//	Dropped records are counted; filtered ones are not.
+//
+extern BaseType_t ReportData_Send( const ReportData_Item *theReport ) {
+
+	if ( ReportData_Queue == NULL ) {
+		ReportData_Lose( 1 );
+		return( pdFALSE );
+	}
+
+	if ( !ReportFilter_Accept( theReport ) ) {
+		return( pdFALSE );
+	}
+
+	if ( xQueueSend( ReportData_Queue, theReport, 0 ) != pdPASS ) {
+		ReportData_Lose( 1 );
+		return( pdFALSE );
+	}
+
+	return( pdTRUE );
+}
+
+//
+//	Send Count records to ReportData_Queue in one critical section,
+//	after compacting away those the report filter drops. Does not
+//	block; returns the number of records queued.
+//
+extern uint32_t ReportData_SendMultiple( ReportData_Item *theReports, uint32_t Count ) {
+
+	uint32_t		Report_Idx;
+	uint32_t		Accepted = 0;
+	uint32_t		Queued;
+
+	if ( ReportData_Queue == NULL ) {
+		ReportData_Lose( Count );
+		return( 0 );
+	}
+
+	for ( Report_Idx = 0; Report_Idx < Count; Report_Idx++ ) {
+		if ( ReportFilter_Accept( &theReports[Report_Idx] ) ) {
+			if ( Accepted != Report_Idx ) {
+				theReports[Accepted] = theReports[Report_Idx];
+			}
+			Accepted++;
+		}
+	}
+
+	Queued = (uint32_t) xQueueSendMultiple( ReportData_Queue, theReports, Accepted, 0 );
+	if ( Queued < Accepted ) {
+		ReportData_Lose( Accepted - Queued );
+	}
+
+	return( Queued );
+}
+
+//
+//	Records accepted by the filter that did not reach ReportData_Queue
+//
+extern uint32_t ReportData_LostCount( void ) {
+
+	return( ReportData_Lost_Nbr );
+}
+
 //
 //	Define the ReportData Task
 //
 #define		NbrValues			4
 #define		FormattedStringSize	32
+#define		ReportBatchSize		8
 
-extern void Task_ReportData( void *pvParameters ) {
+//
+//	A ReportName_Time record is printed every ReportTimePeriod ticks.
+//	Its TimeStamp is the low 32 bits of the tick count, as in every
+//	record; ReportValue_0 is the high 32 bits and ReportValue_1 is
+//	configTICK_RATE_HZ. A reader extends the TimeStamp of the records
+//	printed near it to 64 bits from these, even across a wrap (every
+//	4.97 days at 10 kHz). It bypasses the queue and the report filter.
+//
+#define		ReportTimePeriod	( 2 * configTICK_RATE_HZ )
 
-	ReportData_Item			theReport;
-	BaseType_t				ReportQueue_Status;
+//
+//	Print one record in the current output format. Log_PrintfWait
+//	waits for the console, so no record is dropped once dequeued.
+//
+static void ReportData_Print( const ReportData_Item *theReport ) {
 
 	typedef			 	char	FormattedString_t[FormattedStringSize];
 	FormattedString_t	FormattedStrings[NbrValues];
@@ -76,104 +227,154 @@ extern void Task_ReportData( void *pvParameters ) {
 	typedef			union ValueType { int32_t Integer; float Float; } ValueType_t;
 	ValueType_t		Values[NbrValues];
 
-
 	//
-	//	Ensure UARTStdio is initialized
+	//	First, copy the values to the ValueType_t
+	//	union. This is necessary to handle both
+	//	int32_t and float values.
+	//	Convert the values to strings.
 	//
-	UARTStdio_Initialization();
+	Values[0].Integer = theReport->ReportValue_0;
+	Values[1].Integer = theReport->ReportValue_1;
+	Values[2].Integer = theReport->ReportValue_2;
+	Values[3].Integer = theReport->ReportValue_3;
 
-	UARTprintf( ">>>>ReportData: Initializing.\n" );
+	for ( Value_Idx = 0; Value_Idx < NbrValues; Value_Idx++ ) {
+		if ( theReport->ReportValueType_Flg & (1 << Value_Idx) ) {
 
-	//
-	//	Define ReportData_Queue
-	//
-	ReportData_Queue = xQueueCreate( 1024, sizeof( ReportData_Item ) );
+			//
+			//	Value type is float
+			//
+			sprintf( FormattedStrings[Value_Idx], "%+#8.3F", Values[Value_Idx].Float );
+			} else {
 
-	UARTprintf( ">>>>ReportData: Queue Handle: %p\n", ReportData_Queue );
+			//
+			//	Value type is int32_t
+			//
+			sprintf( FormattedStrings[Value_Idx], "%+#08d", Values[Value_Idx].Integer );
+			}
 
-	while ( 1 )	{
+	}
 
+	switch ( ReportData_CurrentFormat ) {
 
 		//
-		//	Try to read ReportItem from ReportData_Queue.
-		//	If a ReportData_Item is returned, print the contents
-		//		to the UART via UARTStdioPrintf
+		//	Output in Excel Comma Separated format
 		//
-		ReportQueue_Status = xQueueReceive( ReportData_Queue,
-											&theReport,
-											1 * portTICK_PERIOD_MS );
+		case Excel_CSV:
+			Log_PrintfWait( "%08u,%06u,%04u,%s,%s,%s,%s\n",
+						theReport->TimeStamp, theReport->TimeStamp_SubTick_ns,
+						theReport->ReportName,
+						FormattedStrings[0], FormattedStrings[1],
+						FormattedStrings[2], FormattedStrings[3] );
+			break;
 
-//		UARTprintf( ">>>>ReportData: Queue Receive: %d\n", ReportQueue_Status );
+		//
+		//	Output in Mathematica List format
+		//
+		case Mathematica_List:
+			Log_PrintfWait( "{ %08u, %06u, %04u, %s, %s, %s, %s },\n",
+						theReport->TimeStamp, theReport->TimeStamp_SubTick_ns,
+						theReport->ReportName,
+						FormattedStrings[0], FormattedStrings[1],
+						FormattedStrings[2], FormattedStrings[3] );
 
+			break;
 
-		if ( ReportQueue_Status == pdTRUE ) {
+		//
+		//	Output in C white space format
+		//
+		case C_Format:
+			Log_PrintfWait( "%08u %06u %04u %s %s %s %s\n",
+						theReport->TimeStamp, theReport->TimeStamp_SubTick_ns,
+						theReport->ReportName,
+						FormattedStrings[0], FormattedStrings[1],
+						FormattedStrings[2], FormattedStrings[3] );
+			break;
 
-			//
-			//	First, copy the values to the ValueType_t
-			//	union. This is necessary to handle both
-			//	int32_t and float values.
-			//	Convert the values to strings.
-			//
-			Values[0].Integer = theReport.ReportValue_0;
-			Values[1].Integer = theReport.ReportValue_1;
-			Values[2].Integer = theReport.ReportValue_2;
-			Values[3].Integer = theReport.ReportValue_3;
-
-			for ( Value_Idx = 0; Value_Idx < NbrValues; Value_Idx++ ) {
-				if ( theReport.ReportValueType_Flg & (1 << Value_Idx) ) {
-
-					//
-					//	Value type is float
-					//
-					sprintf( FormattedStrings[Value_Idx], "%+#8.3F", Values[Value_Idx].Float );
-					} else {
-
-					//
-					//	Value type is int32_t
-					//
-					sprintf( FormattedStrings[Value_Idx], "%+#08d", Values[Value_Idx].Integer );
-					}
+	}
+}
 
-			}
+//
+//	Print the ReportName_Time record
+//
+static void ReportData_PrintTime( void ) {
+
+	ReportData_Item		theTimeReport;
+	Timestamp			Now;
+
+	Timestamp_Read( &Now );
+	theTimeReport.TimeStamp = Now.ticks;
+	theTimeReport.TimeStamp_SubTick_ns = Now.subTickNs;
+	theTimeReport.ReportName = ReportName_Time;
+	theTimeReport.ReportValueType_Flg = 0x00;
+	theTimeReport.ReportValue_0 = (int32_t) Now.ticksHigh;
+	theTimeReport.ReportValue_1 = configTICK_RATE_HZ;
+	theTimeReport.ReportValue_2 = 0;
+	theTimeReport.ReportValue_3 = 0;
+
+	ReportData_Print( &theTimeReport );
+}
 
+extern void Task_ReportData( void *pvParameters ) {
 
-					switch ( ReportData_CurrentFormat ) {
+	ReportData_Item			theReports[ReportBatchSize];
+	uint32_t				ReportQueue_Count;
+	uint32_t				Report_Idx;
+	TickType_t				TimeReport_Tick;
 
-						//
-						//	Output in Excel Comma Separated format
-						//
-						case Excel_CSV:
-							UARTprintf( "%08d,%04d,%s,%s,%s,%s\n",
-										theReport.TimeStamp, theReport.ReportName,
-										FormattedStrings[0], FormattedStrings[1],
-										FormattedStrings[2], FormattedStrings[3] );
-							break;
 
-						//
-						//	Output in Mathematica List format
-						//
-						case Mathematica_List:
-							UARTprintf( "{ %08d, %04d, %s, %s, %s, %s },\n",
-										theReport.TimeStamp, theReport.ReportName,
-										FormattedStrings[0], FormattedStrings[1],
-										FormattedStrings[2], FormattedStrings[3] );
+	//
+	//	Ensure UARTStdio is initialized
+	//
+	UARTStdio_Initialization();
 
-							break;
+	Log_Printf( ">>>>ReportData: Initializing.\n" );
 
-						//
-						//	Output in C white space format
-						//
-						case C_Format:
-							UARTprintf( "%08d %04d %s %s %s %s\n",
-										theReport.TimeStamp, theReport.ReportName,
-										FormattedStrings[0], FormattedStrings[1],
-										FormattedStrings[2], FormattedStrings[3] );
-							break;
+	//
+	//	Define ReportData_Queue
+	//
+	ReportData_Queue = xQueueCreate( 1024, sizeof( ReportData_Item ) );
 
-					}
+	Log_Printf( ">>>>ReportData: Queue Handle: %p\n", ReportData_Queue );
 
-				}
+	//
+	//	Release everything waiting for ReportData_Queue
+	//
+	Startup_Signal( STARTUP_REPORTDATA );
 
+	//
+	//	The first time record precedes every other record
+	//
+	ReportData_PrintTime();
+	TimeReport_Tick = xTaskGetTickCount();
+
+	while ( 1 )	{
+
+		if ( ( xTaskGetTickCount() - TimeReport_Tick ) >= ReportTimePeriod ) {
+			ReportData_PrintTime();
+			TimeReport_Tick += ReportTimePeriod;
+		}
+
+		//
+		//	Try to read up to ReportBatchSize ReportItems from
+		//	ReportData_Queue in one critical section.
+		//	Print the contents of each ReportData_Item returned
+		//		to the UART via UARTStdioPrintf
+		//
+		ReportQueue_Count = (uint32_t) xQueueReceiveMultiple( ReportData_Queue,
+											theReports, ReportBatchSize,
+											1 * portTICK_PERIOD_MS );
+
+//		Log_Printf( ">>>>ReportData: Queue Receive: %d\n", ReportQueue_Count );
+
+		for ( Report_Idx = 0; Report_Idx < ReportQueue_Count; Report_Idx++ ) {
+			ReportData_Print( &theReports[Report_Idx] );
+		}
+
+		//
+		//	One delay per batch. Records queued meanwhile are
+		//	printed together on the next pass.
+		//
 		vTaskDelay( 100 );
 
 	}
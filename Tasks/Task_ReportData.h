@@ -19,6 +19,23 @@
  *  				(3) Added a global subroutine to
  *  					set the output format
  *
+ *  Modification:	2026-10-19
+ *  				Added ReportName_Metric and ReportName_MetricBucket
+ *  				for Task_Metrics.
+ *
+ *  Modification:	2026-10-19
+ *  				Added TimeStamp_SubTick_ns and ReportData_Stamp.
+ *
+ *  Modification:	2026-10-20
+ *  				Added ReportName_DeadlineMiss for Deadline_Monitor.
+ *
+ *  Modification:	2026-10-20
+ *  				ReportName_Time records carry the high word of the
+ *  				tick count.
+ *
+ *  Modification:	2026-10-20
+ *  				Added ReportData_LostCount.
+ *
  */
 
 #ifndef TASKS_TASK_REPORTDATA_H_
@@ -52,7 +69,16 @@ extern QueueHandle_t ReportData_Queue;
 //
 //	Define a structure to hold a data report
 //
+//
+//	TimeStamp is xPortSysTickCount; TimeStamp_SubTick_ns is the time
+//	since that tick began (see Drivers/Timestamp.h). Records carry
+//	the low 32 bits of the tick count only; a reader unwraps them
+//	from the ReportName_Time records Task_ReportData prints every
+//	2 seconds, whose ReportValue_0 is the high 32 bits of the tick
+//	count and ReportValue_1 is configTICK_RATE_HZ.
+//
 typedef struct  {	uint32_t				TimeStamp;
+					uint32_t				TimeStamp_SubTick_ns;
 					uint32_t				ReportName;
 					uint32_t				ReportValueType_Flg;
 					int32_t					ReportValue_0;
@@ -60,4 +86,52 @@ typedef struct  {	uint32_t				TimeStamp;
 					int32_t					ReportValue_2;
 					int32_t					ReportValue_3; } ReportData_Item;
 
+//
+//	Define the ReportName of each record sent to ReportData_Queue
+//
+#define		ReportName_Time					1
+#define		ReportName_Pressure				2
+#define		ReportName_Temperature			3
+#define		ReportName_Acceleration			4
+#define		ReportName_Gyroscope			5
+#define		ReportName_Magnetometer			6
+#define		ReportName_Quaternion			7
+#define		ReportName_EulerAngles			8
+#define		ReportName_FusionCycles			9
+#define		ReportName_Metric				10
+#define		ReportName_MetricBucket			11
+#define		ReportName_DeadlineMiss			12
+#define		ReportName_ProgramTrace			42
+
+//
+//	Windowed statistics records (see Report_Statistics.h) for value
+//	<Value_Idx> of records named <ReportName>
+//
+#define		ReportName_Statistics( ReportName, Value_Idx )	\
+					( 1000 + ( 10 * ( ReportName ) ) + ( Value_Idx ) )
+
+//
+//	Set TimeStamp and TimeStamp_SubTick_ns to the current time
+//
+extern void ReportData_Stamp( ReportData_Item *theReport );
+
+//
+//	Send a record to ReportData_Queue through the report filter
+//
+extern BaseType_t ReportData_Send( const ReportData_Item *theReport );
+
+//
+//	Send Count records with a single xQueueSendMultiple. Records the
+//	filter drops are removed from theReports, which is compacted in
+//	place. Returns the number of records queued.
+//
+extern uint32_t ReportData_SendMultiple( ReportData_Item *theReports, uint32_t Count );
+
+//
+//	Records the filter accepted that were dropped because
+//	ReportData_Queue was full or not yet created. Once dequeued,
+//	a record is always printed.
+//
+extern uint32_t ReportData_LostCount( void );
+
 #endif /* TASKS_TASK_REPORTDATA_H_ */
@@ -0,0 +1,66 @@
+/**
+* @Filename: FreeRTOS.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [9:10am]
+* @Version:  1.0.0
+*
+* @Description: Host stand-in for FreeRTOS.h. Only the types and the
+*               configuration the hardware independent modules use, with
+*               the target's clock and tick rates.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TESTS_HOST_FREERTOS_H_
+#define TESTS_HOST_FREERTOS_H_
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/************************************************
+* Configuration
+************************************************/
+#define configCPU_CLOCK_HZ 120000000
+#define configASSERT(x)    assert(x)
+
+#define configKERNEL_INTERRUPT_PRIORITY      (7 << 5)
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY (5 << 5)
+
+// A test may be built at other tick rates with -DconfigTICK_RATE_HZ=
+#ifndef configTICK_RATE_HZ
+#define configTICK_RATE_HZ 10000
+#endif
+
+
+/************************************************
+* Types
+************************************************/
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#define pdFALSE       ((BaseType_t)0)
+#define pdTRUE        ((BaseType_t)1)
+#define pdPASS        pdTRUE
+#define pdFAIL        pdFALSE
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFF)
+
+#define portYIELD_FROM_ISR(x) ((void)(x))
+
+// The tests run the module from one thread
+#define portSET_INTERRUPT_MASK_FROM_ISR()     ((UBaseType_t)0)
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x) ((void)(x))
+
+
+/************************************************
+* Trace recorder, as the target's FreeRTOSConfig.h includes it
+************************************************/
+#if defined(configUSE_TRACE_RECORDER) && (configUSE_TRACE_RECORDER == 1)
+#include "Drivers/Trace_Recorder.h"
+#endif
+
+#endif /* TESTS_HOST_FREERTOS_H_ */
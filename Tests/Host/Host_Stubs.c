@@ -0,0 +1,71 @@
+/**
+* @Filename: Host_Stubs.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [9:10am]
+* @Version:  1.0.0
+*
+* @Description: Host definitions of what the modules under test call on
+*               the target: the tick and cycle counts, and Log_Printf.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Drivers/CycleCounter.h"
+
+#include "Tasks/Log.h"
+
+#include "FreeRTOS.h"
+#include "Host_Test.h"
+#include "task.h"
+
+
+/************************************************
+* Variables
+************************************************/
+volatile TickType_t Host_TickCount = 0;
+volatile uint32_t CycleCounter_Host = 0;
+
+char Host_Log_Line[256];
+uint32_t Host_Log_Lines = 0;
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: CycleCounter_Initialization
+* Description:   Nothing to enable on the host
+* Parameters:    N/A
+* Return:        uint32_t (1)
+*************************************************************************/
+extern uint32_t CycleCounter_Initialization() {
+  return (1);
+}
+
+
+/*************************************************************************
+* Function Name: Log_Printf
+* Description:   Keep the line in Host_Log_Line
+* Parameters:    const char* format
+*                ...
+* Return:        void
+*************************************************************************/
+extern void Log_Printf(const char* format, ...) {
+  va_list args;
+
+  va_start(args, format);
+  vsnprintf(Host_Log_Line, sizeof(Host_Log_Line), format, args);
+  va_end(args);
+
+  Host_Log_Lines++;
+}
+
@@ -0,0 +1,42 @@
+/**
+* @Filename: Host_Test.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [2:20pm]
+* @Version:  1.0.0
+*
+* @Description: Check counts of every host test, application or kernel
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Host_Test.h"
+
+
+/************************************************
+* Variables
+************************************************/
+uint32_t HostTest_Checks = 0;
+uint32_t HostTest_Failures = 0;
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: HostTest_Result
+* Description:   Print the totals
+* Parameters:    const char* name
+* Return:        int - 0 if every check passed
+*************************************************************************/
+extern int HostTest_Result(const char* name) {
+  printf("%s: %u checks, %u failed\n", name, HostTest_Checks, HostTest_Failures);
+  return (HostTest_Failures == 0) ? 0 : 1;
+}
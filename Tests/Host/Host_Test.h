@@ -0,0 +1,72 @@
+/**
+* @Filename: Host_Test.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [9:10am]
+* @Version:  1.0.0
+*
+* @Description: Checks and stubs shared by the host tests.
+*
+*               HOST_TEST_CHECK prints the failing condition and counts
+*               it; a test program returns HostTest_Result() from main.
+*               Log_Printf lines are kept in Host_Log_Line (the last one)
+*               instead of going to a UART.
+*
+*               No kernel header is included here, so tests of the kernel
+*               sources (built against Source/include) can use it too.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TESTS_HOST_HOST_TEST_H_
+#define TESTS_HOST_HOST_TEST_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/************************************************
+* Macros
+************************************************/
+#define HOST_TEST_CHECK(condition)                                                 \
+  do {                                                                             \
+    HostTest_Checks++;                                                             \
+    if (!(condition)) {                                                            \
+      HostTest_Failures++;                                                         \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);        \
+    }                                                                              \
+  } while (0)
+
+#define HOST_TEST_CHECK_EQUAL(actual, expected)                                    \
+  do {                                                                             \
+    unsigned long long actualValue = (unsigned long long)(actual);                 \
+    unsigned long long expectedValue = (unsigned long long)(expected);             \
+    HostTest_Checks++;                                                             \
+    if (actualValue != expectedValue) {                                            \
+      HostTest_Failures++;                                                         \
+      printf("%s:%d: %s is %llu, expected %llu\n", __FILE__, __LINE__, #actual,    \
+             actualValue, expectedValue);                                          \
+    }                                                                              \
+  } while (0)
+
+
+/************************************************
+* Variables
+************************************************/
+extern uint32_t HostTest_Checks;
+extern uint32_t HostTest_Failures;
+
+// Last line written with Log_Printf, and the number of lines
+extern char Host_Log_Line[256];
+extern uint32_t Host_Log_Lines;
+
+
+/************************************************
+* Function declarations
+************************************************/
+// Print the totals. Returns the exit status of the test program.
+extern int HostTest_Result(const char* name);
+
+#endif /* TESTS_HOST_HOST_TEST_H_ */
@@ -0,0 +1,28 @@
+/**
+* @Filename: interrupt.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [7:30pm]
+* @Version:  1.0.0
+*
+* @Description: Host stand-in for TivaWare's driverlib/interrupt.h. Only
+*               declared; a test that needs the NVIC defines these.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TESTS_HOST_DRIVERLIB_INTERRUPT_H_
+#define TESTS_HOST_DRIVERLIB_INTERRUPT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+extern void IntRegister(uint32_t ui32Interrupt, void (*pfnHandler)(void));
+extern void IntUnregister(uint32_t ui32Interrupt);
+extern void IntEnable(uint32_t ui32Interrupt);
+extern void IntDisable(uint32_t ui32Interrupt);
+extern void IntPrioritySet(uint32_t ui32Interrupt, uint8_t ui8Priority);
+extern void IntTrigger(uint32_t ui32Interrupt);
+
+#endif /* TESTS_HOST_DRIVERLIB_INTERRUPT_H_ */
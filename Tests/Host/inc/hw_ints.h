@@ -0,0 +1,23 @@
+/**
+* @Filename: hw_ints.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [7:30pm]
+* @Version:  1.0.0
+*
+* @Description: Host stand-in for TivaWare's inc/hw_ints.h. Only the
+*               TM4C1294 numbers the modules under test use.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TESTS_HOST_INC_HW_INTS_H_
+#define TESTS_HOST_INC_HW_INTS_H_
+
+#define FAULT_SYSTICK     15
+#define INT_TIMER1A       37
+#define NUM_INTERRUPTS    130
+#define NUM_PRIORITY_BITS 3
+
+#endif /* TESTS_HOST_INC_HW_INTS_H_ */
@@ -0,0 +1,27 @@
+/**
+* @Filename: queue.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [10:30am]
+* @Version:  1.0.0
+*
+* @Description: Host stand-in for queue.h. Only what Task_ReportData.h
+*               and Log.c use; a test that needs a queue defines these.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TESTS_HOST_QUEUE_H_
+#define TESTS_HOST_QUEUE_H_
+
+#include "FreeRTOS.h"
+
+typedef void* QueueHandle_t;
+
+extern QueueHandle_t xQueueCreate(const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize);
+extern BaseType_t xQueueSendFromISR(QueueHandle_t xQueue, const void* const pvItemToQueue,
+                                    BaseType_t* const pxHigherPriorityTaskWoken);
+extern BaseType_t xQueueReceive(QueueHandle_t xQueue, void* const pvBuffer, TickType_t xTicksToWait);
+
+#endif /* TESTS_HOST_QUEUE_H_ */
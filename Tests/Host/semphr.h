@@ -0,0 +1,27 @@
+/**
+* @Filename: semphr.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [5:10pm]
+* @Version:  1.0.0
+*
+* @Description: Host stand-in for semphr.h. Only the mutex calls Log.c
+*               makes; Test_Log defines them on a pthread mutex.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TESTS_HOST_SEMPHR_H_
+#define TESTS_HOST_SEMPHR_H_
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+typedef QueueHandle_t SemaphoreHandle_t;
+
+extern SemaphoreHandle_t xSemaphoreCreateMutex(void);
+extern BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime);
+extern BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore);
+
+#endif /* TESTS_HOST_SEMPHR_H_ */
@@ -0,0 +1,40 @@
+/**
+* @Filename: i2cm_drv.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [12:10pm]
+* @Version:  1.0.0
+*
+* @Description: Host stand-in for TivaWare's sensorlib/i2cm_drv.h. The
+*               test defines I2CMRead and I2CMWrite; no transaction runs
+*               and no callback is called.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TESTS_HOST_SENSORLIB_I2CM_DRV_H_
+#define TESTS_HOST_SENSORLIB_I2CM_DRV_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define I2CM_STATUS_SUCCESS    0
+#define I2CM_STATUS_ADDR_NACK  1
+
+typedef void(tSensorCallback)(void* pvCallbackData, uint_fast8_t ui8Status);
+
+typedef struct {
+  uint32_t ui32Base;
+} tI2CMInstance;
+
+extern uint_fast8_t I2CMRead(tI2CMInstance* psInst, uint_fast8_t ui8Addr,
+                             const uint8_t* pui8WriteData, uint_fast16_t ui16WriteCount,
+                             uint8_t* pui8ReadData, uint_fast16_t ui16ReadCount,
+                             tSensorCallback* pfnCallback, void* pvCallbackData);
+extern uint_fast8_t I2CMWrite(tI2CMInstance* psInst, uint_fast8_t ui8Addr,
+                              const uint8_t* pui8Data, uint_fast16_t ui16Count,
+                              tSensorCallback* pfnCallback, void* pvCallbackData);
+
+#endif /* TESTS_HOST_SENSORLIB_I2CM_DRV_H_ */
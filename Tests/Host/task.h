@@ -0,0 +1,45 @@
+/**
+* @Filename: task.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [9:10am]
+* @Version:  1.0.0
+*
+* @Description: Host stand-in for task.h. The tick count is
+*               Host_TickCount, set by the test. The tests run the module
+*               from one thread, so critical sections and scheduler
+*               suspension do nothing.
+*
+*               The scheduler state and vTaskDelay are only declared; a
+*               test that needs them (Test_Log) defines them.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TESTS_HOST_TASK_H_
+#define TESTS_HOST_TASK_H_
+
+#include "FreeRTOS.h"
+
+extern volatile TickType_t Host_TickCount;
+
+#define xTaskGetTickCount() (Host_TickCount)
+
+#define taskSCHEDULER_SUSPENDED   ((BaseType_t)0)
+#define taskSCHEDULER_NOT_STARTED ((BaseType_t)1)
+#define taskSCHEDULER_RUNNING     ((BaseType_t)2)
+
+extern BaseType_t xTaskGetSchedulerState(void);
+extern void vTaskDelay(const TickType_t xTicksToDelay);
+
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+#define vTaskSuspendAll()
+
+// A function, so that ignoring the result does not warn
+static inline BaseType_t xTaskResumeAll(void) {
+  return pdFALSE;
+}
+
+#endif /* TESTS_HOST_TASK_H_ */
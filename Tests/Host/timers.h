@@ -0,0 +1,20 @@
+/**
+* @Filename: timers.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [5:10pm]
+* @Version:  1.0.0
+*
+* @Description: Host stand-in for timers.h. The host configuration has no
+*               timer service task, so nothing is declared.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TESTS_HOST_TIMERS_H_
+#define TESTS_HOST_TIMERS_H_
+
+#include "FreeRTOS.h"
+
+#endif /* TESTS_HOST_TIMERS_H_ */
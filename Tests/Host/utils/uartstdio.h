@@ -0,0 +1,19 @@
+/**
+* @Filename: uartstdio.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [10:30am]
+* @Version:  1.0.0
+*
+* @Description: Host stand-in for TivaWare's utils/uartstdio.h, which
+*               Task_ReportData.h includes. The modules under test print
+*               with Log_Printf only.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TESTS_HOST_UTILS_UARTSTDIO_H_
+#define TESTS_HOST_UTILS_UARTSTDIO_H_
+
+#endif /* TESTS_HOST_UTILS_UARTSTDIO_H_ */
@@ -0,0 +1,68 @@
+/**
+* @Filename: FreeRTOSConfig.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [2:30pm]
+* @Version:  1.0.0
+*
+* @Description: Kernel configuration of the host tests that build the
+*               kernel sources themselves. Clock and tick rates are the
+*               target's. Options a test varies (the timer store and
+*               co-routines, for two) keep their defaults unless set
+*               with -D.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TESTS_KERNEL_FREERTOSCONFIG_H_
+#define TESTS_KERNEL_FREERTOSCONFIG_H_
+
+#include <assert.h>
+
+/************************************************
+* Scheduler
+************************************************/
+#define configUSE_PREEMPTION                    1
+#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICK_HOOK                     0
+#define configCPU_CLOCK_HZ                      120000000
+#define configTICK_RATE_HZ                      10000
+#define configMAX_PRIORITIES                    8
+#define configMINIMAL_STACK_SIZE                128
+#define configMAX_TASK_NAME_LEN                 16
+#define configUSE_16_BIT_TICKS                  0
+#define configIDLE_SHOULD_YIELD                 1
+#ifndef configUSE_CO_ROUTINES
+#define configUSE_CO_ROUTINES                   0
+#endif
+#define configMAX_CO_ROUTINE_PRIORITIES         2
+
+#define configKERNEL_INTERRUPT_PRIORITY         (7 << 5)
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY    (5 << 5)
+
+#define configASSERT(x)                         assert(x)
+
+
+/************************************************
+* Software timers
+************************************************/
+#define configUSE_TIMERS                        1
+#define configTIMER_TASK_PRIORITY               (configMAX_PRIORITIES - 1)
+#define configTIMER_QUEUE_LENGTH                16
+#define configTIMER_TASK_STACK_DEPTH            256
+
+
+/************************************************
+* API included
+************************************************/
+#define INCLUDE_vTaskPrioritySet                1
+#define INCLUDE_uxTaskPriorityGet               1
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_vTaskDelayUntil                 1
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_xTaskGetSchedulerState          1
+#define INCLUDE_xTimerPendFunctionCall          1
+
+#endif /* TESTS_KERNEL_FREERTOSCONFIG_H_ */
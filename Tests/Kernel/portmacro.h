@@ -0,0 +1,94 @@
+/**
+* @Filename: portmacro.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [2:30pm]
+* @Version:  1.0.0
+*
+* @Description: Host port of the kernel tests. The types are those of
+*               Source/portable/CCS/ARM_CM4F/portmacro.h, so the kernel
+*               sources build as they do for the target. Yields, critical
+*               sections and interrupt masking call functions of the test's
+*               stubs instead of touching the NVIC.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/************************************************
+* Types
+************************************************/
+typedef uint8_t  portCHAR;
+typedef float    portFLOAT;
+typedef int64_t  portDOUBLE;
+typedef int32_t  portLONG;
+typedef int16_t  portSHORT;
+typedef uint32_t portSTACK_TYPE;
+typedef int32_t  portBASE_TYPE;
+typedef uint32_t StackType_t;
+typedef int32_t  BaseType_t;
+typedef uint32_t UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define portMAX_DELAY           ((TickType_t)0xffffffffUL)
+#define portTICK_TYPE_IS_ATOMIC 1
+
+// Host pointers, for the stack alignment in tasks.c
+#define portPOINTER_SIZE_TYPE uintptr_t
+
+
+/************************************************
+* Architecture
+************************************************/
+#define portSTACK_GROWTH    (-1)
+#define portTICK_PERIOD_MS  ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portBYTE_ALIGNMENT  8
+#define portNOP()
+
+#define portTASK_FUNCTION_PROTO(vFunction, pvParameters) void vFunction(void* pvParameters)
+#define portTASK_FUNCTION(vFunction, pvParameters)       void vFunction(void* pvParameters)
+
+
+/************************************************
+* Scheduler utilities
+************************************************/
+extern void vPortYield(void);
+
+#define portYIELD()                           vPortYield()
+#define portEND_SWITCHING_ISR(xSwitchRequired) if ((xSwitchRequired) != pdFALSE) portYIELD()
+#define portYIELD_FROM_ISR(x)                 portEND_SWITCHING_ISR(x)
+
+// Count leading zeros, as the target's __clz
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
+#define portRECORD_READY_PRIORITY(uxPriority, uxReadyPriorities) (uxReadyPriorities) |= (1UL << (uxPriority))
+#define portRESET_READY_PRIORITY(uxPriority, uxReadyPriorities)  (uxReadyPriorities) &= ~(1UL << (uxPriority))
+#define portGET_HIGHEST_PRIORITY(uxTopPriority, uxReadyPriorities) \
+  uxTopPriority = (31 - __builtin_clz((uint32_t)(uxReadyPriorities)))
+
+
+/************************************************
+* Critical sections
+************************************************/
+extern void vPortEnterCritical(void);
+extern void vPortExitCritical(void);
+extern void vPortDisableInterrupts(void);
+extern void vPortEnableInterrupts(void);
+extern uint32_t ulPortSetInterruptMask(void);
+extern void vPortClearInterruptMask(uint32_t ulNewMask);
+
+#define portENTER_CRITICAL()                 vPortEnterCritical()
+#define portEXIT_CRITICAL()                  vPortExitCritical()
+#define portDISABLE_INTERRUPTS()             vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()              vPortEnableInterrupts()
+#define portSET_INTERRUPT_MASK_FROM_ISR()    ulPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x) vPortClearInterruptMask(x)
+
+#endif /* PORTMACRO_H */
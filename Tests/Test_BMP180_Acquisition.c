@@ -0,0 +1,303 @@
+/**
+* @Filename: Test_BMP180_Acquisition.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [12:10pm]
+* @Version:  1.0.0
+*
+* @Description: Host tests of Drivers/BMP180_Acquisition.c and its timing
+*               model. The Makefile builds it once per tick rate in
+*               BMP180_TICK_RATES.
+*
+*               The engine is run against a simulated bus for each
+*               oversampling setting: every conversion wait must cover
+*               the datasheet conversion time plus the tick vTaskDelay may
+*               lose, the bus bytes it counts must match the transactions
+*               it issued, and the sample rate it achieves must match
+*               BMP180Acq_ModelSamplesPerSecond. The achieved rates are
+*               printed.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Drivers/BMP180_Acquisition.h"
+
+#include "sensorlib/i2cm_drv.h"
+
+#include "FreeRTOS.h"
+#include "Host_Test.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+#define TEST_ADDRESS 0x77
+
+// Temperature conversions simulated per oversampling setting
+#define TEST_CYCLES 10
+
+// Name of the results, with the tick rate the test was built for
+#define TEST_STRING(x) #x
+#define TEST_NAME(rate) "BMP180_Acquisition at " TEST_STRING(rate) " Hz"
+
+// Microseconds per tick and per byte on the bus
+#define TEST_TICK_US ((double)1000000 / configTICK_RATE_HZ)
+#define TEST_BYTE_US ((double)(9 * 1000000) / BMP180ACQ_I2C_BIT_RATE)
+
+// Datasheet example: calibration E2PROM, UT and UP (OSS 0) registers, and
+// the results they compensate to
+static const uint8_t EXAMPLE_E2PROM[22] = {
+  0x01, 0x98, 0xFF, 0xB8, 0xC7, 0xD1, 0x7F, 0xE5, 0x7F, 0xF5, 0x5A, 0x71,
+  0x18, 0x2E, 0x00, 0x04, 0x80, 0x00, 0xDD, 0xF9, 0x0B, 0x34
+};
+static const uint8_t EXAMPLE_UT[2] = { 0x6C, 0xFA };
+static const uint8_t EXAMPLE_UP[3] = { 0x5D, 0x23, 0x00 };
+static const int32_t EXAMPLE_TEMPERATURE = 150;
+
+
+/************************************************
+* Local variables
+************************************************/
+BMP180_Acquisition Test_Acq;
+tI2CMInstance Test_I2C;
+
+// Bytes on the bus of the transactions issued, counted from their sizes
+uint32_t Test_Bus_Bytes = 0;
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: run_step
+* Description:   Issue the next transaction and complete it
+* Parameters:    uint_fast8_t status - status of the transaction
+*                uint32_t* bytes     - bus bytes of the transaction
+*                bool* sampleReady
+* Return:        uint32_t - ticks the engine asked to wait
+*************************************************************************/
+static uint32_t run_step(uint_fast8_t status, uint32_t* bytes, bool* sampleReady) {
+  uint32_t before = Test_Bus_Bytes;
+
+  BMP180Acq_Start(&Test_Acq, NULL, NULL, sampleReady);
+  *bytes = Test_Bus_Bytes - before;
+  return BMP180Acq_Complete(&Test_Acq, status);
+}
+
+
+/*************************************************************************
+* Function Name: test_conversion_ticks
+* Description:   Every datasheet conversion time is covered, with one
+*                tick to spare and less than two
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_conversion_ticks() {
+  uint32_t oss = 0;
+
+  for (oss = BMP180_OSS_ULTRA_LOW_POWER; oss <= (BMP180_OSS_ULTRA_HIGH_RESOLUTION + 1); ++oss) {
+    uint32_t us = (oss > BMP180_OSS_ULTRA_HIGH_RESOLUTION) ? BMP180ACQ_TEMPERATURE_US : BMP180ACQ_PRESSURE_US(oss);
+    uint32_t ticks = BMP180Acq_ConversionTicks(us);
+
+    HOST_TEST_CHECK(ticks >= 2);
+    HOST_TEST_CHECK(((ticks - 1) * TEST_TICK_US) >= us);
+    HOST_TEST_CHECK(((ticks - 2) * TEST_TICK_US) < us);
+  }
+
+  HOST_TEST_CHECK((BMP180ACQ_I2C_BYTE_US * BMP180ACQ_I2C_BIT_RATE) >= (9 * 1000000));
+  HOST_TEST_CHECK(((BMP180ACQ_I2C_BYTE_US - 1) * BMP180ACQ_I2C_BIT_RATE) < (9 * 1000000));
+}
+
+
+/*************************************************************************
+* Function Name: test_engine
+* Description:   Run TEST_CYCLES temperature conversions with their
+*                pressure conversions through the engine and compare the
+*                waits, bus bytes and sample rate with the model
+* Parameters:    uint32_t oss
+*                uint32_t pressurePerTemperature
+* Return:        void
+*************************************************************************/
+static void test_engine(uint32_t oss, uint32_t pressurePerTemperature) {
+  const uint32_t temperatureTicks = BMP180Acq_ConversionTicks(BMP180ACQ_TEMPERATURE_US);
+  const uint32_t pressureTicks = BMP180Acq_ConversionTicks(BMP180ACQ_PRESSURE_US(oss));
+  uint32_t model = BMP180Acq_ModelSamplesPerSecond(oss, pressurePerTemperature);
+  uint32_t samplesBefore = 0;
+  uint32_t busBytesBefore = 0;
+  uint32_t reads = 0;
+  uint32_t bytes = 0;
+  uint32_t ticks = 0;
+  bool sampleReady = false;
+  bool waitsRight = true;
+  double elapsedUs = 0.0;
+  double achieved = 0.0;
+
+  Test_Bus_Bytes = 0;
+  BMP180Acq_Init(&Test_Acq, &Test_I2C, TEST_ADDRESS, oss, pressurePerTemperature);
+
+  // Calibration, then the first temperature conversion starts
+  HOST_TEST_CHECK_EQUAL(run_step(I2CM_STATUS_SUCCESS, &bytes, &sampleReady), 0);
+  HOST_TEST_CHECK_EQUAL(Test_Acq.state, BMP180ACQ_START_TEMPERATURE);
+  samplesBefore = Test_Acq.samples;
+  busBytesBefore = Test_Acq.busBytes;
+
+  // One cycle is a temperature conversion and its pressure conversions,
+  // counted from the start of each temperature conversion
+  while (reads < (TEST_CYCLES * pressurePerTemperature)) {
+    BMP180Acq_State_t state = Test_Acq.state;
+
+    ticks = run_step(I2CM_STATUS_SUCCESS, &bytes, &sampleReady);
+    elapsedUs += (ticks * TEST_TICK_US) + (bytes * TEST_BYTE_US);
+
+    if (state == BMP180ACQ_START_TEMPERATURE) {
+      waitsRight = waitsRight && (ticks == temperatureTicks);
+    }
+    else if (state == BMP180ACQ_START_PRESSURE) {
+      waitsRight = waitsRight && (ticks == pressureTicks);
+    }
+    else {
+      waitsRight = waitsRight && (ticks == 0);
+    }
+    if (state == BMP180ACQ_READ_PRESSURE) {
+      reads++;
+    }
+  }
+  HOST_TEST_CHECK(waitsRight);
+  HOST_TEST_CHECK_EQUAL(Test_Acq.state, BMP180ACQ_START_TEMPERATURE);
+  HOST_TEST_CHECK_EQUAL(Test_Acq.errors, 0);
+
+  // The last pressure value is compensated while the next transaction runs
+  HOST_TEST_CHECK_EQUAL(Test_Acq.samples - samplesBefore, reads - 1);
+  HOST_TEST_CHECK_EQUAL(Test_Acq.temperature, EXAMPLE_TEMPERATURE);
+  HOST_TEST_CHECK((Test_Acq.pressure >= 69962) && (Test_Acq.pressure <= 69966));
+
+  // Bytes counted by the engine, and the model's average per sample
+  HOST_TEST_CHECK_EQUAL(Test_Acq.busBytes, Test_Bus_Bytes);
+  HOST_TEST_CHECK((BMP180Acq_ModelBusBytesPerSample(pressurePerTemperature) * reads) >=
+                  (Test_Acq.busBytes - busBytesBefore));
+  HOST_TEST_CHECK((BMP180Acq_ModelBusBytesPerSample(pressurePerTemperature) * reads) <
+                  (Test_Acq.busBytes - busBytesBefore + reads));
+
+  // The model rounds the bus time up and the rate down, so it may be up
+  // to one sample/s, and 1%, low
+  achieved = (reads * 1000000.0) / elapsedUs;
+  HOST_TEST_CHECK(model <= achieved);
+  HOST_TEST_CHECK(achieved < ((model + 1) * 1.01));
+
+  printf("BMP180 at %u Hz tick: OSS %u, 1 temperature per %u: %.1f samples/s (model %u), %u bytes/sample\n",
+         configTICK_RATE_HZ, oss, pressurePerTemperature, achieved, model,
+         BMP180Acq_ModelBusBytesPerSample(pressurePerTemperature));
+}
+
+
+/*************************************************************************
+* Function Name: test_error
+* Description:   A failed transaction drops the sample in progress, backs
+*                off at least one tick and restarts from a temperature
+*                conversion
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_error() {
+  uint32_t bytes = 0;
+  bool sampleReady = false;
+
+  BMP180Acq_Init(&Test_Acq, &Test_I2C, TEST_ADDRESS, BMP180_OSS_STANDARD, 4);
+
+  // A failed calibration read is retried
+  HOST_TEST_CHECK(run_step(I2CM_STATUS_ADDR_NACK, &bytes, &sampleReady) >= 1);
+  HOST_TEST_CHECK_EQUAL(Test_Acq.state, BMP180ACQ_READ_CALIBRATION);
+
+  run_step(I2CM_STATUS_SUCCESS, &bytes, &sampleReady);
+  run_step(I2CM_STATUS_SUCCESS, &bytes, &sampleReady);
+  run_step(I2CM_STATUS_SUCCESS, &bytes, &sampleReady);
+  HOST_TEST_CHECK_EQUAL(Test_Acq.state, BMP180ACQ_START_PRESSURE);
+
+  HOST_TEST_CHECK(run_step(I2CM_STATUS_ADDR_NACK, &bytes, &sampleReady) >= 1);
+  HOST_TEST_CHECK_EQUAL(Test_Acq.state, BMP180ACQ_START_TEMPERATURE);
+  HOST_TEST_CHECK_EQUAL(Test_Acq.errors, 2);
+  HOST_TEST_CHECK(!Test_Acq.bUTPending);
+  HOST_TEST_CHECK(!Test_Acq.bUPPending);
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: I2CMRead
+* Description:   Host stub. Counts the bytes on the bus (address, register,
+*                repeated start address, data) and returns the datasheet
+*                example for the register block read.
+* Parameters:    As TivaWare's I2CMRead
+* Return:        uint_fast8_t (1)
+*************************************************************************/
+extern uint_fast8_t I2CMRead(tI2CMInstance* psInst, uint_fast8_t ui8Addr,
+                             const uint8_t* pui8WriteData, uint_fast16_t ui16WriteCount,
+                             uint8_t* pui8ReadData, uint_fast16_t ui16ReadCount,
+                             tSensorCallback* pfnCallback, void* pvCallbackData) {
+  (void)psInst;
+  (void)pfnCallback;
+  (void)pvCallbackData;
+
+  HOST_TEST_CHECK_EQUAL(ui8Addr, TEST_ADDRESS);
+  Test_Bus_Bytes += 1 + ui16WriteCount + 1 + ui16ReadCount;
+
+  if (ui16ReadCount == sizeof(EXAMPLE_E2PROM)) {
+    memcpy(pui8ReadData, EXAMPLE_E2PROM, sizeof(EXAMPLE_E2PROM));
+  }
+  else if (ui16ReadCount == sizeof(EXAMPLE_UT)) {
+    memcpy(pui8ReadData, EXAMPLE_UT, sizeof(EXAMPLE_UT));
+  }
+  else {
+    // The registers hold UP left aligned in 24 bits, the same example
+    // pressure reads the same at every OSS
+    HOST_TEST_CHECK_EQUAL(ui16ReadCount, sizeof(EXAMPLE_UP));
+    HOST_TEST_CHECK_EQUAL(pui8WriteData[0], 0xF6);
+    memcpy(pui8ReadData, EXAMPLE_UP, sizeof(EXAMPLE_UP));
+  }
+  return (1);
+}
+
+
+/*************************************************************************
+* Function Name: I2CMWrite
+* Description:   Host stub. Counts the bytes on the bus.
+* Parameters:    As TivaWare's I2CMWrite
+* Return:        uint_fast8_t (1)
+*************************************************************************/
+extern uint_fast8_t I2CMWrite(tI2CMInstance* psInst, uint_fast8_t ui8Addr,
+                              const uint8_t* pui8Data, uint_fast16_t ui16Count,
+                              tSensorCallback* pfnCallback, void* pvCallbackData) {
+  (void)psInst;
+  (void)pui8Data;
+  (void)pfnCallback;
+  (void)pvCallbackData;
+
+  HOST_TEST_CHECK_EQUAL(ui8Addr, TEST_ADDRESS);
+  Test_Bus_Bytes += 1 + ui16Count;
+  return (1);
+}
+
+
+int main() {
+  uint32_t oss = 0;
+
+  test_conversion_ticks();
+  for (oss = BMP180_OSS_ULTRA_LOW_POWER; oss <= BMP180_OSS_ULTRA_HIGH_RESOLUTION; ++oss) {
+    test_engine(oss, 1);
+    test_engine(oss, 8);
+  }
+  test_error();
+
+  return HostTest_Result(TEST_NAME(configTICK_RATE_HZ));
+}
@@ -0,0 +1,154 @@
+/**
+* @Filename: Test_BMP180_Compensation.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [11:40am]
+* @Version:  1.0.0
+*
+* @Description: Host tests of Drivers/BMP180_Compensation.c: bit exact
+*               against the datasheet example (BMP180 datasheet, section
+*               3.5), the calibration dump and UP of each oversampling
+*               setting.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Drivers/BMP180_Compensation.h"
+
+#include "Host_Test.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+// Datasheet example
+static const BMP180_Calibration EXAMPLE_CALIBRATION = {
+  408, -72, -14383, 32741, 32757, 23153, 6190, 4, -32768, -8711, 2868
+};
+static const int32_t EXAMPLE_UT = 27898;
+static const int32_t EXAMPLE_UP = 23843;
+// The datasheet rounds X2 down to -2344, giving B5 = 2399; C division
+// truncates to -2343. Temperature and pressure are the same either way.
+static const int32_t EXAMPLE_B5 = 2400;
+static const int32_t EXAMPLE_TEMPERATURE = 150;  // 15.0 degrees C
+static const int32_t EXAMPLE_PRESSURE = 69964;   // Pa
+
+// The example coefficients as the E2PROM holds them, 0xAA to 0xBF
+static const uint8_t EXAMPLE_E2PROM[22] = {
+  0x01, 0x98, 0xFF, 0xB8, 0xC7, 0xD1, 0x7F, 0xE5, 0x7F, 0xF5, 0x5A, 0x71,
+  0x18, 0x2E, 0x00, 0x04, 0x80, 0x00, 0xDD, 0xF9, 0x0B, 0x34
+};
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: test_datasheet_example
+* Description:   B5, temperature and pressure match the datasheet
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_datasheet_example() {
+  int32_t b5 = BMP180Comp_ComputeB5(&EXAMPLE_CALIBRATION, EXAMPLE_UT);
+
+  HOST_TEST_CHECK_EQUAL(b5, EXAMPLE_B5);
+  HOST_TEST_CHECK_EQUAL(BMP180Comp_Temperature(b5), EXAMPLE_TEMPERATURE);
+  HOST_TEST_CHECK_EQUAL(BMP180Comp_Pressure(&EXAMPLE_CALIBRATION, b5, EXAMPLE_UP, BMP180_OSS_ULTRA_LOW_POWER),
+                        EXAMPLE_PRESSURE);
+}
+
+
+/*************************************************************************
+* Function Name: test_parse_calibration
+* Description:   The E2PROM dump decodes to the example coefficients,
+*                signed and unsigned
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_parse_calibration() {
+  BMP180_Calibration calibration;
+
+  BMP180Comp_ParseCalibration(&calibration, EXAMPLE_E2PROM);
+  HOST_TEST_CHECK_EQUAL(calibration.AC1, EXAMPLE_CALIBRATION.AC1);
+  HOST_TEST_CHECK_EQUAL(calibration.AC2, EXAMPLE_CALIBRATION.AC2);
+  HOST_TEST_CHECK_EQUAL(calibration.AC3, EXAMPLE_CALIBRATION.AC3);
+  HOST_TEST_CHECK_EQUAL(calibration.AC4, EXAMPLE_CALIBRATION.AC4);
+  HOST_TEST_CHECK_EQUAL(calibration.AC5, EXAMPLE_CALIBRATION.AC5);
+  HOST_TEST_CHECK_EQUAL(calibration.AC6, EXAMPLE_CALIBRATION.AC6);
+  HOST_TEST_CHECK_EQUAL(calibration.B1, EXAMPLE_CALIBRATION.B1);
+  HOST_TEST_CHECK_EQUAL(calibration.B2, EXAMPLE_CALIBRATION.B2);
+  HOST_TEST_CHECK_EQUAL(calibration.MB, EXAMPLE_CALIBRATION.MB);
+  HOST_TEST_CHECK_EQUAL(calibration.MC, EXAMPLE_CALIBRATION.MC);
+  HOST_TEST_CHECK_EQUAL(calibration.MD, EXAMPLE_CALIBRATION.MD);
+}
+
+
+/*************************************************************************
+* Function Name: test_oversampling
+* Description:   UP keeps 16 + oss bits of the result registers. The
+*                example pressure read at each oversampling setting
+*                compensates to the same value, within the resolution.
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_oversampling() {
+  int32_t b5 = BMP180Comp_ComputeB5(&EXAMPLE_CALIBRATION, EXAMPLE_UT);
+  uint32_t oss = 0;
+
+  HOST_TEST_CHECK_EQUAL(BMP180Comp_UncompensatedPressure(0x5D, 0x23, 0x00, BMP180_OSS_ULTRA_LOW_POWER), EXAMPLE_UP);
+  HOST_TEST_CHECK_EQUAL(BMP180Comp_UncompensatedPressure(0xFF, 0xFF, 0xE0, BMP180_OSS_ULTRA_HIGH_RESOLUTION), 0x7FFFF);
+
+  for (oss = BMP180_OSS_ULTRA_LOW_POWER; oss <= BMP180_OSS_ULTRA_HIGH_RESOLUTION; ++oss) {
+    // The registers hold UP left aligned in 24 bits
+    uint32_t registers = (uint32_t)EXAMPLE_UP << 8;
+    int32_t up = BMP180Comp_UncompensatedPressure(registers >> 16, (registers >> 8) & 0xFF, registers & 0xFF, oss);
+    int32_t pressure = 0;
+
+    HOST_TEST_CHECK_EQUAL(up, EXAMPLE_UP << oss);
+    pressure = BMP180Comp_Pressure(&EXAMPLE_CALIBRATION, b5, up, oss);
+    HOST_TEST_CHECK((pressure >= (EXAMPLE_PRESSURE - 2)) && (pressure <= (EXAMPLE_PRESSURE + 2)));
+  }
+}
+
+
+/*************************************************************************
+* Function Name: test_pressure_range
+* Description:   Over the UP range of the 300 to 1100 hPa the sensor
+*                measures, pressure rises with UP without an arithmetic
+*                overflow
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_pressure_range() {
+  int32_t b5 = BMP180Comp_ComputeB5(&EXAMPLE_CALIBRATION, EXAMPLE_UT);
+  int32_t previous = BMP180Comp_Pressure(&EXAMPLE_CALIBRATION, b5, 0, BMP180_OSS_ULTRA_LOW_POWER);
+  bool rising = true;
+  int32_t up = 0;
+
+  for (up = 1; up <= 0xFFFF; ++up) {
+    int32_t pressure = BMP180Comp_Pressure(&EXAMPLE_CALIBRATION, b5, up, BMP180_OSS_ULTRA_LOW_POWER);
+
+    if ((pressure >= 30000) && (pressure <= 110000) && (pressure < previous)) {
+      rising = false;
+    }
+    previous = pressure;
+  }
+  HOST_TEST_CHECK(rising);
+}
+
+
+int main() {
+  test_datasheet_example();
+  test_parse_calibration();
+  test_oversampling();
+  test_pressure_range();
+
+  return HostTest_Result("BMP180_Compensation");
+}
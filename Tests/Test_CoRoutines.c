@@ -0,0 +1,340 @@
+/**
+* @Filename: Test_CoRoutines.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [3:10pm]
+* @Version:  1.0.0
+*
+* @Description: Host test of Source/croutine.c as the acquisition
+*               scheduler's CoRoutines task runs it: one
+*               vCoRoutineSchedule, then block for
+*               xCoRoutineGetTicksToNextWake ticks or until an interrupt.
+*
+*               croutine.c is included here, so the run can start just
+*               before the tick count overflows. Blocking moves the
+*               simulated tick count on to the wake time, or to the next
+*               simulated I2C completion, which readies a co-routine
+*               waiting on an event list as crQUEUE_SEND_FROM_ISR does.
+*
+*               Every delayed co-routine must run at the exact tick it is
+*               due, every event must be handled at the tick it was
+*               posted, and no vCoRoutineSchedule call may find nothing to
+*               run, which is the time a polling task would waste.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Source/croutine.c"
+
+#include "Host_Test.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+// Delay of each delayed co-routine, in ticks; the last is the LED's
+const TickType_t TEST_PERIODS[] = { 2, 7, 13, 100, 5000 };
+#define TEST_PERIODS_NBR (sizeof(TEST_PERIODS) / sizeof(TEST_PERIODS[0]))
+
+// The event co-routine comes after the delayed ones
+#define TEST_EVENT_INDEX   TEST_PERIODS_NBR
+#define TEST_EVENT_TIMEOUT 3000
+
+// Simulated interrupts are 1 .. TEST_INTERRUPT_GAP ticks apart, so some
+// waits time out
+#define TEST_INTERRUPT_GAP 4000
+
+// The run starts this far before the tick count overflows
+#define TEST_BEFORE_OVERFLOW 200000
+#define TEST_RUN_TICKS       400000
+
+// Checks of the ticks that pass while a co-routine runs
+#define TEST_BEHIND_CHECKS 100
+
+
+/************************************************
+* Local variables
+************************************************/
+TickType_t Test_Tick = 0;
+uint32_t Test_Random = 1;
+
+TickType_t Test_Due[TEST_PERIODS_NBR];
+uint32_t Test_Calls = 0;  // co-routine functions called, any state
+uint32_t Test_Runs = 0;
+uint32_t Test_Early = 0;
+uint32_t Test_Late = 0;
+
+List_t Test_EventList;
+bool Test_EventPosted = false;
+TickType_t Test_EventTick = 0;
+TickType_t Test_EventWaitStart = 0;
+uint32_t Test_Events = 0;
+uint32_t Test_EventsLate = 0;
+uint32_t Test_Timeouts = 0;
+uint32_t Test_TimeoutsWrong = 0;
+
+uint32_t Test_Schedules = 0;
+uint32_t Test_EmptySchedules = 0;
+uint32_t Test_Blocks = 0;
+uint32_t Test_BehindChecks = 0;
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: random_below
+* Description:   Repeatable random number
+* Parameters:    uint32_t limit
+* Return:        uint32_t - 0 .. limit - 1
+*************************************************************************/
+static uint32_t random_below(uint32_t limit) {
+  Test_Random = (Test_Random * 1664525) + 1013904223;
+  return (uint32_t)(((uint64_t)(Test_Random >> 8) * limit) >> 24);
+}
+
+
+/*************************************************************************
+* Function Name: delay_coroutine
+* Description:   Runs every TEST_PERIODS[uxIndex] ticks with crDELAY
+* Parameters:    CoRoutineHandle_t xHandle
+*                UBaseType_t uxIndex
+* Return:        void
+*************************************************************************/
+static void delay_coroutine(CoRoutineHandle_t xHandle, UBaseType_t uxIndex) {
+  Test_Calls++;
+
+  crSTART(xHandle);
+
+  for (;;) {
+    Test_Runs++;
+    if ((TickType_t)(Test_Tick - Test_Due[uxIndex]) > TEST_PERIODS[uxIndex]) {
+      Test_Early++;
+    }
+    else if (Test_Tick != Test_Due[uxIndex]) {
+      Test_Late++;
+    }
+    Test_Due[uxIndex] = Test_Tick + TEST_PERIODS[uxIndex];
+
+    crDELAY(xHandle, TEST_PERIODS[uxIndex]);
+  }
+
+  crEND();
+}
+
+
+/*************************************************************************
+* Function Name: event_coroutine
+* Description:   Waits on Test_EventList with a timeout, as
+*                crQUEUE_RECEIVE waits on a queue
+* Parameters:    CoRoutineHandle_t xHandle
+*                UBaseType_t uxIndex
+* Return:        void
+*************************************************************************/
+static void event_coroutine(CoRoutineHandle_t xHandle, UBaseType_t uxIndex) {
+  (void)uxIndex;
+  Test_Calls++;
+
+  crSTART(xHandle);
+
+  for (;;) {
+    Test_EventWaitStart = Test_Tick;
+    portDISABLE_INTERRUPTS();
+    vCoRoutineAddToDelayedList(TEST_EVENT_TIMEOUT, &Test_EventList);
+    portENABLE_INTERRUPTS();
+    crSET_STATE0(xHandle);
+
+    Test_Runs++;
+    if (Test_EventPosted) {
+      Test_Events++;
+      if (Test_Tick != Test_EventTick) {
+        Test_EventsLate++;
+      }
+      Test_EventPosted = false;
+    }
+    else {
+      Test_Timeouts++;
+      if (Test_Tick != (TickType_t)(Test_EventWaitStart + TEST_EVENT_TIMEOUT)) {
+        Test_TimeoutsWrong++;
+      }
+    }
+  }
+
+  crEND();
+}
+
+
+/*************************************************************************
+* Function Name: interrupt
+* Description:   I2C completion: ready the waiting co-routine
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void interrupt() {
+  if (listLIST_IS_EMPTY(&Test_EventList) == pdFALSE) {
+    (void)xCoRoutineRemoveFromEventList(&Test_EventList);
+    Test_EventPosted = true;
+    Test_EventTick = Test_Tick;
+  }
+}
+
+
+/*************************************************************************
+* Function Name: run
+* Description:   The CoRoutines task's loop for the given ticks
+* Parameters:    uint32_t ticks
+* Return:        void
+*************************************************************************/
+static void run(uint32_t ticks) {
+  TickType_t nextInterrupt = Test_Tick + 1 + random_below(TEST_INTERRUPT_GAP);
+
+  while (ticks > 0) {
+    uint32_t calls = Test_Calls;
+    TickType_t wait = 0;
+    bool interrupted = false;
+
+    vCoRoutineSchedule();
+    Test_Schedules++;
+    if (Test_Calls == calls) {
+      Test_EmptySchedules++;
+    }
+
+    wait = xCoRoutineGetTicksToNextWake();
+    if (wait == 0) {
+      continue;
+    }
+
+    // Ticks that pass before the call shorten the wait
+    if ((wait >= 2) && (Test_BehindChecks < TEST_BEHIND_CHECKS)) {
+      Test_BehindChecks++;
+      Test_Tick += 1;
+      HOST_TEST_CHECK_EQUAL(xCoRoutineGetTicksToNextWake(), wait - 1);
+      Test_Tick += wait - 1;
+      HOST_TEST_CHECK_EQUAL(xCoRoutineGetTicksToNextWake(), 0);
+      Test_Tick -= wait;
+    }
+
+    // ulTaskNotifyTake(pdTRUE, wait)
+    Test_Blocks++;
+    if ((TickType_t)(nextInterrupt - Test_Tick) <= wait) {
+      wait = nextInterrupt - Test_Tick;
+      interrupted = true;
+    }
+    if (wait > ticks) {
+      wait = ticks;
+      interrupted = false;
+    }
+    Test_Tick += wait;
+    ticks -= wait;
+
+    if (interrupted) {
+      interrupt();
+      nextInterrupt = Test_Tick + 1 + random_below(TEST_INTERRUPT_GAP);
+    }
+  }
+}
+
+
+/************************************************
+* Function definitions: kernel fakes
+************************************************/
+
+/*************************************************************************
+* Function Name: xTaskGetTickCount
+* Description:   Simulated tick count
+* Parameters:    N/A
+* Return:        TickType_t
+*************************************************************************/
+TickType_t xTaskGetTickCount(void) {
+  return Test_Tick;
+}
+
+
+/*************************************************************************
+* Function Name: pvPortMalloc / vPortFree
+* Description:   The C heap
+*************************************************************************/
+void* pvPortMalloc(size_t xSize) {
+  return malloc(xSize);
+}
+
+void vPortFree(void* pv) {
+  free(pv);
+}
+
+
+/*************************************************************************
+* Function Name: port critical sections and yield
+* Description:   One thread, nothing to mask
+*************************************************************************/
+void vPortEnterCritical(void) {
+}
+
+void vPortExitCritical(void) {
+}
+
+void vPortDisableInterrupts(void) {
+}
+
+void vPortEnableInterrupts(void) {
+}
+
+uint32_t ulPortSetInterruptMask(void) {
+  return 0;
+}
+
+void vPortClearInterruptMask(uint32_t ulNewMask) {
+  (void)ulNewMask;
+}
+
+void vPortYield(void) {
+}
+
+
+int main() {
+  uint32_t i = 0;
+
+  // Nothing to wake for before the first co-routine
+  HOST_TEST_CHECK_EQUAL(xCoRoutineGetTicksToNextWake(), portMAX_DELAY);
+
+  Test_Tick = (TickType_t)0 - TEST_BEFORE_OVERFLOW;
+  xCoRoutineTickCount = Test_Tick;
+  xLastTickCount = Test_Tick;
+
+  vListInitialise(&Test_EventList);
+  for (i = 0; i < TEST_PERIODS_NBR; ++i) {
+    Test_Due[i] = Test_Tick;
+    HOST_TEST_CHECK(xCoRoutineCreate(delay_coroutine, i % configMAX_CO_ROUTINE_PRIORITIES, i) == pdPASS);
+  }
+  HOST_TEST_CHECK(xCoRoutineCreate(event_coroutine, 0, TEST_EVENT_INDEX) == pdPASS);
+  HOST_TEST_CHECK_EQUAL(xCoRoutineGetTicksToNextWake(), 0);
+
+  run(TEST_RUN_TICKS);
+
+  HOST_TEST_CHECK_EQUAL(Test_Early, 0);
+  HOST_TEST_CHECK_EQUAL(Test_Late, 0);
+  HOST_TEST_CHECK_EQUAL(Test_EventsLate, 0);
+  HOST_TEST_CHECK_EQUAL(Test_TimeoutsWrong, 0);
+  HOST_TEST_CHECK_EQUAL(Test_EmptySchedules, 0);
+  HOST_TEST_CHECK(Test_Events > 0);
+  HOST_TEST_CHECK(Test_Timeouts > 0);
+  HOST_TEST_CHECK_EQUAL(Test_BehindChecks, TEST_BEHIND_CHECKS);
+
+  // The 2 tick co-routine alone runs TEST_RUN_TICKS / 2 times
+  HOST_TEST_CHECK(Test_Runs > (TEST_RUN_TICKS / 2));
+  HOST_TEST_CHECK_EQUAL(Test_Schedules, Test_Calls);
+
+  printf("CoRoutines: %u co-routine runs, %u events and %u timeouts in %u ticks; "
+         "%u schedule calls, %u blocks\n",
+         Test_Runs, Test_Events, Test_Timeouts, TEST_RUN_TICKS, Test_Schedules, Test_Blocks);
+
+  return HostTest_Result("CoRoutines");
+}
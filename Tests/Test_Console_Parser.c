@@ -0,0 +1,312 @@
+/**
+* @Filename: Test_Console_Parser.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [4:20pm]
+* @Version:  1.0.0
+*
+* @Description: Host test of Tasks/Console_Parser.c. Scripted input is
+*               received one character at a time from a simulated UART
+*               and handled as Task_Console does, against a command table
+*               that records the arguments each handler is given.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Tasks/Console_Parser.h"
+
+#include "Host_Test.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+// Lines kept per script
+#define TEST_MAX_RESULTS 16
+
+
+/************************************************
+* Local variables
+************************************************/
+// Simulated UART receiver
+const char* Test_Uart = NULL;
+
+// Arguments of the last handler call
+int Test_Argc = 0;
+char Test_Argv[CONSOLE_MAX_ARGS][CONSOLE_LINE_SIZE];
+uint32_t Test_Calls = 0;
+
+// Results of the lines of one script
+Console_Result Test_Results[TEST_MAX_RESULTS];
+uint32_t Test_ResultsNbr = 0;
+
+Console_LineEditor Test_Editor;
+
+
+/************************************************
+* Local function declarations
+************************************************/
+static bool handler_echo(int argc, char* argv[]);
+static bool handler_needs_two(int argc, char* argv[]);
+
+
+/************************************************
+* Local command table
+************************************************/
+const Console_Command TEST_COMMANDS[] = {
+  { "echo", "echo [<word>...]", handler_echo },
+  { "pair", "pair <a> <b>", handler_needs_two }
+};
+#define TEST_COMMANDS_NBR (sizeof(TEST_COMMANDS) / sizeof(TEST_COMMANDS[0]))
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: record
+* Description:   Keep a handler's arguments
+* Parameters:    int argc
+*                char* argv[]
+* Return:        void
+*************************************************************************/
+static void record(int argc, char* argv[]) {
+  int i = 0;
+
+  Test_Calls++;
+  Test_Argc = argc;
+  for (i = 0; i < argc; ++i) {
+    snprintf(Test_Argv[i], CONSOLE_LINE_SIZE, "%s", argv[i]);
+  }
+}
+
+
+/*************************************************************************
+* Function Name: handler_echo
+* Description:   Accepts any arguments
+* Parameters:    int argc
+*                char* argv[]
+* Return:        bool
+*************************************************************************/
+static bool handler_echo(int argc, char* argv[]) {
+  record(argc, argv);
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: handler_needs_two
+* Description:   Accepts exactly two arguments
+* Parameters:    int argc
+*                char* argv[]
+* Return:        bool
+*************************************************************************/
+static bool handler_needs_two(int argc, char* argv[]) {
+  record(argc, argv);
+  return argc == 3;
+}
+
+
+/*************************************************************************
+* Function Name: uart_getc
+* Description:   Simulated receiver: the next scripted character
+* Parameters:    char* pcChar
+* Return:        bool - false once the script is used up
+*************************************************************************/
+static bool uart_getc(char* pcChar) {
+  if ((Test_Uart == NULL) || (*Test_Uart == '\0')) {
+    return false;
+  }
+  *pcChar = *Test_Uart++;
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: receive
+* Description:   Task_Console's loop over a script
+* Parameters:    const char* script
+* Return:        void
+*************************************************************************/
+static void receive(const char* script) {
+  char ch;
+
+  Test_Uart = script;
+  Test_ResultsNbr = 0;
+  Test_Calls = 0;
+  Test_Argc = 0;
+  Host_Log_Line[0] = '\0';
+
+  while (uart_getc(&ch)) {
+    if (ConsoleParser_Putc(&Test_Editor, ch)) {
+      Console_Result result = ConsoleParser_Execute(&Test_Editor, TEST_COMMANDS, TEST_COMMANDS_NBR);
+
+      if (Test_ResultsNbr < TEST_MAX_RESULTS) {
+        Test_Results[Test_ResultsNbr++] = result;
+      }
+    }
+  }
+}
+
+
+/*************************************************************************
+* Function Name: test_arguments
+* Description:   Splitting at spaces and tabs, empty lines, CR LF
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_arguments() {
+  receive("echo  one\ttwo   three \r");
+  HOST_TEST_CHECK_EQUAL(Test_ResultsNbr, 1);
+  HOST_TEST_CHECK_EQUAL(Test_Results[0], CONSOLE_DONE);
+  HOST_TEST_CHECK_EQUAL(Test_Argc, 4);
+  HOST_TEST_CHECK(strcmp(Test_Argv[0], "echo") == 0);
+  HOST_TEST_CHECK(strcmp(Test_Argv[1], "one") == 0);
+  HOST_TEST_CHECK(strcmp(Test_Argv[2], "two") == 0);
+  HOST_TEST_CHECK(strcmp(Test_Argv[3], "three") == 0);
+
+  // CR LF is a line and an empty line; blank lines run nothing
+  receive("echo a\r\n   \t\n\n");
+  HOST_TEST_CHECK_EQUAL(Test_ResultsNbr, 4);
+  HOST_TEST_CHECK_EQUAL(Test_Results[0], CONSOLE_DONE);
+  HOST_TEST_CHECK_EQUAL(Test_Results[1], CONSOLE_EMPTY);
+  HOST_TEST_CHECK_EQUAL(Test_Results[2], CONSOLE_EMPTY);
+  HOST_TEST_CHECK_EQUAL(Test_Results[3], CONSOLE_EMPTY);
+  HOST_TEST_CHECK_EQUAL(Test_Calls, 1);
+
+  // Input without a line end waits for the rest of the line
+  receive("echo par");
+  HOST_TEST_CHECK_EQUAL(Test_ResultsNbr, 0);
+  receive("tial\r");
+  HOST_TEST_CHECK_EQUAL(Test_Argc, 2);
+  HOST_TEST_CHECK(strcmp(Test_Argv[1], "partial") == 0);
+}
+
+
+/*************************************************************************
+* Function Name: test_backspace
+* Description:   Backspace and DEL edit the line
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_backspace() {
+  receive("ecx\bho abd\x7F" "c\r");
+  HOST_TEST_CHECK_EQUAL(Test_Results[0], CONSOLE_DONE);
+  HOST_TEST_CHECK_EQUAL(Test_Argc, 2);
+  HOST_TEST_CHECK(strcmp(Test_Argv[1], "abc") == 0);
+
+  // Backspace on an empty line does nothing
+  receive("\b\b\becho\r");
+  HOST_TEST_CHECK_EQUAL(Test_Results[0], CONSOLE_DONE);
+  HOST_TEST_CHECK_EQUAL(Test_Argc, 1);
+
+  // Erasing the whole line leaves an empty line
+  receive("ab\b\b\r");
+  HOST_TEST_CHECK_EQUAL(Test_Results[0], CONSOLE_EMPTY);
+}
+
+
+/*************************************************************************
+* Function Name: test_long_lines
+* Description:   A line that fits exactly runs; one character more is
+*                refused, backspace or not, and the next line runs
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_long_lines() {
+  char script[3 * CONSOLE_LINE_SIZE];
+  uint32_t length = 0;
+
+  // echo and a word, CONSOLE_LINE_SIZE - 1 characters in all
+  length = (uint32_t)snprintf(script, sizeof(script), "echo ");
+  while (length < (CONSOLE_LINE_SIZE - 1)) {
+    script[length++] = 'x';
+  }
+  script[length] = '\0';
+  strcat(script, "\r");
+  receive(script);
+  HOST_TEST_CHECK_EQUAL(Test_Results[0], CONSOLE_DONE);
+  HOST_TEST_CHECK_EQUAL(strlen(Test_Argv[1]), CONSOLE_LINE_SIZE - 1 - 5);
+
+  // One more, even if erased again, is refused and the command not run
+  script[length] = '\0';
+  strcat(script, "y\b\rpair a b\r");
+  receive(script);
+  HOST_TEST_CHECK_EQUAL(Test_ResultsNbr, 2);
+  HOST_TEST_CHECK_EQUAL(Test_Results[0], CONSOLE_TOO_LONG);
+  HOST_TEST_CHECK(strstr(Host_Log_Line, "usage") == NULL);
+  HOST_TEST_CHECK_EQUAL(Test_Results[1], CONSOLE_DONE);
+  HOST_TEST_CHECK_EQUAL(Test_Calls, 1);
+  HOST_TEST_CHECK(strcmp(Test_Argv[0], "pair") == 0);
+}
+
+
+/*************************************************************************
+* Function Name: test_argument_count
+* Description:   CONSOLE_MAX_ARGS words run; one more is refused rather
+*                than the last one dropped
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_argument_count() {
+  receive("echo 1 2 3 4 5 6 7\r");
+  HOST_TEST_CHECK_EQUAL(Test_Results[0], CONSOLE_DONE);
+  HOST_TEST_CHECK_EQUAL(Test_Argc, CONSOLE_MAX_ARGS);
+  HOST_TEST_CHECK(strcmp(Test_Argv[CONSOLE_MAX_ARGS - 1], "7") == 0);
+
+  receive("echo 1 2 3 4 5 6 7 8\r");
+  HOST_TEST_CHECK_EQUAL(Test_Results[0], CONSOLE_TOO_MANY_ARGS);
+  HOST_TEST_CHECK_EQUAL(Test_Calls, 0);
+  HOST_TEST_CHECK(strstr(Host_Log_Line, "more than 8 arguments") != NULL);
+
+  // Trailing spaces are not an argument
+  receive("echo 1 2 3 4 5 6 7      \r");
+  HOST_TEST_CHECK_EQUAL(Test_Results[0], CONSOLE_DONE);
+}
+
+
+/*************************************************************************
+* Function Name: test_errors
+* Description:   Usage and unknown command messages
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_errors() {
+  receive("pair a\r");
+  HOST_TEST_CHECK_EQUAL(Test_Results[0], CONSOLE_USAGE);
+  HOST_TEST_CHECK_EQUAL(Test_Calls, 1);
+  HOST_TEST_CHECK(strcmp(Host_Log_Line, "usage: pair <a> <b>\n") == 0);
+
+  receive("pair a b c\r");
+  HOST_TEST_CHECK_EQUAL(Test_Results[0], CONSOLE_USAGE);
+
+  receive("pairs a b\r");
+  HOST_TEST_CHECK_EQUAL(Test_Results[0], CONSOLE_UNKNOWN);
+  HOST_TEST_CHECK_EQUAL(Test_Calls, 0);
+  HOST_TEST_CHECK(strcmp(Host_Log_Line, "unknown command: pairs, try help\n") == 0);
+
+  // Commands are case sensitive
+  receive("ECHO\r");
+  HOST_TEST_CHECK_EQUAL(Test_Results[0], CONSOLE_UNKNOWN);
+}
+
+
+int main() {
+  ConsoleParser_Reset(&Test_Editor);
+
+  test_arguments();
+  test_backspace();
+  test_long_lines();
+  test_argument_count();
+  test_errors();
+
+  return HostTest_Result("Console_Parser");
+}
@@ -0,0 +1,259 @@
+/**
+* @Filename: Test_Critical_Monitor.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [8:00pm]
+* @Version:  1.0.0
+*
+* @Description: Host test of Drivers/Critical_Monitor.c.
+*
+*               CriticalMonitor_Begin and CriticalMonitor_End are called
+*               as the port calls them, with the fake cycle counter moved
+*               between them. The call site table is read back through
+*               the "critical" console output, which the test captures
+*               line by line.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Drivers/CycleCounter.h"
+#include "Drivers/Critical_Monitor.h"
+
+#include "Tasks/Latency_Histogram.h"
+#include "Tasks/Log.h"
+#include "Tasks/Metrics.h"
+
+#include "FreeRTOS.h"
+#include "Host_Test.h"
+#include "task.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+#define TEST_LINES     32
+#define TEST_LINE_SIZE 128
+
+// Call sites as __FILE__ gives them
+static const char TEST_QUEUE[] = "../Source/queue.c";
+static const char TEST_TASKS[] = "C:\\ccs\\Source\\tasks.c";
+static const char TEST_REPORT[] = "Tasks/Task_ReportData.c";
+
+
+/************************************************
+* Local variables
+************************************************/
+volatile TickType_t Host_TickCount = 0;
+volatile uint32_t CycleCounter_Host = 0;
+
+// Console output since the last clear
+char Test_Lines[TEST_LINES][TEST_LINE_SIZE];
+uint32_t Test_Lines_Nbr = 0;
+
+// Recorded by the module
+extern LatencyHistogram CriticalMonitor_Histogram;
+extern Metrics_Metric CriticalMonitor_Max;
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: masked
+* Description:   Interrupts masked at file:line for cycles
+* Parameters:    const char* file
+*                uint32_t line
+*                uint32_t cycles
+* Return:        void
+*************************************************************************/
+static void masked(const char* file, uint32_t line, uint32_t cycles) {
+  CriticalMonitor_Begin(file, line);
+  CycleCounter_Host += cycles;
+  CriticalMonitor_End();
+  CycleCounter_Host += 1000;
+}
+
+
+/*************************************************************************
+* Function Name: print
+* Description:   Capture the "critical" output
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void print() {
+  Test_Lines_Nbr = 0;
+  CriticalMonitor_Print();
+}
+
+
+/*************************************************************************
+* Function Name: test_uninitialized
+* Description:   Nothing is counted before the monitor is initialized
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_uninitialized() {
+  masked(TEST_QUEUE, 100, 500);
+  HOST_TEST_CHECK_EQUAL(CriticalMonitor_Histogram.count, 0);
+
+  CriticalMonitor_Initialization();
+  print();
+  HOST_TEST_CHECK_EQUAL(Test_Lines_Nbr, 1);
+  HOST_TEST_CHECK_EQUAL(CriticalMonitor_Histogram.count, 0);
+  HOST_TEST_CHECK_EQUAL(CriticalMonitor_Max.value, 0);
+}
+
+
+/*************************************************************************
+* Function Name: test_sites
+* Description:   Periods are counted per call site and printed worst
+*                first, with the directories taken off the file
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_sites() {
+  CriticalMonitor_Reset();
+
+  masked(TEST_QUEUE, 100, 240);
+  masked(TEST_TASKS, 200, 3600);
+  masked(TEST_QUEUE, 100, 600);
+  masked(TEST_REPORT, 300, 40);
+  masked(TEST_QUEUE, 101, 1200);
+  masked(TEST_QUEUE, 100, 360);
+
+  print();
+  HOST_TEST_CHECK_EQUAL(Test_Lines_Nbr, 5);
+  HOST_TEST_CHECK(strcmp(Test_Lines[0], "site,count,max cycles,max us,mean cycles\n") == 0);
+  HOST_TEST_CHECK(strcmp(Test_Lines[1], "tasks.c:200,1,3600,30,3600\n") == 0);
+  HOST_TEST_CHECK(strcmp(Test_Lines[2], "queue.c:101,1,1200,10,1200\n") == 0);
+  HOST_TEST_CHECK(strcmp(Test_Lines[3], "queue.c:100,3,600,5,400\n") == 0);
+  HOST_TEST_CHECK(strcmp(Test_Lines[4], "Task_ReportData.c:300,1,40,0,40\n") == 0);
+
+  // Every period is in the histogram and the gauge
+  HOST_TEST_CHECK_EQUAL(CriticalMonitor_Histogram.count, 6);
+  HOST_TEST_CHECK_EQUAL(CriticalMonitor_Histogram.min, 40);
+  HOST_TEST_CHECK_EQUAL(CriticalMonitor_Histogram.max, 3600);
+  HOST_TEST_CHECK_EQUAL(CriticalMonitor_Histogram.total, 240 + 3600 + 600 + 40 + 1200 + 360);
+  HOST_TEST_CHECK_EQUAL(CriticalMonitor_Histogram.buckets[LatencyHistogram_BucketIndex(3600)], 1);
+  HOST_TEST_CHECK_EQUAL(CriticalMonitor_Histogram.buckets[LatencyHistogram_BucketIndex(40)], 1);
+  HOST_TEST_CHECK_EQUAL(CriticalMonitor_Max.value, 3600);
+
+  // An unmask with no masked period open, as when the mask was set
+  // before the scheduler started, is not counted
+  CriticalMonitor_End();
+  HOST_TEST_CHECK_EQUAL(CriticalMonitor_Histogram.count, 6);
+
+  // A period across the cycle counter wrap
+  CycleCounter_Host = 0xFFFFFFFF - 100;
+  masked(TEST_REPORT, 300, 300);
+  print();
+  HOST_TEST_CHECK(strcmp(Test_Lines[4], "Task_ReportData.c:300,2,300,2,170\n") == 0);
+}
+
+
+/*************************************************************************
+* Function Name: test_full
+* Description:   Sites past CRITICAL_MONITOR_SITES are counted as
+*                "other"; only the CRITICAL_MONITOR_PRINTED_SITES worst
+*                are printed
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_full() {
+  char expected[TEST_LINE_SIZE];
+  uint32_t line = 0;
+  uint32_t i = 0;
+
+  CriticalMonitor_Reset();
+
+  // Lines 1 .. 40 for line * 10 cycles; the first CRITICAL_MONITOR_SITES
+  // fill the table
+  for (line = 1; line <= (CRITICAL_MONITOR_SITES + 8); ++line) {
+    masked(TEST_QUEUE, line, line * 10);
+  }
+
+  // A site in the table is still found when it is full
+  masked(TEST_QUEUE, 1, 5);
+
+  print();
+  HOST_TEST_CHECK_EQUAL(Test_Lines_Nbr, 1 + CRITICAL_MONITOR_PRINTED_SITES + 1);
+  for (i = 0; i < CRITICAL_MONITOR_PRINTED_SITES; ++i) {
+    line = CRITICAL_MONITOR_SITES - i;
+    snprintf(expected, sizeof(expected), "queue.c:%u,1,%u,%u,%u\n", line, line * 10,
+             (line * 10) / CYCLECOUNTER_CYCLES_PER_US, line * 10);
+    HOST_TEST_CHECK(strcmp(Test_Lines[1 + i], expected) == 0);
+  }
+
+  // Lines 33 .. 40
+  HOST_TEST_CHECK(strcmp(Test_Lines[1 + CRITICAL_MONITOR_PRINTED_SITES], "other,8,400,3,365\n") == 0);
+  HOST_TEST_CHECK_EQUAL(CriticalMonitor_Histogram.count, CRITICAL_MONITOR_SITES + 8 + 1);
+  HOST_TEST_CHECK_EQUAL(CriticalMonitor_Histogram.min, 5);
+
+  // Reset forgets everything
+  CriticalMonitor_Reset();
+  print();
+  HOST_TEST_CHECK_EQUAL(Test_Lines_Nbr, 1);
+  HOST_TEST_CHECK_EQUAL(CriticalMonitor_Histogram.count, 0);
+  HOST_TEST_CHECK_EQUAL(CriticalMonitor_Max.value, 0);
+
+  masked(TEST_TASKS, 7, 70);
+  print();
+  HOST_TEST_CHECK_EQUAL(Test_Lines_Nbr, 2);
+  HOST_TEST_CHECK(strcmp(Test_Lines[1], "tasks.c:7,1,70,0,70\n") == 0);
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: CycleCounter_Initialization
+* Description:   Nothing to enable on the host
+* Parameters:    N/A
+* Return:        uint32_t (1)
+*************************************************************************/
+extern uint32_t CycleCounter_Initialization() {
+  return (1);
+}
+
+
+/*************************************************************************
+* Function Name: Log_Printf
+* Description:   Capture the line in Test_Lines
+* Parameters:    const char* format
+*                ...
+* Return:        void
+*************************************************************************/
+extern void Log_Printf(const char* format, ...) {
+  va_list args;
+
+  if (Test_Lines_Nbr >= TEST_LINES) {
+    Test_Lines_Nbr++;
+    return;
+  }
+
+  va_start(args, format);
+  vsnprintf(Test_Lines[Test_Lines_Nbr], TEST_LINE_SIZE, format, args);
+  va_end(args);
+
+  Test_Lines_Nbr++;
+}
+
+
+int main() {
+  test_uninitialized();
+  test_sites();
+  test_full();
+
+  return HostTest_Result("Critical_Monitor");
+}
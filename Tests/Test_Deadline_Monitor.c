@@ -0,0 +1,225 @@
+/**
+* @Filename: Test_Deadline_Monitor.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [10:30am]
+* @Version:  1.0.0
+*
+* @Description: Host tests of Tasks/Deadline_Monitor.c: late, missed and
+*               overrun jobs on a simulated tick and cycle count, alert
+*               rate limiting, a full monitor list and the printed summary.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Drivers/CycleCounter.h"
+#include "Drivers/Timestamp.h"
+
+#include "Tasks/Deadline_Monitor.h"
+#include "Tasks/Task_ReportData.h"
+
+#include "FreeRTOS.h"
+#include "Host_Test.h"
+#include "task.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+#define TEST_PERIOD   10
+#define TEST_DEADLINE 8
+
+
+/************************************************
+* Local variables
+************************************************/
+DeadlineMonitor Test_Monitor;
+DeadlineMonitor Test_Others[DEADLINE_MONITOR_MAX_MONITORS];
+
+// Records sent by the monitor
+ReportData_Item Test_Alert;
+uint32_t Test_Alerts = 0;
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: run_job
+* Description:   One job due at release, started after startDelay ticks,
+*                taking ticks and cycles to finish
+* Parameters:    uint32_t release
+*                uint32_t startDelay
+*                uint32_t ticks
+*                uint32_t cycles
+* Return:        void
+*************************************************************************/
+static void run_job(uint32_t release, uint32_t startDelay, uint32_t ticks, uint32_t cycles) {
+  Host_TickCount = release + startDelay;
+  DeadlineMonitor_Start(&Test_Monitor, release);
+  Host_TickCount += ticks;
+  CycleCounter_Host += cycles;
+  DeadlineMonitor_Finish(&Test_Monitor);
+}
+
+
+/*************************************************************************
+* Function Name: test_on_time
+* Description:   Jobs within their deadline count nothing and alert
+*                nobody
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_on_time() {
+  HOST_TEST_CHECK(DeadlineMonitor_Init(&Test_Monitor, "test", TEST_PERIOD, TEST_DEADLINE));
+  HOST_TEST_CHECK_EQUAL(Test_Monitor.index, 0);
+
+  run_job(100, 0, 2, 1000);
+  run_job(110, 1, 7, 1000);   // finishes exactly at the deadline
+
+  HOST_TEST_CHECK_EQUAL(Test_Monitor.jobs, 2);
+  HOST_TEST_CHECK_EQUAL(Test_Monitor.late, 0);
+  HOST_TEST_CHECK_EQUAL(Test_Monitor.misses, 0);
+  HOST_TEST_CHECK_EQUAL(Test_Monitor.overruns, 0);
+  HOST_TEST_CHECK_EQUAL(Test_Monitor.startDelayMax, 1);
+  HOST_TEST_CHECK_EQUAL(Test_Monitor.responseMax, 8);
+  HOST_TEST_CHECK_EQUAL(Test_Alerts, 0);
+}
+
+
+/*************************************************************************
+* Function Name: test_misses
+* Description:   A job past its deadline is missed, one starting a
+*                period late is late too, one taking more than a period
+*                of cycles overruns. Only the first failure within
+*                DEADLINE_MONITOR_ALERT_TICKS sends an alert, carrying the
+*                totals.
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_misses() {
+  run_job(200, 0, 9, 1000);
+  HOST_TEST_CHECK_EQUAL(Test_Monitor.misses, 1);
+  HOST_TEST_CHECK_EQUAL(Test_Alerts, 1);
+  HOST_TEST_CHECK_EQUAL(Test_Alert.ReportName, ReportName_DeadlineMiss);
+  HOST_TEST_CHECK_EQUAL(Test_Alert.ReportValue_0, 0);
+  HOST_TEST_CHECK_EQUAL(Test_Alert.ReportValue_2, 1);
+
+  // A period late: late and missed, within the alert interval
+  run_job(210, TEST_PERIOD, 1, 1000);
+  HOST_TEST_CHECK_EQUAL(Test_Monitor.late, 1);
+  HOST_TEST_CHECK_EQUAL(Test_Monitor.misses, 2);
+  HOST_TEST_CHECK_EQUAL(Test_Alerts, 1);
+
+  // More than a period of cycles, on time
+  run_job(230, 0, 1, TEST_PERIOD * TIMESTAMP_COUNTS_PER_TICK + 1);
+  HOST_TEST_CHECK_EQUAL(Test_Monitor.overruns, 1);
+  HOST_TEST_CHECK_EQUAL(Test_Monitor.misses, 2);
+  HOST_TEST_CHECK_EQUAL(Test_Alerts, 1);
+
+  // Once the interval has passed the next failure alerts with the totals
+  run_job(230 + DEADLINE_MONITOR_ALERT_TICKS, 0, TEST_DEADLINE + 1, 1000);
+  HOST_TEST_CHECK_EQUAL(Test_Alerts, 2);
+  HOST_TEST_CHECK_EQUAL(Test_Alert.ReportValue_1, 1);
+  HOST_TEST_CHECK_EQUAL(Test_Alert.ReportValue_2, 3);
+  HOST_TEST_CHECK_EQUAL(Test_Alert.ReportValue_3, 1);
+
+  // A tick count wrap between release and finish is not a miss
+  run_job(0xFFFFFFFE, 0, 4, 1000);
+  HOST_TEST_CHECK_EQUAL(Test_Monitor.misses, 3);
+
+  DeadlineMonitor_ResetAll();
+  HOST_TEST_CHECK_EQUAL(Test_Monitor.jobs, 0);
+  HOST_TEST_CHECK_EQUAL(Test_Monitor.misses, 0);
+}
+
+
+/*************************************************************************
+* Function Name: test_full_list
+* Description:   A monitor that does not fit is reported and not indexed;
+*                initializing a listed monitor again keeps its index
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_full_list() {
+  uint32_t i = 0;
+
+  for (i = 0; i < (DEADLINE_MONITOR_MAX_MONITORS - 1); ++i) {
+    HOST_TEST_CHECK(DeadlineMonitor_Init(&Test_Others[i], "other", TEST_PERIOD, TEST_DEADLINE));
+    HOST_TEST_CHECK_EQUAL(Test_Others[i].index, i + 1);
+  }
+
+  HOST_TEST_CHECK(!DeadlineMonitor_Init(&Test_Others[i], "extra", TEST_PERIOD, TEST_DEADLINE));
+  HOST_TEST_CHECK_EQUAL(Test_Others[i].index, DEADLINE_MONITOR_NO_INDEX);
+
+  HOST_TEST_CHECK(DeadlineMonitor_Init(&Test_Monitor, "test", TEST_PERIOD, TEST_DEADLINE));
+  HOST_TEST_CHECK_EQUAL(Test_Monitor.index, 0);
+
+  // The unlisted monitor still counts its jobs
+  Host_TickCount = 1000;
+  DeadlineMonitor_Start(&Test_Others[i], 1000);
+  Host_TickCount += TEST_DEADLINE + 1;
+  DeadlineMonitor_Finish(&Test_Others[i]);
+  HOST_TEST_CHECK_EQUAL(Test_Others[i].misses, 1);
+  HOST_TEST_CHECK_EQUAL((uint32_t)Test_Alert.ReportValue_0, DEADLINE_MONITOR_NO_INDEX);
+}
+
+
+/*************************************************************************
+* Function Name: test_print
+* Description:   A header and a line per listed monitor, times in us
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_print() {
+  uint32_t lines = Host_Log_Lines;
+
+  DeadlineMonitor_PrintAll();
+  HOST_TEST_CHECK_EQUAL(Host_Log_Lines - lines, DEADLINE_MONITOR_MAX_MONITORS + 1);
+  HOST_TEST_CHECK(strncmp(Host_Log_Line, "other,3,1000,800,0,", 19) == 0);
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: ReportData_Stamp
+* Description:   Host stub, clears the record
+* Parameters:    ReportData_Item* theReport
+* Return:        void
+*************************************************************************/
+extern void ReportData_Stamp(ReportData_Item* theReport) {
+  memset(theReport, 0, sizeof(ReportData_Item));
+}
+
+
+/*************************************************************************
+* Function Name: ReportData_Send
+* Description:   Host stub, keeps the record in Test_Alert
+* Parameters:    const ReportData_Item* theReport
+* Return:        BaseType_t (pdPASS)
+*************************************************************************/
+extern BaseType_t ReportData_Send(const ReportData_Item* theReport) {
+  Test_Alert = *theReport;
+  Test_Alerts++;
+  return pdPASS;
+}
+
+
+int main() {
+  test_on_time();
+  test_misses();
+  test_full_list();
+  test_print();
+
+  return HostTest_Result("Deadline_Monitor");
+}
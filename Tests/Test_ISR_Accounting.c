@@ -0,0 +1,475 @@
+/**
+* @Filename: Test_ISR_Accounting.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [7:30pm]
+* @Version:  1.0.0
+*
+* @Description: Host test of Drivers/ISR_Accounting.c, the nesting and
+*               self time arithmetic of ISRAccounting_Dispatch.
+*
+*               IntTrigger stands in for the NVIC and the trampoline: it
+*               sets VECTACTIVE and runs ISRAccounting_Dispatch at once,
+*               so a handler that triggers another interrupt is preempted
+*               by it. Handlers let time pass by adding to the fake cycle
+*               counter. Every cycle must be charged to exactly one
+*               handler: its self time, never also to the handler it
+*               preempted.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "inc/hw_ints.h"
+
+#include "driverlib/interrupt.h"
+
+#include "Drivers/CycleCounter.h"
+#include "Drivers/ISR_Accounting.h"
+#include "Drivers/Timestamp.h"
+
+#include "FreeRTOS.h"
+#include "Host_Test.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+// Vectors of the test handlers
+#define TEST_OUTER 40
+#define TEST_INNER 41
+#define TEST_THIRD 42
+#define TEST_DEEP  43
+#define TEST_LOAD  44
+
+// Levels the deep handler nests, two more than are accounted
+#define TEST_DEEP_LEVELS (ISR_ACCOUNTING_MAX_DEPTH + 2)
+
+// Word of an exception frame holding the PC
+#define TEST_FRAME_PC 6
+
+
+/************************************************
+* Local variables
+************************************************/
+volatile uint32_t ISRAccounting_Host_ICSR = 0;
+uint64_t Test_Ns = 0;
+
+// Accounting state, not exported by the module
+extern volatile uint32_t ISRAccounting_Depth;
+extern uint32_t ISRAccounting_Preempted[ISR_ACCOUNTING_MAX_DEPTH];
+extern void ISR_Accounting_Trampoline(void);
+extern void xPortSysTickHandler(void);
+
+// The vector table
+void (*Test_Vectors[NUM_INTERRUPTS])(void);
+
+// Exception frames, one per vector, with the interrupted PC
+uint32_t Test_Frames[NUM_INTERRUPTS][8];
+
+// What the handlers are to do, and what they saw
+uint32_t Test_OuterBefore = 0;
+uint32_t Test_OuterAfter = 0;
+uint32_t Test_OuterNested = 0;  // inner interrupts the outer handler triggers
+uint32_t Test_InnerCycles = 0;
+bool Test_InnerTriggersThird = false;
+uint32_t Test_ThirdCycles = 0;
+uint32_t Test_DeepLevel = 0;
+uint32_t Test_DeepCalls = 0;
+uint32_t Test_OuterPC = 0;
+uint32_t Test_InnerPC = 0;
+uint32_t Test_OuterPCAfter = 0;
+uint32_t Test_PreemptedSeen = 0;
+
+ISRAccounting_Vector Test_Outer = ISR_ACCOUNTING_VECTOR("outer");
+ISRAccounting_Vector Test_Inner = ISR_ACCOUNTING_VECTOR("inner");
+ISRAccounting_Vector Test_Third = ISR_ACCOUNTING_VECTOR("third");
+ISRAccounting_Vector Test_Deep = ISR_ACCOUNTING_VECTOR("deep");
+ISRAccounting_Vector Test_Load = ISR_ACCOUNTING_VECTOR("load");
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: handler_outer
+* Description:   Runs Test_OuterBefore cycles, is preempted
+*                Test_OuterNested times by the inner interrupt, then runs
+*                Test_OuterAfter cycles
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void handler_outer(void) {
+  uint32_t i = 0;
+
+  Test_OuterPC = ISRAccounting_InterruptedPC();
+  CycleCounter_Host += Test_OuterBefore;
+  for (i = 0; i < Test_OuterNested; ++i) {
+    IntTrigger(TEST_INNER);
+  }
+  Test_PreemptedSeen = ISRAccounting_Preempted[ISRAccounting_Depth - 1];
+  Test_OuterPCAfter = ISRAccounting_InterruptedPC();
+  CycleCounter_Host += Test_OuterAfter;
+}
+
+
+/*************************************************************************
+* Function Name: handler_inner
+* Description:   Runs Test_InnerCycles cycles, split around the third
+*                interrupt if Test_InnerTriggersThird
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void handler_inner(void) {
+  Test_InnerPC = ISRAccounting_InterruptedPC();
+  CycleCounter_Host += Test_InnerCycles / 2;
+  if (Test_InnerTriggersThird) {
+    IntTrigger(TEST_THIRD);
+  }
+  CycleCounter_Host += Test_InnerCycles - (Test_InnerCycles / 2);
+}
+
+
+/*************************************************************************
+* Function Name: handler_third
+* Description:   Runs Test_ThirdCycles cycles
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void handler_third(void) {
+  CycleCounter_Host += Test_ThirdCycles;
+}
+
+
+/*************************************************************************
+* Function Name: handler_deep
+* Description:   One cycle, preempted by itself down to TEST_DEEP_LEVELS,
+*                then one more cycle
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void handler_deep(void) {
+  Test_DeepCalls++;
+  CycleCounter_Host += 1;
+  if (++Test_DeepLevel < TEST_DEEP_LEVELS) {
+    IntTrigger(TEST_DEEP);
+  }
+  CycleCounter_Host += 1;
+}
+
+
+/*************************************************************************
+* Function Name: handler_load
+* Description:   1200 cycles, 10 us
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void handler_load(void) {
+  CycleCounter_Host += 1200;
+}
+
+
+/*************************************************************************
+* Function Name: reset
+* Description:   Zero the counts of every test vector
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void reset() {
+  ISRAccounting_Vector* entries[] = { &Test_Outer, &Test_Inner, &Test_Third, &Test_Deep, &Test_Load };
+  uint32_t i = 0;
+
+  for (i = 0; i < (sizeof(entries) / sizeof(entries[0])); ++i) {
+    entries[i]->calls.value = 0;
+    entries[i]->cycles.value = 0;
+    entries[i]->maxCycles.value = 0;
+    entries[i]->totalCycles = 0;
+    entries[i]->nested = 0;
+    entries[i]->printedCycles = 0;
+  }
+
+  Test_OuterNested = 0;
+  Test_InnerTriggersThird = false;
+}
+
+
+/*************************************************************************
+* Function Name: test_single
+* Description:   An interrupt that nothing preempts is charged its whole
+*                time
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_single() {
+  reset();
+  Test_OuterBefore = 300;
+  Test_OuterAfter = 200;
+
+  IntTrigger(TEST_OUTER);
+  Test_OuterBefore = 1000;
+  IntTrigger(TEST_OUTER);
+
+  HOST_TEST_CHECK_EQUAL(Test_Outer.calls.value, 2);
+  HOST_TEST_CHECK_EQUAL(Test_Outer.totalCycles, 500 + 1200);
+  HOST_TEST_CHECK_EQUAL(Test_Outer.cycles.value, 500 + 1200);
+  HOST_TEST_CHECK_EQUAL(Test_Outer.maxCycles.value, 1200);
+  HOST_TEST_CHECK_EQUAL(Test_Outer.nested, 0);
+  HOST_TEST_CHECK_EQUAL(ISRAccounting_Depth, 0);
+  HOST_TEST_CHECK_EQUAL(Test_PreemptedSeen, 0);
+
+  // The handler sees the PC its own interrupt was taken at
+  HOST_TEST_CHECK_EQUAL(Test_OuterPC, Test_Frames[TEST_OUTER][TEST_FRAME_PC]);
+  HOST_TEST_CHECK_EQUAL(ISRAccounting_InterruptedPC(), 0);
+}
+
+
+/*************************************************************************
+* Function Name: test_nested
+* Description:   Time in a preempting interrupt is its own, not the
+*                preempted one's, through three levels and twice at one
+*                level
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_nested() {
+  uint32_t start = 0;
+
+  reset();
+  Test_OuterBefore = 100;
+  Test_OuterAfter = 50;
+  Test_OuterNested = 1;
+  Test_InnerCycles = 30;
+
+  start = CycleCounter_Host;
+  IntTrigger(TEST_OUTER);
+
+  HOST_TEST_CHECK_EQUAL(Test_Outer.totalCycles, 150);
+  HOST_TEST_CHECK_EQUAL(Test_Inner.totalCycles, 30);
+  HOST_TEST_CHECK_EQUAL(Test_Outer.totalCycles + Test_Inner.totalCycles, CycleCounter_Host - start);
+  HOST_TEST_CHECK_EQUAL(Test_PreemptedSeen, 30);
+  HOST_TEST_CHECK_EQUAL(Test_Outer.nested, 0);
+  HOST_TEST_CHECK_EQUAL(Test_Inner.nested, 1);
+
+  // Each handler sees its own frame, and the outer one again after the
+  // inner one returned
+  HOST_TEST_CHECK_EQUAL(Test_InnerPC, Test_Frames[TEST_INNER][TEST_FRAME_PC]);
+  HOST_TEST_CHECK_EQUAL(Test_OuterPCAfter, Test_Frames[TEST_OUTER][TEST_FRAME_PC]);
+
+  // Three levels: the middle one is charged neither the outer time nor
+  // the third interrupt's
+  reset();
+  Test_OuterBefore = 10;
+  Test_OuterAfter = 20;
+  Test_OuterNested = 1;
+  Test_InnerCycles = 12;
+  Test_InnerTriggersThird = true;
+  Test_ThirdCycles = 3;
+
+  start = CycleCounter_Host;
+  IntTrigger(TEST_OUTER);
+
+  HOST_TEST_CHECK_EQUAL(Test_Outer.totalCycles, 30);
+  HOST_TEST_CHECK_EQUAL(Test_Inner.totalCycles, 12);
+  HOST_TEST_CHECK_EQUAL(Test_Third.totalCycles, 3);
+  HOST_TEST_CHECK_EQUAL(Test_PreemptedSeen, 15);
+  HOST_TEST_CHECK_EQUAL(Test_Inner.nested, 1);
+  HOST_TEST_CHECK_EQUAL(Test_Third.nested, 1);
+  HOST_TEST_CHECK_EQUAL(CycleCounter_Host - start, 45);
+
+  // Preempted twice at the same level: both are taken off
+  reset();
+  Test_OuterBefore = 10;
+  Test_OuterAfter = 10;
+  Test_OuterNested = 2;
+  Test_InnerCycles = 25;
+
+  IntTrigger(TEST_OUTER);
+
+  HOST_TEST_CHECK_EQUAL(Test_Outer.totalCycles, 20);
+  HOST_TEST_CHECK_EQUAL(Test_Inner.calls.value, 2);
+  HOST_TEST_CHECK_EQUAL(Test_Inner.totalCycles, 50);
+  HOST_TEST_CHECK_EQUAL(Test_Inner.maxCycles.value, 25);
+  HOST_TEST_CHECK_EQUAL(Test_PreemptedSeen, 50);
+  HOST_TEST_CHECK_EQUAL(Test_Inner.nested, 2);
+
+  // A later unpreempted call starts with nothing taken off
+  Test_OuterNested = 0;
+  IntTrigger(TEST_OUTER);
+  HOST_TEST_CHECK_EQUAL(Test_Outer.totalCycles, 40);
+  HOST_TEST_CHECK_EQUAL(Test_PreemptedSeen, 0);
+}
+
+
+/*************************************************************************
+* Function Name: test_wrap
+* Description:   Self time is right when the cycle counter wraps inside
+*                a nested call
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_wrap() {
+  reset();
+  CycleCounter_Host = 0xFFFFFFFF - 40;
+  Test_OuterBefore = 30;
+  Test_OuterAfter = 30;
+  Test_OuterNested = 1;
+  Test_InnerCycles = 40;
+
+  IntTrigger(TEST_OUTER);
+
+  HOST_TEST_CHECK_EQUAL(Test_Outer.totalCycles, 60);
+  HOST_TEST_CHECK_EQUAL(Test_Inner.totalCycles, 40);
+}
+
+
+/*************************************************************************
+* Function Name: test_depth
+* Description:   Below ISR_ACCOUNTING_MAX_DEPTH handlers still run; their
+*                time is charged to the deepest accounted level
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_depth() {
+  uint32_t start = CycleCounter_Host;
+
+  reset();
+  Test_DeepLevel = 0;
+  Test_DeepCalls = 0;
+
+  IntTrigger(TEST_DEEP);
+
+  HOST_TEST_CHECK_EQUAL(Test_DeepCalls, TEST_DEEP_LEVELS);
+  HOST_TEST_CHECK_EQUAL(Test_Deep.calls.value, ISR_ACCOUNTING_MAX_DEPTH);
+  HOST_TEST_CHECK_EQUAL(Test_Deep.nested, ISR_ACCOUNTING_MAX_DEPTH - 1);
+  HOST_TEST_CHECK_EQUAL(Test_Deep.totalCycles, CycleCounter_Host - start);
+  HOST_TEST_CHECK_EQUAL(Test_Deep.maxCycles.value, 2 + (2 * (TEST_DEEP_LEVELS - ISR_ACCOUNTING_MAX_DEPTH)));
+  HOST_TEST_CHECK_EQUAL(ISRAccounting_Depth, 0);
+}
+
+
+/*************************************************************************
+* Function Name: test_print
+* Description:   Load is the self time since the previous print over the
+*                time between the prints
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_print() {
+  uint32_t i = 0;
+
+  reset();
+  Test_Ns = 5000000;
+  ISRAccounting_Print();
+
+  // 10 calls of 10 us in 1 ms
+  for (i = 0; i < 10; ++i) {
+    IntTrigger(TEST_LOAD);
+  }
+  Test_Ns += 1000000;
+  ISRAccounting_Print();
+  HOST_TEST_CHECK(strcmp(Host_Log_Line, "load,10,0,0,1200,10,10.00\n") == 0);
+
+  // Nothing since
+  Test_Ns += 1000000;
+  ISRAccounting_Print();
+  HOST_TEST_CHECK(strcmp(Host_Log_Line, "load,10,0,0,1200,10,0.00\n") == 0);
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: IntRegister / IntUnregister / IntEnable / IntDisable /
+*                IntPrioritySet
+* Description:   The vector table; the rest do nothing
+*************************************************************************/
+void IntRegister(uint32_t ui32Interrupt, void (*pfnHandler)(void)) {
+  Test_Vectors[ui32Interrupt] = pfnHandler;
+}
+
+void IntUnregister(uint32_t ui32Interrupt) {
+  Test_Vectors[ui32Interrupt] = NULL;
+}
+
+void IntEnable(uint32_t ui32Interrupt) {
+  (void)ui32Interrupt;
+}
+
+void IntDisable(uint32_t ui32Interrupt) {
+  (void)ui32Interrupt;
+}
+
+void IntPrioritySet(uint32_t ui32Interrupt, uint8_t ui8Priority) {
+  (void)ui32Interrupt;
+  (void)ui8Priority;
+}
+
+
+/*************************************************************************
+* Function Name: IntTrigger
+* Description:   Take the interrupt now: VECTACTIVE is set and the
+*                trampoline's call to ISRAccounting_Dispatch is made
+* Parameters:    uint32_t ui32Interrupt
+* Return:        void
+*************************************************************************/
+void IntTrigger(uint32_t ui32Interrupt) {
+  uint32_t active = ISRAccounting_Host_ICSR;
+
+  HOST_TEST_CHECK(Test_Vectors[ui32Interrupt] == ISR_Accounting_Trampoline);
+
+  ISRAccounting_Host_ICSR = ui32Interrupt;
+  ISRAccounting_Dispatch(Test_Frames[ui32Interrupt]);
+  ISRAccounting_Host_ICSR = active;
+}
+
+
+/*************************************************************************
+* Function Name: ISR_Accounting_Trampoline / xPortSysTickHandler
+* Description:   Only their addresses are used
+*************************************************************************/
+void ISR_Accounting_Trampoline(void) {
+}
+
+void xPortSysTickHandler(void) {
+}
+
+
+/*************************************************************************
+* Function Name: Timestamp_GetNs
+* Description:   Test_Ns
+*************************************************************************/
+uint64_t Timestamp_GetNs() {
+  return Test_Ns;
+}
+
+
+int main() {
+  uint32_t i = 0;
+
+  for (i = 0; i < NUM_INTERRUPTS; ++i) {
+    Test_Frames[i][TEST_FRAME_PC] = 0x00010000 + (i * 0x10);
+  }
+
+  HOST_TEST_CHECK(ISRAccounting_Register(&Test_Outer, TEST_OUTER, handler_outer));
+  HOST_TEST_CHECK(ISRAccounting_Register(&Test_Inner, TEST_INNER, handler_inner));
+  HOST_TEST_CHECK(ISRAccounting_Register(&Test_Third, TEST_THIRD, handler_third));
+  HOST_TEST_CHECK(ISRAccounting_Register(&Test_Deep, TEST_DEEP, handler_deep));
+  HOST_TEST_CHECK(ISRAccounting_Register(&Test_Load, TEST_LOAD, handler_load));
+
+  test_single();
+  test_nested();
+  test_wrap();
+  test_depth();
+  test_print();
+
+  return HostTest_Result("ISR_Accounting");
+}
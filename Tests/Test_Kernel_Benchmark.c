@@ -0,0 +1,168 @@
+/**
+* @Filename: Test_Kernel_Benchmark.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [8:30pm]
+* @Version:  1.0.0
+*
+* @Description: Host build of the queue and semaphore benchmarks of
+*               Tasks/Kernel_Benchmark.c, run against Source/queue.c and
+*               Source/tasks.c before the scheduler starts, so no call
+*               blocks or switches task. Times are nanoseconds of the
+*               host's monotonic clock.
+*
+*               The "bench" lines are printed as the target prints them.
+*               Every benchmark must have run KERNEL_BENCHMARK_RUNS times
+*               and have a host baseline to compare against.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Drivers/CycleCounter.h"
+
+#include "Tasks/Kernel_Benchmark.h"
+#include "Tasks/Log.h"
+
+#include "FreeRTOS.h"
+#include "Host_Test.h"
+#include "task.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+// Benchmarks of KernelBenchmark_RunQueues: three queues, three batch
+// sizes, a send and a receive each, and the semaphore give and take
+#define TEST_BENCHMARKS ((3 * 2) + (3 * 2) + 2)
+
+
+/************************************************
+* Local variables
+************************************************/
+uint32_t Test_Benchmarks = 0;
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: CycleCounter_Initialization / CycleCounter_HostClock
+* Description:   The host's monotonic clock in nanoseconds, wrapping
+*************************************************************************/
+extern uint32_t CycleCounter_Initialization() {
+  return (1);
+}
+
+extern uint32_t CycleCounter_HostClock() {
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint32_t)(((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec);
+}
+
+
+/*************************************************************************
+* Function Name: Log_Printf
+* Description:   Print the line and check the "bench" lines
+* Parameters:    const char* format
+*                ...
+* Return:        void
+*************************************************************************/
+extern void Log_Printf(const char* format, ...) {
+  char line[160];
+  unsigned runs = 0;
+  va_list args;
+
+  va_start(args, format);
+  vsnprintf(line, sizeof(line), format, args);
+  va_end(args);
+
+  fputs(line, stdout);
+
+  if ((strncmp(line, "bench,", 6) != 0) || (strncmp(line, "bench,name,", 11) == 0)) {
+    return;
+  }
+  Test_Benchmarks++;
+
+  HOST_TEST_CHECK(sscanf(strchr(line + 6, ','), ",%u,", &runs) == 1);
+  HOST_TEST_CHECK_EQUAL(runs, KERNEL_BENCHMARK_RUNS);
+  HOST_TEST_CHECK(strstr(line, ",no baseline,") == NULL);
+}
+
+
+/*************************************************************************
+* Function Name: pvPortMalloc / vPortFree
+* Description:   The C heap
+*************************************************************************/
+void* pvPortMalloc(size_t xSize) {
+  return malloc(xSize);
+}
+
+void vPortFree(void* pv) {
+  free(pv);
+}
+
+
+/*************************************************************************
+* Function Name: port critical sections, yield and scheduler
+* Description:   One thread and the scheduler never started: nothing to
+*                mask or switch
+*************************************************************************/
+void vPortEnterCritical(void) {
+}
+
+void vPortExitCritical(void) {
+}
+
+void vPortDisableInterrupts(void) {
+}
+
+void vPortEnableInterrupts(void) {
+}
+
+uint32_t ulPortSetInterruptMask(void) {
+  return 0;
+}
+
+void vPortClearInterruptMask(uint32_t ulNewMask) {
+  (void)ulNewMask;
+}
+
+void vPortYield(void) {
+}
+
+StackType_t* pxPortInitialiseStack(StackType_t* pxTopOfStack, TaskFunction_t pxCode, void* pvParameters) {
+  (void)pxCode;
+  (void)pvParameters;
+  return pxTopOfStack;
+}
+
+BaseType_t xPortStartScheduler(void) {
+  return pdFALSE;
+}
+
+void vPortEndScheduler(void) {
+}
+
+
+int main() {
+  Log_Printf("bench,name,runs,min ns,mean ns,max ns,baseline ns,change %%\n");
+  KernelBenchmark_RunQueues();
+
+  HOST_TEST_CHECK_EQUAL(Test_Benchmarks, TEST_BENCHMARKS);
+
+  return HostTest_Result("Kernel_Benchmark (host)");
+}
@@ -0,0 +1,190 @@
+/**
+* @Filename: Test_Latency_Histogram.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [9:10am]
+* @Version:  1.0.0
+*
+* @Description: Host tests of Tasks/Latency_Histogram.c: bucket
+*               boundaries, merge and percentiles.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Tasks/Latency_Histogram.h"
+
+#include "Host_Test.h"
+
+
+/************************************************
+* Local variables
+************************************************/
+LatencyHistogram Test_First;
+LatencyHistogram Test_Second;
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: test_bucket_boundaries
+* Description:   Exact buckets, the first bucket of each power of two, the
+*                edges between buckets and the overflow bucket
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_bucket_boundaries() {
+  uint32_t value = 0;
+  uint32_t index = 0;
+  uint32_t exponent = 0;
+
+  // Below 2^SUB_BITS every value has its own bucket
+  for (value = 0; value < LATENCY_HISTOGRAM_SUB_BUCKETS; ++value) {
+    HOST_TEST_CHECK_EQUAL(LatencyHistogram_BucketIndex(value), value);
+    HOST_TEST_CHECK_EQUAL(LatencyHistogram_BucketLowest(value), value);
+  }
+
+  // 8..15 are still one value per bucket, 16 and 17 share one
+  HOST_TEST_CHECK_EQUAL(LatencyHistogram_BucketIndex(8), 8);
+  HOST_TEST_CHECK_EQUAL(LatencyHistogram_BucketIndex(15), 15);
+  HOST_TEST_CHECK_EQUAL(LatencyHistogram_BucketIndex(16), 16);
+  HOST_TEST_CHECK_EQUAL(LatencyHistogram_BucketIndex(17), 16);
+  HOST_TEST_CHECK_EQUAL(LatencyHistogram_BucketIndex(18), 17);
+
+  // Each power of two starts a new group of SUB_BUCKETS buckets
+  for (exponent = LATENCY_HISTOGRAM_SUB_BITS; exponent <= LATENCY_HISTOGRAM_MAX_EXPONENT; ++exponent) {
+    index = LatencyHistogram_BucketIndex(1UL << exponent);
+    HOST_TEST_CHECK_EQUAL(index, (exponent - LATENCY_HISTOGRAM_SUB_BITS + 1) << LATENCY_HISTOGRAM_SUB_BITS);
+    HOST_TEST_CHECK_EQUAL(LatencyHistogram_BucketLowest(index), 1UL << exponent);
+    HOST_TEST_CHECK_EQUAL(LatencyHistogram_BucketIndex((1UL << exponent) - 1), index - 1);
+  }
+
+  // Every bucket's lowest value maps back to it, the value below it to the
+  // previous bucket, and no bucket is wider than 1/8 of its lowest value
+  for (index = 1; index < (LATENCY_HISTOGRAM_BUCKETS - 1); ++index) {
+    uint32_t lowest = LatencyHistogram_BucketLowest(index);
+    uint32_t next = LatencyHistogram_BucketLowest(index + 1);
+
+    HOST_TEST_CHECK_EQUAL(LatencyHistogram_BucketIndex(lowest), index);
+    HOST_TEST_CHECK_EQUAL(LatencyHistogram_BucketIndex(lowest - 1), index - 1);
+    HOST_TEST_CHECK(next > lowest);
+    HOST_TEST_CHECK(((next - lowest) <= 1) || ((next - lowest) * LATENCY_HISTOGRAM_SUB_BUCKETS <= lowest));
+  }
+
+  // 2^(MAX_EXPONENT + 1) and above share the overflow bucket
+  HOST_TEST_CHECK_EQUAL(LatencyHistogram_BucketIndex((1UL << (LATENCY_HISTOGRAM_MAX_EXPONENT + 1)) - 1),
+                        LATENCY_HISTOGRAM_BUCKETS - 2);
+  HOST_TEST_CHECK_EQUAL(LatencyHistogram_BucketIndex(1UL << (LATENCY_HISTOGRAM_MAX_EXPONENT + 1)),
+                        LATENCY_HISTOGRAM_BUCKETS - 1);
+  HOST_TEST_CHECK_EQUAL(LatencyHistogram_BucketIndex(UINT32_MAX), LATENCY_HISTOGRAM_BUCKETS - 1);
+  HOST_TEST_CHECK_EQUAL(LatencyHistogram_BucketLowest(LATENCY_HISTOGRAM_BUCKETS - 1),
+                        1UL << (LATENCY_HISTOGRAM_MAX_EXPONENT + 1));
+}
+
+
+/*************************************************************************
+* Function Name: test_record_and_merge
+* Description:   Counts, min, max and total of two histograms and of their
+*                merge; merging an empty histogram changes nothing
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_record_and_merge() {
+  uint32_t i = 0;
+
+  LatencyHistogram_Init(&Test_First, "first");
+  LatencyHistogram_Init(&Test_Second, "second");
+
+  LatencyHistogram_Record(&Test_First, 5);
+  LatencyHistogram_Record(&Test_First, 1000);
+  LatencyHistogram_Record(&Test_Second, 3);
+  LatencyHistogram_Record(&Test_Second, 1000);
+  LatencyHistogram_Record(&Test_Second, 1UL << 30);
+
+  HOST_TEST_CHECK_EQUAL(Test_First.count, 2);
+  HOST_TEST_CHECK_EQUAL(Test_First.min, 5);
+  HOST_TEST_CHECK_EQUAL(Test_First.max, 1000);
+
+  LatencyHistogram_Merge(&Test_First, &Test_Second);
+  HOST_TEST_CHECK_EQUAL(Test_First.count, 5);
+  HOST_TEST_CHECK_EQUAL(Test_First.min, 3);
+  HOST_TEST_CHECK_EQUAL(Test_First.max, 1UL << 30);
+  HOST_TEST_CHECK_EQUAL(Test_First.total, 5 + 1000 + 3 + 1000 + (1ULL << 30));
+  HOST_TEST_CHECK_EQUAL(Test_First.buckets[5], 1);
+  HOST_TEST_CHECK_EQUAL(Test_First.buckets[3], 1);
+  HOST_TEST_CHECK_EQUAL(Test_First.buckets[LatencyHistogram_BucketIndex(1000)], 2);
+  HOST_TEST_CHECK_EQUAL(Test_First.buckets[LATENCY_HISTOGRAM_BUCKETS - 1], 1);
+
+  // The source is left alone
+  HOST_TEST_CHECK_EQUAL(Test_Second.count, 3);
+
+  // An empty source (min UINT32_MAX, max 0) changes nothing
+  LatencyHistogram_Init(&Test_Second, "second");
+  LatencyHistogram_Merge(&Test_First, &Test_Second);
+  HOST_TEST_CHECK_EQUAL(Test_First.count, 5);
+  HOST_TEST_CHECK_EQUAL(Test_First.min, 3);
+
+  // Registering the same histogram twice keeps one entry
+  for (i = 0; i < 3; ++i) {
+    LatencyHistogram_Init(&Test_First, "first");
+  }
+  HOST_TEST_CHECK(LatencyHistogram_PrintBuckets("first"));
+  HOST_TEST_CHECK(!LatencyHistogram_PrintBuckets("none"));
+}
+
+
+/*************************************************************************
+* Function Name: test_percentile
+* Description:   Percentiles of an empty histogram, of a uniform run of
+*                exact values, and the bucket lowest for larger values
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_percentile() {
+  uint32_t i = 0;
+
+  LatencyHistogram_Init(&Test_First, "first");
+  HOST_TEST_CHECK_EQUAL(LatencyHistogram_Percentile(&Test_First, 500), 0);
+
+  // 0..7 once each: the median is the 4th value (3), p0 the lowest
+  for (i = 0; i < LATENCY_HISTOGRAM_SUB_BUCKETS; ++i) {
+    LatencyHistogram_Record(&Test_First, i);
+  }
+  HOST_TEST_CHECK_EQUAL(LatencyHistogram_Percentile(&Test_First, 0), 0);
+  HOST_TEST_CHECK_EQUAL(LatencyHistogram_Percentile(&Test_First, 500), 3);
+  HOST_TEST_CHECK_EQUAL(LatencyHistogram_Percentile(&Test_First, 501), 4);
+  HOST_TEST_CHECK_EQUAL(LatencyHistogram_Percentile(&Test_First, 1000), 7);
+
+  // 99 fast and one slow value: p99 is still fast, p100 is the slow
+  // value's bucket
+  LatencyHistogram_Init(&Test_First, "first");
+  for (i = 0; i < 99; ++i) {
+    LatencyHistogram_Record(&Test_First, 1200);
+  }
+  LatencyHistogram_Record(&Test_First, 120000);
+  HOST_TEST_CHECK_EQUAL(LatencyHistogram_Percentile(&Test_First, 990),
+                        LatencyHistogram_BucketLowest(LatencyHistogram_BucketIndex(1200)));
+  HOST_TEST_CHECK_EQUAL(LatencyHistogram_Percentile(&Test_First, 1000),
+                        LatencyHistogram_BucketLowest(LatencyHistogram_BucketIndex(120000)));
+  HOST_TEST_CHECK(LatencyHistogram_Percentile(&Test_First, 1000) <= 120000);
+  HOST_TEST_CHECK(LatencyHistogram_Percentile(&Test_First, 1000) * 9 / 8 > 120000);
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+int main() {
+  test_bucket_boundaries();
+  test_record_and_merge();
+  test_percentile();
+
+  return HostTest_Result("Latency_Histogram");
+}
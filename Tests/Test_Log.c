@@ -0,0 +1,574 @@
+/**
+* @Filename: Test_Log.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [5:10pm]
+* @Version:  1.0.0
+*
+* @Description: Host stress test of Tasks/Log.c. Threads stand in for the
+*               tasks, a pthread mutex for Log_Mutex, and a slow UART
+*               writes into a capture buffer: character by character in
+*               the blocking build, or through a TX buffer of
+*               UART_TX_BUFFER_SIZE drained by a transmitter thread in the
+*               UART_BUFFERED build.
+*
+*               Writers mix Log_Printf and Log_PrintfWait. Every captured
+*               line must be whole, every Log_PrintfWait line must arrive
+*               exactly once, and the Log_Printf lines missing must be
+*               exactly the ones Log_DroppedCount counted.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "Drivers/uartstdio.h"
+
+#include "Tasks/Log.h"
+
+#include "FreeRTOS.h"
+#include "Host_Test.h"
+#include "queue.h"
+#include "semphr.h"
+#include "task.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+#define TEST_WRITERS 8
+#define TEST_LINES   300
+
+// Room for every line of every writer, with CR LF
+#define TEST_CAPTURE_SIZE (TEST_WRITERS * TEST_LINES * 80)
+
+// Time the UART takes per write call, in ns, in the blocking build
+#define TEST_WRITE_NS 50000
+
+// Characters the transmitter moves per tick in the buffered build
+#define TEST_TX_PER_TICK 16
+
+#define TEST_TICK_NS (1000000000L / configTICK_RATE_HZ)
+
+
+/************************************************
+* Local variables
+************************************************/
+volatile TickType_t Host_TickCount = 0;
+volatile uint32_t Log_Host_ICSR = 0;
+
+// Log_Mutex
+pthread_mutex_t Test_Mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// What reached the wire
+char Test_Capture[TEST_CAPTURE_SIZE];
+atomic_uint Test_CaptureLength;
+
+// Set by test_busy_console to hold the next write until it is cleared
+atomic_bool Test_Hold;
+atomic_bool Test_Holding;
+
+// Interrupt queue of Log_PrintfFromISR
+UBaseType_t Test_QueueLength = 0;
+UBaseType_t Test_QueueItems = 0;
+
+#ifdef UART_BUFFERED
+// TX buffer of the buffered driver, guarded by its own mutex as the
+// driver's is by the UART interrupt priority
+pthread_mutex_t Test_TxMutex = PTHREAD_MUTEX_INITIALIZER;
+char Test_TxBuffer[UART_TX_BUFFER_SIZE];
+uint32_t Test_TxRead = 0;
+uint32_t Test_TxWrite = 0;
+atomic_bool Test_TxRun;
+#endif
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: sleep_ns
+* Description:   Let the other threads run for a while
+* Parameters:    long ns
+* Return:        void
+*************************************************************************/
+static void sleep_ns(long ns) {
+  struct timespec delay;
+
+  delay.tv_sec = ns / 1000000000L;
+  delay.tv_nsec = ns % 1000000000L;
+  nanosleep(&delay, NULL);
+}
+
+
+/*************************************************************************
+* Function Name: capture
+* Description:   One character reaches the wire. The index is atomic so
+*                that writes racing past a broken lock show up as mixed
+*                lines rather than as lost characters.
+* Parameters:    char ch
+* Return:        void
+*************************************************************************/
+static void capture(char ch) {
+  uint32_t index = atomic_fetch_add(&Test_CaptureLength, 1);
+
+  if (index < TEST_CAPTURE_SIZE) {
+    Test_Capture[index] = ch;
+  }
+}
+
+
+#ifdef UART_BUFFERED
+/*************************************************************************
+* Function Name: transmitter
+* Description:   The UART interrupt: drain the TX buffer at a fixed rate
+* Parameters:    void* parameter
+* Return:        void*
+*************************************************************************/
+static void* transmitter(void* parameter) {
+  uint32_t i = 0;
+
+  (void)parameter;
+
+  while (atomic_load(&Test_TxRun) || (Test_TxRead != Test_TxWrite)) {
+    pthread_mutex_lock(&Test_TxMutex);
+    for (i = 0; (i < TEST_TX_PER_TICK) && (Test_TxRead != Test_TxWrite); ++i) {
+      capture(Test_TxBuffer[Test_TxRead]);
+      Test_TxRead = (Test_TxRead + 1) % UART_TX_BUFFER_SIZE;
+    }
+    pthread_mutex_unlock(&Test_TxMutex);
+    sleep_ns(TEST_TICK_NS);
+  }
+
+  return NULL;
+}
+#endif
+
+
+/*************************************************************************
+* Function Name: line_text
+* Description:   The line a writer sends; its length varies with seq
+* Parameters:    char* line
+*                size_t size
+*                uint32_t writer
+*                uint32_t seq
+*                const char* end - "\n" as sent, "\r\n" as received
+* Return:        void
+*************************************************************************/
+static void line_text(char* line, size_t size, uint32_t writer, uint32_t seq, const char* end) {
+  static const char PAD[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMN";
+
+  snprintf(line, size, "w%u %u %.*s %u%s", writer, seq, (int)((seq * 7 + writer) % 40) + 1, PAD,
+           (writer * 100000) + seq, end);
+}
+
+
+/*************************************************************************
+* Function Name: writer
+* Description:   A task printing its lines; odd writers must not lose any
+* Parameters:    void* parameter - writer number
+* Return:        void*
+*************************************************************************/
+static void* writer(void* parameter) {
+  uint32_t number = (uint32_t)(uintptr_t)parameter;
+  uint32_t seq = 0;
+  char line[80];
+
+  for (seq = 0; seq < TEST_LINES; ++seq) {
+    line_text(line, sizeof(line), number, seq, "\n");
+    if ((number % 2) == 1) {
+      Log_PrintfWait("%s", line);
+    }
+    else {
+      Log_Printf("%s", line);
+    }
+  }
+
+  return NULL;
+}
+
+
+/*************************************************************************
+* Function Name: hold_writer
+* Description:   A task printing one line with Log_PrintfWait
+* Parameters:    void* parameter - the line, without its LF
+* Return:        void*
+*************************************************************************/
+static void* hold_writer(void* parameter) {
+  Log_PrintfWait("%s\n", (const char*)parameter);
+  return NULL;
+}
+
+
+/*************************************************************************
+* Function Name: drain
+* Description:   Wait for the transmitter to empty the TX buffer
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void drain() {
+#ifdef UART_BUFFERED
+  while (true) {
+    bool empty = false;
+
+    pthread_mutex_lock(&Test_TxMutex);
+    empty = Test_TxRead == Test_TxWrite;
+    pthread_mutex_unlock(&Test_TxMutex);
+    if (empty) {
+      break;
+    }
+    sleep_ns(TEST_TICK_NS);
+  }
+#endif
+}
+
+
+/*************************************************************************
+* Function Name: count_lines
+* Description:   Split the capture into lines and check each is whole
+* Parameters:    uint32_t seen[TEST_WRITERS][TEST_LINES]
+* Return:        uint32_t - lines that are not exactly as sent
+*************************************************************************/
+static uint32_t count_lines(uint32_t seen[TEST_WRITERS][TEST_LINES]) {
+  uint32_t length = atomic_load(&Test_CaptureLength);
+  uint32_t bad = 0;
+  uint32_t start = 0;
+  uint32_t i = 0;
+
+  for (i = 0; i < length; ++i) {
+    char line[128];
+    char expected[128];
+    uint32_t lineLength = i + 1 - start;
+    unsigned writerNumber = 0;
+    unsigned seq = 0;
+
+    if (Test_Capture[i] != '\n') {
+      continue;
+    }
+
+    if (lineLength >= sizeof(line)) {
+      lineLength = sizeof(line) - 1;
+    }
+    memcpy(line, &Test_Capture[start], lineLength);
+    line[lineLength] = '\0';
+    start = i + 1;
+
+    if ((sscanf(line, "w%u %u", &writerNumber, &seq) != 2) || (writerNumber >= TEST_WRITERS) ||
+        (seq >= TEST_LINES)) {
+      bad++;
+      continue;
+    }
+    line_text(expected, sizeof(expected), writerNumber, seq, "\r\n");
+    if (strcmp(line, expected) != 0) {
+      bad++;
+      continue;
+    }
+    seen[writerNumber][seq]++;
+  }
+
+  // Nothing may follow the last line
+  if (start != length) {
+    bad++;
+  }
+
+  return bad;
+}
+
+
+/*************************************************************************
+* Function Name: test_busy_console
+* Description:   While one task holds the console past the timeout,
+*                Log_Printf drops its line and Log_PrintfWait waits
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_busy_console() {
+  pthread_t holder;
+  pthread_t waiter;
+  uint32_t dropped = Log_DroppedCount();
+  const char* expected = "holder\r\nwaiter\r\n";
+
+  atomic_store(&Test_CaptureLength, 0);
+  atomic_store(&Test_Hold, true);
+  pthread_create(&holder, NULL, hold_writer, "holder");
+  while (!atomic_load(&Test_Holding)) {
+    sleep_ns(TEST_TICK_NS);
+  }
+  pthread_create(&waiter, NULL, hold_writer, "waiter");
+
+  // Longer than LOG_MUTEX_TIMEOUT_TICKS passes before the holder is let go
+  Log_Printf("printf\n");
+  HOST_TEST_CHECK_EQUAL(Log_DroppedCount(), dropped + 1);
+
+  sleep_ns(2 * LOG_MUTEX_TIMEOUT_TICKS * TEST_TICK_NS);
+  atomic_store(&Test_Hold, false);
+  pthread_join(holder, NULL);
+  pthread_join(waiter, NULL);
+  atomic_store(&Test_Holding, false);
+  drain();
+
+  HOST_TEST_CHECK_EQUAL(Log_DroppedCount(), dropped + 1);
+  HOST_TEST_CHECK_EQUAL(atomic_load(&Test_CaptureLength), strlen(expected));
+  HOST_TEST_CHECK(memcmp(Test_Capture, expected, strlen(expected)) == 0);
+}
+
+
+/*************************************************************************
+* Function Name: test_interrupts
+* Description:   Log_Printf from a handler and a full interrupt queue are
+*                counted as dropped
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_interrupts() {
+  uint32_t dropped = Log_DroppedCount();
+  uint32_t i = 0;
+
+  atomic_store(&Test_CaptureLength, 0);
+  Log_Host_ICSR = 15;
+  Log_Printf("from a handler\n");
+  Log_PrintfWait("from a handler\n");
+  HOST_TEST_CHECK_EQUAL(Log_DroppedCount(), dropped + 2);
+
+  for (i = 0; i < LOG_ISR_QUEUE_LENGTH + 3; ++i) {
+    Log_PrintfFromISR("isr %u %u\n", i, 0);
+  }
+  Log_Host_ICSR = 0;
+  HOST_TEST_CHECK_EQUAL(Test_QueueItems, LOG_ISR_QUEUE_LENGTH);
+  HOST_TEST_CHECK_EQUAL(Log_DroppedCount(), dropped + 5);
+  HOST_TEST_CHECK_EQUAL(atomic_load(&Test_CaptureLength), 0);
+  Test_QueueItems = 0;
+}
+
+
+/*************************************************************************
+* Function Name: test_stress
+* Description:   TEST_WRITERS tasks print at once
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_stress() {
+  static uint32_t seen[TEST_WRITERS][TEST_LINES];
+  pthread_t writers[TEST_WRITERS];
+  uint32_t dropped = Log_DroppedCount();
+  uint32_t missing = 0;
+  uint32_t repeated = 0;
+  uint32_t waitMissing = 0;
+  uint32_t i = 0;
+  uint32_t seq = 0;
+
+  atomic_store(&Test_CaptureLength, 0);
+  for (i = 0; i < TEST_WRITERS; ++i) {
+    pthread_create(&writers[i], NULL, writer, (void*)(uintptr_t)i);
+  }
+  for (i = 0; i < TEST_WRITERS; ++i) {
+    pthread_join(writers[i], NULL);
+  }
+
+  drain();
+
+  HOST_TEST_CHECK(atomic_load(&Test_CaptureLength) <= TEST_CAPTURE_SIZE);
+  HOST_TEST_CHECK_EQUAL(count_lines(seen), 0);
+
+  for (i = 0; i < TEST_WRITERS; ++i) {
+    for (seq = 0; seq < TEST_LINES; ++seq) {
+      if (seen[i][seq] == 0) {
+        missing++;
+        if ((i % 2) == 1) {
+          waitMissing++;
+        }
+      }
+      else if (seen[i][seq] > 1) {
+        repeated++;
+      }
+    }
+  }
+
+  HOST_TEST_CHECK_EQUAL(waitMissing, 0);
+  HOST_TEST_CHECK_EQUAL(repeated, 0);
+  HOST_TEST_CHECK_EQUAL(missing, Log_DroppedCount() - dropped);
+
+  printf("Log: %u of %u Log_Printf lines dropped and counted\n", missing, (TEST_WRITERS / 2) * TEST_LINES);
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: xTaskGetSchedulerState / vTaskDelay
+* Description:   The scheduler always runs; a tick is TEST_TICK_NS
+*************************************************************************/
+BaseType_t xTaskGetSchedulerState(void) {
+  return taskSCHEDULER_RUNNING;
+}
+
+void vTaskDelay(const TickType_t xTicksToDelay) {
+  sleep_ns((long)xTicksToDelay * TEST_TICK_NS);
+}
+
+/*************************************************************************
+* Function Name: xSemaphoreCreateMutex / xSemaphoreTake / xSemaphoreGive
+* Description:   Log_Mutex on Test_Mutex, timeouts in ticks
+*************************************************************************/
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+  return &Test_Mutex;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime) {
+  struct timespec deadline;
+  long ns = 0;
+
+  if (xBlockTime == portMAX_DELAY) {
+    return (pthread_mutex_lock(xSemaphore) == 0) ? pdPASS : pdFAIL;
+  }
+
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  ns = deadline.tv_nsec + ((long)xBlockTime * TEST_TICK_NS);
+  deadline.tv_sec += ns / 1000000000L;
+  deadline.tv_nsec = ns % 1000000000L;
+  return (pthread_mutex_timedlock(xSemaphore, &deadline) == 0) ? pdPASS : pdFAIL;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore) {
+  return (pthread_mutex_unlock(xSemaphore) == 0) ? pdPASS : pdFAIL;
+}
+
+/*************************************************************************
+* Function Name: xQueueCreate / xQueueSendFromISR / xQueueReceive
+* Description:   The interrupt queue only counts its items; Task_Log does
+*                not run
+*************************************************************************/
+QueueHandle_t xQueueCreate(const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize) {
+  (void)uxItemSize;
+  Test_QueueLength = uxQueueLength;
+  return &Test_QueueLength;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t xQueue, const void* const pvItemToQueue,
+                             BaseType_t* const pxHigherPriorityTaskWoken) {
+  (void)xQueue;
+  (void)pvItemToQueue;
+  (void)pxHigherPriorityTaskWoken;
+
+  if (Test_QueueItems == Test_QueueLength) {
+    return pdFAIL;
+  }
+  Test_QueueItems++;
+  return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void* const pvBuffer, TickType_t xTicksToWait) {
+  (void)xQueue;
+  (void)pvBuffer;
+  (void)xTicksToWait;
+  return pdFAIL;
+}
+
+
+/*************************************************************************
+* Function Name: UARTwrite
+* Description:   The driver's UARTwrite, LF sent as CR LF. The blocking
+*                build takes TEST_WRITE_NS halfway through each call; the
+*                buffered build discards what does not fit, as the driver
+*                does.
+* Parameters:    const char* pcBuf
+*                uint32_t ui32Len
+* Return:        int - characters consumed
+*************************************************************************/
+int UARTwrite(const char* pcBuf, uint32_t ui32Len) {
+  uint32_t i = 0;
+
+  // Only the first write is held
+  if (atomic_load(&Test_Hold) && !atomic_exchange(&Test_Holding, true)) {
+    while (atomic_load(&Test_Hold)) {
+      sleep_ns(TEST_TICK_NS);
+    }
+  }
+
+#ifdef UART_BUFFERED
+  pthread_mutex_lock(&Test_TxMutex);
+  for (i = 0; i < ui32Len; ++i) {
+    if (pcBuf[i] == '\n') {
+      if (((Test_TxWrite + 1) % UART_TX_BUFFER_SIZE) == Test_TxRead) {
+        break;
+      }
+      Test_TxBuffer[Test_TxWrite] = '\r';
+      Test_TxWrite = (Test_TxWrite + 1) % UART_TX_BUFFER_SIZE;
+    }
+    if (((Test_TxWrite + 1) % UART_TX_BUFFER_SIZE) == Test_TxRead) {
+      break;
+    }
+    Test_TxBuffer[Test_TxWrite] = pcBuf[i];
+    Test_TxWrite = (Test_TxWrite + 1) % UART_TX_BUFFER_SIZE;
+  }
+  pthread_mutex_unlock(&Test_TxMutex);
+#else
+  for (i = 0; i < ui32Len; ++i) {
+    if (i == (ui32Len / 2)) {
+      sleep_ns(TEST_WRITE_NS);
+    }
+    if (pcBuf[i] == '\n') {
+      capture('\r');
+    }
+    capture(pcBuf[i]);
+  }
+#endif
+
+  return (int)i;
+}
+
+
+#ifdef UART_BUFFERED
+/*************************************************************************
+* Function Name: UARTTxBytesFree
+* Description:   Free space of the TX buffer, one more than fits
+* Parameters:    N/A
+* Return:        int
+*************************************************************************/
+int UARTTxBytesFree(void) {
+  int used = 0;
+
+  pthread_mutex_lock(&Test_TxMutex);
+  used = (int)((Test_TxWrite + UART_TX_BUFFER_SIZE - Test_TxRead) % UART_TX_BUFFER_SIZE);
+  pthread_mutex_unlock(&Test_TxMutex);
+
+  return UART_TX_BUFFER_SIZE - used;
+}
+#endif
+
+
+int main() {
+#ifdef UART_BUFFERED
+  pthread_t uart;
+
+  atomic_store(&Test_TxRun, true);
+  pthread_create(&uart, NULL, transmitter, NULL);
+#endif
+
+  Log_Initialization();
+
+  test_interrupts();
+  test_busy_console();
+  test_stress();
+
+#ifdef UART_BUFFERED
+  atomic_store(&Test_TxRun, false);
+  pthread_join(uart, NULL);
+  return HostTest_Result("Log (UART_BUFFERED)");
+#else
+  return HostTest_Result("Log");
+#endif
+}
@@ -0,0 +1,182 @@
+/**
+* @Filename: Test_Metrics.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [9:40am]
+* @Version:  1.0.0
+*
+* @Description: Host tests of Tasks/Metrics.c: the registry, histogram
+*               buckets, and counters and histograms updated from several
+*               threads at once through the C11 Atomic_Add32.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Tasks/Metrics.h"
+
+#include "Host_Test.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+#define TEST_THREADS 8
+#define TEST_UPDATES 200000
+
+const uint32_t Test_Bounds[] = { 10, 100, 1000 };
+
+
+/************************************************
+* Local variables
+************************************************/
+Metrics_Metric Test_Counter = METRICS_COUNTER("test counter");
+Metrics_Metric Test_Gauge = METRICS_GAUGE("test gauge");
+
+volatile uint32_t Test_Buckets[sizeof(Test_Bounds) / sizeof(Test_Bounds[0]) + 1];
+uint32_t Test_BucketSnapshots[sizeof(Test_Bounds) / sizeof(Test_Bounds[0]) + 1];
+Metrics_Metric Test_Histogram = METRICS_HISTOGRAM("test histogram", Test_Bounds, Test_Buckets, Test_BucketSnapshots);
+
+Metrics_Metric Test_Filler[METRICS_MAX_METRICS];
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: test_registry
+* Description:   Registration, duplicates and a full registry
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_registry() {
+  uint32_t i = 0;
+
+  HOST_TEST_CHECK(Metrics_Register(&Test_Counter));
+  HOST_TEST_CHECK(Metrics_Register(&Test_Gauge));
+  HOST_TEST_CHECK(Metrics_Register(&Test_Histogram));
+  HOST_TEST_CHECK(Metrics_Register(&Test_Counter));
+  HOST_TEST_CHECK_EQUAL(Metrics_Count(), 3);
+  HOST_TEST_CHECK(Metrics_Get(1) == &Test_Gauge);
+  HOST_TEST_CHECK(Metrics_Get(3) == NULL);
+
+  for (i = 0; i < (METRICS_MAX_METRICS - 3); ++i) {
+    HOST_TEST_CHECK(Metrics_Register(&Test_Filler[i]));
+  }
+  HOST_TEST_CHECK(!Metrics_Register(&Test_Filler[METRICS_MAX_METRICS - 1]));
+  HOST_TEST_CHECK(Metrics_Register(&Test_Histogram));
+  HOST_TEST_CHECK_EQUAL(Metrics_Count(), METRICS_MAX_METRICS);
+}
+
+
+/*************************************************************************
+* Function Name: test_histogram_buckets
+* Description:   A sample goes in the first bucket whose bound is not
+*                below it, larger samples in the last bucket
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_histogram_buckets() {
+  Metrics_Record(&Test_Histogram, 0);
+  Metrics_Record(&Test_Histogram, 10);
+  Metrics_Record(&Test_Histogram, 11);
+  Metrics_Record(&Test_Histogram, 1000);
+  Metrics_Record(&Test_Histogram, 1001);
+  Metrics_Record(&Test_Histogram, UINT32_MAX);
+
+  HOST_TEST_CHECK_EQUAL(Test_Histogram.bucketsNbr, 4);
+  HOST_TEST_CHECK_EQUAL(Test_Buckets[0], 2);
+  HOST_TEST_CHECK_EQUAL(Test_Buckets[1], 1);
+  HOST_TEST_CHECK_EQUAL(Test_Buckets[2], 1);
+  HOST_TEST_CHECK_EQUAL(Test_Buckets[3], 2);
+  HOST_TEST_CHECK_EQUAL(Test_Histogram.value, 6);
+
+  Metrics_Set(&Test_Gauge, 42);
+  HOST_TEST_CHECK_EQUAL(Test_Gauge.value, 42);
+  HOST_TEST_CHECK_EQUAL(Atomic_Add32(&Test_Gauge.value, 8), 50);
+}
+
+
+/*************************************************************************
+* Function Name: update_thread
+* Description:   Count TEST_UPDATES events and samples, racing the other
+*                threads
+* Parameters:    void* argument - thread number
+* Return:        void* - NULL
+*************************************************************************/
+static void* update_thread(void* argument) {
+  uint32_t thread = (uint32_t)(uintptr_t)argument;
+  uint32_t i = 0;
+
+  for (i = 0; i < TEST_UPDATES; ++i) {
+    Metrics_Increment(&Test_Counter);
+    Metrics_Record(&Test_Histogram, (thread % 2) ? 5 : 5000);
+  }
+
+  return NULL;
+}
+
+
+/*************************************************************************
+* Function Name: test_concurrent_updates
+* Description:   No update is lost when several threads update the same
+*                counter and histogram
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_concurrent_updates() {
+  pthread_t threads[TEST_THREADS];
+  uint32_t buckets0 = Test_Buckets[0];
+  uint32_t buckets3 = Test_Buckets[3];
+  uint32_t samples = Test_Histogram.value;
+  uint32_t i = 0;
+
+  Metrics_Add(&Test_Counter, 7);
+
+  for (i = 0; i < TEST_THREADS; ++i) {
+    HOST_TEST_CHECK(pthread_create(&threads[i], NULL, update_thread, (void*)(uintptr_t)i) == 0);
+  }
+  for (i = 0; i < TEST_THREADS; ++i) {
+    pthread_join(threads[i], NULL);
+  }
+
+  HOST_TEST_CHECK_EQUAL(Test_Counter.value, 7 + TEST_THREADS * TEST_UPDATES);
+  HOST_TEST_CHECK_EQUAL(Test_Histogram.value, samples + TEST_THREADS * TEST_UPDATES);
+  HOST_TEST_CHECK_EQUAL(Test_Buckets[0], buckets0 + (TEST_THREADS / 2) * TEST_UPDATES);
+  HOST_TEST_CHECK_EQUAL(Test_Buckets[3], buckets3 + (TEST_THREADS / 2) * TEST_UPDATES);
+}
+
+
+/*************************************************************************
+* Function Name: test_print
+* Description:   Metrics_Print lists the histogram's last bucket as inf
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_print() {
+  uint32_t lines = Host_Log_Lines;
+
+  Metrics_Print();
+  HOST_TEST_CHECK(Host_Log_Lines > lines);
+  HOST_TEST_CHECK(strncmp(Host_Log_Line, "3,inf,", 6) == 0);
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+int main() {
+  test_registry();
+  test_histogram_buckets();
+  test_concurrent_updates();
+  test_print();
+
+  return HostTest_Result("Metrics");
+}
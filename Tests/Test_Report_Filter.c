@@ -0,0 +1,333 @@
+/**
+* @Filename: Test_Report_Filter.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [1:30pm]
+* @Version:  1.0.0
+*
+* @Description: Host tests of Tasks/Report_Filter.c. An hour of pressure,
+*               acceleration and temperature records is replayed through
+*               the filter: the reduction in records sent, how far a
+*               reader's last value may lag the sensor, and how quickly
+*               steps and ramps get out. Also the "filter" console
+*               command's argument checks and printed rules.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Tasks/Report_Filter.h"
+#include "Tasks/Task_ReportData.h"
+
+#include "FreeRTOS.h"
+#include "Host_Test.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+#define TEST_SECOND       configTICK_RATE_HZ
+#define TEST_TRACE_LENGTH (3600 * TEST_SECOND)
+
+// Pressure: 1 record per second, Pa
+#define TEST_PRESSURE_PERIOD     TEST_SECOND
+#define TEST_PRESSURE_BASE       98000
+#define TEST_PRESSURE_DRIFT      20     // Pa over the hour
+#define TEST_PRESSURE_STEP       60     // Pa, a door closing...
+#define TEST_PRESSURE_STEP_AT    1200   // s
+#define TEST_PRESSURE_STEP_FOR   30     // s
+#define TEST_PRESSURE_RAMP       12     // Pa/s, ...and a lift moving
+#define TEST_PRESSURE_RAMP_AT    2400   // s
+#define TEST_PRESSURE_RAMP_FOR   20     // s
+#define TEST_PRESSURE_DEADBAND   8.0f
+#define TEST_PRESSURE_RATE       10.0f  // Pa/s
+#define TEST_PRESSURE_HYSTERESIS 4.0f
+#define TEST_PRESSURE_HEARTBEAT  60     // s
+
+// Acceleration: 10 records per second, g, with one tap
+#define TEST_ACCELERATION_PERIOD   (TEST_SECOND / 10)
+#define TEST_ACCELERATION_NOISE    0.01f
+#define TEST_ACCELERATION_TAP      0.5f
+#define TEST_ACCELERATION_TAP_AT   (1800 * TEST_SECOND)
+#define TEST_ACCELERATION_TAP_FOR  (TEST_SECOND / 5)
+#define TEST_ACCELERATION_DEADBAND 0.05f
+
+
+/************************************************
+* Local variables
+************************************************/
+uint32_t Test_Random = 1;
+
+// The values a reader last received, per ReportName
+float Test_Received[16][4];
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: noise
+* Description:   Repeatable noise, an integer in [-amplitude, amplitude]
+* Parameters:    int32_t amplitude
+* Return:        int32_t
+*************************************************************************/
+static int32_t noise(int32_t amplitude) {
+  Test_Random = (Test_Random * 1664525) + 1013904223;
+  return (int32_t)((Test_Random >> 16) % (uint32_t)((2 * amplitude) + 1)) - amplitude;
+}
+
+
+/*************************************************************************
+* Function Name: float_bits
+* Description:   A float as a record value
+* Parameters:    float value
+* Return:        int32_t
+*************************************************************************/
+static int32_t float_bits(float value) {
+  int32_t bits = 0;
+
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+
+/*************************************************************************
+* Function Name: pressure_at
+* Description:   The pressure trace at time, in Pa
+* Parameters:    uint32_t time - ticks
+* Return:        int32_t
+*************************************************************************/
+static int32_t pressure_at(uint32_t time) {
+  uint32_t seconds = time / TEST_SECOND;
+  int32_t pressure = TEST_PRESSURE_BASE + (int32_t)(((uint64_t)TEST_PRESSURE_DRIFT * time) / TEST_TRACE_LENGTH);
+
+  if ((seconds >= TEST_PRESSURE_STEP_AT) && (seconds < (TEST_PRESSURE_STEP_AT + TEST_PRESSURE_STEP_FOR))) {
+    pressure += TEST_PRESSURE_STEP;
+  }
+  if ((seconds >= TEST_PRESSURE_RAMP_AT) && (seconds < (TEST_PRESSURE_RAMP_AT + TEST_PRESSURE_RAMP_FOR))) {
+    pressure -= TEST_PRESSURE_RAMP * (int32_t)(seconds - TEST_PRESSURE_RAMP_AT);
+  }
+  else if (seconds >= (TEST_PRESSURE_RAMP_AT + TEST_PRESSURE_RAMP_FOR)) {
+    pressure -= TEST_PRESSURE_RAMP * TEST_PRESSURE_RAMP_FOR;
+  }
+  return pressure + noise(2);
+}
+
+
+/*************************************************************************
+* Function Name: replay
+* Description:   Pass a record through the filter. A record sent becomes
+*                what the reader holds; a record suppressed may differ
+*                from that by at most the deadband.
+* Parameters:    const ReportData_Item* item
+*                float deadband - 0 if the record has no rule
+*                uint32_t* sent - counts records sent
+* Return:        bool - true if the record was sent
+*************************************************************************/
+static bool replay(const ReportData_Item* item, float deadband, uint32_t* sent) {
+  const int32_t raw[4] = { item->ReportValue_0, item->ReportValue_1, item->ReportValue_2, item->ReportValue_3 };
+  float* received = Test_Received[item->ReportName];
+  float lag = 0.0f;
+  uint32_t i = 0;
+
+  if (ReportFilter_Accept(item)) {
+    for (i = 0; i < 4; ++i) {
+      if (item->ReportValueType_Flg & (1 << i)) {
+        memcpy(&received[i], &raw[i], sizeof(float));
+      }
+      else {
+        received[i] = (float)raw[i];
+      }
+    }
+    (*sent)++;
+    return true;
+  }
+
+  for (i = 0; i < 4; ++i) {
+    float value = (float)raw[i];
+    if (item->ReportValueType_Flg & (1 << i)) {
+      memcpy(&value, &raw[i], sizeof(float));
+    }
+    lag = (fabsf(value - received[i]) > lag) ? fabsf(value - received[i]) : lag;
+  }
+  HOST_TEST_CHECK(lag <= deadband);
+  return false;
+}
+
+
+/*************************************************************************
+* Function Name: test_trace
+* Description:   Replay the hour in time order and compare the records
+*                sent with and without rules
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_trace() {
+  ReportData_Item item;
+  uint32_t time = 0;
+  uint32_t records = 0;
+  uint32_t sent = 0;
+  uint32_t pressureSent = 0;
+  uint32_t accelerationSent = 0;
+  uint32_t temperatureSent = 0;
+  uint32_t lastPressureSent = 0;
+  uint32_t longestGap = 0;
+  uint32_t rampSent = 0;
+  bool stepSent = false;
+  bool stepBackSent = false;
+  bool tapSent = false;
+
+  HOST_TEST_CHECK(ReportFilter_SetRule(ReportName_Pressure, TEST_PRESSURE_DEADBAND, TEST_PRESSURE_RATE,
+                                       TEST_PRESSURE_HYSTERESIS, TEST_PRESSURE_HEARTBEAT * TEST_SECOND));
+  HOST_TEST_CHECK(ReportFilter_SetRule(ReportName_Acceleration, TEST_ACCELERATION_DEADBAND, 0.0f, 0.0f, 0));
+
+  for (time = 0; time < TEST_TRACE_LENGTH; time += TEST_ACCELERATION_PERIOD) {
+    memset(&item, 0, sizeof(item));
+    item.TimeStamp = time;
+
+    // Acceleration x, y, z, and a tap on z
+    item.ReportName = ReportName_Acceleration;
+    item.ReportValueType_Flg = 0b0111;
+    item.ReportValue_0 = float_bits(TEST_ACCELERATION_NOISE * noise(1));
+    item.ReportValue_1 = float_bits(TEST_ACCELERATION_NOISE * noise(1));
+    item.ReportValue_2 = float_bits(1.0f + (TEST_ACCELERATION_NOISE * noise(1)) +
+                                    (((time >= TEST_ACCELERATION_TAP_AT) &&
+                                      (time < (TEST_ACCELERATION_TAP_AT + TEST_ACCELERATION_TAP_FOR))) ?
+                                     TEST_ACCELERATION_TAP : 0.0f));
+    records++;
+    if (replay(&item, TEST_ACCELERATION_DEADBAND, &accelerationSent) && (time == TEST_ACCELERATION_TAP_AT)) {
+      tapSent = true;
+    }
+
+    if ((time % TEST_PRESSURE_PERIOD) != 0) {
+      continue;
+    }
+
+    // Pressure, with the sample count and oversampling setting as sent
+    item.ReportName = ReportName_Pressure;
+    item.ReportValueType_Flg = 0b0000;
+    item.ReportValue_0 = pressure_at(time);
+    item.ReportValue_1 = 33;
+    item.ReportValue_2 = 3;
+    item.ReportValue_3 = 0;
+    records++;
+    if (replay(&item, TEST_PRESSURE_DEADBAND, &pressureSent)) {
+      uint32_t seconds = time / TEST_SECOND;
+
+      longestGap = ((time - lastPressureSent) > longestGap) ? (time - lastPressureSent) : longestGap;
+      lastPressureSent = time;
+      stepSent = stepSent || (seconds == TEST_PRESSURE_STEP_AT);
+      stepBackSent = stepBackSent || (seconds == (TEST_PRESSURE_STEP_AT + TEST_PRESSURE_STEP_FOR));
+      if ((seconds > TEST_PRESSURE_RAMP_AT) && (seconds < (TEST_PRESSURE_RAMP_AT + TEST_PRESSURE_RAMP_FOR))) {
+        rampSent++;
+      }
+    }
+
+    // Temperature has no rule
+    item.ReportName = ReportName_Temperature;
+    item.ReportValue_0 = 215 + noise(1);
+    item.ReportValue_1 = 0;
+    item.ReportValue_2 = 0;
+    records++;
+    replay(&item, 0.0f, &temperatureSent);
+  }
+
+  sent = pressureSent + accelerationSent + temperatureSent;
+  printf("Report_Filter: %u records replayed, %u sent (%.1f%%): pressure %u of %u, "
+         "acceleration %u of %u, temperature %u of %u\n",
+         records, sent, (100.0 * sent) / records,
+         pressureSent, TEST_TRACE_LENGTH / TEST_PRESSURE_PERIOD,
+         accelerationSent, TEST_TRACE_LENGTH / TEST_ACCELERATION_PERIOD,
+         temperatureSent, TEST_TRACE_LENGTH / TEST_PRESSURE_PERIOD);
+
+  // Steps go out with the first sample that shows them, a ramp faster
+  // than the rate limit with every sample
+  HOST_TEST_CHECK(stepSent);
+  HOST_TEST_CHECK(stepBackSent);
+  HOST_TEST_CHECK(tapSent);
+  HOST_TEST_CHECK_EQUAL(rampSent, TEST_PRESSURE_RAMP_FOR - 1);
+
+  // The heartbeat bounds the time between pressure records
+  HOST_TEST_CHECK(longestGap <= (TEST_PRESSURE_HEARTBEAT * TEST_SECOND));
+
+  // Records without a rule all pass; the others are mostly suppressed
+  HOST_TEST_CHECK_EQUAL(temperatureSent, TEST_TRACE_LENGTH / TEST_PRESSURE_PERIOD);
+  HOST_TEST_CHECK((pressureSent * 10) < (TEST_TRACE_LENGTH / TEST_PRESSURE_PERIOD));
+  HOST_TEST_CHECK((accelerationSent * 100) < (TEST_TRACE_LENGTH / TEST_ACCELERATION_PERIOD));
+
+  HOST_TEST_CHECK(ReportFilter_ClearRule(ReportName_Pressure));
+  HOST_TEST_CHECK(ReportFilter_ClearRule(ReportName_Acceleration));
+  HOST_TEST_CHECK(!ReportFilter_ClearRule(ReportName_Acceleration));
+}
+
+
+/*************************************************************************
+* Function Name: command
+* Description:   Run a "filter" console line split into arguments
+* Parameters:    const char* line
+* Return:        bool - ReportFilter_Command's result
+*************************************************************************/
+static bool command(const char* line) {
+  char buffer[128];
+  char* argv[8];
+  int argc = 0;
+  char* token = NULL;
+
+  strncpy(buffer, line, sizeof(buffer) - 1);
+  buffer[sizeof(buffer) - 1] = '\0';
+  for (token = strtok(buffer, " "); (token != NULL) && (argc < 8); token = strtok(NULL, " ")) {
+    argv[argc++] = token;
+  }
+  return ReportFilter_Command(argc, argv);
+}
+
+
+/*************************************************************************
+* Function Name: test_command
+* Description:   Numbers must parse whole and fit; the largest floats
+*                print within the line
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_command() {
+  HOST_TEST_CHECK(!command("filter set abc 1 1 1"));
+  HOST_TEST_CHECK(!command("filter set 2x 1 1 1"));
+  HOST_TEST_CHECK(!command("filter set -2 1 1 1"));
+  HOST_TEST_CHECK(!command("filter set 99999999999 1 1 1"));
+  HOST_TEST_CHECK(!command("filter set 2 1 1 1 10ms"));
+  HOST_TEST_CHECK(!command("filter set 2 1 1 1 4294967295"));
+  HOST_TEST_CHECK(!command("filter set 2 nan 1 1"));
+  HOST_TEST_CHECK(!command("filter set 2 1 -1 1"));
+  HOST_TEST_CHECK(!command("filter set 2 1e39 1 1"));
+  HOST_TEST_CHECK(!command("filter set 2 1 1"));
+  HOST_TEST_CHECK(!command("filter clear 2?"));
+  HOST_TEST_CHECK(!command("filter"));
+
+  HOST_TEST_CHECK(command("filter set 2 1e38 1e38 1e38 400000"));
+  HOST_TEST_CHECK(command("filter list"));
+  HOST_TEST_CHECK(strlen(Host_Log_Line) < 64);
+  HOST_TEST_CHECK(strcmp(Host_Log_Line, "0002,1e+38,1e+38,1e+38,4000000,0,0\n") == 0);
+
+  HOST_TEST_CHECK(command("filter set 2 5 0 2.5 250"));
+  HOST_TEST_CHECK(command("filter list"));
+  HOST_TEST_CHECK(strcmp(Host_Log_Line, "0002,5,0,2.5,2500,0,0\n") == 0);
+
+  HOST_TEST_CHECK(command("filter clear 2"));
+  HOST_TEST_CHECK(command("filter clear 2"));
+  HOST_TEST_CHECK(strcmp(Host_Log_Line, "filter: no rule for 2\n") == 0);
+}
+
+
+int main() {
+  test_trace();
+  test_command();
+
+  return HostTest_Result("Report_Filter");
+}
@@ -0,0 +1,267 @@
+/**
+* @Filename: Test_Report_Statistics.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [12:50pm]
+* @Version:  1.0.0
+*
+* @Description: Host tests of Tasks/Report_Statistics.c: the Welford
+*               update against a two-pass double reference, including a
+*               large mean with a small spread, window boundaries and the
+*               update cost totals.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Tasks/Report_Statistics.h"
+#include "Tasks/Task_ReportData.h"
+
+#include "FreeRTOS.h"
+#include "Host_Test.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+#define TEST_NAME    42
+#define TEST_WINDOW  100
+#define TEST_SAMPLES 1000
+
+
+/************************************************
+* External variables
+************************************************/
+extern uint64_t ReportStatistics_Cycles_Total;
+extern uint32_t ReportStatistics_Cycles_Max;
+extern uint64_t ReportStatistics_Updates_Nbr;
+
+
+/************************************************
+* Local variables
+************************************************/
+volatile long int xPortSysTickCount = 0;
+
+ReportStatistics_Channel Test_Channel;
+float Test_Values[TEST_SAMPLES];
+
+// Summary records sent
+ReportData_Item Test_Record;
+uint32_t Test_Records = 0;
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: record_float
+* Description:   A value of the last summary record as a float
+* Parameters:    int32_t bits
+* Return:        float
+*************************************************************************/
+static float record_float(int32_t bits) {
+  float value = 0.0f;
+
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+
+/*************************************************************************
+* Function Name: check_window
+* Description:   Add Test_Values[0..count) within one window, close it and
+*                compare the record with a two-pass double reference
+* Parameters:    uint32_t count
+*                double relativeTolerance - of the standard deviation
+* Return:        void
+*************************************************************************/
+static void check_window(uint32_t count, double relativeTolerance) {
+  double mean = 0.0;
+  double squares = 0.0;
+  double deviation = 0.0;
+  float min = Test_Values[0];
+  float max = Test_Values[0];
+  uint32_t records = Test_Records;
+  uint32_t i = 0;
+
+  for (i = 0; i < count; ++i) {
+    mean += Test_Values[i];
+    min = (Test_Values[i] < min) ? Test_Values[i] : min;
+    max = (Test_Values[i] > max) ? Test_Values[i] : max;
+  }
+  mean /= count;
+  for (i = 0; i < count; ++i) {
+    squares += (Test_Values[i] - mean) * (Test_Values[i] - mean);
+  }
+  deviation = sqrt(squares / count);
+
+  ReportStatistics_Init(&Test_Channel, TEST_NAME, TEST_WINDOW);
+  for (i = 0; i < count; ++i) {
+    ReportStatistics_Add(&Test_Channel, Test_Values[i], xPortSysTickCount);
+  }
+  ReportStatistics_Flush(&Test_Channel, xPortSysTickCount);
+
+  HOST_TEST_CHECK_EQUAL(Test_Records, records + 1);
+  HOST_TEST_CHECK_EQUAL(Test_Record.ReportName, TEST_NAME);
+  HOST_TEST_CHECK_EQUAL(Test_Record.ReportValueType_Flg, 0b1111);
+  HOST_TEST_CHECK(record_float(Test_Record.ReportValue_0) == min);
+  HOST_TEST_CHECK(record_float(Test_Record.ReportValue_1) == max);
+  HOST_TEST_CHECK(fabs(record_float(Test_Record.ReportValue_2) - mean) <= (fabs(mean) * 1e-6));
+  HOST_TEST_CHECK(fabs(record_float(Test_Record.ReportValue_3) - deviation) <= (deviation * relativeTolerance));
+}
+
+
+/*************************************************************************
+* Function Name: test_welford
+* Description:   1..N, a constant, and pressure in Pa: a mean of ~101325
+*                with a spread of a few Pa, where summing squares in float
+*                loses every digit of the variance
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_welford() {
+  uint32_t i = 0;
+  float sum = 0.0f;
+  float sumSquares = 0.0f;
+  float naive = 0.0f;
+
+  for (i = 0; i < TEST_SAMPLES; ++i) {
+    Test_Values[i] = (float)(i + 1);
+  }
+  check_window(TEST_SAMPLES, 1e-4);
+
+  for (i = 0; i < TEST_SAMPLES; ++i) {
+    Test_Values[i] = 25.5f;
+  }
+  check_window(TEST_SAMPLES, 0.0);
+  HOST_TEST_CHECK(record_float(Test_Record.ReportValue_3) == 0.0f);
+
+  // Pressure: 101325 Pa +- 3 Pa in a repeating pattern
+  for (i = 0; i < TEST_SAMPLES; ++i) {
+    Test_Values[i] = 101325.0f + (float)((int32_t)((i * 5) % 7) - 3);
+  }
+  check_window(TEST_SAMPLES, 1e-3);
+
+  // The same values through a sum of squares in float give nonsense
+  for (i = 0; i < TEST_SAMPLES; ++i) {
+    sum += Test_Values[i];
+    sumSquares += Test_Values[i] * Test_Values[i];
+  }
+  naive = (sumSquares / TEST_SAMPLES) - (sum / TEST_SAMPLES) * (sum / TEST_SAMPLES);
+  HOST_TEST_CHECK(fabsf(sqrtf(fabsf(naive)) - record_float(Test_Record.ReportValue_3)) > 1.0f);
+
+  // One sample: no spread, min = max = mean
+  Test_Values[0] = -3.25f;
+  check_window(1, 0.0);
+}
+
+
+/*************************************************************************
+* Function Name: test_windows
+* Description:   A sample past the window sends the summary first, and
+*                windows stay TEST_WINDOW apart however late that sample
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_windows() {
+  uint32_t records = 0;
+
+  xPortSysTickCount = 1000;
+  ReportStatistics_Init(&Test_Channel, TEST_NAME, TEST_WINDOW);
+  records = Test_Records;
+
+  ReportStatistics_Add(&Test_Channel, 1.0f, 1000);
+  ReportStatistics_Add(&Test_Channel, 3.0f, 1099);
+  HOST_TEST_CHECK_EQUAL(Test_Records, records);
+
+  // 1130 closes [1000, 1100) and starts [1100, 1200)
+  ReportStatistics_Add(&Test_Channel, 5.0f, 1130);
+  HOST_TEST_CHECK_EQUAL(Test_Records, records + 1);
+  HOST_TEST_CHECK(record_float(Test_Record.ReportValue_2) == 2.0f);
+  HOST_TEST_CHECK_EQUAL(Test_Channel.windowStart, 1100);
+  HOST_TEST_CHECK_EQUAL(Test_Channel.count, 1);
+
+  // 1475 skips the empty windows and starts [1400, 1500)
+  ReportStatistics_Add(&Test_Channel, 7.0f, 1475);
+  HOST_TEST_CHECK_EQUAL(Test_Records, records + 2);
+  HOST_TEST_CHECK(record_float(Test_Record.ReportValue_2) == 5.0f);
+  HOST_TEST_CHECK_EQUAL(Test_Channel.windowStart, 1400);
+
+  // An empty window sends nothing
+  ReportStatistics_Flush(&Test_Channel, 1500);
+  ReportStatistics_Flush(&Test_Channel, 1600);
+  HOST_TEST_CHECK_EQUAL(Test_Records, records + 3);
+  HOST_TEST_CHECK_EQUAL(Test_Channel.windowStart, 1600);
+
+  // Across the tick count wrap
+  xPortSysTickCount = 0xFFFFFFF0;
+  ReportStatistics_Init(&Test_Channel, TEST_NAME, TEST_WINDOW);
+  ReportStatistics_Add(&Test_Channel, 1.0f, 0xFFFFFFF0);
+  ReportStatistics_Add(&Test_Channel, 1.0f, 0x50);
+  HOST_TEST_CHECK_EQUAL(Test_Records, records + 3);
+  ReportStatistics_Add(&Test_Channel, 1.0f, 0x60);
+  HOST_TEST_CHECK_EQUAL(Test_Records, records + 4);
+  HOST_TEST_CHECK_EQUAL(Test_Channel.windowStart, 0x54);
+}
+
+
+/*************************************************************************
+* Function Name: test_update_cost
+* Description:   The average stays right once the totals pass 32 bits
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_update_cost() {
+  uint32_t average = 0;
+  uint32_t max = 0;
+
+  ReportStatistics_Cycles_Total = 0;
+  ReportStatistics_Updates_Nbr = 0;
+  ReportStatistics_GetUpdateCost(&average, &max);
+  HOST_TEST_CHECK_EQUAL(average, 0);
+
+  // 100 cycles for each of 2^32 + 10 updates
+  ReportStatistics_Updates_Nbr = 0x10000000AULL;
+  ReportStatistics_Cycles_Total = ReportStatistics_Updates_Nbr * 100;
+  ReportStatistics_Cycles_Max = 250;
+  ReportStatistics_GetUpdateCost(&average, &max);
+  HOST_TEST_CHECK_EQUAL(average, 100);
+  HOST_TEST_CHECK_EQUAL(max, 250);
+
+  ReportStatistics_Init(&Test_Channel, TEST_NAME, TEST_WINDOW);
+  ReportStatistics_Add(&Test_Channel, 1.0f, xPortSysTickCount);
+  HOST_TEST_CHECK_EQUAL(ReportStatistics_Updates_Nbr, 0x10000000BULL);
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: ReportData_Send
+* Description:   Host stub, keeps the record in Test_Record
+* Parameters:    const ReportData_Item* theReport
+* Return:        BaseType_t (pdPASS)
+*************************************************************************/
+extern BaseType_t ReportData_Send(const ReportData_Item* theReport) {
+  Test_Record = *theReport;
+  Test_Records++;
+  return pdPASS;
+}
+
+
+int main() {
+  test_welford();
+  test_windows();
+  test_update_cost();
+
+  return HostTest_Result("Report_Statistics");
+}
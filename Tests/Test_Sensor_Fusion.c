@@ -0,0 +1,290 @@
+/**
+* @Filename: Test_Sensor_Fusion.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [11:00am]
+* @Version:  1.0.0
+*
+* @Description: Host tests of Tasks/Sensor_Fusion.c against known
+*               orientations: gyroscope integration, accelerometer and
+*               magnetometer convergence, and the AK8975 axis remap.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Tasks/Sensor_Fusion.h"
+
+#include "Host_Test.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+#define TEST_PI 3.14159265f
+
+// Gain used to converge within a few seconds. The filter then runs with
+// SENSOR_FUSION_BETA, whose smaller steps settle closer to the reference.
+#define TEST_FAST_BETA 0.5f
+#define TEST_SETTLE    1000
+
+// Magnetic field, 60 degree dip, in the earth frame (north, 0, down)
+#define TEST_FIELD_X 0.5f
+#define TEST_FIELD_Z 0.8660254f
+
+
+/************************************************
+* Local variables
+************************************************/
+SensorFusion_State Test_State;
+SensorFusion_State Test_Other;
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: is_close
+* Description:   |actual - expected| <= tolerance
+* Parameters:    float actual
+*                float expected
+*                float tolerance
+* Return:        bool
+*************************************************************************/
+static bool is_close(float actual, float expected, float tolerance) {
+  return fabsf(actual - expected) <= tolerance;
+}
+
+
+/*************************************************************************
+* Function Name: check_quaternion
+* Description:   The state is q0..q3, or its negation (same orientation)
+* Parameters:    const SensorFusion_State* state
+*                float q0, q1, q2, q3
+*                float tolerance
+* Return:        void
+*************************************************************************/
+static void check_quaternion(const SensorFusion_State* state, float q0, float q1, float q2, float q3, float tolerance) {
+  float sign = (state->q0 < 0.0f) ? -1.0f : 1.0f;
+
+  HOST_TEST_CHECK(is_close(sign * state->q0, q0, tolerance));
+  HOST_TEST_CHECK(is_close(sign * state->q1, q1, tolerance));
+  HOST_TEST_CHECK(is_close(sign * state->q2, q2, tolerance));
+  HOST_TEST_CHECK(is_close(sign * state->q3, q3, tolerance));
+  HOST_TEST_CHECK(is_close(state->q0 * state->q0 + state->q1 * state->q1 +
+                        state->q2 * state->q2 + state->q3 * state->q3, 1.0f, 1e-5f));
+}
+
+
+/*************************************************************************
+* Function Name: test_at_rest
+* Description:   Level and still, the identity orientation does not move
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_at_rest() {
+  float roll = 1.0f;
+  float pitch = 1.0f;
+  float yaw = 1.0f;
+  uint32_t i = 0;
+
+  SensorFusion_Init(&Test_State, SENSOR_FUSION_SAMPLE_RATE_HZ, SENSOR_FUSION_BETA);
+  for (i = 0; i < 1000; ++i) {
+    SensorFusion_UpdateMARG(&Test_State, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 9.81f,
+                            TEST_FIELD_X, 0.0f, TEST_FIELD_Z);
+  }
+  check_quaternion(&Test_State, 1.0f, 0.0f, 0.0f, 0.0f, 1e-6f);
+
+  SensorFusion_GetEuler(&Test_State, &roll, &pitch, &yaw);
+  HOST_TEST_CHECK(is_close(roll, 0.0f, 1e-4f));
+  HOST_TEST_CHECK(is_close(pitch, 0.0f, 1e-4f));
+  HOST_TEST_CHECK(is_close(yaw, 0.0f, 1e-4f));
+}
+
+
+/*************************************************************************
+* Function Name: test_gyroscope
+* Description:   Without accelerometer and magnetometer the filter
+*                integrates the gyroscope: 90 deg/s for one second about
+*                each axis
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_gyroscope() {
+  const float rate = TEST_PI / 2.0f;
+  const float half = 0.70710678f;
+  float roll = 0.0f;
+  float pitch = 0.0f;
+  float yaw = 0.0f;
+  uint32_t i = 0;
+
+  SensorFusion_Init(&Test_State, SENSOR_FUSION_SAMPLE_RATE_HZ, SENSOR_FUSION_BETA);
+  for (i = 0; i < SENSOR_FUSION_SAMPLE_RATE_HZ; ++i) {
+    SensorFusion_UpdateIMU(&Test_State, 0.0f, 0.0f, rate, 0.0f, 0.0f, 0.0f);
+  }
+  check_quaternion(&Test_State, half, 0.0f, 0.0f, half, 1e-3f);
+  SensorFusion_GetEuler(&Test_State, &roll, &pitch, &yaw);
+  HOST_TEST_CHECK(is_close(yaw, 90.0f, 0.1f));
+
+  SensorFusion_Init(&Test_State, SENSOR_FUSION_SAMPLE_RATE_HZ, SENSOR_FUSION_BETA);
+  for (i = 0; i < SENSOR_FUSION_SAMPLE_RATE_HZ; ++i) {
+    SensorFusion_UpdateIMU(&Test_State, rate, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+  }
+  check_quaternion(&Test_State, half, half, 0.0f, 0.0f, 1e-3f);
+  SensorFusion_GetEuler(&Test_State, &roll, &pitch, &yaw);
+  HOST_TEST_CHECK(is_close(roll, 90.0f, 0.1f));
+
+  // Pitch is clamped at the pole instead of returning NaN
+  SensorFusion_Init(&Test_State, SENSOR_FUSION_SAMPLE_RATE_HZ, SENSOR_FUSION_BETA);
+  for (i = 0; i < SENSOR_FUSION_SAMPLE_RATE_HZ; ++i) {
+    SensorFusion_UpdateIMU(&Test_State, 0.0f, rate, 0.0f, 0.0f, 0.0f, 0.0f);
+  }
+  check_quaternion(&Test_State, half, 0.0f, half, 0.0f, 1e-3f);
+  SensorFusion_GetEuler(&Test_State, &roll, &pitch, &yaw);
+  HOST_TEST_CHECK(!isnan(pitch));
+  HOST_TEST_CHECK(is_close(pitch, 90.0f, 0.5f));
+}
+
+
+/*************************************************************************
+* Function Name: test_accelerometer
+* Description:   Gravity measured 30 degrees off in roll, then in pitch,
+*                the IMU update settles on that tilt
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_accelerometer() {
+  const float angle = TEST_PI / 6.0f;
+  float roll = 0.0f;
+  float pitch = 0.0f;
+  float yaw = 0.0f;
+  uint32_t i = 0;
+
+  // Rolled by +30 degrees, gravity is (0, sin, cos) in the sensor frame
+  SensorFusion_Init(&Test_State, SENSOR_FUSION_SAMPLE_RATE_HZ, TEST_FAST_BETA);
+  for (i = 0; i < (2 * TEST_SETTLE); ++i) {
+    Test_State.beta = (i < TEST_SETTLE) ? TEST_FAST_BETA : SENSOR_FUSION_BETA;
+    SensorFusion_UpdateIMU(&Test_State, 0.0f, 0.0f, 0.0f,
+                           0.0f, 9.81f * sinf(angle), 9.81f * cosf(angle));
+  }
+  check_quaternion(&Test_State, cosf(angle / 2.0f), sinf(angle / 2.0f), 0.0f, 0.0f, 1e-3f);
+  SensorFusion_GetEuler(&Test_State, &roll, &pitch, &yaw);
+  HOST_TEST_CHECK(is_close(roll, 30.0f, 0.1f));
+  HOST_TEST_CHECK(is_close(pitch, 0.0f, 0.1f));
+
+  // Pitched by +30 degrees, gravity is (-sin, 0, cos)
+  SensorFusion_Init(&Test_State, SENSOR_FUSION_SAMPLE_RATE_HZ, TEST_FAST_BETA);
+  for (i = 0; i < (2 * TEST_SETTLE); ++i) {
+    Test_State.beta = (i < TEST_SETTLE) ? TEST_FAST_BETA : SENSOR_FUSION_BETA;
+    SensorFusion_UpdateIMU(&Test_State, 0.0f, 0.0f, 0.0f,
+                           -9.81f * sinf(angle), 0.0f, 9.81f * cosf(angle));
+  }
+  check_quaternion(&Test_State, cosf(angle / 2.0f), 0.0f, sinf(angle / 2.0f), 0.0f, 1e-3f);
+  SensorFusion_GetEuler(&Test_State, &roll, &pitch, &yaw);
+  HOST_TEST_CHECK(is_close(roll, 0.0f, 0.1f));
+  HOST_TEST_CHECK(is_close(pitch, 30.0f, 0.1f));
+}
+
+
+/*************************************************************************
+* Function Name: test_magnetometer
+* Description:   Level, with the field measured as seen 45 degrees east
+*                of north, the MARG update settles on that heading. An all
+*                zero magnetometer reading is an IMU update.
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_magnetometer() {
+  const float heading = TEST_PI / 4.0f;
+  float roll = 0.0f;
+  float pitch = 0.0f;
+  float yaw = 0.0f;
+  uint32_t i = 0;
+
+  SensorFusion_Init(&Test_State, SENSOR_FUSION_SAMPLE_RATE_HZ, TEST_FAST_BETA);
+  for (i = 0; i < (2 * TEST_SETTLE); ++i) {
+    Test_State.beta = (i < TEST_SETTLE) ? TEST_FAST_BETA : SENSOR_FUSION_BETA;
+    SensorFusion_UpdateMARG(&Test_State, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 9.81f,
+                            TEST_FIELD_X * cosf(heading), -TEST_FIELD_X * sinf(heading), TEST_FIELD_Z);
+  }
+  check_quaternion(&Test_State, cosf(heading / 2.0f), 0.0f, 0.0f, sinf(heading / 2.0f), 1e-3f);
+  SensorFusion_GetEuler(&Test_State, &roll, &pitch, &yaw);
+  HOST_TEST_CHECK(is_close(yaw, 45.0f, 0.1f));
+
+  SensorFusion_Init(&Test_State, SENSOR_FUSION_SAMPLE_RATE_HZ, SENSOR_FUSION_BETA);
+  SensorFusion_Init(&Test_Other, SENSOR_FUSION_SAMPLE_RATE_HZ, SENSOR_FUSION_BETA);
+  for (i = 0; i < 100; ++i) {
+    SensorFusion_UpdateMARG(&Test_State, 0.1f, 0.2f, 0.3f, 1.0f, 2.0f, 9.0f, 0.0f, 0.0f, 0.0f);
+    SensorFusion_UpdateIMU(&Test_Other, 0.1f, 0.2f, 0.3f, 1.0f, 2.0f, 9.0f);
+  }
+  HOST_TEST_CHECK(Test_State.q0 == Test_Other.q0);
+  HOST_TEST_CHECK(Test_State.q1 == Test_Other.q1);
+  HOST_TEST_CHECK(Test_State.q2 == Test_Other.q2);
+  HOST_TEST_CHECK(Test_State.q3 == Test_Other.q3);
+}
+
+
+/*************************************************************************
+* Function Name: test_ak8975_remap
+* Description:   The same field read in AK8975 axes (X and Y swapped, Z
+*                reversed) gives the same heading, and exactly the same
+*                update as the MARG one in accelerometer axes
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_ak8975_remap() {
+  const float heading = TEST_PI / 4.0f;
+  const float northX = TEST_FIELD_X * cosf(heading);
+  const float northY = -TEST_FIELD_X * sinf(heading);
+  float roll = 0.0f;
+  float pitch = 0.0f;
+  float yaw = 0.0f;
+  uint32_t i = 0;
+
+  SensorFusion_Init(&Test_State, SENSOR_FUSION_SAMPLE_RATE_HZ, TEST_FAST_BETA);
+  for (i = 0; i < (2 * TEST_SETTLE); ++i) {
+    Test_State.beta = (i < TEST_SETTLE) ? TEST_FAST_BETA : SENSOR_FUSION_BETA;
+    SensorFusion_UpdateMPU9150(&Test_State, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 9.81f,
+                               northY, northX, -TEST_FIELD_Z);
+  }
+  check_quaternion(&Test_State, cosf(heading / 2.0f), 0.0f, 0.0f, sinf(heading / 2.0f), 1e-3f);
+  SensorFusion_GetEuler(&Test_State, &roll, &pitch, &yaw);
+  HOST_TEST_CHECK(is_close(yaw, 45.0f, 0.1f));
+
+  // Read without the remap, the field would point elsewhere
+  SensorFusion_Init(&Test_Other, SENSOR_FUSION_SAMPLE_RATE_HZ, TEST_FAST_BETA);
+  for (i = 0; i < (2 * TEST_SETTLE); ++i) {
+    SensorFusion_UpdateMARG(&Test_Other, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 9.81f,
+                            northY, northX, -TEST_FIELD_Z);
+  }
+  SensorFusion_GetEuler(&Test_Other, &roll, &pitch, &yaw);
+  HOST_TEST_CHECK(!is_close(yaw, 45.0f, 1.0f));
+
+  SensorFusion_Init(&Test_State, SENSOR_FUSION_SAMPLE_RATE_HZ, SENSOR_FUSION_BETA);
+  SensorFusion_Init(&Test_Other, SENSOR_FUSION_SAMPLE_RATE_HZ, SENSOR_FUSION_BETA);
+  for (i = 0; i < 100; ++i) {
+    SensorFusion_UpdateMPU9150(&Test_State, 0.1f, 0.2f, 0.3f, 1.0f, 2.0f, 9.0f, 0.4f, 0.5f, 0.6f);
+    SensorFusion_UpdateMARG(&Test_Other, 0.1f, 0.2f, 0.3f, 1.0f, 2.0f, 9.0f, 0.5f, 0.4f, -0.6f);
+  }
+  HOST_TEST_CHECK(Test_State.q0 == Test_Other.q0);
+  HOST_TEST_CHECK(Test_State.q1 == Test_Other.q1);
+  HOST_TEST_CHECK(Test_State.q2 == Test_Other.q2);
+  HOST_TEST_CHECK(Test_State.q3 == Test_Other.q3);
+}
+
+
+int main() {
+  test_at_rest();
+  test_gyroscope();
+  test_accelerometer();
+  test_magnetometer();
+  test_ak8975_remap();
+
+  return HostTest_Result("Sensor_Fusion");
+}
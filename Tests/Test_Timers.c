@@ -0,0 +1,626 @@
+/**
+* @Filename: Test_Timers.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [2:40pm]
+* @Version:  1.0.0
+*
+* @Description: Host test and benchmark of Source/timers.c, built once
+*               with the sorted timer lists and once with the timing wheel
+*               (configUSE_TIMER_WHEEL).
+*
+*               timers.c is included here, so the timer service task's
+*               loop body can be run one pass at a time on a simulated
+*               tick count. The task and queue functions it calls are
+*               fakes below: the timer task has the highest priority, so it
+*               handles each command as soon as it is sent, and blocking
+*               moves the tick count on to the time it would wake.
+*
+*               With 10, 100 and 1000 timers of random periods, some
+*               beyond the wheel's span, and random resets, stops and
+*               period changes, every callback must come at the exact tick
+*               it is due, across a tick count overflow. The benchmark
+*               prints the host time to start a timer behind every active
+*               timer and per expiry.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Source/timers.c"
+
+#include "Host_Test.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+#if ( configUSE_TIMER_WHEEL == 1 )
+#define TEST_STORE "wheel"
+#else
+#define TEST_STORE "list"
+#endif
+
+const uint32_t TEST_COUNTS[] = { 10, 100, 1000 };
+#define TEST_COUNTS_NBR (sizeof(TEST_COUNTS) / sizeof(TEST_COUNTS[0]))
+#define TEST_COUNT_MAX  1000
+
+// Periods in ticks: short, up to the third wheel level, and beyond the
+// 2^20 tick span of a 4 level wheel
+#define TEST_SHORT_MIN  100
+#define TEST_SHORT_MAX  5000
+#define TEST_MEDIUM_MAX 200000
+#define TEST_FAR_MIN    1100000
+#define TEST_FAR_MAX    2000000
+
+// The run starts this far before the tick count overflows and lasts
+// long enough for the far timers to expire after it
+#define TEST_BEFORE_OVERFLOW 1000000
+#define TEST_RUN_TICKS       2500000
+
+// Ticks between the commands a task sends while the timers run
+#define TEST_COMMAND_INTERVAL 613
+
+// Benchmark: active timer periods in [TEST_BENCH_PERIOD, 2 * TEST_BENCH_PERIOD)
+#define TEST_BENCH_PERIOD  1000
+#define TEST_BENCH_STARTS  20000
+#define TEST_BENCH_TICKS   200000
+
+// Fake timer queue
+#define TEST_QUEUE_BYTES 1024
+
+
+/************************************************
+* Local types
+************************************************/
+typedef struct Test_Timer {
+  TimerHandle_t handle;
+  TickType_t period;
+  bool autoReload;
+  bool active;
+  TickType_t expected;  // tick of the next callback while active
+  uint32_t fires;
+} Test_Timer;
+
+
+/************************************************
+* Local variables
+************************************************/
+volatile TickType_t Test_Tick = 0;
+uint32_t Test_Random = 1;
+
+Test_Timer Test_Timers[TEST_COUNT_MAX];
+uint32_t Test_Count = 0;
+uint32_t Test_Callbacks = 0;
+uint32_t Test_Late = 0;
+
+// Set by vQueueWaitForMessageRestricted when the timer task blocks
+bool Test_Blocked = false;
+TickType_t Test_BlockTicks = 0;
+bool Test_BlockIndefinitely = false;
+
+// The fake timer queue holds one queue's items
+uint8_t Test_Queue[TEST_QUEUE_BYTES];
+UBaseType_t Test_QueueLength = 0;
+UBaseType_t Test_QueueItemSize = 0;
+UBaseType_t Test_QueueHead = 0;
+UBaseType_t Test_QueueCount = 0;
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: random_below
+* Description:   Repeatable random number
+* Parameters:    uint32_t limit
+* Return:        uint32_t - 0 .. limit - 1
+*************************************************************************/
+static uint32_t random_below(uint32_t limit) {
+  Test_Random = (Test_Random * 1664525) + 1013904223;
+  return (uint32_t)(((uint64_t)(Test_Random >> 8) * limit) >> 24);
+}
+
+
+/*************************************************************************
+* Function Name: random_period
+* Description:   60% short, 30% medium and 10% far periods
+* Parameters:    N/A
+* Return:        TickType_t
+*************************************************************************/
+static TickType_t random_period() {
+  uint32_t kind = random_below(10);
+
+  if (kind < 6) {
+    return TEST_SHORT_MIN + random_below(TEST_SHORT_MAX - TEST_SHORT_MIN);
+  }
+  if (kind < 9) {
+    return TEST_SHORT_MAX + random_below(TEST_MEDIUM_MAX - TEST_SHORT_MAX);
+  }
+  return TEST_FAR_MIN + random_below(TEST_FAR_MAX - TEST_FAR_MIN);
+}
+
+
+/*************************************************************************
+* Function Name: timer_callback
+* Description:   A timer expired: it must be due now
+* Parameters:    TimerHandle_t xTimer
+* Return:        void
+*************************************************************************/
+static void timer_callback(TimerHandle_t xTimer) {
+  Test_Timer* timer = &Test_Timers[(uintptr_t)pvTimerGetTimerID(xTimer)];
+
+  Test_Callbacks++;
+  timer->fires++;
+  if (!timer->active || (timer->expected != Test_Tick)) {
+    Test_Late++;
+  }
+  if (timer->autoReload) {
+    timer->expected = Test_Tick + timer->period;
+  }
+  else {
+    timer->active = false;
+  }
+}
+
+
+/*************************************************************************
+* Function Name: daemon_commands
+* Description:   The timer task preempts the sender and handles the
+*                commands at once
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void daemon_commands() {
+  prvProcessReceivedCommands();
+}
+
+
+/*************************************************************************
+* Function Name: daemon_run
+* Description:   Run the timer task until it blocks at xEnd. Every
+*                interval ticks, until then, onTick is called with the
+*                task blocked, as a lower priority task would.
+* Parameters:    TickType_t xEnd
+*                TickType_t interval - 0 for none
+*                void (*onTick)(void)
+* Return:        void
+*************************************************************************/
+static void daemon_run(TickType_t xEnd, TickType_t interval, void (*onTick)(void)) {
+  TickType_t xNextCommand = Test_Tick + interval;
+  uint32_t spins = 0;
+
+  for (;;) {
+    TickType_t xNextExpireTime;
+    BaseType_t xListWasEmpty;
+    TickType_t remaining = xEnd - Test_Tick;
+    TickType_t delay = 0;
+
+    Test_Blocked = false;
+    xNextExpireTime = prvGetNextExpireTime(&xListWasEmpty);
+    prvProcessTimerOrBlockTask(xNextExpireTime, xListWasEmpty);
+    prvProcessReceivedCommands();
+    if (!Test_Blocked) {
+      continue;
+    }
+
+    if ((interval > 0) && (Test_Tick == xNextCommand) && (remaining > 0)) {
+      onTick();
+      xNextCommand += interval;
+      continue;
+    }
+    if (remaining == 0) {
+      break;
+    }
+
+    delay = Test_BlockIndefinitely ? remaining : Test_BlockTicks;
+    delay = (delay < remaining) ? delay : remaining;
+    if ((interval > 0) && ((xNextCommand - Test_Tick) < delay)) {
+      delay = xNextCommand - Test_Tick;
+    }
+
+    // A block of 0 ticks returns at once; it must not repeat
+    if (delay == 0) {
+      spins++;
+      HOST_TEST_CHECK(spins < 3);
+      delay = 1;
+    }
+    else {
+      spins = 0;
+    }
+    Test_Tick += delay;
+  }
+}
+
+
+/*************************************************************************
+* Function Name: random_command
+* Description:   A task resets, stops, restarts or changes the period of a
+*                random timer
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void random_command() {
+  Test_Timer* timer = &Test_Timers[random_below(Test_Count)];
+  uint32_t action = random_below(4);
+
+  if (action == 0) {
+    HOST_TEST_CHECK(xTimerStop(timer->handle, 0) == pdPASS);
+    timer->active = false;
+  }
+  else if (action == 1) {
+    timer->period = random_period();
+    HOST_TEST_CHECK(xTimerChangePeriod(timer->handle, timer->period, 0) == pdPASS);
+    timer->active = true;
+    timer->expected = Test_Tick + timer->period;
+  }
+  else {
+    HOST_TEST_CHECK(xTimerReset(timer->handle, 0) == pdPASS);
+    timer->active = true;
+    timer->expected = Test_Tick + timer->period;
+  }
+  daemon_commands();
+}
+
+
+/*************************************************************************
+* Function Name: create_timers
+* Description:   Create count timers, half of them auto-reload, and start
+*                them now
+* Parameters:    uint32_t count
+*                bool benchmark - periods in [TEST_BENCH_PERIOD, 2x), all
+*                                 auto-reload
+* Return:        void
+*************************************************************************/
+static void create_timers(uint32_t count, bool benchmark) {
+  uint32_t i = 0;
+
+  Test_Count = count;
+  for (i = 0; i < count; ++i) {
+    Test_Timer* timer = &Test_Timers[i];
+
+    memset(timer, 0, sizeof(Test_Timer));
+    timer->period = benchmark ? (TEST_BENCH_PERIOD + random_below(TEST_BENCH_PERIOD)) : random_period();
+    timer->autoReload = benchmark || (random_below(2) == 0);
+    timer->handle = xTimerCreate("test", timer->period, timer->autoReload ? pdTRUE : pdFALSE,
+                                 (void*)(uintptr_t)i, timer_callback);
+    HOST_TEST_CHECK(timer->handle != NULL);
+    HOST_TEST_CHECK(xTimerStart(timer->handle, 0) == pdPASS);
+    timer->active = true;
+    timer->expected = Test_Tick + timer->period;
+    daemon_commands();
+  }
+}
+
+
+/*************************************************************************
+* Function Name: delete_timers
+* Description:   Delete the timers of create_timers
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void delete_timers() {
+  uint32_t i = 0;
+
+  for (i = 0; i < Test_Count; ++i) {
+    HOST_TEST_CHECK(xTimerDelete(Test_Timers[i].handle, 0) == pdPASS);
+    daemon_commands();
+  }
+  Test_Count = 0;
+}
+
+
+/*************************************************************************
+* Function Name: elapsed_ns
+* Description:   Host time since start
+* Parameters:    const struct timespec* start
+* Return:        double - ns
+*************************************************************************/
+static double elapsed_ns(const struct timespec* start) {
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return ((double)(now.tv_sec - start->tv_sec) * 1e9) + (double)(now.tv_nsec - start->tv_nsec);
+}
+
+
+/*************************************************************************
+* Function Name: test_expiry
+* Description:   count timers run across the tick count overflow with
+*                random commands; each callback comes when it is due and
+*                no active timer is overdue at the end
+* Parameters:    uint32_t count
+* Return:        void
+*************************************************************************/
+static void test_expiry(uint32_t count) {
+  uint32_t i = 0;
+  uint32_t callbacks = Test_Callbacks;
+  uint32_t late = Test_Late;
+
+  Test_Tick = (TickType_t)0U - TEST_BEFORE_OVERFLOW;
+  create_timers(count, false);
+  daemon_run(Test_Tick + TEST_RUN_TICKS, TEST_COMMAND_INTERVAL, random_command);
+
+  HOST_TEST_CHECK_EQUAL(Test_Late, late);
+  HOST_TEST_CHECK(Test_Callbacks > callbacks);
+  for (i = 0; i < count; ++i) {
+    Test_Timer* timer = &Test_Timers[i];
+
+    HOST_TEST_CHECK_EQUAL(xTimerIsTimerActive(timer->handle) != pdFALSE, timer->active);
+    if (timer->active) {
+      HOST_TEST_CHECK(((timer->expected - Test_Tick) > 0) && ((timer->expected - Test_Tick) <= timer->period));
+    }
+  }
+  printf("Timers (%s): %u timers, %u callbacks across the tick overflow\n", TEST_STORE, count,
+         Test_Callbacks - callbacks);
+  delete_timers();
+}
+
+
+/*************************************************************************
+* Function Name: test_overflow_edges
+* Description:   Timers due exactly at, and one tick either side of, the
+*                tick count overflow; and one started just before it that
+*                is due after it
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_overflow_edges() {
+  const TickType_t periods[] = { 9, 10, 11, 25, 1100000 };
+  uint32_t late = Test_Late;
+  uint32_t i = 0;
+
+  Test_Tick = (TickType_t)0U - 10;
+  Test_Count = sizeof(periods) / sizeof(periods[0]);
+  for (i = 0; i < Test_Count; ++i) {
+    Test_Timer* timer = &Test_Timers[i];
+
+    memset(timer, 0, sizeof(Test_Timer));
+    timer->period = periods[i];
+    timer->handle = xTimerCreate("edge", timer->period, pdFALSE, (void*)(uintptr_t)i, timer_callback);
+    HOST_TEST_CHECK(xTimerStart(timer->handle, 0) == pdPASS);
+    timer->active = true;
+    timer->expected = Test_Tick + timer->period;
+    daemon_commands();
+  }
+
+  daemon_run(Test_Tick + 1100000, 0, NULL);
+  for (i = 0; i < Test_Count; ++i) {
+    HOST_TEST_CHECK_EQUAL(Test_Timers[i].fires, 1);
+    HOST_TEST_CHECK(!Test_Timers[i].active);
+  }
+  HOST_TEST_CHECK_EQUAL(Test_Late, late);
+  delete_timers();
+}
+
+
+/*************************************************************************
+* Function Name: bench
+* Description:   With count auto-reload timers active, the host time to
+*                start a timer due after all of them (the longest sorted
+*                insert) and per expiry
+* Parameters:    uint32_t count
+* Return:        void
+*************************************************************************/
+static void bench(uint32_t count) {
+  struct timespec start;
+  TimerHandle_t probe = NULL;
+  uint32_t callbacks = 0;
+  double startNs = 0.0;
+  double expireNs = 0.0;
+  uint32_t i = 0;
+
+  Test_Tick = 0;
+  create_timers(count, true);
+  probe = xTimerCreate("probe", 3 * TEST_BENCH_PERIOD, pdFALSE, (void*)(uintptr_t)0, timer_callback);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (i = 0; i < TEST_BENCH_STARTS; ++i) {
+    xTimerStart(probe, 0);
+    daemon_commands();
+  }
+  startNs = elapsed_ns(&start) / TEST_BENCH_STARTS;
+  xTimerDelete(probe, 0);
+  daemon_commands();
+
+  callbacks = Test_Callbacks;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  daemon_run(Test_Tick + TEST_BENCH_TICKS, 0, NULL);
+  expireNs = elapsed_ns(&start) / (Test_Callbacks - callbacks);
+
+  printf("Timers (%s): %4u active: start %6.1f ns, per expiry %6.1f ns (host)\n", TEST_STORE, count,
+         startNs, expireNs);
+  delete_timers();
+}
+
+
+/************************************************
+* Function definitions: kernel fakes
+************************************************/
+
+/*************************************************************************
+* Function Name: xTaskGetTickCount
+* Description:   Simulated tick count
+* Parameters:    N/A
+* Return:        TickType_t
+*************************************************************************/
+TickType_t xTaskGetTickCount(void) {
+  return Test_Tick;
+}
+
+
+/*************************************************************************
+* Function Name: vTaskSuspendAll / xTaskResumeAll / xTaskGetSchedulerState
+* Description:   One thread, nothing to suspend; no yield is pending
+*************************************************************************/
+void vTaskSuspendAll(void) {
+}
+
+BaseType_t xTaskResumeAll(void) {
+  return pdTRUE;
+}
+
+BaseType_t xTaskGetSchedulerState(void) {
+  return taskSCHEDULER_RUNNING;
+}
+
+
+/*************************************************************************
+* Function Name: xTaskGenericCreate
+* Description:   The timer task is not created; daemon_run is its loop
+*************************************************************************/
+BaseType_t xTaskGenericCreate(TaskFunction_t pxTaskCode, const char* const pcName, const uint16_t usStackDepth,
+                              void* const pvParameters, UBaseType_t uxPriority, TaskHandle_t* const pxCreatedTask,
+                              StackType_t* const puxStackBuffer, const MemoryRegion_t* const xRegions) {
+  (void)pxTaskCode;
+  (void)pcName;
+  (void)usStackDepth;
+  (void)pvParameters;
+  (void)uxPriority;
+  (void)pxCreatedTask;
+  (void)puxStackBuffer;
+  (void)xRegions;
+  return pdFAIL;
+}
+
+
+/*************************************************************************
+* Function Name: xQueueGenericCreate
+* Description:   The timer queue, a ring of bytes
+*************************************************************************/
+QueueHandle_t xQueueGenericCreate(const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize,
+                                  const uint8_t ucQueueType) {
+  (void)ucQueueType;
+  configASSERT((uxQueueLength * uxItemSize) <= TEST_QUEUE_BYTES);
+  Test_QueueLength = uxQueueLength;
+  Test_QueueItemSize = uxItemSize;
+  return (QueueHandle_t)Test_Queue;
+}
+
+
+/*************************************************************************
+* Function Name: xQueueGenericSend / xQueueGenericSendFromISR
+* Description:   Append a command; never blocks
+*************************************************************************/
+BaseType_t xQueueGenericSend(QueueHandle_t xQueue, const void* const pvItemToQueue, TickType_t xTicksToWait,
+                             const BaseType_t xCopyPosition) {
+  UBaseType_t tail = (Test_QueueHead + Test_QueueCount) % Test_QueueLength;
+
+  (void)xQueue;
+  (void)xTicksToWait;
+  (void)xCopyPosition;
+  if (Test_QueueCount == Test_QueueLength) {
+    return errQUEUE_FULL;
+  }
+  memcpy(&Test_Queue[tail * Test_QueueItemSize], pvItemToQueue, Test_QueueItemSize);
+  Test_QueueCount++;
+  return pdPASS;
+}
+
+BaseType_t xQueueGenericSendFromISR(QueueHandle_t xQueue, const void* const pvItemToQueue,
+                                    BaseType_t* const pxHigherPriorityTaskWoken, const BaseType_t xCopyPosition) {
+  (void)pxHigherPriorityTaskWoken;
+  return xQueueGenericSend(xQueue, pvItemToQueue, 0, xCopyPosition);
+}
+
+
+/*************************************************************************
+* Function Name: xQueueGenericReceive
+* Description:   Take the oldest command; never blocks
+*************************************************************************/
+BaseType_t xQueueGenericReceive(QueueHandle_t xQueue, void* const pvBuffer, TickType_t xTicksToWait,
+                                const BaseType_t xJustPeek) {
+  (void)xQueue;
+  (void)xTicksToWait;
+  if (Test_QueueCount == 0) {
+    return pdFAIL;
+  }
+  memcpy(pvBuffer, &Test_Queue[Test_QueueHead * Test_QueueItemSize], Test_QueueItemSize);
+  if (!xJustPeek) {
+    Test_QueueHead = (Test_QueueHead + 1) % Test_QueueLength;
+    Test_QueueCount--;
+  }
+  return pdPASS;
+}
+
+
+/*************************************************************************
+* Function Name: vQueueWaitForMessageRestricted
+* Description:   The timer task blocks, unless a command is waiting
+*************************************************************************/
+void vQueueWaitForMessageRestricted(QueueHandle_t xQueue, TickType_t xTicksToWait,
+                                    const BaseType_t xWaitIndefinitely) {
+  (void)xQueue;
+  if (Test_QueueCount == 0) {
+    Test_Blocked = true;
+    Test_BlockTicks = xTicksToWait;
+    Test_BlockIndefinitely = (xWaitIndefinitely != pdFALSE);
+  }
+}
+
+
+/*************************************************************************
+* Function Name: pvPortMalloc / vPortFree
+* Description:   The C heap
+*************************************************************************/
+void* pvPortMalloc(size_t xSize) {
+  return malloc(xSize);
+}
+
+void vPortFree(void* pv) {
+  free(pv);
+}
+
+
+/*************************************************************************
+* Function Name: port critical sections and yield
+* Description:   One thread, nothing to mask
+*************************************************************************/
+void vPortEnterCritical(void) {
+}
+
+void vPortExitCritical(void) {
+}
+
+void vPortDisableInterrupts(void) {
+}
+
+void vPortEnableInterrupts(void) {
+}
+
+uint32_t ulPortSetInterruptMask(void) {
+  return 0;
+}
+
+void vPortClearInterruptMask(uint32_t ulNewMask) {
+  (void)ulNewMask;
+}
+
+void vPortYield(void) {
+}
+
+
+int main() {
+  uint32_t i = 0;
+
+  test_overflow_edges();
+  for (i = 0; i < TEST_COUNTS_NBR; ++i) {
+    test_expiry(TEST_COUNTS[i]);
+  }
+  for (i = 0; i < TEST_COUNTS_NBR; ++i) {
+    bench(TEST_COUNTS[i]);
+  }
+
+  return HostTest_Result("Timers (" TEST_STORE ")");
+}
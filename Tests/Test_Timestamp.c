@@ -0,0 +1,302 @@
+/**
+* @Filename: Test_Timestamp.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [3:40pm]
+* @Version:  1.0.0
+*
+* @Description: Host test of Drivers/Timestamp.c, the merge of the
+*               64-bit tick count with SysTick's current value.
+*
+*               Timestamp_HostRead models SysTick at the CPU clock: each
+*               register read lets a random few cycles pass, and each
+*               reload either runs the tick interrupt at once (the caller
+*               is a task) or sets PENDSTSET until the read is over (the
+*               caller masks interrupts). Reads start just before reloads
+*               and just before xPortSysTickCount wraps into
+*               xPortSysTickCountHigh.
+*
+*               Every reading must lie between the true time at the start
+*               of the read, less one SysTick count, and the true time at
+*               its end, and readings must never go backwards.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Drivers/Timestamp.h"
+
+#include "Host_Test.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+// Cycles each register read takes, at most
+#define TEST_READ_CYCLES 40
+
+// Reads start up to this many cycles before a reload
+#define TEST_BEFORE_RELOAD 120
+
+// Ticks before xPortSysTickCount wraps at the first read
+#define TEST_BEFORE_WRAP 20
+
+// Reads per mode
+#define TEST_READS 200000
+
+
+/************************************************
+* Local variables
+************************************************/
+volatile uint32_t xPortSysTickCount = 0;
+volatile uint32_t xPortSysTickCountHigh = 0;
+
+// Cycles since tick 0 of the model; tick count = Test_BaseTicks + cycles / counts
+uint64_t Test_Cycles = 0;
+uint64_t Test_BaseTicks = 0;
+uint64_t Test_ServicedTicks = 0;
+bool Test_Masked = false;
+bool Test_Pending = false;
+uint32_t Test_Random = 1;
+
+uint32_t Test_PendingSeen = 0;
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: random_below
+* Description:   Repeatable random number
+* Parameters:    uint32_t limit
+* Return:        uint32_t - 0 .. limit - 1
+*************************************************************************/
+static uint32_t random_below(uint32_t limit) {
+  Test_Random = (Test_Random * 1664525) + 1013904223;
+  return (uint32_t)(((uint64_t)(Test_Random >> 8) * limit) >> 24);
+}
+
+
+/*************************************************************************
+* Function Name: tick_interrupt
+* Description:   xPortSysTickHandler's update of the 64-bit tick count
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void tick_interrupt() {
+  if (++xPortSysTickCount == 0) {
+    xPortSysTickCountHigh++;
+  }
+  Test_ServicedTicks++;
+}
+
+
+/*************************************************************************
+* Function Name: advance
+* Description:   Let cycles pass; run or pend the tick interrupt of every
+*                reload among them
+* Parameters:    uint32_t cycles
+* Return:        void
+*************************************************************************/
+static void advance(uint32_t cycles) {
+  uint64_t reloads = ((Test_Cycles + cycles) / TIMESTAMP_COUNTS_PER_TICK) - (Test_Cycles / TIMESTAMP_COUNTS_PER_TICK);
+
+  Test_Cycles += cycles;
+  while (reloads-- > 0) {
+    if (Test_Masked) {
+      // The model never masks for a whole tick, so a pending tick is not lost
+      HOST_TEST_CHECK(!Test_Pending);
+      Test_Pending = true;
+    }
+    else {
+      tick_interrupt();
+    }
+  }
+}
+
+
+/*************************************************************************
+* Function Name: unmask
+* Description:   End of the caller's masked section: a pending tick runs
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void unmask() {
+  Test_Masked = false;
+  if (Test_Pending) {
+    Test_Pending = false;
+    tick_interrupt();
+  }
+}
+
+
+/*************************************************************************
+* Function Name: true_ns
+* Description:   Time of the model now, in nanoseconds
+* Parameters:    N/A
+* Return:        uint64_t
+*************************************************************************/
+static uint64_t true_ns() {
+  uint64_t ticks = Test_BaseTicks + (Test_Cycles / TIMESTAMP_COUNTS_PER_TICK);
+  uint64_t counts = Test_Cycles % TIMESTAMP_COUNTS_PER_TICK;
+
+  return (ticks * TIMESTAMP_TICK_NS) + ((counts * TIMESTAMP_TICK_NS) / TIMESTAMP_COUNTS_PER_TICK);
+}
+
+
+/*************************************************************************
+* Function Name: start
+* Description:   Reset the model to just before xPortSysTickCount wraps
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void start() {
+  xPortSysTickCountHigh = 5;
+  xPortSysTickCount = (uint32_t)0 - TEST_BEFORE_WRAP;
+  Test_BaseTicks = ((uint64_t)xPortSysTickCountHigh << 32) | xPortSysTickCount;
+  Test_Cycles = 0;
+  Test_ServicedTicks = 0;
+  Test_Masked = false;
+  Test_Pending = false;
+}
+
+
+/*************************************************************************
+* Function Name: test_reads
+* Description:   Read the time close to reloads, from a task or with
+*                interrupts masked, across the tick count wrap
+* Parameters:    bool masked
+* Return:        void
+*************************************************************************/
+static void test_reads(bool masked) {
+  uint64_t lastNs = 0;
+  uint32_t bad = 0;
+  uint32_t backwards = 0;
+  uint32_t i = 0;
+
+  start();
+
+  for (i = 0; i < TEST_READS; ++i) {
+    Timestamp timestamp;
+    uint64_t before = 0;
+    uint64_t after = 0;
+    uint64_t ns = 0;
+    uint64_t nextReload = ((Test_Cycles / TIMESTAMP_COUNTS_PER_TICK) + 1) * TIMESTAMP_COUNTS_PER_TICK;
+    uint32_t gap = random_below(TEST_BEFORE_RELOAD);
+
+    // Start the read up to TEST_BEFORE_RELOAD cycles before the next
+    // reload, or just after it with the tick still pending when masked
+    if ((nextReload - Test_Cycles) > gap) {
+      advance((uint32_t)(nextReload - Test_Cycles - gap));
+    }
+    Test_Masked = masked;
+    if (masked && (random_below(4) == 0)) {
+      advance(gap + random_below(TEST_READ_CYCLES));
+    }
+
+    before = true_ns();
+    Timestamp_Read(&timestamp);
+    after = true_ns();
+    unmask();
+
+    ns = Timestamp_ToNs(&timestamp);
+    if ((ns + (TIMESTAMP_TICK_NS / TIMESTAMP_COUNTS_PER_TICK) + 1 < before) || (ns > after)) {
+      if (bad++ < 5) {
+        printf("read %u: %llu ns outside %llu .. %llu\n", i, (unsigned long long)ns, (unsigned long long)before,
+               (unsigned long long)after);
+      }
+    }
+    if (ns < lastNs) {
+      backwards++;
+    }
+    lastNs = ns;
+
+    HOST_TEST_CHECK(timestamp.subTickNs < TIMESTAMP_TICK_NS);
+  }
+
+  HOST_TEST_CHECK_EQUAL(bad, 0);
+  HOST_TEST_CHECK_EQUAL(backwards, 0);
+
+  // The run crossed the wrap, and every reload's interrupt ran
+  HOST_TEST_CHECK_EQUAL(xPortSysTickCountHigh, 6);
+  HOST_TEST_CHECK_EQUAL(Test_ServicedTicks, Test_Cycles / TIMESTAMP_COUNTS_PER_TICK);
+  if (masked) {
+    HOST_TEST_CHECK(Test_PendingSeen > 0);
+  }
+}
+
+
+/*************************************************************************
+* Function Name: test_conversion
+* Description:   Timestamp_ToNs of hand-made readings
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_conversion() {
+  Timestamp timestamp;
+
+  timestamp.ticksHigh = 0;
+  timestamp.ticks = 0;
+  timestamp.subTickNs = 0;
+  HOST_TEST_CHECK_EQUAL(Timestamp_ToNs(&timestamp), 0);
+
+  timestamp.ticks = 0xFFFFFFFF;
+  timestamp.subTickNs = TIMESTAMP_TICK_NS - 1;
+  HOST_TEST_CHECK_EQUAL(Timestamp_ToNs(&timestamp), (0xFFFFFFFFULL * TIMESTAMP_TICK_NS) + TIMESTAMP_TICK_NS - 1);
+
+  // One tick later the high word has counted the wrap
+  timestamp.ticksHigh = 1;
+  timestamp.ticks = 0;
+  timestamp.subTickNs = 0;
+  HOST_TEST_CHECK_EQUAL(Timestamp_ToNs(&timestamp), 0x100000000ULL * TIMESTAMP_TICK_NS);
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: Timestamp_HostRead
+* Description:   Model of the SysTick and ICSR registers
+* Parameters:    uint32_t address
+* Return:        uint32_t
+*************************************************************************/
+extern uint32_t Timestamp_HostRead(uint32_t address) {
+  advance(1 + random_below(TEST_READ_CYCLES));
+
+  switch (address) {
+    case TIMESTAMP_SYSTICK_LOAD_ADDRESS:
+      return TIMESTAMP_COUNTS_PER_TICK - 1;
+
+    case TIMESTAMP_SYSTICK_CURRENT_ADDRESS:
+      return (uint32_t)(TIMESTAMP_COUNTS_PER_TICK - 1 - (Test_Cycles % TIMESTAMP_COUNTS_PER_TICK));
+
+    case TIMESTAMP_ICSR_ADDRESS:
+      if (Test_Pending) {
+        Test_PendingSeen++;
+        return TIMESTAMP_ICSR_PENDSTSET;
+      }
+      return 0;
+
+    default:
+      HOST_TEST_CHECK(false);
+      return 0;
+  }
+}
+
+
+int main() {
+  test_conversion();
+  test_reads(false);
+  test_reads(true);
+
+  printf("Timestamp: %u reads saw PENDSTSET\n", Test_PendingSeen);
+  return HostTest_Result("Timestamp");
+}
@@ -0,0 +1,465 @@
+/**
+* @Filename: Test_Trace_Stream.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [6:30pm]
+* @Version:  1.0.0
+*
+* @Description: Host test of the trace recorder's streaming
+*               (Drivers/Trace_Recorder.c) and of the host converter
+*               (Tools/Trace_Convert.c).
+*
+*               A scripted run of every event type, across a cycle
+*               counter wrap and mixed with other console output, is
+*               streamed and converted; the JSON must be the same as the
+*               recorder's own "trace dump" of the ring. Events overwritten
+*               before they are streamed must be counted the same by both
+*               sides.
+*
+*               The host cost per event of recording, streaming and
+*               converting, and the console bytes per streamed event, are
+*               printed.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Drivers/CycleCounter.h"
+#include "Drivers/Trace_Recorder.h"
+
+#include "Tasks/Log.h"
+
+#include "Tools/Trace_Convert.h"
+
+#include "FreeRTOS.h"
+#include "Host_Test.h"
+#include "task.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+// Console output kept
+#define TEST_CAPTURE_SIZE (1024 * 1024)
+
+// Events of the scripted run, fewer than the ring holds
+#define TEST_SCRIPT_EVENTS 600
+
+// Events per poll when timing
+#define TEST_COST_CHUNK  512
+#define TEST_COST_CHUNKS 400
+
+#define TEST_TASKS 3
+
+
+/************************************************
+* Local variables
+************************************************/
+volatile TickType_t Host_TickCount = 0;
+volatile uint32_t CycleCounter_Host = 0;
+
+// Console output since the last clear
+char Test_Capture[TEST_CAPTURE_SIZE];
+size_t Test_CaptureLength = 0;
+
+// Stand-ins for TCBs, queues and a timer name
+uint32_t Test_Tasks[TEST_TASKS];
+const char* TEST_TASK_NAMES[TEST_TASKS] = { "Idle", "ReportData", "Console" };
+uint32_t Test_Queues[2];
+const char TEST_TIMER_NAME[] = "Blinky";
+
+uint32_t Test_Random = 7;
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: random_below
+* Description:   Repeatable random number
+* Parameters:    uint32_t limit
+* Return:        uint32_t - 0 .. limit - 1
+*************************************************************************/
+static uint32_t random_below(uint32_t limit) {
+  Test_Random = (Test_Random * 1664525) + 1013904223;
+  return (uint32_t)(((uint64_t)(Test_Random >> 8) * limit) >> 24);
+}
+
+
+/*************************************************************************
+* Function Name: now_ns
+* Description:   Host monotonic clock
+* Parameters:    N/A
+* Return:        uint64_t
+*************************************************************************/
+static uint64_t now_ns() {
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+
+/*************************************************************************
+* Function Name: capture
+* Description:   Append a formatted line to Test_Capture
+* Parameters:    const char* format
+*                va_list args
+* Return:        void
+*************************************************************************/
+static void capture(const char* format, va_list args) {
+  int length = vsnprintf(&Test_Capture[Test_CaptureLength], TEST_CAPTURE_SIZE - Test_CaptureLength, format, args);
+
+  if ((length > 0) && (Test_CaptureLength + (size_t)length < TEST_CAPTURE_SIZE)) {
+    Test_CaptureLength += (size_t)length;
+  }
+}
+
+
+/*************************************************************************
+* Function Name: convert
+* Description:   Run the capture through the converter into json
+* Parameters:    TraceConvert* converter
+*                char* json
+*                size_t size
+* Return:        void
+*************************************************************************/
+static void convert(TraceConvert* converter, char* json, size_t size) {
+  FILE* out = tmpfile();
+  char* line = Test_Capture;
+  size_t length = 0;
+
+  HOST_TEST_CHECK(out != NULL);
+  if (out == NULL) {
+    json[0] = '\0';
+    return;
+  }
+
+  TraceConvert_Begin(converter, out);
+  while (*line != '\0') {
+    char* end = strchr(line, '\n');
+    char saved = 0;
+
+    if (end == NULL) {
+      end = line + strlen(line) - 1;
+    }
+    saved = end[1];
+    end[1] = '\0';
+    TraceConvert_Line(converter, line);
+    end[1] = saved;
+    line = end + 1;
+  }
+  TraceConvert_End(converter);
+
+  rewind(out);
+  length = fread(json, 1, size - 1, out);
+  json[length] = '\0';
+  fclose(out);
+}
+
+
+/*************************************************************************
+* Function Name: record_random
+* Description:   Record one event of a random type after a random time
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void record_random() {
+  uint32_t type = 1 + random_below(TRACE_RECORDER_USER);
+
+  CycleCounter_Host += 1 + random_below(20000);
+
+  switch (type) {
+    case TRACE_RECORDER_TASK_SWITCHED_IN:
+    case TRACE_RECORDER_TASK_CREATE:
+    case TRACE_RECORDER_TASK_DELAY:
+    case TRACE_RECORDER_TASK_DELAY_UNTIL:
+      TraceRecorder_Record(type, &Test_Tasks[random_below(TEST_TASKS)]);
+      break;
+
+    case TRACE_RECORDER_TIMER_EXPIRED:
+      TraceRecorder_Record(type, TEST_TIMER_NAME);
+      break;
+
+    case TRACE_RECORDER_USER:
+      TraceRecorder_Record(type, NULL);
+      break;
+
+    default:
+      TraceRecorder_Record(type, &Test_Queues[random_below(2)]);
+      break;
+  }
+}
+
+
+/*************************************************************************
+* Function Name: test_round_trip
+* Description:   Streamed and converted, a run gives the JSON of "trace
+*                dump"
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_round_trip() {
+  static char streamed[TEST_CAPTURE_SIZE];
+  static char dumped[TEST_CAPTURE_SIZE];
+  TraceConvert converter;
+  uint32_t sent = 0;
+  uint32_t i = 0;
+
+  // Wraps a quarter of the way through
+  CycleCounter_Host = 0xFFFFFFFF - (TEST_SCRIPT_EVENTS * 10000 / 4);
+  Test_CaptureLength = 0;
+  Test_Capture[0] = '\0';
+
+  TraceRecorder_Start();
+  TraceRecorder_StreamStart();
+
+  for (i = 0; i < TEST_SCRIPT_EVENTS; ++i) {
+    record_random();
+    if (random_below(16) == 0) {
+      sent += TraceRecorder_StreamPoll();
+    }
+    if (random_below(64) == 0) {
+      Log_Printf("00012345,000000,0001,23,45,67,89\n");
+    }
+  }
+  sent += TraceRecorder_StreamPoll();
+
+  HOST_TEST_CHECK_EQUAL(sent, TEST_SCRIPT_EVENTS);
+  HOST_TEST_CHECK_EQUAL(TraceRecorder_StreamLostCount(), 0);
+  HOST_TEST_CHECK_EQUAL(TraceRecorder_StreamPoll(), 0);
+
+  convert(&converter, streamed, sizeof(streamed));
+  HOST_TEST_CHECK_EQUAL(converter.events, TEST_SCRIPT_EVENTS);
+  HOST_TEST_CHECK_EQUAL(converter.lost, 0);
+  HOST_TEST_CHECK_EQUAL(converter.malformed, 0);
+  HOST_TEST_CHECK_EQUAL(converter.tasksNbr, TEST_TASKS);
+  HOST_TEST_CHECK(strstr(streamed, "timer Blinky") != NULL);
+
+  Test_CaptureLength = 0;
+  Test_Capture[0] = '\0';
+  TraceRecorder_PrintChromeTrace();
+  memcpy(dumped, Test_Capture, Test_CaptureLength + 1);
+
+  HOST_TEST_CHECK_EQUAL(strlen(streamed), strlen(dumped));
+  HOST_TEST_CHECK(strcmp(streamed, dumped) == 0);
+  if (strcmp(streamed, dumped) != 0) {
+    size_t at = 0;
+
+    while ((streamed[at] != '\0') && (streamed[at] == dumped[at])) {
+      at++;
+    }
+    printf("streamed and dumped JSON differ at %zu:\n%.120s\n%.120s\n", at, &streamed[at], &dumped[at]);
+  }
+
+  TraceRecorder_StreamStop();
+}
+
+
+/*************************************************************************
+* Function Name: test_overrun
+* Description:   Events overwritten before a poll are counted lost by the
+*                recorder and by the converter
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_overrun() {
+  static char json[TEST_CAPTURE_SIZE];
+  TraceConvert converter;
+  char expected[64];
+  uint32_t sent = 0;
+  uint32_t i = 0;
+
+  Test_CaptureLength = 0;
+  Test_Capture[0] = '\0';
+
+  TraceRecorder_Start();
+  TraceRecorder_StreamStart();
+
+  // A first line, then a gap, then the rest
+  record_random();
+  sent += TraceRecorder_StreamPoll();
+  for (i = 0; i < (3 * TRACE_RECORDER_EVENTS) + 7; ++i) {
+    record_random();
+  }
+  sent += TraceRecorder_StreamPoll();
+
+  HOST_TEST_CHECK_EQUAL(sent, 1 + TRACE_RECORDER_EVENTS);
+  HOST_TEST_CHECK_EQUAL(TraceRecorder_StreamLostCount(), (2 * TRACE_RECORDER_EVENTS) + 7);
+
+  convert(&converter, json, sizeof(json));
+  HOST_TEST_CHECK_EQUAL(converter.events, sent);
+  HOST_TEST_CHECK_EQUAL(converter.lost, TraceRecorder_StreamLostCount());
+  snprintf(expected, sizeof(expected), "\"lost %u events\"", (2 * TRACE_RECORDER_EVENTS) + 7);
+  HOST_TEST_CHECK(strstr(json, expected) != NULL);
+
+  // Events lost before the first line are counted from the header's index
+  Test_CaptureLength = 0;
+  Test_Capture[0] = '\0';
+  TraceRecorder_StreamStart();
+  for (i = 0; i < TRACE_RECORDER_EVENTS + 3; ++i) {
+    record_random();
+  }
+  TraceRecorder_StreamPoll();
+  convert(&converter, json, sizeof(json));
+  HOST_TEST_CHECK_EQUAL(converter.lost, 3);
+  HOST_TEST_CHECK_EQUAL(TraceRecorder_StreamLostCount(), 3);
+
+  TraceRecorder_StreamStop();
+}
+
+
+/*************************************************************************
+* Function Name: test_malformed
+* Description:   Damaged lines are counted and skipped; other console
+*                output is ignored
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_malformed() {
+  static char json[4096];
+  TraceConvert converter;
+
+  Test_CaptureLength = 0;
+  Test_Capture[0] = '\0';
+  Log_Printf("#TH 1 120 00000000\n");
+  Log_Printf("#TE 00000000 0100001000000abcd\n");       // short record
+  Log_Printf("#TE 0000000g 01000010000000abcd\n");      // bad index
+  Log_Printf("#TX 1\n");                                 // unknown line
+  Log_Printf("report queue 0 waiting, 1024 free\n");    // not a trace line
+  Log_Printf("#TE 00000000 0b0000001000001234\n");      // unnamed timer
+  convert(&converter, json, sizeof(json));
+
+  HOST_TEST_CHECK_EQUAL(converter.malformed, 3);
+  HOST_TEST_CHECK_EQUAL(converter.events, 1);
+  HOST_TEST_CHECK(strstr(json, "\"timer 0x00001234\"") != NULL);
+}
+
+
+/*************************************************************************
+* Function Name: test_cost
+* Description:   Host time per event to record, stream and convert, and
+*                the console bytes each streamed event takes
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_cost() {
+  static char json[TEST_CAPTURE_SIZE];
+  TraceConvert converter;
+  uint64_t recordNs = 0;
+  uint64_t streamNs = 0;
+  uint64_t convertNs = 0;
+  uint64_t bytes = 0;
+  uint32_t events = 0;
+  uint32_t chunk = 0;
+  uint32_t i = 0;
+
+  TraceRecorder_Start();
+  TraceRecorder_StreamStart();
+
+  for (chunk = 0; chunk < TEST_COST_CHUNKS; ++chunk) {
+    uint64_t start = 0;
+
+    Test_CaptureLength = 0;
+    Test_Capture[0] = '\0';
+
+    start = now_ns();
+    for (i = 0; i < TEST_COST_CHUNK; ++i) {
+      CycleCounter_Host += 1000;
+      TraceRecorder_Record(TRACE_RECORDER_QUEUE_SEND, &Test_Queues[0]);
+    }
+    recordNs += now_ns() - start;
+
+    start = now_ns();
+    events += TraceRecorder_StreamPoll();
+    streamNs += now_ns() - start;
+    bytes += Test_CaptureLength;
+
+    start = now_ns();
+    convert(&converter, json, sizeof(json));
+    convertNs += now_ns() - start;
+  }
+
+  TraceRecorder_StreamStop();
+
+  HOST_TEST_CHECK_EQUAL(events, TEST_COST_CHUNK * TEST_COST_CHUNKS);
+  HOST_TEST_CHECK_EQUAL(TraceRecorder_StreamLostCount(), 0);
+
+  printf("Trace_Stream: host ns per event: record %.1f, stream %.1f, convert %.1f\n",
+         (double)recordNs / events, (double)streamNs / events, (double)convertNs / events);
+  printf("Trace_Stream: %.1f console bytes per event, %u events/s at 115200 baud\n", (double)bytes / events,
+         (uint32_t)((11520.0 * events) / (double)bytes));
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: CycleCounter_Initialization
+* Description:   Nothing to enable on the host
+* Parameters:    N/A
+* Return:        uint32_t (1)
+*************************************************************************/
+extern uint32_t CycleCounter_Initialization() {
+  return (1);
+}
+
+
+/*************************************************************************
+* Function Name: Log_Printf / Log_PrintfWait
+* Description:   Append the line to Test_Capture
+*************************************************************************/
+extern void Log_Printf(const char* format, ...) {
+  va_list args;
+
+  va_start(args, format);
+  capture(format, args);
+  va_end(args);
+}
+
+extern void Log_PrintfWait(const char* format, ...) {
+  va_list args;
+
+  va_start(args, format);
+  capture(format, args);
+  va_end(args);
+}
+
+
+/*************************************************************************
+* Function Name: vTaskDelay
+* Description:   Task_TraceStream is not run
+*************************************************************************/
+void vTaskDelay(const TickType_t xTicksToDelay) {
+  (void)xTicksToDelay;
+}
+
+
+int main() {
+  uint32_t i = 0;
+
+  for (i = 0; i < TEST_TASKS; ++i) {
+    TraceRecorder_TaskCreate(&Test_Tasks[i], TEST_TASK_NAMES[i]);
+  }
+
+  test_round_trip();
+  test_overrun();
+  test_malformed();
+  test_cost();
+
+  return HostTest_Result("Trace_Stream");
+}
@@ -0,0 +1,365 @@
+/**
+* @Filename: Test_UART_FIFO.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [4:50pm]
+* @Version:  1.0.0
+*
+* @Description: Host model of the UART FIFO interrupts of buffered
+*               uartstdio, checked against the table in
+*               Drivers/uartstdio.c.
+*
+*               The model runs a 16 byte FIFO one byte time at a time. The
+*               TX interrupt fires when the FIFO drains to its trigger
+*               level and refills it; the RX interrupt fires when the FIFO
+*               fills to its trigger level, or 32 bit times after the last
+*               byte of a burst (the receive timeout), and empties it.
+*
+*               Each row of the table in uartstdio.c, and the rows of the
+*               UART_TX_FIFO_LEVEL and UART_RX_FIFO_LEVEL defaults, must
+*               match the model. The model's interrupts per byte and RX
+*               overrun margin are printed for every level at several bit
+*               rates.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Host_Test.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+#define TEST_SOURCE "../Drivers/uartstdio.c"
+
+#define TEST_FIFO_DEPTH 16
+
+// Levels are in eighths of the FIFO: 1/8, 2/8, 4/8, 6/8 and 7/8
+const uint32_t TEST_LEVELS[] = { 1, 2, 4, 6, 7 };
+#define TEST_LEVELS_NBR (sizeof(TEST_LEVELS) / sizeof(TEST_LEVELS[0]))
+
+// Bit rates printed; 7.5 Mbaud is the fastest at the 120 MHz UART clock
+const uint32_t TEST_BAUDS[] = { 115200, 921600, 3000000, 7500000 };
+#define TEST_BAUDS_NBR (sizeof(TEST_BAUDS) / sizeof(TEST_BAUDS[0]))
+
+// Bytes streamed for the steady state
+#define TEST_STREAM_BYTES 1000000
+
+// Bits per byte with start and stop bits
+#define TEST_BITS_PER_BYTE 10
+
+
+/************************************************
+* Local types
+************************************************/
+typedef struct Test_Model {
+  double txInterruptsPerByte;
+  double txBytesPerInterrupt;
+  double rxBytesPerInterrupt;
+  uint32_t rxMarginBytes;
+} Test_Model;
+
+
+/************************************************
+* Local variables
+************************************************/
+uint32_t Test_TxRows = 0;
+uint32_t Test_RxRows = 0;
+bool Test_TxDefaultRow = false;
+bool Test_RxDefaultRow = false;
+uint32_t Test_TxDefault = 0;
+uint32_t Test_RxDefault = 0;
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: model_tx
+* Description:   Interrupts to send bytes in one stream. The first FIFO
+*                load is written without an interrupt.
+* Parameters:    uint32_t eighths - TX trigger level
+*                uint32_t bytes
+* Return:        uint32_t - interrupts
+*************************************************************************/
+static uint32_t model_tx(uint32_t eighths, uint32_t bytes) {
+  uint32_t trigger = (TEST_FIFO_DEPTH * eighths) / 8;
+  uint32_t fifo = (bytes < TEST_FIFO_DEPTH) ? bytes : TEST_FIFO_DEPTH;
+  uint32_t remaining = bytes - fifo;
+  uint32_t interrupts = 0;
+
+  while (fifo > 0) {
+    // One byte time: a byte leaves the FIFO
+    fifo--;
+    if ((fifo == trigger) && (remaining > 0)) {
+      uint32_t refill = TEST_FIFO_DEPTH - fifo;
+
+      if (refill > remaining) {
+        refill = remaining;
+      }
+      interrupts++;
+      fifo += refill;
+      remaining -= refill;
+    }
+  }
+
+  return interrupts;
+}
+
+
+/*************************************************************************
+* Function Name: model_rx
+* Description:   Interrupts to receive bursts of bytes, back to back within
+*                a burst and with a long gap between bursts
+* Parameters:    uint32_t eighths - RX trigger level
+*                uint32_t burst - bytes per burst
+*                uint32_t bursts
+* Return:        uint32_t - interrupts
+*************************************************************************/
+static uint32_t model_rx(uint32_t eighths, uint32_t burst, uint32_t bursts) {
+  uint32_t trigger = (TEST_FIFO_DEPTH * eighths) / 8;
+  uint32_t interrupts = 0;
+  uint32_t i = 0;
+
+  for (i = 0; i < bursts; ++i) {
+    uint32_t fifo = 0;
+    uint32_t j = 0;
+
+    for (j = 0; j < burst; ++j) {
+      // One byte time: a byte arrives
+      fifo++;
+      if (fifo == trigger) {
+        interrupts++;
+        fifo = 0;
+      }
+    }
+
+    // The gap is longer than the receive timeout
+    if (fifo > 0) {
+      interrupts++;
+    }
+  }
+
+  return interrupts;
+}
+
+
+/*************************************************************************
+* Function Name: model
+* Description:   Steady state of a level
+* Parameters:    uint32_t eighths
+* Return:        Test_Model
+*************************************************************************/
+static Test_Model model(uint32_t eighths) {
+  Test_Model result;
+  uint32_t txInterrupts = model_tx(eighths, TEST_STREAM_BYTES);
+  uint32_t rxInterrupts = model_rx(eighths, TEST_STREAM_BYTES, 1);
+
+  result.txInterruptsPerByte = (double)txInterrupts / TEST_STREAM_BYTES;
+  result.txBytesPerInterrupt = (double)TEST_STREAM_BYTES / txInterrupts;
+  result.rxBytesPerInterrupt = (double)TEST_STREAM_BYTES / rxInterrupts;
+  result.rxMarginBytes = TEST_FIFO_DEPTH - ((TEST_FIFO_DEPTH * eighths) / 8);
+  return result;
+}
+
+
+/*************************************************************************
+* Function Name: margin_us
+* Description:   Time to receive a number of bytes
+* Parameters:    uint32_t bytes
+*                uint32_t baud
+* Return:        double
+*************************************************************************/
+static double margin_us(uint32_t bytes, uint32_t baud) {
+  return ((double)bytes * TEST_BITS_PER_BYTE * 1000000.0) / baud;
+}
+
+
+/*************************************************************************
+* Function Name: check_tx_row
+* Description:   A row of the TX table against the model
+* Parameters:    const char* line
+* Return:        bool - false if the line is not a TX row
+*************************************************************************/
+static bool check_tx_row(const char* line) {
+  uint32_t eighths = 0;
+  uint32_t bytes = 0;
+  double perByte = 0;
+  Test_Model expected;
+  char printed[16];
+
+  if (sscanf(line, "// %u/8 %u %lf", &eighths, &bytes, &perByte) != 3) {
+    return false;
+  }
+
+  Test_TxRows++;
+  Test_TxDefaultRow |= (eighths == Test_TxDefault);
+  expected = model(eighths);
+
+  HOST_TEST_CHECK_EQUAL(bytes, (uint32_t)(expected.txBytesPerInterrupt + 0.5));
+
+  // Compared as printed, to the table's three decimals
+  snprintf(printed, sizeof(printed), "%.3f", expected.txInterruptsPerByte);
+  HOST_TEST_CHECK(strstr(line, printed) != NULL);
+  if (strstr(line, printed) == NULL) {
+    printf("TX %u/8: model %s interrupts per byte\n", eighths, printed);
+  }
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: check_rx_row
+* Description:   A row of the RX table against the model
+* Parameters:    const char* line
+*                uint32_t baud - of the margin column
+* Return:        bool - false if the line is not an RX row
+*************************************************************************/
+static bool check_rx_row(const char* line, uint32_t baud) {
+  uint32_t eighths = 0;
+  uint32_t bytes = 0;
+  uint32_t marginBytes = 0;
+  uint32_t marginUs = 0;
+  Test_Model expected;
+
+  if (sscanf(line, "// %u/8 %u %u bytes, %u us", &eighths, &bytes, &marginBytes, &marginUs) != 4) {
+    return false;
+  }
+
+  Test_RxRows++;
+  Test_RxDefaultRow |= (eighths == Test_RxDefault);
+  expected = model(eighths);
+
+  HOST_TEST_CHECK_EQUAL(bytes, (uint32_t)(expected.rxBytesPerInterrupt + 0.5));
+  HOST_TEST_CHECK_EQUAL(marginBytes, expected.rxMarginBytes);
+  HOST_TEST_CHECK_EQUAL(marginUs, (uint32_t)(margin_us(expected.rxMarginBytes, baud) + 0.5));
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: test_source_table
+* Description:   Read the defaults and the table from uartstdio.c
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_source_table() {
+  FILE* source = fopen(TEST_SOURCE, "r");
+  char line[256];
+  enum { NONE, TX, RX } table = NONE;
+  uint32_t rxBaud = 0;
+
+  HOST_TEST_CHECK(source != NULL);
+  if (source == NULL) {
+    return;
+  }
+
+  // The defaults come first
+  while (fgets(line, sizeof(line), source) != NULL) {
+    sscanf(line, "#define UART_TX_FIFO_LEVEL UART_FIFO_TX%u_8", &Test_TxDefault);
+    sscanf(line, "#define UART_RX_FIFO_LEVEL UART_FIFO_RX%u_8", &Test_RxDefault);
+  }
+  HOST_TEST_CHECK(Test_TxDefault != 0);
+  HOST_TEST_CHECK(Test_RxDefault != 0);
+
+  rewind(source);
+  while (fgets(line, sizeof(line), source) != NULL) {
+    if (strstr(line, "TX level") != NULL) {
+      table = TX;
+    }
+    else if (strstr(line, "RX level") != NULL) {
+      const char* at = strstr(line, " at ");
+
+      table = RX;
+      HOST_TEST_CHECK((at != NULL) && (sscanf(at, " at %u", &rxBaud) == 1));
+    }
+    else if (table == TX) {
+      if (!check_tx_row(line)) {
+        table = NONE;
+      }
+    }
+    else if (table == RX) {
+      if (!check_rx_row(line, rxBaud)) {
+        table = NONE;
+      }
+    }
+  }
+  fclose(source);
+
+  HOST_TEST_CHECK(Test_TxRows > 0);
+  HOST_TEST_CHECK(Test_RxRows > 0);
+  HOST_TEST_CHECK(Test_TxDefaultRow);
+  HOST_TEST_CHECK(Test_RxDefaultRow);
+}
+
+
+/*************************************************************************
+* Function Name: test_model
+* Description:   Closed forms of the model, and short bursts
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void test_model() {
+  uint32_t i = 0;
+
+  for (i = 0; i < TEST_LEVELS_NBR; ++i) {
+    uint32_t trigger = (TEST_FIFO_DEPTH * TEST_LEVELS[i]) / 8;
+
+    // A long stream moves the FIFO less the trigger level per TX
+    // interrupt and the trigger level per RX interrupt
+    HOST_TEST_CHECK_EQUAL(model_tx(TEST_LEVELS[i], TEST_FIFO_DEPTH), 0);
+    HOST_TEST_CHECK_EQUAL(model_tx(TEST_LEVELS[i], 1600),
+                          (1600 - TEST_FIFO_DEPTH + (TEST_FIFO_DEPTH - trigger) - 1) / (TEST_FIFO_DEPTH - trigger));
+    HOST_TEST_CHECK_EQUAL(model_rx(TEST_LEVELS[i], 1600, 1), (1600 + trigger - 1) / trigger);
+
+    // Typed characters take an interrupt each, whatever the level
+    HOST_TEST_CHECK_EQUAL(model_rx(TEST_LEVELS[i], 1, 100), 100);
+  }
+}
+
+
+/*************************************************************************
+* Function Name: print_model
+* Description:   Interrupts per 1000 bytes and RX margin of every level
+* Parameters:    N/A
+* Return:        void
+*************************************************************************/
+static void print_model() {
+  uint32_t i = 0;
+  uint32_t j = 0;
+
+  printf("UART_FIFO: level  TX ints/1000 B  RX ints/1000 B  RX margin us at");
+  for (j = 0; j < TEST_BAUDS_NBR; ++j) {
+    printf(" %u", TEST_BAUDS[j]);
+  }
+  printf("\n");
+
+  for (i = 0; i < TEST_LEVELS_NBR; ++i) {
+    Test_Model levelModel = model(TEST_LEVELS[i]);
+
+    printf("UART_FIFO:  %u/8   %14.1f  %14.1f ", TEST_LEVELS[i], levelModel.txInterruptsPerByte * 1000,
+           1000 / levelModel.rxBytesPerInterrupt);
+    for (j = 0; j < TEST_BAUDS_NBR; ++j) {
+      printf(" %6.1f", margin_us(levelModel.rxMarginBytes, TEST_BAUDS[j]));
+    }
+    printf("%s%s\n", (TEST_LEVELS[i] == Test_TxDefault) ? "  TX default" : "",
+           (TEST_LEVELS[i] == Test_RxDefault) ? "  RX default" : "");
+  }
+}
+
+
+int main() {
+  test_model();
+  test_source_table();
+  print_model();
+
+  return HostTest_Result("UART_FIFO");
+}
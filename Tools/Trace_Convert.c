@@ -0,0 +1,411 @@
+/**
+* @Filename: Trace_Convert.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [6:30pm]
+* @Version:  1.0.0
+*
+* @Description: Host converter of a streamed trace to Chrome trace JSON
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Drivers/Trace_Recorder.h"
+
+#include "Tools/Trace_Convert.h"
+
+
+/************************************************
+* Local constant variables
+************************************************/
+// Row of interrupts, and of tasks that were never named
+#define TRACE_CONVERT_ISR_TID     0
+#define TRACE_CONVERT_UNKNOWN_TID (TRACE_CONVERT_MAX_NAMES + 1)
+
+
+/************************************************
+* Local function declarations
+************************************************/
+static bool parse_hex(const char** text, uint32_t digits, uint32_t* value);
+static void parse_name(const char* text, char* name);
+static TraceConvert_Name* find_name(TraceConvert_Name* names, uint32_t namesNbr, uint32_t address);
+static const char* event_name(uint32_t type);
+static void convert_event(TraceConvert* convert, uint32_t type, uint32_t cycles, uint32_t object);
+static bool convert_events(TraceConvert* convert, const char* text);
+static bool convert_name(TraceConvert* convert, const char* text, bool task);
+
+
+/************************************************
+* Local function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: parse_hex
+* Description:   Read exactly digits hex digits and step past them
+* Parameters:    const char** text
+*                uint32_t digits
+*                uint32_t* value
+* Return:        bool - false if a digit is missing
+*************************************************************************/
+static bool parse_hex(const char** text, uint32_t digits, uint32_t* value) {
+  uint32_t i = 0;
+
+  *value = 0;
+  for (i = 0; i < digits; ++i) {
+    char ch = (*text)[i];
+
+    if ((ch >= '0') && (ch <= '9')) {
+      *value = (*value << 4) | (uint32_t)(ch - '0');
+    }
+    else if ((ch >= 'a') && (ch <= 'f')) {
+      *value = (*value << 4) | (uint32_t)(ch - 'a' + 10);
+    }
+    else if ((ch >= 'A') && (ch <= 'F')) {
+      *value = (*value << 4) | (uint32_t)(ch - 'A' + 10);
+    }
+    else {
+      return false;
+    }
+  }
+
+  *text += digits;
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: parse_name
+* Description:   Copy the rest of the line, without its line end, cut to
+*                TRACE_CONVERT_NAME_SIZE
+* Parameters:    const char* text
+*                char* name
+* Return:        void
+*************************************************************************/
+static void parse_name(const char* text, char* name) {
+  size_t length = strcspn(text, "\r\n");
+
+  if (length >= TRACE_CONVERT_NAME_SIZE) {
+    length = TRACE_CONVERT_NAME_SIZE - 1;
+  }
+  memcpy(name, text, length);
+  name[length] = '\0';
+}
+
+
+/*************************************************************************
+* Function Name: find_name
+* Description:   Entry of a name table for an address
+* Parameters:    TraceConvert_Name* names
+*                uint32_t namesNbr
+*                uint32_t address
+* Return:        TraceConvert_Name* - NULL if not there
+*************************************************************************/
+static TraceConvert_Name* find_name(TraceConvert_Name* names, uint32_t namesNbr, uint32_t address) {
+  uint32_t i = 0;
+
+  for (i = 0; i < namesNbr; ++i) {
+    if (names[i].address == address) {
+      return &names[i];
+    }
+  }
+
+  return NULL;
+}
+
+
+/*************************************************************************
+* Function Name: event_name
+* Description:   Name printed for an instant event, as on the target
+* Parameters:    uint32_t type
+* Return:        const char*
+*************************************************************************/
+static const char* event_name(uint32_t type) {
+  switch (type) {
+    case TRACE_RECORDER_TASK_CREATE:
+      return "create";
+    case TRACE_RECORDER_TASK_DELAY:
+      return "delay";
+    case TRACE_RECORDER_TASK_DELAY_UNTIL:
+      return "delay until";
+    case TRACE_RECORDER_QUEUE_SEND:
+    case TRACE_RECORDER_QUEUE_SEND_FROM_ISR:
+      return "send";
+    case TRACE_RECORDER_QUEUE_RECEIVE:
+    case TRACE_RECORDER_QUEUE_RECEIVE_FROM_ISR:
+      return "receive";
+    case TRACE_RECORDER_QUEUE_BLOCK_SEND:
+      return "block on send";
+    case TRACE_RECORDER_QUEUE_BLOCK_RECEIVE:
+      return "block on receive";
+    case TRACE_RECORDER_TIMER_EXPIRED:
+      return "timer";
+    default:
+      return "user";
+  }
+}
+
+
+/*************************************************************************
+* Function Name: convert_event
+* Description:   Write one event, as TraceRecorder_PrintChromeTrace does
+* Parameters:    TraceConvert* convert
+*                uint32_t type
+*                uint32_t cycles
+*                uint32_t object
+* Return:        void
+*************************************************************************/
+static void convert_event(TraceConvert* convert, uint32_t type, uint32_t cycles, uint32_t object) {
+  FILE* out = convert->out;
+  uint32_t us = 0;
+  uint32_t ns = 0;
+  uint32_t tid = convert->running;
+  TraceConvert_Name* name = NULL;
+
+  // Time from the first event, cycle count differences survive a wrap
+  if (convert->started) {
+    convert->elapsed += (uint32_t)(cycles - convert->previousCycles);
+  }
+  convert->started = true;
+  convert->previousCycles = cycles;
+  convert->events++;
+  us = (uint32_t)(convert->elapsed / convert->cyclesPerUs);
+  ns = (uint32_t)((convert->elapsed % convert->cyclesPerUs) * 1000 / convert->cyclesPerUs);
+
+  switch (type) {
+    case TRACE_RECORDER_TASK_SWITCHED_IN:
+      if (convert->running != 0) {
+        fprintf(out, ",{\"ph\":\"E\",\"ts\":%u.%03u,\"pid\":1,\"tid\":%u}\n", us, ns, convert->running);
+      }
+      name = find_name(convert->tasks, convert->tasksNbr, object);
+      convert->running = (name != NULL) ? (uint32_t)(name - convert->tasks) + 1 : TRACE_CONVERT_UNKNOWN_TID;
+      fprintf(out, ",{\"name\":\"run\",\"ph\":\"B\",\"ts\":%u.%03u,\"pid\":1,\"tid\":%u}\n", us, ns,
+              convert->running);
+      break;
+
+    case TRACE_RECORDER_TIMER_EXPIRED:
+      name = find_name(convert->timers, convert->timersNbr, object);
+      if (name != NULL) {
+        fprintf(out, ",{\"name\":\"timer %s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%u.%03u,\"pid\":1,\"tid\":%u}\n",
+                name->name, us, ns, tid);
+      }
+      else {
+        fprintf(out, ",{\"name\":\"timer 0x%08x\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%u.%03u,\"pid\":1,\"tid\":%u}\n",
+                object, us, ns, tid);
+      }
+      break;
+
+    case TRACE_RECORDER_TASK_CREATE:
+      name = find_name(convert->tasks, convert->tasksNbr, object);
+      tid = (name != NULL) ? (uint32_t)(name - convert->tasks) + 1 : TRACE_CONVERT_UNKNOWN_TID;
+      fprintf(out, ",{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%u.%03u,\"pid\":1,\"tid\":%u}\n",
+              event_name(type), us, ns, tid);
+      break;
+
+    case TRACE_RECORDER_TASK_DELAY:
+    case TRACE_RECORDER_TASK_DELAY_UNTIL:
+    case TRACE_RECORDER_USER:
+      fprintf(out, ",{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%u.%03u,\"pid\":1,\"tid\":%u}\n",
+              event_name(type), us, ns, tid);
+      break;
+
+    default:
+      if ((type == TRACE_RECORDER_QUEUE_SEND_FROM_ISR) || (type == TRACE_RECORDER_QUEUE_RECEIVE_FROM_ISR)) {
+        tid = TRACE_CONVERT_ISR_TID;
+      }
+      fprintf(out, ",{\"name\":\"%s 0x%08x\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%u.%03u,\"pid\":1,\"tid\":%u}\n",
+              event_name(type), object, us, ns, tid);
+      break;
+  }
+}
+
+
+/*************************************************************************
+* Function Name: convert_events
+* Description:   "#TE <index> <record>..."
+* Parameters:    TraceConvert* convert
+*                const char* text - after "#TE "
+* Return:        bool - false if malformed
+*************************************************************************/
+static bool convert_events(TraceConvert* convert, const char* text) {
+  uint32_t index = 0;
+  uint32_t count = 0;
+  const char* check = NULL;
+
+  if (!parse_hex(&text, 8, &index)) {
+    return false;
+  }
+
+  // Read the whole line before writing any of it
+  for (check = text; *check == ' '; ++count) {
+    uint32_t value = 0;
+
+    check++;
+    if (!parse_hex(&check, 2, &value) || !parse_hex(&check, 8, &value) || !parse_hex(&check, 8, &value)) {
+      return false;
+    }
+  }
+  if ((count == 0) || (strspn(check, "\r\n") != strlen(check))) {
+    return false;
+  }
+
+  // A later index than expected: events were overwritten before they
+  // were sent. An earlier one: the ring was restarted.
+  if (convert->synced && (index > convert->nextIndex)) {
+    uint32_t lost = index - convert->nextIndex;
+    uint64_t elapsed = convert->elapsed;
+
+    convert->lost += lost;
+    fprintf(convert->out, ",{\"name\":\"lost %u events\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%u.%03u,\"pid\":1,\"tid\":%u}\n",
+            lost, (uint32_t)(elapsed / convert->cyclesPerUs),
+            (uint32_t)((elapsed % convert->cyclesPerUs) * 1000 / convert->cyclesPerUs), TRACE_CONVERT_ISR_TID);
+  }
+  convert->nextIndex = index + count;
+  convert->synced = true;
+
+  while (*text == ' ') {
+    uint32_t type = 0;
+    uint32_t cycles = 0;
+    uint32_t object = 0;
+
+    text++;
+    parse_hex(&text, 2, &type);
+    parse_hex(&text, 8, &cycles);
+    parse_hex(&text, 8, &object);
+    convert_event(convert, type, cycles, object);
+  }
+
+  return true;
+}
+
+
+/*************************************************************************
+* Function Name: convert_name
+* Description:   "#TN <address> <name>" or "#TS <address> <name>". A new
+*                task gets the next row.
+* Parameters:    TraceConvert* convert
+*                const char* text - after "#TN " or "#TS "
+*                bool task
+* Return:        bool - false if malformed
+*************************************************************************/
+static bool convert_name(TraceConvert* convert, const char* text, bool task) {
+  TraceConvert_Name* names = task ? convert->tasks : convert->timers;
+  uint32_t* namesNbr = task ? &convert->tasksNbr : &convert->timersNbr;
+  TraceConvert_Name* name = NULL;
+  uint32_t address = 0;
+
+  if (!parse_hex(&text, 8, &address) || (*text++ != ' ')) {
+    return false;
+  }
+
+  name = find_name(names, *namesNbr, address);
+  if (name == NULL) {
+    if (*namesNbr == TRACE_CONVERT_MAX_NAMES) {
+      return true;
+    }
+    name = &names[(*namesNbr)++];
+    name->address = address;
+  }
+  parse_name(text, name->name);
+
+  if (task) {
+    fprintf(convert->out,
+            ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}\n",
+            (uint32_t)(name - names) + 1, name->name);
+  }
+
+  return true;
+}
+
+
+/************************************************
+* Function definitions
+************************************************/
+
+/*************************************************************************
+* Function Name: TraceConvert_Begin
+* Description:   Start the JSON with the interrupts row
+* Parameters:    TraceConvert* convert
+*                FILE* out
+* Return:        void
+*************************************************************************/
+extern void TraceConvert_Begin(TraceConvert* convert, FILE* out) {
+  memset(convert, 0, sizeof(*convert));
+  convert->out = out;
+  // The target's clock until a header says otherwise
+  convert->cyclesPerUs = 120;
+
+  fprintf(out, "{\"traceEvents\":[\n");
+  fprintf(out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"interrupts\"}}\n",
+          TRACE_CONVERT_ISR_TID);
+}
+
+
+/*************************************************************************
+* Function Name: TraceConvert_Line
+* Description:   Convert one line of the capture
+* Parameters:    TraceConvert* convert
+*                const char* line
+* Return:        bool - false if a malformed "#T" line
+*************************************************************************/
+extern bool TraceConvert_Line(TraceConvert* convert, const char* line) {
+  bool good = true;
+
+  if (strncmp(line, "#T", 2) != 0) {
+    return true;
+  }
+
+  if (strncmp(line, "#TH ", 4) == 0) {
+    unsigned version = 0;
+    unsigned cyclesPerUs = 0;
+    unsigned index = 0;
+
+    good = (sscanf(line + 4, "%u %u %x", &version, &cyclesPerUs, &index) == 3) &&
+           (version == TRACE_RECORDER_STREAM_VERSION) && (cyclesPerUs > 0);
+    if (good) {
+      convert->cyclesPerUs = cyclesPerUs;
+      convert->nextIndex = index;
+      convert->synced = true;
+    }
+  }
+  else if (strncmp(line, "#TN ", 4) == 0) {
+    good = convert_name(convert, line + 4, true);
+  }
+  else if (strncmp(line, "#TS ", 4) == 0) {
+    good = convert_name(convert, line + 4, false);
+  }
+  else if (strncmp(line, "#TE ", 4) == 0) {
+    good = convert_events(convert, line + 4);
+  }
+  else {
+    good = false;
+  }
+
+  if (!good) {
+    convert->malformed++;
+  }
+  return good;
+}
+
+
+/*************************************************************************
+* Function Name: TraceConvert_End
+* Description:   End the running slice and the JSON
+* Parameters:    TraceConvert* convert
+* Return:        void
+*************************************************************************/
+extern void TraceConvert_End(TraceConvert* convert) {
+  if (convert->running != 0) {
+    uint32_t us = (uint32_t)(convert->elapsed / convert->cyclesPerUs);
+    uint32_t ns = (uint32_t)((convert->elapsed % convert->cyclesPerUs) * 1000 / convert->cyclesPerUs);
+    fprintf(convert->out, ",{\"ph\":\"E\",\"ts\":%u.%03u,\"pid\":1,\"tid\":%u}\n", us, ns, convert->running);
+  }
+
+  fprintf(convert->out, "]}\n");
+}
@@ -0,0 +1,83 @@
+/**
+* @Filename: Trace_Convert.h
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [6:30pm]
+* @Version:  1.0.0
+*
+* @Description: Host converter of a streamed trace (see
+*               Drivers/Trace_Recorder.h) to Chrome trace JSON, the same
+*               JSON "trace dump" prints on the target.
+*
+*               Lines of a console capture are given one at a time; lines
+*               not starting with "#T" are other console output and are
+*               skipped. A gap in the event index, from the header's
+*               on, is shown as a "lost" instant event on the interrupts
+*               row; an index going back is the ring being restarted.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef TOOLS_TRACE_CONVERT_H_
+#define TOOLS_TRACE_CONVERT_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/************************************************
+* Configuration
+************************************************/
+// Tasks and timers that can be named, and the longest name kept
+#define TRACE_CONVERT_MAX_NAMES 64
+#define TRACE_CONVERT_NAME_SIZE 32
+
+
+/************************************************
+* Types
+************************************************/
+typedef struct TraceConvert_Name {
+  uint32_t address;
+  char name[TRACE_CONVERT_NAME_SIZE];
+} TraceConvert_Name;
+
+typedef struct TraceConvert {
+  FILE* out;
+  uint32_t cyclesPerUs;
+
+  // Position in the stream
+  bool started;  // an event has been converted
+  bool synced;   // nextIndex is the index the next line should have
+  uint32_t nextIndex;
+  uint32_t previousCycles;
+  uint64_t elapsed;
+  uint32_t running;  // row of the running task, 0 if none
+
+  TraceConvert_Name tasks[TRACE_CONVERT_MAX_NAMES];
+  uint32_t tasksNbr;
+  TraceConvert_Name timers[TRACE_CONVERT_MAX_NAMES];
+  uint32_t timersNbr;
+
+  // Totals
+  uint32_t events;
+  uint32_t lost;
+  uint32_t malformed;  // "#T" lines that could not be read
+} TraceConvert;
+
+
+/************************************************
+* Function declarations
+************************************************/
+// Start the JSON on out
+extern void TraceConvert_Begin(TraceConvert* convert, FILE* out);
+
+// Convert one line of the capture. Returns false if it is a malformed
+// "#T" line.
+extern bool TraceConvert_Line(TraceConvert* convert, const char* line);
+
+// End the running slice and the JSON
+extern void TraceConvert_End(TraceConvert* convert);
+
+#endif /* TOOLS_TRACE_CONVERT_H_ */
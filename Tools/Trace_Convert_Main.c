@@ -0,0 +1,56 @@
+/**
+* @Filename: Trace_Convert_Main.c
+* @Author:   Kaiser Mittenburg and Ben Sokol
+* @Email:    ben@bensokol.com
+* @Email:    kaisermittenburg@gmail.com
+* @Created:  October 20th, 2026 [6:30pm]
+* @Version:  1.0.0
+*
+* @Description: Trace_Convert [capture] > trace.json
+*
+*               Converts a console capture taken while "trace stream on"
+*               (standard input if no file is named) to Chrome trace JSON
+*               on standard output. The totals go to standard error.
+*
+* Copyright (C) 2026 by Kaiser Mittenburg and Ben Sokol. All Rights Reserved.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Tools/Trace_Convert.h"
+
+
+int main(int argc, char* argv[]) {
+  TraceConvert convert;
+  FILE* in = stdin;
+  char line[256];
+
+  if (argc > 2) {
+    fprintf(stderr, "usage: %s [capture]\n", argv[0]);
+    return 2;
+  }
+  if (argc == 2) {
+    in = fopen(argv[1], "r");
+    if (in == NULL) {
+      perror(argv[1]);
+      return 1;
+    }
+  }
+
+  TraceConvert_Begin(&convert, stdout);
+  while (fgets(line, sizeof(line), in) != NULL) {
+    TraceConvert_Line(&convert, line);
+  }
+  TraceConvert_End(&convert);
+
+  fprintf(stderr, "%u events, %u lost, %u malformed lines, %u tasks\n", convert.events, convert.lost,
+          convert.malformed, convert.tasksNbr);
+
+  if (in != stdin) {
+    fclose(in);
+  }
+  return (convert.malformed == 0) ? 0 : 1;
+}